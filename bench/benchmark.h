@@ -0,0 +1,331 @@
+/**
+ * @file benchmark.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing a minimal, self-contained micro-benchmark harness for GRAB
+ * libraries.
+ *
+ * Each benchmark times a callable many times and reports the distribution of its cost
+ * in nanoseconds per call, so that both the typical cost and the jitter can be checked
+ * against the budget of a real-time control cycle. Results can be saved to a JSON file
+ * and compared against a previous run taken as baseline:
+ * @code
+ * grabbench::Runner runner(options);
+ * runner.Run("Matrix6d/Product", [&] {
+ *   grabbench::DoNotOptimize(mat1);
+ *   grabbench::DoNotOptimize(mat1 * mat2);
+ * });
+ * runner.Print();
+ * @endcode
+ */
+
+#ifndef GRABCOMMON_BENCH_BENCHMARK_H
+#define GRABCOMMON_BENCH_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+/**
+ * @brief Namespace for the micro-benchmark harness of GRAB libraries.
+ */
+namespace grabbench {
+
+/**
+ * Prevents the compiler from optimizing away the computation of a value.
+ *
+ * @param[in] value The value which must be computed.
+ */
+template <class T> inline void DoNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Prevents the compiler from optimizing away or reordering writes to memory.
+ */
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+/**
+ * @brief Options of a benchmark run.
+ */
+struct Options
+{
+  uint32_t samples      = 2000;   /**< number of timed samples per benchmark. */
+  double min_sample_ns  = 5000.0; /**< minimum duration of a sample [ns]. */
+  std::string filter    = "";     /**< only run benchmarks whose name contains this. */
+  std::string json_path = "";     /**< if not empty, results are written here. */
+  std::string baseline  = "";     /**< if not empty, results are compared to this. */
+  double tolerance      = 0.10;   /**< relative slow-down of the median flagged. */
+
+  /**
+   * Parses command line arguments.
+   *
+   * Recognized arguments are `--samples N`, `--filter TEXT`, `--json FILE`,
+   * `--baseline FILE` and `--tolerance FRACTION`.
+   *
+   * @param[in] argc The number of arguments.
+   * @param[in] argv The arguments.
+   * @return _True_ if all arguments were recognized, _false_ otherwise.
+   */
+  bool Parse(const int argc, const char* const* argv);
+};
+
+/**
+ * @brief Statistics of a benchmark, in nanoseconds per call.
+ */
+struct Result
+{
+  std::string name;    /**< benchmark name. */
+  uint32_t batch;      /**< calls per timed sample. */
+  double mean;         /**< mean cost. */
+  double median;       /**< median cost. */
+  double p90;          /**< 90th percentile of the cost. */
+  double p99;          /**< 99th percentile of the cost. */
+  double max;          /**< worst sample. */
+  double error = -1.0; /**< error w.r.t. a reference, negative if not measured. */
+};
+
+/**
+ * @brief Runs benchmarks and collects, prints, saves and compares their results.
+ */
+class Runner
+{
+public:
+  /**
+   * Constructor.
+   *
+   * @param[in] options The options of the run.
+   */
+  explicit Runner(const Options& options) : options_(options) {}
+
+  /**
+   * Times a callable, unless filtered out by the options.
+   *
+   * The callable is first called in batches of growing size until a batch lasts at least
+   * Options::min_sample_ns, then the same batch is timed Options::samples times. Each
+   * sample gives the average cost of a call within it.
+   *
+   * @param[in] name The name of the benchmark, e.g. `"Matrix6d/Product"`.
+   * @param[in] fun The callable to be timed. It should feed its inputs and outputs to
+   * DoNotOptimize().
+   */
+  template <class Fun> void Run(const std::string& name, Fun&& fun);
+
+  /**
+   * Attaches the accuracy to the results of a benchmark, so that it is reported next to
+   * its cost, e.g. when trading precision for speed.
+   *
+   * @param[in] name The name of a benchmark already run. If it was filtered out, nothing
+   * happens.
+   * @param[in] error The error of the benchmarked computation with respect to a
+   * reference one, e.g. the maximum absolute error of a single precision kernel with
+   * respect to its double precision counterpart.
+   */
+  void SetError(const std::string& name, const double error);
+
+  /**
+   * Returns the results collected so far.
+   *
+   * @return The results of all the benchmarks which were run.
+   */
+  const std::vector<Result>& Results() const { return results_; }
+
+  /**
+   * Prints a table with the results to the standard output.
+   */
+  void Print() const;
+
+  /**
+   * Writes the results to a JSON file.
+   *
+   * @param[in] path The path of the output file.
+   * @return _True_ if the file was written, _false_ otherwise.
+   */
+  bool WriteJson(const std::string& path) const;
+
+  /**
+   * Compares the results with the ones of a baseline JSON file, and prints the relative
+   * change of the medians.
+   *
+   * @param[in] path The path of a file written by WriteJson().
+   * @return The number of benchmarks whose median grew more than Options::tolerance, or
+   * -1 if the baseline could not be read.
+   */
+  int CompareToBaseline(const std::string& path) const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  Options options_;
+  std::vector<Result> results_;
+
+  template <class Fun> double TimeBatch(Fun& fun, const uint32_t batch) const;
+  static double Percentile(const std::vector<double>& sorted, const double fraction);
+};
+
+//----- Implementation ---------------------------------------------------------------//
+
+inline bool Options::Parse(const int argc, const char* const* argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (i + 1 == argc)
+      return false;
+    const char* value = argv[++i];
+    if (arg == "--samples")
+      samples = static_cast<uint32_t>(std::max(1, atoi(value)));
+    else if (arg == "--filter")
+      filter = value;
+    else if (arg == "--json")
+      json_path = value;
+    else if (arg == "--baseline")
+      baseline = value;
+    else if (arg == "--tolerance")
+      tolerance = atof(value);
+    else
+      return false;
+  }
+  return true;
+}
+
+template <class Fun> void Runner::Run(const std::string& name, Fun&& fun)
+{
+  if (name.find(options_.filter) == std::string::npos)
+    return;
+
+  // Warm up caches and branch predictors while calibrating the batch size.
+  uint32_t batch = 1;
+  while (TimeBatch(fun, batch) < options_.min_sample_ns && batch < (1u << 24))
+    batch *= 2;
+
+  std::vector<double> costs(options_.samples);
+  double sum = 0.0;
+  for (double& cost : costs)
+  {
+    cost = TimeBatch(fun, batch) / batch;
+    sum += cost;
+  }
+  std::sort(costs.begin(), costs.end());
+  results_.push_back({name, batch, sum / costs.size(), Percentile(costs, 0.5),
+                      Percentile(costs, 0.9), Percentile(costs, 0.99), costs.back()});
+}
+
+template <class Fun> double Runner::TimeBatch(Fun& fun, const uint32_t batch) const
+{
+  const Clock::time_point start = Clock::now();
+  for (uint32_t i = 0; i < batch; ++i)
+    fun();
+  ClobberMemory();
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+inline double Runner::Percentile(const std::vector<double>& sorted, const double fraction)
+{
+  // Nearest-rank percentile.
+  const size_t rank = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+  return sorted[std::min(rank, sorted.size() - 1)];
+}
+
+inline void Runner::SetError(const std::string& name, const double error)
+{
+  for (Result& result : results_)
+    if (result.name == name)
+      result.error = error;
+}
+
+inline void Runner::Print() const
+{
+  printf("%-36s %10s %10s %10s %10s %10s %9s %9s\n", "benchmark [ns/op]", "mean",
+         "median", "p90", "p99", "max", "batch", "error");
+  for (const Result& result : results_)
+  {
+    printf("%-36s %10.1f %10.1f %10.1f %10.1f %10.1f %9u", result.name.c_str(),
+           result.mean, result.median, result.p90, result.p99, result.max, result.batch);
+    if (result.error < 0.0)
+      printf(" %9s\n", "-");
+    else
+      printf(" %9.1e\n", result.error);
+  }
+}
+
+inline bool Runner::WriteJson(const std::string& path) const
+{
+  nlohmann::json benchmarks = nlohmann::json::array();
+  for (const Result& result : results_)
+  {
+    benchmarks.push_back({{"name", result.name},
+                          {"batch", result.batch},
+                          {"mean_ns", result.mean},
+                          {"median_ns", result.median},
+                          {"p90_ns", result.p90},
+                          {"p99_ns", result.p99},
+                          {"max_ns", result.max}});
+    if (result.error >= 0.0)
+      benchmarks.back()["error"] = result.error;
+  }
+  nlohmann::json context = {{"samples", options_.samples},
+#if defined(GRABNUM_SIMD_AVX2)
+                            {"simd", "AVX2"},
+#elif defined(GRABNUM_SIMD_SSE2)
+                            {"simd", "SSE2"},
+#else
+                            {"simd", "none"},
+#endif
+                            {"compiler", __VERSION__}};
+
+  std::ofstream file(path);
+  if (!file)
+    return false;
+  const nlohmann::json output = {{"context", context}, {"benchmarks", benchmarks}};
+  file << output.dump(2) << "\n";
+  return static_cast<bool>(file);
+}
+
+inline int Runner::CompareToBaseline(const std::string& path) const
+{
+  nlohmann::json baseline;
+  try
+  {
+    std::ifstream file(path);
+    file >> baseline;
+  }
+  catch (const std::exception& e)
+  {
+    printf("Could not read baseline %s: %s\n", path.c_str(), e.what());
+    return -1;
+  }
+
+  int regressions = 0;
+  printf("\n%-36s %12s %12s %9s\n", "median [ns/op]", "baseline", "current", "change");
+  for (const Result& result : results_)
+  {
+    const auto match = std::find_if(
+      baseline["benchmarks"].begin(), baseline["benchmarks"].end(),
+      [&result](const nlohmann::json& entry) { return entry["name"] == result.name; });
+    if (match == baseline["benchmarks"].end())
+    {
+      printf("%-36s %12s %12.1f %9s\n", result.name.c_str(), "-", result.median, "new");
+      continue;
+    }
+    const double reference = (*match)["median_ns"];
+    const double change     = result.median / reference - 1.0;
+    const bool regressed    = change > options_.tolerance;
+    regressions += regressed;
+    printf("%-36s %12.1f %12.1f %+8.1f%%%s\n", result.name.c_str(), reference,
+           result.median, 100.0 * change, regressed ? "  REGRESSION" : "");
+  }
+  return regressions;
+}
+
+} // end namespace grabbench
+
+#endif // GRABCOMMON_BENCH_BENCHMARK_H
@@ -0,0 +1,653 @@
+/**
+ * @file grabcommon_bench.cpp
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the micro-benchmarks of the hot paths of GRAB libraries.
+ *
+ * Usage:
+ * @code
+ * grabcommon_bench [--samples N] [--filter TEXT] [--json FILE] [--baseline FILE]
+ *                  [--tolerance FRACTION]
+ * @endcode
+ * The exit status is 1 if any benchmark got slower than the baseline by more than the
+ * given tolerance (10% by default), so that the benchmark can be used as a check.
+ */
+
+#include <random>
+#include <stdio.h>
+
+#include "benchmark.h"
+
+#include "decompositions.h"
+#include "diffkinematics.h"
+#include "kinematics.h"
+#include "matrix_utilities.h"
+#include "pid/pid.h"
+#include "quaternions.h"
+#include "rotations.h"
+#include "rotations_batch.h"
+#include "solvers.h"
+#include "statics.h"
+#include "vector_batch.h"
+
+using grabbench::DoNotOptimize;
+
+namespace {
+
+constexpr uint8_t kCablesNum = 8; // a typical over-constrained 6-DoF CDPR
+
+using Matrix6d = grabnum::MatrixXd<6, 6>;
+
+Matrix6d MakeSpdMatrix()
+{
+  Matrix6d mat;
+  for (uint8_t i = 1; i <= 6; ++i)
+    for (uint8_t j = 1; j <= 6; ++j)
+      mat(i, j) = 1.0 / (i + j) + (i == j ? 2.0 : 0.0);
+  return mat;
+}
+
+grabcdpr::Params MakeRobotParams(grabcdpr::PlatformParams* platform)
+{
+  platform->pos_PG_loc = grabnum::Vector3d({0.01, 0.02, -0.03});
+
+  grabcdpr::Params params;
+  params.platform = platform;
+  params.actuators.resize(kCablesNum);
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+  {
+    const double angle                 = i * 2.0 * M_PI / kCablesNum;
+    grabcdpr::ActuatorParams& actuator = params.actuators[i];
+    actuator.pulley.pos_OD_glob =
+      grabnum::Vector3d({2.0 * cos(angle), 2.0 * sin(angle), i % 2 ? 2.5 : 0.2});
+    actuator.pulley.vers_i = grabnum::Vector3d({cos(angle), sin(angle), 0.0});
+    actuator.pulley.vers_j = grabnum::Vector3d({-sin(angle), cos(angle), 0.0});
+    actuator.pulley.vers_k = grabnum::Vector3d({0.0, 0.0, 1.0});
+    actuator.pulley.radius = 0.05;
+    actuator.winch.pos_PA_loc =
+      grabnum::Vector3d({0.2 * cos(angle + 0.3), 0.2 * sin(angle + 0.3), 0.1});
+  }
+  return params;
+}
+
+template <typename T1, typename T2, uint8_t rows, uint8_t cols>
+double MaxAbsDiff(const grabnum::Matrix<T1, rows, cols>& mat1,
+                  const grabnum::Matrix<T2, rows, cols>& mat2)
+{
+  double max_diff = 0.0;
+  for (uint8_t i = 1; i <= rows; ++i)
+    for (uint8_t j = 1; j <= cols; ++j)
+      max_diff = std::max(max_diff, fabs(static_cast<double>(mat1(i, j)) - mat2(i, j)));
+  return max_diff;
+}
+
+void BenchNumeric(grabbench::Runner& runner)
+{
+  grabnum::Matrix3d mat3 = grabgeom::RPY2Rot(0.1, 0.2, 0.3);
+  Matrix6d mat6 = MakeSpdMatrix();
+  grabnum::MatrixXd<6, kCablesNum> structure_mat;
+  grabnum::VectorXd<kCablesNum> tensions;
+  for (uint8_t j = 1; j <= kCablesNum; ++j)
+  {
+    tensions(j) = 100.0 + j;
+    for (uint8_t i = 1; i <= 6; ++i)
+      structure_mat(i, j) = sin(i * j);
+  }
+  grabnum::VectorXd<6> vect6({1., 2., 3., 4., 5., 6.});
+  grabnum::Vector3d vect1({0.1, 0.2, 0.3});
+  grabnum::Vector3d vect2({-0.4, 0.5, 0.6});
+
+  runner.Run("Matrix3d/Product", [&] {
+    DoNotOptimize(mat3);
+    DoNotOptimize(grabnum::Matrix3d(mat3 * mat3));
+  });
+  runner.Run("Matrix6d/Product", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(Matrix6d(mat6 * mat6));
+  });
+  runner.Run("Matrix6d/Sum", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(Matrix6d(mat6 + 2.0 * mat6));
+  });
+  runner.Run("Matrix6d/Transpose", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(mat6.Transpose());
+  });
+  runner.Run("Matrix6x8/WrenchProduct", [&] {
+    DoNotOptimize(structure_mat);
+    DoNotOptimize(grabnum::VectorXd<6>(structure_mat * tensions));
+  });
+  runner.Run("Vector3d/Cross", [&] {
+    DoNotOptimize(vect1);
+    DoNotOptimize(grabnum::Cross(vect1, vect2));
+  });
+  runner.Run("Vector3d/Norm", [&] {
+    DoNotOptimize(vect1);
+    DoNotOptimize(grabnum::Norm(vect1));
+  });
+  runner.Run("Det/3x3", [&] {
+    DoNotOptimize(mat3);
+    DoNotOptimize(grabnum::Det(mat3));
+  });
+  runner.Run("Det/6x6", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::Det(mat6));
+  });
+  runner.Run("Linsolve/6x6", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::solvers::Linsolve(mat6, vect6));
+  });
+  runner.Run("LU/6x6/Solve", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::LU<double, 6>(mat6).Solve(vect6));
+  });
+  runner.Run("Cholesky/6x6", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::Cholesky(mat6));
+  });
+  runner.Run("LDLT/6x6/Solve", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::LDLT<double, 6>(mat6).Solve(vect6));
+  });
+  grabnum::LDLT<double, 6> ldlt(mat6);
+  const grabnum::VectorXd<6> update = 0.1 * vect6;
+  runner.Run("LDLT/6x6/Update+Downdate", [&] {
+    DoNotOptimize(ldlt.Update(update));
+    DoNotOptimize(ldlt.Update(update, -1.0));
+  });
+  runner.Run("IsPositiveDefinite/6x6", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(mat6.IsPositiveDefinite());
+  });
+  grabnum::Matrix3d sym3 = mat3 + mat3.Transpose();
+  runner.Run("SymmetricEigen/3x3", [&] {
+    DoNotOptimize(sym3);
+    DoNotOptimize(grabnum::SymmetricEigen<double, 3>(sym3).GetEigenvalues());
+  });
+  runner.Run("SymmetricEigen/6x6", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::SymmetricEigen<double, 6>(mat6).GetEigenvalues());
+  });
+  runner.Run("SymmetricEigen/6x6/ValuesOnly", [&] {
+    DoNotOptimize(mat6);
+    DoNotOptimize(grabnum::SymmetricEigen<double, 6>(mat6, false).GetEigenvalues());
+  });
+  runner.Run("SVD/6x8", [&] {
+    DoNotOptimize(structure_mat);
+    DoNotOptimize(grabnum::SVD<double, 6, kCablesNum>(structure_mat).GetSingularValues());
+  });
+  runner.Run("SVD/6x8/Condition", [&] {
+    DoNotOptimize(structure_mat);
+    DoNotOptimize(grabnum::SVD<double, 6, kCablesNum>(structure_mat, false).Condition());
+  });
+
+  grabnum::Vector3Batchd<kCablesNum> batch1, batch2;
+  std::array<double, kCablesNum> angles;
+  for (uint8_t i = 1; i <= kCablesNum; ++i)
+  {
+    batch1.Set(i, vect1 * i);
+    batch2.Set(i, vect2 - vect1 * i);
+    angles[i - 1] = 0.7 * i;
+  }
+  runner.Run("Vector3Batch8/Dot", [&] {
+    DoNotOptimize(batch1);
+    DoNotOptimize(grabnum::Dot(batch1, batch2));
+  });
+  runner.Run("Vector3Batch8/Norm", [&] {
+    DoNotOptimize(batch1);
+    DoNotOptimize(grabnum::Norm(batch1));
+  });
+  runner.Run("Batch8/SinCos", [&] {
+    std::array<double, kCablesNum> sin, cos;
+    DoNotOptimize(angles);
+    grabnum::SinCos(angles, &sin, &cos);
+    DoNotOptimize(sin);
+    DoNotOptimize(cos);
+  });
+}
+
+void BenchGeom(grabbench::Runner& runner)
+{
+  grabnum::Vector3d rpy({0.1, -0.2, 0.3});
+  grabnum::Matrix3d rot_mat = grabgeom::RPY2Rot(rpy);
+  grabgeom::Quaternion quat = grabgeom::Rot2Quat(rot_mat);
+
+  runner.Run("RPY2Rot", [&] {
+    DoNotOptimize(rpy);
+    DoNotOptimize(grabgeom::RPY2Rot(rpy));
+  });
+  grabnum::Vector3f rpy_f(rpy);
+  runner.Run("RPY2Rot/float", [&] {
+    DoNotOptimize(rpy_f);
+    DoNotOptimize(grabgeom::RPY2Rot(rpy_f));
+  });
+  runner.SetError("RPY2Rot/float", MaxAbsDiff(grabgeom::RPY2Rot(rpy_f), rot_mat));
+  const grabnum::Vector3d tilt_torsion({0.4, 0.2, -0.1});
+  const grabnum::Vector3d angles_dot({0.5, -0.3, 0.2});
+  runner.Run("TiltTorsion2Rot+Htf+DHtf", [&] {
+    DoNotOptimize(tilt_torsion);
+    DoNotOptimize(grabgeom::TiltTorsion2Rot(tilt_torsion));
+    DoNotOptimize(grabgeom::HtfTiltTorsion(tilt_torsion));
+    DoNotOptimize(grabgeom::DHtfTiltTorsion(tilt_torsion, angles_dot));
+  });
+  runner.Run("TiltTorsion2Rot+Htf+DHtf/SharedSinCos", [&] {
+    DoNotOptimize(tilt_torsion);
+    const grabgeom::AnglesSinCos<double> trig(tilt_torsion);
+    DoNotOptimize(grabgeom::TiltTorsion2Rot(trig));
+    DoNotOptimize(grabgeom::HtfTiltTorsion(trig));
+    DoNotOptimize(grabgeom::DHtfTiltTorsion(trig, angles_dot));
+  });
+  runner.Run("Rot2Quat", [&] {
+    DoNotOptimize(rot_mat);
+    DoNotOptimize(grabgeom::Rot2Quat(rot_mat));
+  });
+  runner.Run("Quat2Rot", [&] {
+    DoNotOptimize(quat);
+    DoNotOptimize(grabgeom::Quat2Rot(quat));
+  });
+
+  // Rotating a vector directly by a quaternion, against building the matrix first.
+  const grabnum::Vector3d vect({0.2, -0.1, 0.4});
+  runner.Run("QuatRotate/Quat2Rot*Vector", [&] {
+    DoNotOptimize(quat);
+    DoNotOptimize(grabnum::Vector3d(grabgeom::Quat2Rot(quat) * vect));
+  });
+  runner.Run("QuatRotate", [&] {
+    DoNotOptimize(quat);
+    DoNotOptimize(grabgeom::QuatRotate(quat, vect));
+  });
+  runner.SetError("QuatRotate",
+                  MaxAbsDiff(grabgeom::QuatRotate(quat, vect), rot_mat * vect));
+  const grabgeom::Quaternion quat_dot(0.01, 0.02, -0.01, 0.03);
+  runner.Run("HtfQuat*Vector", [&] {
+    DoNotOptimize(quat);
+    DoNotOptimize(grabnum::Vector3d(grabgeom::HtfQuat(quat) * quat_dot.q()));
+  });
+  runner.Run("HtfQuatMul", [&] {
+    DoNotOptimize(quat);
+    DoNotOptimize(grabgeom::HtfQuatMul(quat, quat_dot));
+  });
+
+  // Random rotations, e.g. as received from an external tracker, so that no path through
+  // the conversions can be learned by the branch predictor, and matrices drifting by up
+  // to 1e-6 per element to be corrected.
+  constexpr uint16_t kRotationsNum = 1024;
+  std::mt19937 generator(42);
+  std::normal_distribution<double> normal;
+  std::uniform_real_distribution<double> drift(-1e-6, 1e-6);
+  std::vector<grabnum::Matrix3d> rot_mats(kRotationsNum);
+  std::vector<grabnum::Matrix3d> drifting_mats(kRotationsNum);
+  for (uint16_t k = 0; k < kRotationsNum; ++k)
+  {
+    grabgeom::Quaternion random_quat(normal(generator), normal(generator),
+                                     normal(generator), normal(generator));
+    rot_mats[k] = grabgeom::Quat2Rot(random_quat.Normalized());
+    drifting_mats[k] = rot_mats[k];
+    for (uint8_t i = 1; i <= 3; ++i)
+      for (uint8_t j = 1; j <= 3; ++j)
+        drifting_mats[k](i, j) += drift(generator);
+  }
+  uint16_t rotation = 0;
+  runner.Run("Random1k/Rot2Quat", [&] {
+    rotation = (rotation + 1) % kRotationsNum;
+    DoNotOptimize(grabgeom::Rot2Quat(rot_mats[rotation]));
+  });
+  runner.Run("Random1k/Rot2RPY", [&] {
+    rotation = (rotation + 1) % kRotationsNum;
+    DoNotOptimize(grabgeom::Rot2RPY(rot_mats[rotation]));
+  });
+  runner.Run("Random1k/Orthonormalize", [&] {
+    rotation = (rotation + 1) % kRotationsNum;
+    DoNotOptimize(grabgeom::Orthonormalize(drifting_mats[rotation]));
+  });
+
+  const grabgeom::Quaternion quat_end =
+    grabgeom::RPY2Quat(grabnum::Vector3d({0.4, 0.1, -0.5}));
+  const grabgeom::Quaternion quat_next =
+    grabgeom::RPY2Quat(grabnum::Vector3d({0.6, -0.2, -0.3}));
+  const grabgeom::Quaternion ctrl_start =
+    grabgeom::QuatSquadControlPoint(quat, quat, quat_end);
+  const grabgeom::Quaternion ctrl_end =
+    grabgeom::QuatSquadControlPoint(quat, quat_end, quat_next);
+  double param = 0.3;
+  runner.Run("QuatSlerp", [&] {
+    DoNotOptimize(param);
+    DoNotOptimize(grabgeom::QuatSlerp(quat, quat_end, param));
+  });
+  runner.Run("QuatNlerp", [&] {
+    DoNotOptimize(param);
+    DoNotOptimize(grabgeom::QuatNlerp(quat, quat_end, param));
+  });
+  runner.Run("QuatSquad", [&] {
+    DoNotOptimize(param);
+    DoNotOptimize(grabgeom::QuatSquad(quat, ctrl_start, ctrl_end, quat_end, param));
+  });
+
+  // A segment sampled at 1 kHz for one second.
+  constexpr uint32_t kSegmentSamples = 1000;
+  std::vector<double> params(kSegmentSamples), segment(4 * kSegmentSamples);
+  for (uint32_t i = 0; i < kSegmentSamples; ++i)
+    params[i] = i / (kSegmentSamples - 1.0);
+  runner.Run("Segment1k/QuatSquad/Loop", [&] {
+    for (uint32_t i = 0; i < kSegmentSamples; ++i)
+    {
+      const grabgeom::Quaternion q =
+        grabgeom::QuatSquad(quat, ctrl_start, ctrl_end, quat_end, params[i]);
+      segment[i]                       = q.w;
+      segment[kSegmentSamples + i]     = q.x;
+      segment[2 * kSegmentSamples + i] = q.y;
+      segment[3 * kSegmentSamples + i] = q.z;
+    }
+    DoNotOptimize(segment);
+  });
+  runner.Run("Segment1k/QuatSquad/Batch", [&] {
+    grabgeom::batch::QuatSquad(quat, ctrl_start, ctrl_end, quat_end, params.data(),
+                               segment.data(), kSegmentSamples, kSegmentSamples);
+    DoNotOptimize(segment);
+  });
+  double squad_error = 0.0;
+  for (uint32_t i = 0; i < kSegmentSamples; ++i)
+  {
+    const grabgeom::Quaternion q =
+      grabgeom::QuatSquad(quat, ctrl_start, ctrl_end, quat_end, params[i]);
+    squad_error = std::max(squad_error, fabs(q.w - segment[i]));
+    squad_error = std::max(squad_error, fabs(q.z - segment[3 * kSegmentSamples + i]));
+  }
+  runner.SetError("Segment1k/QuatSquad/Batch", squad_error);
+  runner.Run("Segment1k/QuatSlerp/Batch", [&] {
+    grabgeom::batch::QuatSlerp(quat, quat_end, params.data(), segment.data(),
+                               kSegmentSamples, kSegmentSamples);
+    DoNotOptimize(segment);
+  });
+  runner.Run("Segment1k/QuatNlerp/Batch", [&] {
+    grabgeom::batch::QuatNlerp(quat, quat_end, params.data(), segment.data(),
+                               kSegmentSamples, kSegmentSamples);
+    DoNotOptimize(segment);
+  });
+
+  // An offline trajectory, stored as structure of arrays.
+  constexpr uint32_t kSamples = 1 << 16;
+  std::vector<double> traj_rpy(3 * kSamples), traj_quat(4 * kSamples);
+  std::vector<double> traj_rot(9 * kSamples), traj_angles(3 * kSamples);
+  for (uint32_t i = 0; i < kSamples; ++i)
+  {
+    traj_rpy[i]                = 0.5 * sin(1e-3 * i);
+    traj_rpy[kSamples + i]     = 0.3 * cos(2e-3 * i);
+    traj_rpy[2 * kSamples + i] = 3.0 * sin(1e-4 * i);
+  }
+  runner.Run("Trajectory64k/RPY2Quat/Loop", [&] {
+    for (uint32_t i = 0; i < kSamples; ++i)
+    {
+      const grabgeom::Quaternion q = grabgeom::RPY2Quat(
+        traj_rpy[i], traj_rpy[kSamples + i], traj_rpy[2 * kSamples + i]);
+      traj_quat[i]                = q.w;
+      traj_quat[kSamples + i]     = q.x;
+      traj_quat[2 * kSamples + i] = q.y;
+      traj_quat[3 * kSamples + i] = q.z;
+    }
+    DoNotOptimize(traj_quat);
+  });
+  runner.Run("Trajectory64k/RPY2Quat/Batch", [&] {
+    grabgeom::batch::RPY2Quat(traj_rpy.data(), traj_quat.data(), kSamples, kSamples);
+    DoNotOptimize(traj_quat);
+  });
+  runner.Run("Trajectory64k/RPY2Quat/Parallel", [&] {
+    grabgeom::batch::ParallelConvert(grabgeom::batch::RPY2Quat<double>, traj_rpy.data(),
+                                     traj_quat.data(), kSamples, kSamples);
+    DoNotOptimize(traj_quat);
+  });
+  runner.Run("Trajectory64k/Quat2Rot/Batch", [&] {
+    grabgeom::batch::Quat2Rot(traj_quat.data(), traj_rot.data(), kSamples, kSamples);
+    DoNotOptimize(traj_rot);
+  });
+  runner.Run("Trajectory64k/Rot2EulerXYZ/Loop", [&] {
+    for (uint32_t i = 0; i < kSamples; ++i)
+    {
+      grabnum::Matrix3d rot;
+      for (uint8_t k = 0; k < 9; ++k)
+        rot.Data()[k] = traj_rot[k * kSamples + i];
+      const grabnum::Vector3d angles = grabgeom::Rot2EulerXYZ(rot);
+      for (uint8_t k = 0; k < 3; ++k)
+        traj_angles[k * kSamples + i] = angles(k + 1);
+    }
+    DoNotOptimize(traj_angles);
+  });
+  runner.Run("Trajectory64k/Rot2EulerXYZ/Batch", [&] {
+    grabgeom::batch::Rot2EulerXYZ(traj_rot.data(), traj_angles.data(), kSamples,
+                                  kSamples);
+    DoNotOptimize(traj_angles);
+  });
+  // Round trip error through quaternions and rotation matrices.
+  grabgeom::batch::RPY2Quat(traj_rpy.data(), traj_quat.data(), kSamples, kSamples);
+  grabgeom::batch::Quat2RPY(traj_quat.data(), traj_angles.data(), kSamples, kSamples);
+  double round_trip_error = 0.0;
+  for (uint32_t i = 0; i < 3 * kSamples; ++i)
+    round_trip_error = std::max(round_trip_error, fabs(traj_angles[i] - traj_rpy[i]));
+  runner.SetError("Trajectory64k/RPY2Quat/Batch", round_trip_error);
+}
+
+void BenchCdpr(grabbench::Runner& runner)
+{
+  grabcdpr::PlatformParams platform_params;
+  const grabcdpr::Params params = MakeRobotParams(&platform_params);
+
+  const grabnum::Vector3d position({0.1, -0.2, 0.8});
+  const grabnum::Vector3d velocity({0.3, 0.1, -0.2});
+  const grabnum::Vector3d acceleration({-0.5, 0.2, 0.1});
+  const grabnum::Vector3d angles({0.1, 0.2, 0.3});
+  const grabnum::Vector3d angles_dot({0.05, -0.1, 0.2});
+  const grabnum::Vector3d angles_ddot({0.3, 0.1, -0.4});
+
+  grabcdpr::PlatformVars platform(grabcdpr::RPY);
+  grabcdpr::Vars vars;
+  vars.platform = &platform;
+  vars.cables.resize(kCablesNum);
+  grabcdpr::UpdateIK(position, angles, velocity, angles_dot, acceleration, angles_ddot,
+                     &params, &vars);
+
+  runner.Run("UpdateIK0/RPY/8cables", [&] {
+    grabcdpr::UpdateIK0(position, angles, &params, &vars);
+    DoNotOptimize(vars.cables.front().length);
+  });
+  runner.Run("UpdateIK1/RPY/8cables", [&] {
+    grabcdpr::UpdateIK1(velocity, angles_dot, &vars);
+    DoNotOptimize(vars.cables.front().speed);
+  });
+  runner.Run("UpdateIK2/RPY/8cables", [&] {
+    grabcdpr::UpdateIK2(acceleration, angles_ddot, &params, &vars);
+    DoNotOptimize(vars.cables.front().acceleration);
+  });
+  grabcdpr::PlatformVars platform_tt(grabcdpr::TILT_TORSION);
+  runner.Run("PlatformVars/Update/TiltTorsion", [&] {
+    DoNotOptimize(angles);
+    platform_tt.Update(position, velocity, acceleration, angles, angles_dot, angles_ddot);
+    DoNotOptimize(platform_tt.angular_acc);
+  });
+
+  // Cable lengths only, in double and single precision, the latter with and without
+  // double accumulation. Errors are the worst ones over a range of platform poses.
+  std::vector<grabcdpr::ActuatorGeometry<double>> geometry;
+  std::vector<grabcdpr::ActuatorGeometry<float>> geometry_f;
+  for (const grabcdpr::ActuatorParams& actuator : params.actuators)
+  {
+    geometry.push_back(grabcdpr::ActuatorGeometry<double>(actuator));
+    geometry_f.push_back(grabcdpr::ActuatorGeometry<float>(actuator));
+  }
+  const grabnum::Matrix3d rot_mat = grabgeom::RPY2Rot(angles);
+  const grabnum::Vector3f position_f(position);
+  const grabnum::Matrix3f rot_mat_f = grabgeom::RPY2Rot(grabnum::Vector3f(angles));
+  std::vector<double> lengths;
+  std::vector<float> lengths_f;
+  runner.Run("CalcCablesLength/double/8cables", [&] {
+    DoNotOptimize(position);
+    grabcdpr::CalcCablesLength(position, rot_mat, geometry, &lengths);
+    DoNotOptimize(lengths.front());
+  });
+  runner.Run("CalcCablesLength/float/8cables", [&] {
+    DoNotOptimize(position_f);
+    grabcdpr::CalcCablesLength(position_f, rot_mat_f, geometry_f, &lengths_f);
+    DoNotOptimize(lengths_f.front());
+  });
+  runner.Run("CalcCablesLength/float+acc/8cables", [&] {
+    DoNotOptimize(position_f);
+    grabcdpr::CalcCablesLength<float, double>(position_f, rot_mat_f, geometry_f,
+                                              &lengths_f);
+    DoNotOptimize(lengths_f.front());
+  });
+  double error     = 0.0;
+  double error_acc = 0.0;
+  for (uint16_t k = 0; k < 1000; ++k)
+  {
+    const grabnum::Vector3d sample_position(
+      {1.5 * sin(0.01 * k), 1.5 * cos(0.013 * k), 0.5 + 0.001 * k});
+    const grabnum::Vector3d sample_angles({0.3 * sin(0.02 * k), 0.2, 0.001 * k});
+    grabcdpr::CalcCablesLength(sample_position, grabgeom::RPY2Rot(sample_angles),
+                               geometry, &lengths);
+    const grabnum::Matrix3f sample_rot_mat_f =
+      grabgeom::RPY2Rot(grabnum::Vector3f(sample_angles));
+    grabcdpr::CalcCablesLength(grabnum::Vector3f(sample_position), sample_rot_mat_f,
+                               geometry_f, &lengths_f);
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+      error = std::max(error, fabs(lengths_f[i] - lengths[i]));
+    grabcdpr::CalcCablesLength<float, double>(grabnum::Vector3f(sample_position),
+                                              sample_rot_mat_f, geometry_f, &lengths_f);
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+      error_acc = std::max(error_acc, fabs(lengths_f[i] - lengths[i]));
+  }
+  runner.SetError("CalcCablesLength/float/8cables", error);
+  runner.SetError("CalcCablesLength/float+acc/8cables", error_acc);
+
+  // Forward kinematics along a closed trajectory sampled at 1 kHz, one sample per call.
+  constexpr uint16_t kSamplesNum = 1000;
+  std::vector<grabcdpr::CableVars> measures(kSamplesNum * kCablesNum);
+  for (uint16_t k = 0; k < kSamplesNum; ++k)
+  {
+    const double phase = k * 2.0 * M_PI / kSamplesNum;
+    const double offset = 0.1 * sin(phase);
+    grabcdpr::UpdateIK0(grabnum::Vector3d({position(1) + 0.1 * cos(phase),
+                                           position(2) + offset, position(3)}),
+                        grabnum::Vector3d({angles(1), angles(2), angles(3) + offset}),
+                        &params, &vars);
+    std::copy(vars.cables.begin(), vars.cables.end(), measures.begin() + k * kCablesNum);
+  }
+  grabcdpr::FKWorkspace workspace;
+  uint16_t sample = 0;
+  runner.Run("UpdateFK0/RPY/8cables", [&] {
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+    {
+      vars.cables[i].length     = measures[sample * kCablesNum + i].length;
+      vars.cables[i].swivel_ang = measures[sample * kCablesNum + i].swivel_ang;
+    }
+    sample = (sample + 1) % kSamplesNum;
+    DoNotOptimize(grabcdpr::UpdateFK0(&params, &vars, &workspace));
+  });
+
+  // Tension distribution of slowly varying wrenches, which the robot can exert with
+  // tensions close to the lower limit.
+  grabcdpr::UpdateIK0(position, angles, &params, &vars);
+  const grabnum::MatrixXd<6, kCablesNum> structure_mat =
+    grabcdpr::CalcStructureMatrix<kCablesNum>(vars.cables);
+  std::vector<grabnum::VectorXd<6>> wrenches(kSamplesNum);
+  for (uint16_t k = 0; k < kSamplesNum; ++k)
+  {
+    grabnum::VectorXd<kCablesNum> tensions;
+    for (uint8_t i = 1; i <= kCablesNum; ++i)
+      tensions(i) = 60.0 + 40.0 * sin(k * 2.0 * M_PI / kSamplesNum + i);
+    wrenches[k] = structure_mat * tensions;
+  }
+  grabcdpr::TensionWorkspace<kCablesNum> tension_workspace;
+  tension_workspace.min_tension = 30.0;
+  tension_workspace.max_tension = 300.0;
+  runner.Run("UpdateCablesTension/8cables", [&] {
+    sample = (sample + 1) % kSamplesNum;
+    DoNotOptimize(
+      grabcdpr::UpdateCablesTension(wrenches[sample], &vars.cables, &tension_workspace));
+  });
+
+  const grabgeom::Quaternion quat = grabgeom::RPY2Quat(angles);
+  const grabgeom::Quaternion quat_dot(0.01, 0.02, -0.01, 0.03);
+  grabcdpr::PlatformQuatVars platform_quat(position, velocity, acceleration, quat,
+                                           quat_dot, quat_dot);
+  grabcdpr::VarsQuat vars_quat;
+  vars_quat.platform = &platform_quat;
+  vars_quat.cables.resize(kCablesNum);
+  grabcdpr::UpdateIK0(position, quat, &params, &vars_quat);
+
+  // Attach points of all cables, one at a time against all at once.
+  runner.Run("UpdatePosA/8cables/Loop", [&] {
+    DoNotOptimize(platform_quat.rot_mat);
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+    {
+      grabcdpr::CableVars& cable = vars_quat.cables[i];
+      cable.pos_PA_glob = platform_quat.rot_mat * params.actuators[i].winch.pos_PA_loc;
+      cable.pos_OA_glob = platform_quat.position + cable.pos_PA_glob;
+      cable.pos_DA_glob = cable.pos_OA_glob - params.actuators[i].pulley.pos_OD_glob;
+    }
+    DoNotOptimize(vars_quat.cables.back().pos_DA_glob);
+  });
+  runner.Run("UpdatePosA/8cables/Batch", [&] {
+    DoNotOptimize(platform_quat.rot_mat);
+    grabcdpr::UpdatePosA(params.actuators, &platform_quat, &vars_quat.cables);
+    DoNotOptimize(vars_quat.cables.back().pos_DA_glob);
+  });
+  runner.Run("PlatformQuatVars/Update", [&] {
+    DoNotOptimize(quat);
+    platform_quat.Update(position, velocity, acceleration, quat, quat_dot, quat_dot);
+    DoNotOptimize(platform_quat.angular_acc);
+  });
+  runner.Run("UpdateIK0/Quat/8cables", [&] {
+    grabcdpr::UpdateIK0(position, quat, &params, &vars_quat);
+    DoNotOptimize(vars_quat.cables.front().length);
+  });
+  runner.Run("UpdateIK1/Quat/8cables", [&] {
+    grabcdpr::UpdateIK1(velocity, quat_dot, &vars_quat);
+    DoNotOptimize(vars_quat.cables.front().speed);
+  });
+}
+
+void BenchControl(grabbench::Runner& runner)
+{
+  PID pid(0.001, 1.5, 0.5, 0.01, 0.005, 10.0, -10.0);
+  double value = 0.0;
+
+  runner.Run("PID/Calculate", [&] {
+    DoNotOptimize(value);
+    value = 0.999 * value + 1e-3 * pid.Calculate(1.0, value);
+  });
+}
+
+} // end anonymous namespace
+
+int main(int argc, char** argv)
+{
+  grabbench::Options options;
+  if (!options.Parse(argc, argv))
+  {
+    printf("Usage: %s [--samples N] [--filter TEXT] [--json FILE] [--baseline FILE] "
+           "[--tolerance FRACTION]\n",
+           argv[0]);
+    return 2;
+  }
+
+  grabbench::Runner runner(options);
+  BenchNumeric(runner);
+  BenchGeom(runner);
+  BenchCdpr(runner);
+  BenchControl(runner);
+  runner.Print();
+
+  if (!options.json_path.empty() && !runner.WriteJson(options.json_path))
+  {
+    printf("Could not write %s\n", options.json_path.c_str());
+    return 2;
+  }
+  if (!options.baseline.empty())
+  {
+    const int regressions = runner.CompareToBaseline(options.baseline);
+    if (regressions < 0)
+      return 2;
+    if (regressions > 0)
+      return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,48 @@
+QT       -= core gui
+
+TARGET = grabcommon_bench
+CONFIG   += console c++14 release thread
+CONFIG   -= app_bundle qt
+
+TEMPLATE = app
+
+HEADERS += \
+    $$PWD/benchmark.h \
+    $$PWD/../pid/pid.h \
+    $$PWD/../libcdpr/inc/kinematics.h \
+    $$PWD/../libcdpr/inc/diffkinematics.h \
+    $$PWD/../libcdpr/inc/statics.h \
+    $$PWD/../libcdpr/inc/types.h
+
+SOURCES += \
+    $$PWD/grabcommon_bench.cpp \
+    $$PWD/../pid/pid.cpp \
+    $$PWD/../libcdpr/src/kinematics.cpp \
+    $$PWD/../libcdpr/src/diffkinematics.cpp \
+    $$PWD/../libcdpr/src/statics.cpp
+
+INCLUDEPATH += \
+    $$PWD \
+    $$PWD/.. \
+    $$PWD/../libcdpr/inc \
+    $$PWD/../libcdpr/tools
+
+# Benchmarks are meaningful only in release mode. Uncomment to time the kernels of the
+# instruction set of the host (see libnumeric/inc/simd.h).
+# QMAKE_CXXFLAGS += -march=native
+
+# Lib numeric
+unix:!macx: LIBS += -L$$PWD/../libnumeric/lib/ -lnumeric
+
+INCLUDEPATH += $$PWD/../libnumeric $$PWD/../libnumeric/inc
+DEPENDPATH += $$PWD/../libnumeric
+
+unix:!macx: PRE_TARGETDEPS += $$PWD/../libnumeric/lib/libnumeric.a
+
+# Lib geometric
+unix:!macx: LIBS += -L$$PWD/../libgeom/lib/ -lgeom
+
+INCLUDEPATH += $$PWD/../libgeom $$PWD/../libgeom/inc
+DEPENDPATH += $$PWD/../libgeom
+
+unix:!macx: PRE_TARGETDEPS += $$PWD/../libgeom/lib/libgeom.a
@@ -2,6 +2,7 @@
 HEADERS += \
     $$PWD/inc/kinematics.h \
     $$PWD/inc/diffkinematics.h \
+    $$PWD/inc/statics.h \
     $$PWD/inc/types.h \
     $$PWD/tools/json.hpp \
     $$PWD/tools/robotconfigjsonparser.h \
@@ -10,6 +11,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/src/kinematics.cpp \
     $$PWD/src/diffkinematics.cpp \
+    $$PWD/src/statics.cpp \
     $$PWD/tools/robotconfigjsonparser.cpp \
 
 INCLUDEPATH += \
@@ -19,7 +21,7 @@ INCLUDEPATH += \
 
 QT       -= gui
 
-CONFIG   += staticlib c++11
+CONFIG   += staticlib c++14
 CONFIG   -= app_bundle
 
 TEMPLATE = lib
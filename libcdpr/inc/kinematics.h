@@ -11,6 +11,7 @@
 
 #include "matrix_utilities.h"
 #include "rotations.h"
+#include "solvers.h"
 #include "types.h"
 
 /**
@@ -86,6 +87,24 @@ template <class PlatformVarsType>
 void UpdatePosA(const ActuatorParams* params, const PlatformVarsType* platform,
                 CableVars* cable);
 
+/**
+ * @brief Update global position of points @f$A_i@f$ and relative segments of all cables
+ * at once.
+ *
+ * Same as calling UpdatePosA() for each cable, but local attach points are rotated
+ * together by grabgeom::batch::Rotate().
+ * @param[in] params The parameters of all actuators, at least as many as cables.
+ * @param[in] platform A pointer to the updated platform structure.
+ * @param[out] cables A pointer to the variables of all cables, including the positions to
+ * be updated.
+ * @note See @ref legend for symbols reference.
+ * @note Both orientation parametrizations are valid here, that is both angles and
+ * quaternions can be used.
+ */
+template <class PlatformVarsType>
+void UpdatePosA(const std::vector<ActuatorParams>& params,
+                const PlatformVarsType* platform, std::vector<CableVars>* cables);
+
 /**
  * @brief Calculate swivel pulley versors @f$\hat{\mathbf{u}}_i, \hat{\mathbf{w}}_i@f$.
  *
@@ -272,6 +291,133 @@ template <class OrientationType, class VarsType>
 void UpdateIK0(const grabnum::Vector3d& position, const OrientationType& orientation,
                const Params* params, VarsType* vars);
 
+/**
+ * @brief Copy of the actuator parameters used by CalcCablesLength(), in a given scalar
+ * type.
+ *
+ * It is meant to be built once from the robot parameters, e.g. in single precision for
+ * controllers where @c float arithmetic is faster or twice as wide in SIMD registers.
+ */
+template <typename T> struct ActuatorGeometry
+{
+  grabnum::Vector3<T> pos_PA_loc;  /**< [m] vector @f$\mathbf{a}_i'@f$. */
+  grabnum::Vector3<T> pos_OD_glob; /**< [m] vector @f$\mathbf{d}_i@f$. */
+  grabnum::Vector3<T> vers_i;      /**< versor @f$\hat{\mathbf{i}}_i@f$. */
+  grabnum::Vector3<T> vers_j;      /**< versor @f$\hat{\mathbf{j}}_i@f$. */
+  grabnum::Vector3<T> vers_k;      /**< versor @f$\hat{\mathbf{k}}_i@f$. */
+  T radius = 0;                    /**< [m] swivel pulley radius @f$r_i@f$. */
+
+  /**
+   * @brief Default constructor.
+   */
+  ActuatorGeometry() {}
+  /**
+   * @brief Constructor converting the parameters of an actuator.
+   * @param[in] params The parameters of _i-th_ actuator.
+   */
+  explicit ActuatorGeometry(const ActuatorParams& params)
+    : pos_PA_loc(params.winch.pos_PA_loc), pos_OD_glob(params.pulley.pos_OD_glob),
+      vers_i(params.pulley.vers_i), vers_j(params.pulley.vers_j),
+      vers_k(params.pulley.vers_k), radius(static_cast<T>(params.pulley.radius))
+  {}
+};
+
+/**
+ * @brief Calculate cable lengths and swivel angles of a given platform pose.
+ *
+ * This is the hot path of UpdateIK0(), i.e. the same quantities are found, without
+ * filling any variables structure. Since @f$\sigma_i@f$ is the angle of
+ * @f$\mathbf{d}_i\mathbf{a}_i@f$ in the swivel plane, no versor is needed at all:
+ * @f[
+ * \hat{\mathbf{u}}_i \cdot \overrightarrow{D_iA_i} = \sqrt{(\hat{\mathbf{i}}_i \cdot
+ * \overrightarrow{D_iA_i})^2 + (\hat{\mathbf{j}}_i \cdot \overrightarrow{D_iA_i})^2}
+ * \qquad \|\boldsymbol{\rho}_i\|^2 = \|\overrightarrow{D_iA_i}\|^2 - 2r_i
+ * \hat{\mathbf{u}}_i \cdot \overrightarrow{D_iA_i}
+ * @f]
+ * All inputs and outputs are of type @a T. Differences and dot products of positions,
+ * which may cancel out several meters to get a few millimeters, are carried out in type
+ * @a AccT instead: single precision inputs with double precision accumulation is the
+ * trade-off between the speed of @c float and the accuracy of @c double.
+ * @param[in] position [m] Platform global position @f$\mathbf{p}@f$.
+ * @param[in] rot_mat Platform rotation matrix @f$\mathbf{R}@f$, e.g. from
+ * grabgeom::RPY2Rot().
+ * @param[in] actuators The geometry of all actuators.
+ * @param[out] lengths [m] Cable lengths @f$l_i@f$, resized to the number of actuators.
+ * @param[out] swivel_angles (Optional) [rad] Swivel angles @f$\sigma_i@f$, resized to
+ * the number of actuators.
+ * @note Only <tt>(T, AccT)</tt> = <tt>(double, double)</tt>, <tt>(float, float)</tt>
+ * and <tt>(float, double)</tt> are instantiated in the library.
+ * @note See @ref legend for symbols reference.
+ */
+template <typename T, typename AccT = T>
+void CalcCablesLength(const grabnum::Vector3<T>& position,
+                      const grabnum::Matrix3<T>& rot_mat,
+                      const std::vector<ActuatorGeometry<T>>& actuators,
+                      std::vector<T>* lengths, std::vector<T>* swivel_angles = nullptr);
+
+/**
+ * @brief Settings and reusable state of the forward kinematics solver UpdateFK0().
+ *
+ * The same workspace must be passed at each control cycle, so that the factorization of
+ * the normal equations computed at a cycle can be reused at the following ones.
+ * Measurement buffers are sized at the first call, hence no memory is allocated
+ * afterwards as long as the number of cables does not change.
+ */
+struct FKWorkspace
+{
+  uint8_t max_iter     = 10;    /**< maximum number of iterations per call. */
+  double ftol          = 1e-10; /**< [_m_] tolerance on the norm of the residual. */
+  double xtol          = 1e-8;  /**< relative tolerance on the norm of the step. */
+  double swivel_weight = 1.0;   /**< [_m/rad_] weight of swivel angle residuals. */
+  double damping       = 1e-9;  /**< relative damping of the normal equations, which
+                                     keeps them solvable at singular orientations. */
+  double refresh_ratio = 0.005; /**< ratio between consecutive step norms above which
+                                     the jacobian is recomputed. */
+
+  std::vector<double> lengths;       /**< [_m_] measured cable lengths. */
+  std::vector<double> swivel_angles; /**< [_rad_] measured swivel angles. */
+  grabnum::LU<double, 6> normal_lu;  /**< factorization of the normal equations. */
+  bool cached               = false; /**< whether @ref normal_lu is valid. */
+  double contraction        = 0.0;   /**< last ratio between consecutive step norms. */
+  uint32_t jacobian_updates = 0;     /**< number of factorizations so far. */
+};
+
+/**
+ * @brief Update all robots zero-order variables at once from measured cable lengths and
+ * swivel angles (forward kinematics problem).
+ *
+ * The platform pose @f$\mathbf{q}@f$ is found as the least-squares solution of
+ * @f[
+ * l_i(\mathbf{q}) = \bar{l}_i \qquad w_\sigma\sigma_i(\mathbf{q}) =
+ * w_\sigma\bar{\sigma}_i \qquad i = 1, \dots, n
+ * @f]
+ * by _Gauss-Newton_ iterations, using the analytic jacobian of the inverse kinematics
+ * @f[
+ * \frac{\partial l_i}{\partial\mathbf{q}} = \left[\hat{\boldsymbol{\rho}}_i^T,
+ * (\mathbf{a}'_i \times \hat{\boldsymbol{\rho}}_i)^T\mathbf{H}\right] \qquad
+ * \frac{\partial \sigma_i}{\partial\mathbf{q}} = \frac{\left[\hat{\mathbf{w}}_i^T,
+ * (\mathbf{a}'_i \times \hat{\mathbf{w}}_i)^T\mathbf{H}\right]}
+ * {\hat{\mathbf{u}}_i \cdot \mathbf{f}_i}
+ * @f]
+ * Iterations are warm-started from the current platform pose in @a vars, i.e. the
+ * solution of the previous control cycle. The gradient is always exact, while the
+ * factorization of the normal equations is kept in @a workspace and reused, across
+ * iterations and cycles, as long as each step is at least 1/FKWorkspace::refresh_ratio
+ * times shorter than the previous one. At 1 kHz a typical cycle takes two iterations,
+ * and the jacobian is refreshed once every few cycles only.
+ * @param[in] params A pointer to the robot parameters structure.
+ * @param[in,out] vars A pointer to the robot variables structure. Cable lengths and
+ * swivel angles are read as measurements, and the platform pose is used as initial
+ * guess. On return, all zero-order variables are updated at the solution, thus
+ * measurements are replaced by their fitted values (they are kept in @a workspace).
+ * @param[in,out] workspace A pointer to the settings and state of the solver.
+ * @return The convergence diagnostics.
+ * @note Only the 3-angle parametrization of the orientation is supported.
+ * @note See @ref legend for symbols reference.
+ */
+grabnum::solvers::SolverReport<double> UpdateFK0(const Params* params, Vars* vars,
+                                                 FKWorkspace* workspace);
+
 /** @} */ // end of ZeroOrderKinematics group
 
 } // end namespace grabcdpr
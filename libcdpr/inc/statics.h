@@ -0,0 +1,118 @@
+/**
+ * @file statics.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing statics-related functions to be included in the GRAB CDPR
+ * library.
+ */
+
+#ifndef GRABCOMMON_LIBCDPR_STATICS_H
+#define GRABCOMMON_LIBCDPR_STATICS_H
+
+#include "matrix_utilities.h"
+#include "solvers.h"
+#include "types.h"
+
+/**
+ * @brief Namespace for CDPR-related utilities, such as kinematics and dynamics.
+ */
+namespace grabcdpr {
+
+/** @defgroup Statics Statics
+ * This group collects all elements related to the statics of a generic 6DoF CDPR, i.e.
+ * to the distribution of a wrench among the cables.
+ * @{
+ */
+
+/**
+ * @brief Calculate the structure matrix @f$\mathbf{W}@f$.
+ *
+ * The _i-th_ column of the structure matrix is the wrench exerted on the platform, about
+ * its origin @f$P@f$ and in global frame, by the _i-th_ cable under unit tension:
+ * @f[
+ * \mathbf{W}_i = -\begin{bmatrix} \hat{\boldsymbol{\rho}}_i \\
+ * \mathbf{a}'_i \times \hat{\boldsymbol{\rho}}_i \end{bmatrix}
+ * @f]
+ * so that @f$\mathbf{W}\boldsymbol{\tau}@f$ is the total wrench of the cables.
+ * @param[in] cables The cables variables, with up-to-date zero-order kinematics.
+ * @return The @f$6 \times n@f$ structure matrix.
+ * @note See @ref legend for symbols reference.
+ */
+template <uint8_t cables_num>
+grabnum::Matrix<double, 6, cables_num>
+CalcStructureMatrix(const std::vector<CableVars>& cables);
+
+/**
+ * @brief Calculate the wrench the cables must exert to hold the platform still.
+ *
+ * It balances gravity and the external loads in @a params, which are assumed to be
+ * applied at the center of gravity @f$G@f$:
+ * @f[
+ * \mathbf{w} = -\begin{bmatrix} \mathbf{f} \\ \mathbf{r}' \times \mathbf{f} +
+ * \mathbf{R}\,^\mathcal{P}\boldsymbol{\mu} \end{bmatrix} \qquad \mathbf{f} =
+ * m\mathbf{g} + \mathbf{R}\,^\mathcal{P}\mathbf{f}_{ext}
+ * @f]
+ * Inertial effects of a moving platform, if relevant, must be added by the caller.
+ * @param[in] params A pointer to the platform parameters structure.
+ * @param[in] platform A pointer to the platform variables structure, with up-to-date
+ * zero-order kinematics.
+ * @param[in] gravity (Optional) [_m/s<sup>2</sup>_] Gravity acceleration in global frame.
+ * Default is 9.81 along negative _z_.
+ * @return [_N_, _Nm_] The wrench about @f$P@f$ in global frame.
+ * @note See @ref legend for symbols reference.
+ */
+grabnum::VectorXd<6>
+CalcStaticWrench(const PlatformParams* params, const PlatformVarsBase* platform,
+                 const grabnum::Vector3d& gravity = grabnum::Vector3d({0.0, 0.0, -9.81}));
+
+/**
+ * @brief Settings and reusable state of the tension distribution UpdateCablesTension().
+ *
+ * The same workspace must be passed at each control cycle, so that the set of cables at
+ * their limits found at a cycle is the starting guess of the following one.
+ */
+template <uint8_t cables_num> struct TensionWorkspace
+{
+  double min_tension       = 10.0;   /**< [_N_] lower limit of all cable tensions. */
+  double max_tension       = 1000.0; /**< [_N_] upper limit of all cable tensions. */
+  double reference_tension = 0.0;    /**< [_N_] tension each cable is drawn toward, e.g.
+                                          0 for the minimum-norm distribution or the mid
+                                          limit for the one farthest from the limits. */
+  grabnum::solvers::QPOptions<double> options; /**< options of the QP solver. */
+
+  grabnum::Matrix<double, 6, cables_num> structure_mat; /**< last structure matrix. */
+  grabnum::solvers::QPWorkspace<double, cables_num, 6> qp; /**< state of the solver. */
+};
+
+/**
+ * @brief Update cable tensions so that they exert a given wrench on the platform.
+ *
+ * Among the infinitely many tension distributions of a redundant robot, it finds the
+ * closest one to TensionWorkspace::reference_tension within the limits:
+ * @f[
+ * \min_{\boldsymbol{\tau}} \frac{1}{2}\|\boldsymbol{\tau} - \tau_{ref}\mathbf{1}\|^2
+ * \quad \text{s.t.} \quad \mathbf{W}\boldsymbol{\tau} = \mathbf{w}, \quad
+ * \tau_{min} \leq \tau_i \leq \tau_{max}
+ * @f]
+ * by means of grabnum::solvers::QuadProg(), warm-started from the limits reached at the
+ * previous call. At 1 kHz, this is typically solved in a single iteration and takes a
+ * few microseconds, without allocating any memory.
+ * @param[in] wrench [_N_, _Nm_] The wrench about @f$P@f$ in global frame, e.g. the one
+ * given by CalcStaticWrench().
+ * @param[in,out] cables The cables variables, with up-to-date zero-order kinematics. On
+ * return, their tensions are updated.
+ * @param[in,out] workspace A pointer to the settings and state of the solver.
+ * @return The convergence diagnostics. If the wrench cannot be exerted within the
+ * limits, the status is INFEASIBLE and the tensions are the ones which get closest to it.
+ * @note Only robots with 6, 7 or 8 cables are instantiated in the library.
+ */
+template <uint8_t cables_num>
+grabnum::solvers::SolverReport<double>
+UpdateCablesTension(const grabnum::VectorXd<6>& wrench, std::vector<CableVars>* cables,
+                    TensionWorkspace<cables_num>* workspace);
+
+/** @} */ // end of Statics group
+
+} // end namespace grabcdpr
+
+#endif // GRABCOMMON_LIBCDPR_STATICS_H
@@ -211,6 +211,8 @@ struct PlatformVars: PlatformVarsBase
    * @{
    */
   grabnum::Vector3d orientation; /**< [_rad_] vector @f$\boldsymbol{\varepsilon}@f$. */
+  grabgeom::AnglesSinCos<double>
+    orientation_trig; /**< sines and cosines of @f$\boldsymbol{\varepsilon}@f$. */
 
   grabnum::Matrix3d h_mat;  /**< matrix @f$\mathbf{H}@f$. */
   grabnum::Matrix3d dh_mat; /**< matrix @f$\dot{\mathbf{H}}@f$. */
@@ -270,6 +272,9 @@ struct PlatformVars: PlatformVarsBase
 
   /**
    * @brief Update platform pose with position and angles.
+   *
+   * Sines and cosines of the angles are computed here once, and reused by UpdateVel()
+   * and UpdateAcc() when no orientation is given to them.
    * @param[in] _position [m] Platform global position @f$\mathbf{p}@f$.
    * @param[in] _orientation [rad] Platform global orientation expressed by angles
    * @f$\boldsymbol{\varepsilon}@f$.
@@ -286,21 +291,22 @@ struct PlatformVars: PlatformVarsBase
     for (uint8_t i = 1; i <= 3; ++i)
     {
       pose(i)     = position(i);
-      pose(2 * i) = orientation(i);
+      pose(3 + i) = orientation(i);
     }
+    orientation_trig = grabgeom::AnglesSinCos<double>(orientation);
     switch (angles_type)
     {
       case EULER_ZYZ:
-        rot_mat = grabgeom::EulerZYZ2Rot(orientation);
+        rot_mat = grabgeom::EulerZYZ2Rot(orientation_trig);
         break;
       case TAIT_BRYAN:
-        rot_mat = grabgeom::EulerXYZ2Rot(orientation);
+        rot_mat = grabgeom::EulerXYZ2Rot(orientation_trig);
         break;
       case RPY:
-        rot_mat = grabgeom::RPY2Rot(orientation);
+        rot_mat = grabgeom::RPY2Rot(orientation_trig);
         break;
       case TILT_TORSION:
-        rot_mat = grabgeom::TiltTorsion2Rot(orientation);
+        rot_mat = grabgeom::TiltTorsion2Rot(orientation_trig);
         break;
     }
   }
@@ -318,22 +324,40 @@ struct PlatformVars: PlatformVarsBase
   void UpdateVel(const grabnum::Vector3d& _velocity,
                  const grabnum::Vector3d& _orientation_dot,
                  const grabnum::Vector3d& _orientation)
+  {
+    UpdateVel(_velocity, _orientation_dot,
+              grabgeom::AnglesSinCos<double>(_orientation));
+  }
+
+  /**
+   * @brief Update platform velocities with linear velocity and angles speed.
+   * @param[in] _velocity [m/s] Platform global linear velocity @f$\dot{\mathbf{p}}@f$.
+   * @param[in] _orientation_dot [rad/s] Vector @f$\dot{\boldsymbol{\varepsilon}}@f$.
+   * @param[in] _orientation_trig Sines and cosines of platform global orientation
+   * angles @f$\boldsymbol{\varepsilon}@f$.
+   * @ingroup FirstOrderKinematics
+   * @see UpdateVel()
+   * @note See @ref legend for more details.
+   */
+  void UpdateVel(const grabnum::Vector3d& _velocity,
+                 const grabnum::Vector3d& _orientation_dot,
+                 const grabgeom::AnglesSinCos<double>& _orientation_trig)
   {
     velocity        = _velocity;
     orientation_dot = _orientation_dot;
     switch (angles_type)
     {
       case EULER_ZYZ:
-        h_mat = grabgeom::HtfZYZ(_orientation);
+        h_mat = grabgeom::HtfZYZ(_orientation_trig);
         break;
       case TAIT_BRYAN:
-        h_mat = grabgeom::HtfXYZ(_orientation);
-        break;
-      case TILT_TORSION:
-        h_mat = grabgeom::HtfRPY(_orientation);
+        h_mat = grabgeom::HtfXYZ(_orientation_trig);
         break;
       case RPY:
-        h_mat = grabgeom::HtfTiltTorsion(_orientation);
+        h_mat = grabgeom::HtfRPY(_orientation_trig);
+        break;
+      case TILT_TORSION:
+        h_mat = grabgeom::HtfTiltTorsion(_orientation_trig);
         break;
     }
     angular_vel = h_mat * orientation_dot;
@@ -353,7 +377,7 @@ struct PlatformVars: PlatformVarsBase
   void UpdateVel(const grabnum::Vector3d& _velocity,
                  const grabnum::Vector3d& _orientation_dot)
   {
-    UpdateVel(_velocity, _orientation_dot, orientation);
+    UpdateVel(_velocity, _orientation_dot, orientation_trig);
   }
 
   /**
@@ -373,22 +397,45 @@ struct PlatformVars: PlatformVarsBase
                  const grabnum::Vector3d& _orientation_ddot,
                  const grabnum::Vector3d& _orientation_dot,
                  const grabnum::Vector3d& _orientation, const grabnum::Matrix3d& _h_mat)
+  {
+    UpdateAcc(_acceleration, _orientation_ddot, _orientation_dot,
+              grabgeom::AnglesSinCos<double>(_orientation), _h_mat);
+  }
+
+  /**
+   * @brief Update platform accelerations with linear and angles acceleration.
+   * @param[in] _acceleration [m/s<sup>2</sup>] Vector @f$\ddot{\mathbf{p}}@f$.
+   * @param[in] _orientation_ddot [rad/s<sup>2</sup>] Vector
+   * @f$\ddot{\boldsymbol{\varepsilon}}@f$.
+   * @param[in] _orientation_dot [rad/s] Vector @f$\dot{\boldsymbol{\varepsilon}}@f$.
+   * @param[in] _orientation_trig Sines and cosines of platform global orientation
+   * angles @f$\boldsymbol{\varepsilon}@f$.
+   * @param[in] _h_mat Transformation matrix @f$\mathbf{H}@f$.
+   * @ingroup SecondOrderKinematics
+   * @see UpdateAcc()
+   * @note See @ref legend for more details.
+   */
+  void UpdateAcc(const grabnum::Vector3d& _acceleration,
+                 const grabnum::Vector3d& _orientation_ddot,
+                 const grabnum::Vector3d& _orientation_dot,
+                 const grabgeom::AnglesSinCos<double>& _orientation_trig,
+                 const grabnum::Matrix3d& _h_mat)
   {
     acceleration     = _acceleration;
     orientation_ddot = _orientation_ddot;
     switch (angles_type)
     {
       case TAIT_BRYAN:
-        dh_mat = grabgeom::DHtfXYZ(_orientation, _orientation_dot);
+        dh_mat = grabgeom::DHtfXYZ(_orientation_trig, _orientation_dot);
         break;
       case TILT_TORSION:
-        dh_mat = grabgeom::DHtfTiltTorsion(_orientation, _orientation_dot);
+        dh_mat = grabgeom::DHtfTiltTorsion(_orientation_trig, _orientation_dot);
         break;
       case RPY:
-        dh_mat = grabgeom::DHtfRPY(_orientation, _orientation_dot);
+        dh_mat = grabgeom::DHtfRPY(_orientation_trig, _orientation_dot);
         break;
       case EULER_ZYZ:
-        dh_mat = grabgeom::DHtfZYZ(_orientation, _orientation_dot);
+        dh_mat = grabgeom::DHtfZYZ(_orientation_trig, _orientation_dot);
         break;
     }
     angular_acc = dh_mat * _orientation_dot + _h_mat * orientation_ddot;
@@ -409,7 +456,7 @@ struct PlatformVars: PlatformVarsBase
   void UpdateAcc(const grabnum::Vector3d& _acceleration,
                  const grabnum::Vector3d& _orientation_ddot)
   {
-    UpdateAcc(_acceleration, _orientation_ddot, orientation_dot, orientation, h_mat);
+    UpdateAcc(_acceleration, _orientation_ddot, orientation_dot, orientation_trig, h_mat);
   }
 
   /**
@@ -518,10 +565,10 @@ struct PlatformQuatVars: PlatformVarsBase
     for (uint8_t i = 1; i <= 3; ++i)
     {
       pose(i)     = position(i);
-      pose(2 * i) = orientation(i);
+      pose(3 + i) = orientation(i);
     }
     pose(7) = orientation(4);
-    rot_mat = grabgeom::Quat2Rot(orientation);
+    rot_mat = grabgeom::Quat2Rot(_orientation);
   }
 
   /**
@@ -542,7 +589,7 @@ struct PlatformQuatVars: PlatformVarsBase
     velocity        = _velocity;
     orientation_dot = _orientation_dot.q();
     h_mat           = grabgeom::HtfQuat(_orientation);
-    angular_vel     = h_mat * orientation_dot;
+    angular_vel     = grabgeom::HtfQuatMul(_orientation, _orientation_dot);
   }
   /**
    * @brief Update platform velocities with linear velocity and angles speed.
@@ -581,7 +628,8 @@ struct PlatformQuatVars: PlatformVarsBase
     acceleration     = _acceleration;
     orientation_ddot = _orientation_ddot.q();
     dh_mat           = grabgeom::DHtfQuat(_orientation_dot);
-    angular_acc      = dh_mat * _orientation_dot.q() + _h_mat * orientation_ddot;
+    // Term dh_mat * orientation_dot vanishes identically, see grabgeom::DHtfQuatMul().
+    angular_acc = _h_mat * orientation_ddot;
   }
   /**
    * @brief Update platform accelerations with linear and quaternion acceleration.
@@ -686,6 +734,12 @@ struct CableVars
   grabnum::Vector3d
     acc_OA_glob; /**< [_m/s<sup>2</sup>_] vector @f$\ddot{\mathbf{a}}_i@f$. */
   /** @} */      // end of SecondOrderKinematics group
+
+  /** @addtogroup Statics
+   * @{
+   */
+  double tension; /**< [_N_] _i-th_ cable tension @f$\tau_i@f$. */
+  /** @} */       // end of Statics group
 };
 
 /**
@@ -3,7 +3,7 @@ QT       += testlib
 QT       -= gui
 
 TARGET = libcdpr_test
-CONFIG   += console c++11
+CONFIG   += console c++14
 CONFIG   -= app_bundle
 
 TEMPLATE = app
@@ -17,6 +17,7 @@ DEFINES += QT_DEPRECATED_WARNINGS
 HEADERS += \
     $$PWD/inc/kinematics.h \
     $$PWD/inc/diffkinematics.h \
+    $$PWD/inc/statics.h \
     $$PWD/inc/types.h \
     $$PWD/tools/json.hpp \
     $$PWD/tools/robotconfigjsonparser.h \
@@ -25,6 +26,7 @@ HEADERS += \
 SOURCES += \
     $$PWD/src/kinematics.cpp \
     $$PWD/src/diffkinematics.cpp \
+    $$PWD/src/statics.cpp \
     $$PWD/tools/robotconfigjsonparser.cpp \
     $$PWD/test/libcdpr_test.cpp
 
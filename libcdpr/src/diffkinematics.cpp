@@ -246,7 +246,7 @@ void UpdateIK2(const grabnum::Vector3d& acceleration,
 {
   UpdatePlatformAcc(acceleration, orientation_ddot, vars->platform);
   for (uint8_t i = 0; i < vars->cables.size(); ++i)
-    UpdateCableSecondOrd(&(params->actuators[i]), vars->platform, &(vars->cables[i]));
+    UpdateCableSecondOrd(params->actuators[i].pulley, vars->platform, &(vars->cables[i]));
 }
 
 template <class OrientationType, class VarsType>
@@ -263,8 +263,29 @@ void UpdateIK(const grabnum::Vector3d& position, const OrientationType& orientat
   {
     UpdateCableZeroOrd(&(params->actuators[i]), vars->platform, &(vars->cables[i]));
     UpdateCableFirstOrd(vars->platform, &(vars->cables[i]));
-    UpdateCableSecondOrd(&(params->actuators[i]), vars->platform, &(vars->cables[i]));
+    UpdateCableSecondOrd(params->actuators[i].pulley, vars->platform, &(vars->cables[i]));
   }
 }
 
+// Explicit instantiations.
+template void UpdateIK1<grabnum::Vector3d, Vars>(const grabnum::Vector3d&,
+                                                 const grabnum::Vector3d&, Vars*);
+template void UpdateIK1<grabgeom::Quaternion, VarsQuat>(const grabnum::Vector3d&,
+                                                        const grabgeom::Quaternion&,
+                                                        VarsQuat*);
+template void UpdateIK2<grabnum::Vector3d, Vars>(const grabnum::Vector3d&,
+                                                 const grabnum::Vector3d&, const Params*,
+                                                 Vars*);
+template void UpdateIK2<grabgeom::Quaternion, VarsQuat>(const grabnum::Vector3d&,
+                                                        const grabgeom::Quaternion&,
+                                                        const Params*, VarsQuat*);
+template void UpdateIK<grabnum::Vector3d, Vars>(
+  const grabnum::Vector3d&, const grabnum::Vector3d&, const grabnum::Vector3d&,
+  const grabnum::Vector3d&, const grabnum::Vector3d&, const grabnum::Vector3d&,
+  const Params*, Vars*);
+template void UpdateIK<grabgeom::Quaternion, VarsQuat>(
+  const grabnum::Vector3d&, const grabgeom::Quaternion&, const grabnum::Vector3d&,
+  const grabgeom::Quaternion&, const grabnum::Vector3d&, const grabgeom::Quaternion&,
+  const Params*, VarsQuat*);
+
 } // end namespace grabcdpr
@@ -7,9 +7,25 @@
 
 #include "kinematics.h"
 
+#include "rotations_batch.h"
+
 namespace grabcdpr
 {
 
+namespace {
+
+// Update all zero-order variables of a cable following the segments ending with A_i.
+void UpdateCableFromPosA(const PulleyParams& params, CableVars* cable)
+{
+  cable->swivel_ang = CalcSwivelAngle(params, cable); // from 1st kinematic constraint.
+  CalcPulleyVersors(params, cable);
+  cable->tan_ang = CalcTangentAngle(params, cable); // from 2nd kinematic constraint.
+  CalcCableVectors(params, cable);                  // from 1st kinematic constraint.
+  cable->length = CalcCableLen(params, cable);      // from 3rd kinematic constraint.
+}
+
+} // end anonymous namespace
+
 template <class OrientationType, class PlatformVarsType>
 void UpdatePlatformPose(const grabnum::Vector3d& position,
                         const OrientationType& orientation,
@@ -39,6 +55,40 @@ void UpdatePosA(const ActuatorParams* params, const PlatformVarsType* platform,
   cable->pos_DA_glob = cable->pos_OA_glob - params->pulley.pos_OD_glob;
 }
 
+template <class PlatformVarsType>
+void UpdatePosA(const std::vector<ActuatorParams>& params,
+                const PlatformVarsType* platform, std::vector<CableVars>* cables)
+{
+  assert(params.size() >= cables->size());
+
+  // Gather local attach points component by component and rotate them all at once, a
+  // block of cables at a time.
+  static constexpr size_t kBlockSize = 16;
+  const size_t cables_num            = cables->size();
+  for (size_t begin = 0; begin < cables_num; begin += kBlockSize)
+  {
+    const size_t count           = std::min(kBlockSize, cables_num - begin);
+    double pos_PA[3][kBlockSize] = {};
+    for (size_t i = 0; i < count; ++i)
+      for (size_t k = 0; k < 3; ++k)
+        pos_PA[k][i] = params[begin + i].winch.pos_PA_loc(k + 1);
+    grabgeom::batch::Rotate(platform->rot_mat, pos_PA[0], pos_PA[0],
+                            static_cast<uint32_t>(count), kBlockSize);
+    for (size_t i = 0; i < count; ++i)
+    {
+      const ActuatorParams& actuator = params[begin + i];
+      CableVars& cable               = (*cables)[begin + i];
+      for (size_t k = 0; k < 3; ++k)
+      {
+        cable.pos_PA_glob(k + 1) = pos_PA[k][i];
+        cable.pos_OA_glob(k + 1) = platform->position(k + 1) + pos_PA[k][i];
+        cable.pos_DA_glob(k + 1) =
+          cable.pos_OA_glob(k + 1) - actuator.pulley.pos_OD_glob(k + 1);
+      }
+    }
+  }
+}
+
 void CalcPulleyVersors(const PulleyParams& params, const double swivel_ang,
                        CableVars* cable)
 {
@@ -114,13 +164,7 @@ void UpdateCableZeroOrd(const ActuatorParams* params, const PlatformVarsType* pl
                         CableVars* cable)
 {
   UpdatePosA(params, platform, cable); // update segments ending with point A_i.
-  cable->swivel_ang =
-    CalcSwivelAngle(params->pulley, cable); // from 1st kinematic constraint.
-  CalcPulleyVersors(params->pulley, cable);
-  cable->tan_ang =
-    CalcTangentAngle(params->pulley, cable);           // from 2nd kinematic constraint.
-  CalcCableVectors(params->pulley, cable);             // from 1st kinematic constraint.
-  cable->length = CalcCableLen(params->pulley, cable); // from 3rd kinematic constraint.
+  UpdateCableFromPosA(params->pulley, cable);
 }
 
 template <class OrientationType, class VarsType>
@@ -128,8 +172,224 @@ void UpdateIK0(const grabnum::Vector3d& position, const OrientationType& orienta
                const Params* params, VarsType* vars)
 {
   UpdatePlatformPose(position, orientation, params->platform, vars->platform);
+  // Segments ending with points A_i of all cables at once.
+  UpdatePosA(params->actuators, vars->platform, &(vars->cables));
   for (uint8_t i = 0; i < vars->cables.size(); ++i)
-    UpdateCableZeroOrd(&(params->actuators[i]), vars->platform, &(vars->cables[i]));
+    UpdateCableFromPosA(params->actuators[i].pulley, &(vars->cables[i]));
+}
+
+template <typename T, typename AccT>
+void CalcCablesLength(const grabnum::Vector3<T>& position,
+                      const grabnum::Matrix3<T>& rot_mat,
+                      const std::vector<ActuatorGeometry<T>>& actuators,
+                      std::vector<T>* lengths, std::vector<T>* swivel_angles)
+{
+  const size_t cables_num = actuators.size();
+  lengths->resize(cables_num);
+  if (swivel_angles != nullptr)
+    swivel_angles->resize(cables_num);
+  for (size_t i = 0; i < cables_num; ++i)
+  {
+    const ActuatorGeometry<T>& actuator   = actuators[i];
+    const grabnum::Vector3<T> pos_PA_glob = rot_mat * actuator.pos_PA_loc;
+    // Components of vector DA along the pulley axes.
+    AccT proj_i = 0;
+    AccT proj_j = 0;
+    AccT proj_k = 0;
+    for (uint8_t j = 1; j <= 3; ++j)
+    {
+      const AccT pos_DA_glob =
+        static_cast<AccT>(position(j)) + pos_PA_glob(j) - actuator.pos_OD_glob(j);
+      proj_i += actuator.vers_i(j) * pos_DA_glob;
+      proj_j += actuator.vers_j(j) * pos_DA_glob;
+      proj_k += actuator.vers_k(j) * pos_DA_glob;
+    }
+    // Component along u, being the one along w null by definition of swivel angle.
+    const AccT proj_u    = std::sqrt(proj_i * proj_i + proj_j * proj_j);
+    const AccT radius    = actuator.radius;
+    const T app_var      = static_cast<T>(proj_k / proj_u);
+    const T radius_ratio = static_cast<T>(2 * radius / proj_u);
+    const T tan_ang =
+      2 * std::atan(app_var + std::sqrt(1 - radius_ratio + SQUARE(app_var)));
+    const AccT rho_norm =
+      std::sqrt(proj_u * proj_u + proj_k * proj_k - 2 * radius * proj_u);
+    (*lengths)[i] =
+      static_cast<T>(radius * (static_cast<AccT>(M_PI) - tan_ang) + rho_norm);
+    if (swivel_angles != nullptr)
+      (*swivel_angles)[i] = std::atan2(static_cast<T>(proj_j), static_cast<T>(proj_i));
+  }
+}
+
+grabnum::solvers::SolverReport<double> UpdateFK0(const Params* params, Vars* vars,
+                                                 FKWorkspace* workspace)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const Clock::time_point start = Clock::now();
+  grabnum::solvers::SolverReport<double> report{grabnum::solvers::NUMERIC_FAILURE, 0, 0,
+                                                0.0, 0.0, 0.0};
+  const size_t cables_num = vars->cables.size();
+  workspace->lengths.resize(cables_num);
+  workspace->swivel_angles.resize(cables_num);
+  for (size_t i = 0; i < cables_num; ++i)
+  {
+    workspace->lengths[i]       = vars->cables[i].length;
+    workspace->swivel_angles[i] = vars->cables[i].swivel_ang;
+  }
+
+  PlatformVars* platform        = vars->platform;
+  grabnum::Vector3d position    = platform->position;
+  grabnum::Vector3d orientation = platform->orientation;
+  grabnum::VectorXd<6> row;
+  grabnum::VectorXd<6> grad;
+  grabnum::MatrixXd<6, 6> normal_mat;
+  double last_step_norm = 0.0;
+  double step_norm      = 0.0;
+  bool small_step       = false;
+  bool refresh = !workspace->cached || workspace->contraction > workspace->refresh_ratio;
+  while (true)
+  {
+    UpdateIK0(position, orientation, params, vars);
+    report.evaluations++;
+    // Only H is needed here, velocities are left untouched.
+    platform->UpdateVel(platform->velocity, platform->orientation_dot);
+    if (refresh)
+      normal_mat.SetZero();
+    grad.SetZero();
+    double cost = 0.0;
+    for (size_t i = 0; i < cables_num; ++i)
+    {
+      const CableVars& cable = vars->cables[i];
+      const double swivel_res =
+        std::remainder(cable.swivel_ang - workspace->swivel_angles[i], 2. * M_PI);
+      const double residuals[2] = {cable.length - workspace->lengths[i],
+                                   workspace->swivel_weight * swivel_res};
+      cost += SQUARE(residuals[0]) + SQUARE(residuals[1]);
+      // Rows of the jacobian: cable length first, then swivel angle.
+      for (uint8_t k = 0; k < 2; ++k)
+      {
+        const grabnum::Vector3d& vers = k == 0 ? cable.vers_rho : cable.vers_w;
+        const double scale = k == 0 ? 1.0
+                                    : workspace->swivel_weight /
+                                        grabnum::Dot(cable.vers_u, cable.pos_DA_glob);
+        const grabnum::Vector3d ang_row =
+          platform->h_mat.Transpose() * grabnum::Cross(cable.pos_PA_glob, vers);
+        for (uint8_t j = 1; j <= 3; ++j)
+        {
+          row(j)     = scale * vers(j);
+          row(3 + j) = scale * ang_row(j);
+        }
+        grad += row * residuals[k];
+        if (refresh)
+          for (uint8_t r = 1; r <= 6; ++r)
+            for (uint8_t c = r; c <= 6; ++c)
+              normal_mat(r, c) += row(r) * row(c);
+      }
+    }
+    report.residual_norm = std::sqrt(cost);
+
+    if (report.residual_norm <= workspace->ftol)
+    {
+      report.status = grabnum::solvers::CONVERGED_RESIDUAL;
+      break;
+    }
+    if (small_step)
+    {
+      report.status = grabnum::solvers::CONVERGED_STEP;
+      break;
+    }
+    if (report.iterations >= workspace->max_iter)
+    {
+      report.status = grabnum::solvers::MAX_ITERATIONS;
+      break;
+    }
+    if (refresh)
+    {
+      double max_diag = 0.0;
+      for (uint8_t r = 1; r <= 6; ++r)
+      {
+        max_diag = std::max(max_diag, normal_mat(r, r));
+        for (uint8_t c = 1; c < r; ++c)
+          normal_mat(r, c) = normal_mat(c, r);
+      }
+      for (uint8_t r = 1; r <= 6; ++r)
+        normal_mat(r, r) += workspace->damping * max_diag;
+      workspace->normal_lu.Compute(normal_mat);
+      workspace->jacobian_updates++;
+      workspace->contraction = 0.0;
+      workspace->cached      = workspace->normal_lu.IsInvertible(0.0);
+      if (!workspace->cached)
+        break;
+    }
+
+    report.iterations++;
+    const grabnum::VectorXd<6> step = -workspace->normal_lu.Solve(grad);
+    for (uint8_t j = 1; j <= 3; ++j)
+    {
+      position(j) += step(j);
+      orientation(j) += step(3 + j);
+    }
+    last_step_norm = step_norm;
+    step_norm      = grabnum::Norm(step);
+    // Given the contraction ratio between consecutive steps, the error left after this
+    // step is about as large as the next step.
+    double estimated_error = step_norm;
+    refresh                = false;
+    if (report.iterations > 1)
+    {
+      workspace->contraction = step_norm / last_step_norm;
+      estimated_error *= std::min(workspace->contraction, 1.0);
+      // A stale jacobian still converges, but only linearly: refresh it as soon as steps
+      // stop shrinking fast enough.
+      refresh = workspace->contraction > workspace->refresh_ratio;
+    }
+    small_step =
+      estimated_error <= workspace->xtol * (1.0 + grabnum::Norm(platform->pose));
+  }
+  // Do not trust an old factorization after a failure.
+  if (!report.Converged())
+    workspace->cached = false;
+
+  report.elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  return report;
 }
 
+// Explicit instantiations.
+template void UpdatePlatformPose<grabnum::Vector3d, PlatformVars>(
+  const grabnum::Vector3d&, const grabnum::Vector3d&, const PlatformParams*,
+  PlatformVars*);
+template void UpdatePlatformPose<grabgeom::Quaternion, PlatformQuatVars>(
+  const grabnum::Vector3d&, const grabgeom::Quaternion&, const PlatformParams*,
+  PlatformQuatVars*);
+template void UpdatePosA<PlatformVars>(const std::vector<ActuatorParams>&,
+                                       const PlatformVars*, std::vector<CableVars>*);
+template void UpdatePosA<PlatformQuatVars>(const std::vector<ActuatorParams>&,
+                                           const PlatformQuatVars*,
+                                           std::vector<CableVars>*);
+template void UpdateCableZeroOrd<PlatformVars>(const ActuatorParams*, const PlatformVars*,
+                                               CableVars*);
+template void UpdateCableZeroOrd<PlatformQuatVars>(const ActuatorParams*,
+                                                   const PlatformQuatVars*, CableVars*);
+template void UpdateIK0<grabnum::Vector3d, Vars>(const grabnum::Vector3d&,
+                                                 const grabnum::Vector3d&, const Params*,
+                                                 Vars*);
+template void UpdateIK0<grabgeom::Quaternion, VarsQuat>(const grabnum::Vector3d&,
+                                                        const grabgeom::Quaternion&,
+                                                        const Params*, VarsQuat*);
+
+// Explicit instantiations for double and single precision, the latter with and without
+// double precision accumulation.
+template void CalcCablesLength<double, double>(
+  const grabnum::Vector3<double>&, const grabnum::Matrix3<double>&,
+  const std::vector<ActuatorGeometry<double>>&, std::vector<double>*,
+  std::vector<double>*);
+template void CalcCablesLength<float, float>(const grabnum::Vector3<float>&,
+                                             const grabnum::Matrix3<float>&,
+                                             const std::vector<ActuatorGeometry<float>>&,
+                                             std::vector<float>*, std::vector<float>*);
+template void CalcCablesLength<float, double>(const grabnum::Vector3<float>&,
+                                              const grabnum::Matrix3<float>&,
+                                              const std::vector<ActuatorGeometry<float>>&,
+                                              std::vector<float>*, std::vector<float>*);
+
 } // end namespace grabcdpr
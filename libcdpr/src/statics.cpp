@@ -0,0 +1,96 @@
+/**
+ * @file statics.cpp
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions of functions declared in statics.h.
+ */
+
+#include "statics.h"
+
+namespace grabcdpr
+{
+
+template <uint8_t cables_num>
+grabnum::Matrix<double, 6, cables_num>
+CalcStructureMatrix(const std::vector<CableVars>& cables)
+{
+  assert(cables.size() == cables_num);
+
+  grabnum::Matrix<double, 6, cables_num> structure_mat;
+  for (uint8_t i = 0; i < cables_num; ++i)
+  {
+    // Cables pull attach points towards pulleys, i.e. along -rho.
+    const grabnum::Vector3d& vers_rho = cables[i].vers_rho;
+    const grabnum::Vector3d moment = grabnum::Cross(cables[i].pos_PA_glob, vers_rho);
+    for (uint8_t j = 1; j <= 3; ++j)
+    {
+      structure_mat(j, i + 1)     = -vers_rho(j);
+      structure_mat(j + 3, i + 1) = -moment(j);
+    }
+  }
+  return structure_mat;
+}
+
+grabnum::VectorXd<6> CalcStaticWrench(const PlatformParams* params,
+                                      const PlatformVarsBase* platform,
+                                      const grabnum::Vector3d& gravity)
+{
+  const grabnum::Vector3d force =
+    params->mass * gravity + platform->rot_mat * params->ext_force_loc;
+  const grabnum::Vector3d torque = grabnum::Cross(platform->pos_PG_glob, force) +
+                                   platform->rot_mat * params->ext_torque_loc;
+  grabnum::VectorXd<6> wrench;
+  for (uint8_t j = 1; j <= 3; ++j)
+  {
+    wrench(j)     = -force(j);
+    wrench(j + 3) = -torque(j);
+  }
+  return wrench;
+}
+
+template <uint8_t cables_num>
+grabnum::solvers::SolverReport<double>
+UpdateCablesTension(const grabnum::VectorXd<6>& wrench, std::vector<CableVars>* cables,
+                    TensionWorkspace<cables_num>* workspace)
+{
+  workspace->structure_mat = CalcStructureMatrix<cables_num>(*cables);
+
+  grabnum::VectorXd<cables_num> gradient;
+  grabnum::VectorXd<cables_num> lower;
+  grabnum::VectorXd<cables_num> upper;
+  for (uint8_t i = 1; i <= cables_num; ++i)
+  {
+    gradient(i) = -workspace->reference_tension;
+    lower(i)    = workspace->min_tension;
+    upper(i)    = workspace->max_tension;
+  }
+  static constexpr grabnum::Matrix<double, cables_num, cables_num> kIdentity(1.0);
+
+  grabnum::VectorXd<cables_num> tensions;
+  const grabnum::solvers::SolverReport<double> report = grabnum::solvers::QuadProg(
+    kIdentity, gradient, workspace->structure_mat, wrench, lower, upper, tensions,
+    workspace->qp, workspace->options);
+  if (report.status != grabnum::solvers::NUMERIC_FAILURE)
+    for (uint8_t i = 0; i < cables_num; ++i)
+      (*cables)[i].tension = tensions(i + 1);
+  return report;
+}
+
+// Explicit instantiations for the most common numbers of cables of a 6DoF robot.
+template grabnum::Matrix<double, 6, 6>
+CalcStructureMatrix<6>(const std::vector<CableVars>&);
+template grabnum::Matrix<double, 6, 7>
+CalcStructureMatrix<7>(const std::vector<CableVars>&);
+template grabnum::Matrix<double, 6, 8>
+CalcStructureMatrix<8>(const std::vector<CableVars>&);
+template grabnum::solvers::SolverReport<double>
+UpdateCablesTension<6>(const grabnum::VectorXd<6>&, std::vector<CableVars>*,
+                       TensionWorkspace<6>*);
+template grabnum::solvers::SolverReport<double>
+UpdateCablesTension<7>(const grabnum::VectorXd<6>&, std::vector<CableVars>*,
+                       TensionWorkspace<7>*);
+template grabnum::solvers::SolverReport<double>
+UpdateCablesTension<8>(const grabnum::VectorXd<6>&, std::vector<CableVars>*,
+                       TensionWorkspace<8>*);
+
+} // end namespace grabcdpr
@@ -7,12 +7,53 @@
 
 #include "kinematics.h"
 #include "diffkinematics.h"
+#include "statics.h"
 #include "types.h"
 #include "robotconfigjsonparser.h"
 
 // Aliases ---------------------------------------------------------------------
 using json = nlohmann::json; // JSON library support
 
+namespace {
+
+const uint8_t kCablesNum = 8; // cables of the test robot
+
+/**
+ * @brief Builds the parameters of an 8-cable test robot, with pulleys evenly spaced on a
+ * circle at alternating heights.
+ *
+ * Attach points on the platform have alternating offsets, so that cables can also balance
+ * torsion.
+ *
+ * @param[in] platform The platform parameters to be linked to the robot.
+ * @return The parameters of the test robot.
+ */
+grabcdpr::Params MakeTestRobot(grabcdpr::PlatformParams* platform)
+{
+  platform->pos_PG_loc = grabnum::Vector3d({0.01, 0.02, -0.03});
+
+  grabcdpr::Params params;
+  params.platform = platform;
+  params.actuators.resize(kCablesNum);
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+  {
+    const double angle                 = i * 2.0 * M_PI / kCablesNum;
+    const double offset                = i % 2 ? 0.4 : -0.4;
+    grabcdpr::ActuatorParams& actuator = params.actuators[i];
+    actuator.pulley.pos_OD_glob =
+      grabnum::Vector3d({2.0 * cos(angle), 2.0 * sin(angle), i % 2 ? 2.5 : 0.2});
+    actuator.pulley.vers_i = grabnum::Vector3d({cos(angle), sin(angle), 0.0});
+    actuator.pulley.vers_j = grabnum::Vector3d({-sin(angle), cos(angle), 0.0});
+    actuator.pulley.vers_k = grabnum::Vector3d({0.0, 0.0, 1.0});
+    actuator.pulley.radius = 0.05;
+    actuator.winch.pos_PA_loc =
+      grabnum::Vector3d({0.2 * cos(angle + offset), 0.2 * sin(angle + offset), 0.1});
+  }
+  return params;
+}
+
+} // namespace
+
 /**
  * @brief The LibcdprTest class
  */
@@ -25,6 +66,21 @@ private Q_SLOTS:
    * @brief testCase1
    */
   void testJsonParser();
+
+  /**
+   * @brief Checks that forward kinematics recovers the pose given by inverse kinematics.
+   */
+  void testForwardKinematics();
+
+  /**
+   * @brief Checks that cable tensions balance the platform weight within their limits.
+   */
+  void testTensionDistribution();
+
+  /**
+   * @brief Checks cable lengths computed in single and double precision.
+   */
+  void testMixedPrecision();
 };
 
 void LibcdprTest::testJsonParser()
@@ -43,6 +99,164 @@ void LibcdprTest::testJsonParser()
   parser.PrintConfig();
 }
 
+void LibcdprTest::testForwardKinematics()
+{
+  grabcdpr::PlatformParams platform_params;
+  grabcdpr::Params params = MakeTestRobot(&platform_params);
+
+  grabcdpr::PlatformVars platform(grabcdpr::RPY);
+  grabcdpr::PlatformVars measured_platform(grabcdpr::RPY);
+  grabcdpr::Vars vars;
+  grabcdpr::Vars measured;
+  vars.platform     = &platform;
+  measured.platform = &measured_platform;
+  vars.cables.resize(kCablesNum);
+  measured.cables.resize(kCablesNum);
+  grabcdpr::FKWorkspace workspace;
+
+  // Cold start from a far guess.
+  grabnum::Vector3d position({0.1, -0.2, 0.8});
+  grabnum::Vector3d angles({0.1, 0.2, 0.3});
+  grabcdpr::UpdateIK0(position, angles, &params, &measured);
+  grabcdpr::UpdateIK0(grabnum::Vector3d({0.2, -0.1, 0.7}),
+                      grabnum::Vector3d({0.0, 0.0, 0.0}), &params, &vars);
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+  {
+    vars.cables[i].length     = measured.cables[i].length;
+    vars.cables[i].swivel_ang = measured.cables[i].swivel_ang;
+  }
+  grabnum::solvers::SolverReport<double> report =
+    grabcdpr::UpdateFK0(&params, &vars, &workspace);
+  QVERIFY(report.Converged());
+  QVERIFY(grabnum::Norm(platform.position - position) < 1e-8);
+  QVERIFY(grabnum::Norm(platform.orientation - angles) < 1e-8);
+  QCOMPARE(platform.pose(4), platform.orientation(1));
+
+  // Warm start along a trajectory sampled at 1 kHz.
+  uint16_t iterations = 0;
+  for (uint16_t k = 1; k <= 100; ++k)
+  {
+    position(1) += 1e-3 * cos(0.01 * k);
+    position(3) -= 5e-4;
+    angles(3) += 1e-3;
+    grabcdpr::UpdateIK0(position, angles, &params, &measured);
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+    {
+      vars.cables[i].length     = measured.cables[i].length;
+      vars.cables[i].swivel_ang = measured.cables[i].swivel_ang;
+    }
+    report = grabcdpr::UpdateFK0(&params, &vars, &workspace);
+    QVERIFY(report.Converged());
+    QVERIFY(report.iterations <= 3);
+    iterations += report.iterations;
+    QVERIFY(grabnum::Norm(platform.position - position) < 1e-7);
+    QVERIFY(grabnum::Norm(platform.orientation - angles) < 1e-7);
+  }
+  QVERIFY(iterations < 300);
+  QVERIFY(workspace.jacobian_updates < 100);
+}
+
+void LibcdprTest::testTensionDistribution()
+{
+  grabcdpr::PlatformParams platform_params;
+  platform_params.mass    = 15.0;
+  grabcdpr::Params params = MakeTestRobot(&platform_params);
+
+  grabcdpr::PlatformVars platform(grabcdpr::RPY);
+  grabcdpr::Vars vars;
+  vars.platform = &platform;
+  vars.cables.resize(kCablesNum);
+  grabcdpr::TensionWorkspace<kCablesNum> workspace;
+  workspace.min_tension       = 20.0;
+  workspace.max_tension       = 300.0;
+  workspace.reference_tension = 50.0;
+
+  // Moving along a trajectory sampled at 1 kHz, the active limits are warm-started.
+  grabnum::Vector3d position({0.1, -0.2, 0.8});
+  grabnum::Vector3d angles({0.05, -0.05, 0.0});
+  uint16_t iterations = 0;
+  for (uint16_t k = 0; k < 100; ++k)
+  {
+    position(1) += 2e-3;
+    angles(3) += 1e-3;
+    grabcdpr::UpdateIK0(position, angles, &params, &vars);
+    const grabnum::VectorXd<6> wrench =
+      grabcdpr::CalcStaticWrench(&platform_params, &platform);
+    grabnum::solvers::SolverReport<double> report =
+      grabcdpr::UpdateCablesTension(wrench, &vars.cables, &workspace);
+    QVERIFY(report.Converged());
+    iterations += report.iterations;
+
+    grabnum::VectorXd<kCablesNum> tensions;
+    for (uint8_t i = 0; i < kCablesNum; ++i)
+    {
+      QVERIFY(vars.cables[i].tension >= workspace.min_tension - 1e-6);
+      QVERIFY(vars.cables[i].tension <= workspace.max_tension + 1e-6);
+      tensions(i + 1) = vars.cables[i].tension;
+    }
+    const grabnum::VectorXd<6> cables_wrench =
+      grabcdpr::CalcStructureMatrix<kCablesNum>(vars.cables) * tensions;
+    QVERIFY(cables_wrench.IsApprox(wrench, 1e-6));
+    QVERIFY(cables_wrench(3) > 0.0);
+  }
+  QVERIFY(iterations < 150);
+
+  // An unreachable load gives the closest tensions at the limits.
+  platform_params.mass = 1e4;
+  const grabnum::solvers::SolverReport<double> report = grabcdpr::UpdateCablesTension(
+    grabcdpr::CalcStaticWrench(&platform_params, &platform), &vars.cables, &workspace);
+  QCOMPARE(report.status, grabnum::solvers::INFEASIBLE);
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+    QVERIFY(vars.cables[i].tension <= workspace.max_tension + 1e-6);
+}
+
+void LibcdprTest::testMixedPrecision()
+{
+  grabcdpr::PlatformParams platform_params;
+  grabcdpr::Params params = MakeTestRobot(&platform_params);
+  std::vector<grabcdpr::ActuatorGeometry<double>> geometry;
+  std::vector<grabcdpr::ActuatorGeometry<float>> geometry_f;
+  for (const grabcdpr::ActuatorParams& actuator : params.actuators)
+  {
+    geometry.push_back(grabcdpr::ActuatorGeometry<double>(actuator));
+    geometry_f.push_back(grabcdpr::ActuatorGeometry<float>(actuator));
+  }
+
+  grabcdpr::PlatformVars platform(grabcdpr::RPY);
+  grabcdpr::Vars vars;
+  vars.platform = &platform;
+  vars.cables.resize(kCablesNum);
+  const grabnum::Vector3d position({0.3, -0.2, 1.1});
+  const grabnum::Vector3d angles({0.1, -0.2, 0.3});
+  grabcdpr::UpdateIK0(position, angles, &params, &vars);
+
+  // Same quantities as the whole inverse kinematics, up to round-off errors.
+  std::vector<double> lengths;
+  std::vector<double> swivel_angles;
+  grabcdpr::CalcCablesLength(position, grabgeom::RPY2Rot(angles), geometry, &lengths,
+                             &swivel_angles);
+  QCOMPARE(lengths.size(), static_cast<size_t>(kCablesNum));
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+  {
+    QVERIFY(grabnum::IsClose(lengths[i], vars.cables[i].length, 1e-12));
+    QVERIFY(grabnum::IsClose(swivel_angles[i], vars.cables[i].swivel_ang, 1e-12));
+  }
+
+  // Single precision is accurate to a few micrometers over several meters.
+  const grabnum::Vector3f position_f(position);
+  const grabnum::Matrix3f rot_mat_f = grabgeom::RPY2Rot(grabnum::Vector3f(angles));
+  std::vector<float> lengths_f;
+  std::vector<float> lengths_acc;
+  grabcdpr::CalcCablesLength(position_f, rot_mat_f, geometry_f, &lengths_f);
+  grabcdpr::CalcCablesLength<float, double>(position_f, rot_mat_f, geometry_f,
+                                            &lengths_acc);
+  for (uint8_t i = 0; i < kCablesNum; ++i)
+  {
+    QVERIFY(grabnum::IsClose<double>(lengths_f[i], lengths[i], 1e-5));
+    QVERIFY(grabnum::IsClose<double>(lengths_acc[i], lengths[i], 1e-5));
+  }
+}
+
 QTEST_APPLESS_MAIN(LibcdprTest)
 
 #include "libcdpr_test.moc"
@@ -1,17 +1,19 @@
 
 HEADERS += \
     $$PWD/inc/rotations.h \
-    $$PWD/inc/quaternions.h
+    $$PWD/inc/quaternions.h \
+    $$PWD/inc/rotations_batch.h
 
 SOURCES += \
     $$PWD/src/rotations.cpp \
-    $$PWD/src/quaternions.cpp
+    $$PWD/src/quaternions.cpp \
+    $$PWD/src/rotations_batch.cpp
 
 INCLUDEPATH += $$PWD/inc
 
 QT       -= gui
 
-CONFIG   += staticlib c++11
+CONFIG   += staticlib c++14 thread
 CONFIG   -= app_bundle
 
 TEMPLATE = lib
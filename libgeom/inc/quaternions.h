@@ -31,18 +31,23 @@ namespace grabgeom {
  * @f[
  * \mathbf{q} := ( w, \mathbf{v}^T)^T = (w, x, y, z)^T
  * @f]
+ * The structure is templated on the type @a T of the components, and so are all
+ * functions in this file. They are instantiated in the library for @c double, i.e.
+ * Quaternion, and @c float, i.e. Quaternionf.
  */
-struct Quaternion
+template <typename T> struct BasicQuaternion
 {
-  double w; /**< _w_ component */
-  double x; /**< _x_ component  */
-  double y; /**< _y_ component */
-  double z; /**< _z_ component  */
+  T w; /**< _w_ component */
+  T x; /**< _x_ component  */
+  T y; /**< _y_ component */
+  T z; /**< _z_ component  */
+
+  using Scalar = T; /**< type of the components */
 
   /**
    * @brief Default constructor. Initializes all components to 0.
    */
-  Quaternion() { Quaternion(0., 0., 0., 0.); }
+  BasicQuaternion() : w(0), x(0), y(0), z(0) {}
   /**
    * @brief Constructor to initialize all components individually.
    * @param[in] _w @a w component.
@@ -50,7 +55,7 @@ struct Quaternion
    * @param[in] _y @a y component.
    * @param[in] _z @a z component.
    */
-  Quaternion(const double _w, const double _x, const double _y, const double _z)
+  BasicQuaternion(const T _w, const T _x, const T _y, const T _z)
   {
     w = _w;
     x = _x;
@@ -61,7 +66,7 @@ struct Quaternion
    * @brief Constructor to initialize all components from a 4-vector.
    * @param[in] vect A 4-vector @f$(w, x, y, z)^T@f$.
    */
-  Quaternion(const grabnum::VectorXd<4>& vect)
+  BasicQuaternion(const grabnum::VectorX<T, 4>& vect)
   {
     w = vect(1);
     x = vect(2);
@@ -73,7 +78,7 @@ struct Quaternion
    * @param[in] _w @a w component, i.e. the real part.
    * @param[in] _v A 3-vector @f$(x, y, z)^T@f$, i.e. the imaginary parts.
    */
-  Quaternion(const double _w, const grabnum::Vector3d& _v)
+  BasicQuaternion(const T _w, const grabnum::Vector3<T>& _v)
   {
     w = _w;
     x = _v(1);
@@ -88,7 +93,10 @@ struct Quaternion
    * @note This method is not safe due to numerical imprecition of floating points.
    * @see IsApprox()
    */
-  bool operator==(const Quaternion& other) const { return v() == other.v(); }
+  bool operator==(const BasicQuaternion& other) const
+  {
+    return w == other.w && x == other.x && y == other.y && z == other.z;
+  }
 
   /**
    * @brief operator !=
@@ -97,7 +105,7 @@ struct Quaternion
    * @note This method is not safe due to numerical imprecition of floating points.
    * @see IsApprox()
    */
-  bool operator!=(const Quaternion& other) const { return v() != other.v(); }
+  bool operator!=(const BasicQuaternion& other) const { return !(*this == other); }
 
   /**
    * @brief Replaces @c *this by @c *this + the _other_ quaternion.
@@ -111,7 +119,7 @@ struct Quaternion
    * @param[in] other The quaternion to be added.
    * @return A reference to @c *this.
    */
-  Quaternion& operator+=(const Quaternion& other)
+  BasicQuaternion& operator+=(const BasicQuaternion& other)
   {
     w += other.w;
     x += other.x;
@@ -125,7 +133,7 @@ struct Quaternion
    * @param[in] scalar The scalar value to be added to each element of the quaternion.
    * @return A reference to @c *this.
    */
-  Quaternion& operator+=(const double scalar)
+  BasicQuaternion& operator+=(const T scalar)
   {
     w += scalar;
     x += scalar;
@@ -146,7 +154,7 @@ struct Quaternion
    * @param[in] other The quaternion to be subtracted.
    * @return A reference to @c *this.
    */
-  Quaternion& operator-=(const Quaternion& other)
+  BasicQuaternion& operator-=(const BasicQuaternion& other)
   {
     w -= other.w;
     x -= other.x;
@@ -161,7 +169,7 @@ struct Quaternion
    * quaternion.
    * @return A reference to @c *this.
    */
-  Quaternion& operator-=(const double scalar)
+  BasicQuaternion& operator-=(const T scalar)
   {
     w -= scalar;
     x -= scalar;
@@ -187,13 +195,13 @@ struct Quaternion
    * real, or when both imaginary parts are parallel. It is, however, _associative_ and
    * _distributive over the sum_.
    */
-  Quaternion& operator*=(const Quaternion& other)
+  BasicQuaternion& operator*=(const BasicQuaternion& other)
   {
-    grabnum::Vector3d old_v   = v();
-    grabnum::Vector3d other_v = other.v();
-    grabnum::Vector3d new_v =
+    grabnum::Vector3<T> old_v   = v();
+    grabnum::Vector3<T> other_v = other.v();
+    grabnum::Vector3<T> new_v =
       w * other_v + other.w * old_v + grabnum::Cross(old_v, other_v);
-    w = w + other.w - grabnum::Dot(old_v, other_v);
+    w = w * other.w - grabnum::Dot(old_v, other_v);
     x = new_v(1);
     y = new_v(2);
     z = new_v(3);
@@ -206,7 +214,7 @@ struct Quaternion
    * quaternion.
    * @return A reference to @c *this.
    */
-  Quaternion& operator*=(const double scalar)
+  BasicQuaternion& operator*=(const T scalar)
   {
     w *= scalar;
     x *= scalar;
@@ -220,7 +228,7 @@ struct Quaternion
    * @param[in] scalar The scalar value to be divided to each element of the quaternion.
    * @return A reference to @c *this.
    */
-  Quaternion& operator/=(const double scalar)
+  BasicQuaternion& operator/=(const T scalar)
   {
     w /= scalar;
     x /= scalar;
@@ -234,9 +242,9 @@ struct Quaternion
    * @param[in] scalar The scalar value to be divided to each element of the quaternion.
    * @return The resulting quaternion.
    */
-  Quaternion operator/(const double scalar) const
+  BasicQuaternion operator/(const T scalar) const
   {
-    Quaternion res;
+    BasicQuaternion res;
     res.w = w / scalar;
     res.x = x / scalar;
     res.y = y / scalar;
@@ -248,9 +256,9 @@ struct Quaternion
    * @brief Returns the imaginary parts vector component @f$\mathbf{q}_v@f$.
    * @return The 3D vector @f$\mathbf{q}_v@f$.
    */
-  grabnum::Vector3d v() const
+  grabnum::Vector3<T> v() const
   {
-    grabnum::Vector3d v;
+    grabnum::Vector3<T> v;
     v(1) = x;
     v(2) = y;
     v(3) = z;
@@ -261,9 +269,9 @@ struct Quaternion
    * @brief Returns the whole quaternion in vector format.
    * @return The 4D vector @f$\mathbf{q}@f$.
    */
-  grabnum::VectorXd<4> q() const
+  grabnum::VectorX<T, 4> q() const
   {
-    grabnum::VectorXd<4> q;
+    grabnum::VectorX<T, 4> q;
     q(1) = w;
     q(2) = x;
     q(3) = y;
@@ -276,7 +284,7 @@ struct Quaternion
    * @f$\mathbf{q}_1 = (1, \mathbf{0}_v)^T@f$.
    * @return The identity quaternion @f$\mathbf{q}_1@f$.
    */
-  Quaternion Identity() const { return Quaternion(1., 0., 0., 0.); }
+  BasicQuaternion Identity() const { return BasicQuaternion(1., 0., 0., 0.); }
 
   /**
    * @brief Returns the _conjugate_ of @c *this.
@@ -287,7 +295,7 @@ struct Quaternion
    * @f]
    * @return The conjugate quaternion @f$\mathbf{q}^*@f$.
    */
-  Quaternion Conj() const { return Quaternion(w, -x, -y, -z); }
+  BasicQuaternion Conj() const { return BasicQuaternion(w, -x, -y, -z); }
 
   /**
    * @brief Returns the _inverse_ of @c *this.
@@ -305,7 +313,7 @@ struct Quaternion
    * @f$\|\mathbf{q}\| = 1@f$.
    * @return The inverse quaternion @f$\mathbf{q}^{-1}@f$.
    */
-  Quaternion Inv() const { return Conj() / Norm(); }
+  BasicQuaternion Inv() const { return Conj() / SQUARE(Norm()); }
 
   /**
    * @brief Calculate the norm of @c *this.
@@ -314,7 +322,11 @@ struct Quaternion
    * @return The norm of @c *this.
    * @see Normalized() Normalize()
    */
-  double Norm() const { return grabnum::Norm(q()); }
+  double Norm() const
+  {
+    return sqrt(static_cast<double>(w) * w + static_cast<double>(x) * x +
+                static_cast<double>(y) * y + static_cast<double>(z) * z);
+  }
 
   /**
    * @brief Normalize @c *this.
@@ -326,7 +338,7 @@ struct Quaternion
    * @note This function replaces @c *this with its normalized version. If you do not want
    * to change the original quaternion, please use Normalized() instead.
    */
-  Quaternion& Normalize()
+  BasicQuaternion& Normalize()
   {
     *this /= Norm();
     return *this;
@@ -340,13 +352,13 @@ struct Quaternion
    * @return The normalized quaternion.
    * @see Normalize() Norm()
    */
-  Quaternion Normalized() const { return *this / Norm(); }
+  BasicQuaternion Normalized() const { return *this / Norm(); }
 
   /**
    * @brief Check whether @c *this is a unitary quaternion.
-   * @return _True_ if it is unitary.
+   * @return _True_ if it is unitary, within the default tolerance of its scalar type.
    */
-  bool IsUnitary() const { return grabnum::IsClose(Norm(), 1.); }
+  bool IsUnitary() const { return grabnum::IsClose(Norm(), 1., grabnum::Tolerance<T>()); }
 
   /**
    * @brief Check whether 2 quaternions are approximately equal, within a certain
@@ -355,19 +367,27 @@ struct Quaternion
    * @param[in] tol (Optional) The tolerance for element-wise comparison for being equal.
    * @return _True_ if they are approximately the same.
    */
-  bool IsApprox(const Quaternion& other, const double tol = grabnum::EPSILON)
+  bool IsApprox(const BasicQuaternion& other,
+                const double tol = grabnum::Tolerance<T>()) const
   {
-    return v().IsApprox(other.v(), tol);
+    return q().IsApprox(other.q(), tol);
   }
 };
 
+using Quaternion  = BasicQuaternion<double>; /**< quaternion of double */
+using Quaternionf = BasicQuaternion<float>;  /**< quaternion of float */
+
 /**
  * @brief Addition between two quaternions.
  * @param[in] lhs A quaternion.
  * @param[in] rhs A quaternion.
  * @return A quaternion, result of the addition.
  */
-inline Quaternion operator+(Quaternion lhs, const Quaternion& rhs) { return lhs += rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator+(BasicQuaternion<T> lhs, const BasicQuaternion<T>& rhs)
+{
+  return lhs += rhs;
+}
 
 /**
  * @brief Addition between a quaternion and a scalar.
@@ -375,7 +395,12 @@ inline Quaternion operator+(Quaternion lhs, const Quaternion& rhs) { return lhs
  * @param[in] rhs A scalar value.
  * @return A quaternion, result of the addition.
  */
-inline Quaternion operator+(Quaternion lhs, const double rhs) { return lhs += rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator+(BasicQuaternion<T> lhs,
+                                    const typename BasicQuaternion<T>::Scalar rhs)
+{
+  return lhs += rhs;
+}
 
 /**
  * @brief Addition between a scalar and a quaternion.
@@ -383,14 +408,20 @@ inline Quaternion operator+(Quaternion lhs, const double rhs) { return lhs += rh
  * @param[in] rhs A quaternion.
  * @return A quaternion, result of the addition.
  */
-inline Quaternion operator+(const double lhs, Quaternion rhs) { return rhs += lhs; }
+template <typename T>
+inline BasicQuaternion<T> operator+(const typename BasicQuaternion<T>::Scalar lhs,
+                                    BasicQuaternion<T> rhs)
+{
+  return rhs += lhs;
+}
 
 /**
  * @brief Returns the opposite of a quaternion @f$-\mathbf{q}@f$.
  * @param[in] quat A quaternion
  * @return A quaternion, opposite of @c quat.
  */
-inline Quaternion operator-(Quaternion quat) { return quat *= -1.; }
+template <typename T>
+inline BasicQuaternion<T> operator-(BasicQuaternion<T> quat) { return quat *= -1.; }
 
 /**
  * @brief Subtraction between two quaternions.
@@ -398,7 +429,11 @@ inline Quaternion operator-(Quaternion quat) { return quat *= -1.; }
  * @param[in] rhs A quaternion.
  * @return A quaternion, result of the subtraction.
  */
-inline Quaternion operator-(Quaternion lhs, const Quaternion& rhs) { return lhs -= rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator-(BasicQuaternion<T> lhs, const BasicQuaternion<T>& rhs)
+{
+  return lhs -= rhs;
+}
 
 /**
  * @brief Subtraction between a quaternion and a scalar.
@@ -406,7 +441,12 @@ inline Quaternion operator-(Quaternion lhs, const Quaternion& rhs) { return lhs
  * @param[in] rhs A scalar value.
  * @return A quaternion, result of the subtraction.
  */
-inline Quaternion operator-(Quaternion lhs, const double rhs) { return lhs -= rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator-(BasicQuaternion<T> lhs,
+                                    const typename BasicQuaternion<T>::Scalar rhs)
+{
+  return lhs -= rhs;
+}
 
 /**
  * @brief Subtraction between a scalar and a quaternion.
@@ -414,7 +454,12 @@ inline Quaternion operator-(Quaternion lhs, const double rhs) { return lhs -= rh
  * @param[in] lhs A quaternion.
  * @return A quaternion, result of the subtraction.
  */
-inline Quaternion operator-(const double lhs, Quaternion rhs) { return -rhs + lhs; }
+template <typename T>
+inline BasicQuaternion<T> operator-(const typename BasicQuaternion<T>::Scalar lhs,
+                                    BasicQuaternion<T> rhs)
+{
+  return -rhs + lhs;
+}
 
 /**
  * @brief Quaternions product @f$\otimes@f$.
@@ -422,7 +467,11 @@ inline Quaternion operator-(const double lhs, Quaternion rhs) { return -rhs + lh
  * @param[in] rhs A quaternion.
  * @return A quaternion, result of the product @f$\mathbf{q} \otimes \mathbf{p}@f$.
  */
-inline Quaternion operator*(Quaternion lhs, const Quaternion& rhs) { return lhs *= rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator*(BasicQuaternion<T> lhs, const BasicQuaternion<T>& rhs)
+{
+  return lhs *= rhs;
+}
 
 /**
  * @brief Multiplication between a quaternion and a scalar.
@@ -430,7 +479,12 @@ inline Quaternion operator*(Quaternion lhs, const Quaternion& rhs) { return lhs
  * @param[in] rhs A scalar value.
  * @return A quaternion, result of the multiplication.
  */
-inline Quaternion operator*(Quaternion lhs, const double rhs) { return lhs *= rhs; }
+template <typename T>
+inline BasicQuaternion<T> operator*(BasicQuaternion<T> lhs,
+                                    const typename BasicQuaternion<T>::Scalar rhs)
+{
+  return lhs *= rhs;
+}
 
 /**
  * @brief Multiplication between a scalar and a quaternion.
@@ -438,7 +492,12 @@ inline Quaternion operator*(Quaternion lhs, const double rhs) { return lhs *= rh
  * @param[in] lhs A quaternion.
  * @return A quaternion, result of the multiplication.
  */
-inline Quaternion operator*(const double lhs, Quaternion rhs) { return rhs *= lhs; }
+template <typename T>
+inline BasicQuaternion<T> operator*(const typename BasicQuaternion<T>::Scalar lhs,
+                                    BasicQuaternion<T> rhs)
+{
+  return rhs *= lhs;
+}
 
 /**
  * @brief Returns the _conjugate_ of a quaternion.
@@ -450,7 +509,11 @@ inline Quaternion operator*(const double lhs, Quaternion rhs) { return rhs *= lh
  * @param[in] quat The original quaternion.
  * @return The conjugate quaternion @f$\mathbf{q}^*@f$.
  */
-inline Quaternion QuatConjugate(const Quaternion& quat) { return quat.Conj(); }
+template <typename T>
+inline BasicQuaternion<T> QuatConjugate(const BasicQuaternion<T>& quat)
+{
+  return quat.Conj();
+}
 
 /**
  * @brief Returns the _inverse_ of a quaternion.
@@ -470,7 +533,11 @@ inline Quaternion QuatConjugate(const Quaternion& quat) { return quat.Conj(); }
  * @param[in] quat The original quaternion.
  * @return The inverse quaternion @f$\mathbf{q}^{-1}@f$.
  */
-inline Quaternion QuatInverse(const Quaternion& quat) { return quat.Inv(); }
+template <typename T>
+inline BasicQuaternion<T> QuatInverse(const BasicQuaternion<T>& quat)
+{
+  return quat.Inv();
+}
 
 /**
  * @brief Calculate the norm of a quaternion.
@@ -480,7 +547,8 @@ inline Quaternion QuatInverse(const Quaternion& quat) { return quat.Inv(); }
  * @return The norm of @c quat.
  * @see QuatNormalized()
  */
-inline double QuatNorm(const Quaternion& quat) { return quat.Norm(); }
+template <typename T>
+inline double QuatNorm(const BasicQuaternion<T>& quat) { return quat.Norm(); }
 
 /**
  * @brief Returns the normalized version of a quaternion.
@@ -491,17 +559,161 @@ inline double QuatNorm(const Quaternion& quat) { return quat.Norm(); }
  * @return The normalized quaternion.
  * @see QuatNorm()
  */
-inline Quaternion QuatNormalized(const Quaternion& quat) { return quat.Normalized(); }
+template <typename T>
+inline BasicQuaternion<T> QuatNormalized(const BasicQuaternion<T>& quat)
+{
+  return quat.Normalized();
+}
+
+/**
+ * @brief Dot product of two quaternions, seen as 4-vectors.
+ *
+ * For unit quaternions, it is the cosine of half the angle of the rotation between the
+ * two orientations, and it is negative if they lie on opposite hemispheres.
+ * @param[in] lhs A quaternion.
+ * @param[in] rhs A quaternion.
+ * @return @f$\mathbf{p} \cdot \mathbf{q}@f$.
+ */
+template <typename T>
+inline T QuatDot(const BasicQuaternion<T>& lhs, const BasicQuaternion<T>& rhs)
+{
+  return lhs.w * rhs.w + lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
+}
+
+/**
+ * @brief Exponential map of a quaternion.
+ *
+ * @f[
+ * e^\mathbf{q} = e^{q_w} \begin{bmatrix} \cos\|\mathbf{q}_v\| \\
+ *    \frac{\mathbf{q}_v}{\|\mathbf{q}_v\|} \sin\|\mathbf{q}_v\| \end{bmatrix}
+ * @f]
+ * In particular, the exponential of a pure quaternion @f$(0, \frac{\theta}{2}
+ * \mathbf{\hat{u}})@f$ is the unit quaternion of a rotation of angle @f$\theta@f$ about
+ * @f$\mathbf{\hat{u}}@f$.
+ * @param[in] quat A quaternion.
+ * @return The quaternion @f$e^\mathbf{q}@f$.
+ * @see QuatLog()
+ */
+template <typename T> BasicQuaternion<T> QuatExp(const BasicQuaternion<T>& quat);
+
+/**
+ * @brief Logarithm map of a quaternion, i.e. the inverse of QuatExp().
+ *
+ * @f[
+ * \ln\mathbf{q} = \begin{bmatrix} \ln\|\mathbf{q}\| \\
+ *    \frac{\mathbf{q}_v}{\|\mathbf{q}_v\|} \operatorname{atan2}(\|\mathbf{q}_v\|, q_w)
+ *    \end{bmatrix}
+ * @f]
+ * For a unit quaternion, it is the pure quaternion @f$(0, \frac{\theta}{2}
+ * \mathbf{\hat{u}})@f$, with @f$\theta \in [0, 2\pi]@f$.
+ * @param[in] quat A non-null quaternion.
+ * @return The quaternion @f$\ln\mathbf{q}@f$.
+ * @note The axis of a negative real quaternion is undefined, and @f$x@f$-axis is
+ * returned.
+ * @see QuatExp()
+ */
+template <typename T> BasicQuaternion<T> QuatLog(const BasicQuaternion<T>& quat);
+
+/**
+ * @brief Spherical linear interpolation between two orientations.
+ *
+ * @f[
+ * \operatorname{slerp}(\mathbf{p}, \mathbf{q}, t) =
+ *    \frac{\sin((1 - t)\Omega)}{\sin\Omega} \mathbf{p} +
+ *    \frac{\sin(t\Omega)}{\sin\Omega} \mathbf{q} \qquad
+ *    \Omega = 2 \operatorname{atan2}(\|\mathbf{q} - \mathbf{p}\|,
+ *    \|\mathbf{q} + \mathbf{p}\|)
+ * @f]
+ * The orientation rotates about a fixed axis at constant angular velocity. @f$\Omega@f$
+ * is computed from the chord, which is accurate also for very close orientations, unlike
+ * @f$\arccos(\mathbf{p} \cdot \mathbf{q})@f$.
+ * @param[in] start The unit quaternion at @f$t = 0@f$.
+ * @param[in] end The unit quaternion at @f$t = 1@f$.
+ * @param[in] param The interpolation parameter @f$t \in [0, 1]@f$.
+ * @return The interpolated unit quaternion.
+ * @note @a end is replaced by its opposite if needed, so that the shortest path is taken.
+ * @see QuatNlerp()
+ */
+template <typename T>
+BasicQuaternion<T> QuatSlerp(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& end, const T param);
+
+/**
+ * @brief Normalized linear interpolation between two orientations.
+ *
+ * The path is the same of QuatSlerp(), but the angular velocity is not constant: it is
+ * higher in the middle of the interval, by a factor @f$1/\cos(\Omega/2)@f$. Since it
+ * avoids any trigonometric function, it is well suited to interpolate close orientations,
+ * such as consecutive set-points of a control loop.
+ * @param[in] start The unit quaternion at @f$t = 0@f$.
+ * @param[in] end The unit quaternion at @f$t = 1@f$.
+ * @param[in] param The interpolation parameter @f$t \in [0, 1]@f$.
+ * @return The interpolated unit quaternion.
+ * @note @a end is replaced by its opposite if needed, so that the shortest path is taken.
+ * When the linear interpolation is close to unit norm, as for close orientations, it is
+ * normalized by a rational approximation instead of a square root, which is exact to the
+ * precision of @a T.
+ */
+template <typename T>
+BasicQuaternion<T> QuatNlerp(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& end, const T param);
+
+/**
+ * @brief Spherical cubic interpolation between two orientations.
+ *
+ * @f[
+ * \operatorname{squad}(\mathbf{q}_i, \mathbf{a}_i, \mathbf{a}_{i+1}, \mathbf{q}_{i+1}, t)
+ *    = \operatorname{slerp}(\operatorname{slerp}(\mathbf{q}_i, \mathbf{q}_{i+1}, t),
+ *    \operatorname{slerp}(\mathbf{a}_i, \mathbf{a}_{i+1}, t), 2t(1 - t))
+ * @f]
+ * With the control points given by QuatSquadControlPoint(), consecutive segments of a
+ * sequence of keyframes join with continuous angular velocity.
+ * @param[in] start The unit quaternion @f$\mathbf{q}_i@f$ at @f$t = 0@f$.
+ * @param[in] start_ctrl The control point @f$\mathbf{a}_i@f$ of @a start.
+ * @param[in] end_ctrl The control point @f$\mathbf{a}_{i+1}@f$ of @a end.
+ * @param[in] end The unit quaternion @f$\mathbf{q}_{i+1}@f$ at @f$t = 1@f$.
+ * @param[in] param The interpolation parameter @f$t \in [0, 1]@f$.
+ * @return The interpolated unit quaternion.
+ * @note Unlike QuatSlerp(), no quaternion is replaced by its opposite, so consecutive
+ * keyframes must be given on the same hemisphere, i.e.
+ * @f$\mathbf{q}_i \cdot \mathbf{q}_{i+1} \geq 0@f$.
+ */
+template <typename T>
+BasicQuaternion<T> QuatSquad(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& start_ctrl,
+                             const BasicQuaternion<T>& end_ctrl,
+                             const BasicQuaternion<T>& end, const T param);
+
+/**
+ * @brief Control point of a keyframe for QuatSquad() interpolation.
+ *
+ * @f[
+ * \mathbf{a}_i = \mathbf{q}_i \otimes \exp\left(-\frac{
+ *    \ln(\mathbf{q}_i^{-1} \otimes \mathbf{q}_{i+1}) +
+ *    \ln(\mathbf{q}_i^{-1} \otimes \mathbf{q}_{i-1})}{4}\right)
+ * @f]
+ * @param[in] prev The unit quaternion @f$\mathbf{q}_{i-1}@f$ of the previous keyframe.
+ * At the first keyframe of a sequence, pass the keyframe itself.
+ * @param[in] current The unit quaternion @f$\mathbf{q}_i@f$ of the keyframe.
+ * @param[in] next The unit quaternion @f$\mathbf{q}_{i+1}@f$ of the next keyframe. At the
+ * last keyframe of a sequence, pass the keyframe itself.
+ * @return The unit quaternion @f$\mathbf{a}_i@f$.
+ */
+template <typename T>
+BasicQuaternion<T> QuatSquadControlPoint(const BasicQuaternion<T>& prev,
+                                         const BasicQuaternion<T>& current,
+                                         const BasicQuaternion<T>& next);
 
 /**
  * @brief Determines the rotation matrix corresponding to a given unit quaternion.
  *
  * @param[in] quaternion The orientation expressed by a unit quaternion
  * @f$(q_w, q_x, q_y, q_z)@f$.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  * @see Rot2Quat()
  */
-grabnum::Matrix3d Quat2Rot(const Quaternion& quaternion);
+template <typename T>
+grabnum::Matrix3<T> Quat2Rot(const BasicQuaternion<T>& quaternion);
 
 /**
  * @brief Obtain _Tait-Bryan_ angles (Euler with @f$X_1Y_2Z_3@f$ order) out of a unit
@@ -512,7 +724,8 @@ grabnum::Matrix3d Quat2Rot(const Quaternion& quaternion);
  * @see EulerXYZ2Quat()
  * @todo Do this conversion in a smarter way.
  */
-inline grabnum::Vector3d Quat2EulerXYZ(const Quaternion& quaternion)
+template <typename T>
+inline grabnum::Vector3<T> Quat2EulerXYZ(const BasicQuaternion<T>& quaternion)
 {
   return Rot2EulerXYZ(Quat2Rot(quaternion));
 }
@@ -525,7 +738,8 @@ inline grabnum::Vector3d Quat2EulerXYZ(const Quaternion& quaternion)
  * @see RPY2Quat()
  * @todo Do this conversion in a smarter way.
  */
-inline grabnum::Vector3d Quat2RPY(const Quaternion& quaternion)
+template <typename T>
+inline grabnum::Vector3<T> Quat2RPY(const BasicQuaternion<T>& quaternion)
 {
   return Rot2RPY(Quat2Rot(quaternion));
 }
@@ -539,7 +753,8 @@ inline grabnum::Vector3d Quat2RPY(const Quaternion& quaternion)
  * @see EulerZYZ2Quat()
  * @todo Do this conversion in a smarter way.
  */
-inline grabnum::Vector3d Quat2EulerZYZ(const Quaternion& quaternion)
+template <typename T>
+inline grabnum::Vector3<T> Quat2EulerZYZ(const BasicQuaternion<T>& quaternion)
 {
   return Rot2EulerZYZ(Quat2Rot(quaternion));
 }
@@ -553,17 +768,24 @@ inline grabnum::Vector3d Quat2EulerZYZ(const Quaternion& quaternion)
  * @see TiltTorsion2Quat()
  * @todo Do this conversion in a smarter way.
  */
-inline grabnum::Vector3d Quat2TiltTorsion(const Quaternion& quaternion)
+template <typename T>
+inline grabnum::Vector3<T> Quat2TiltTorsion(const BasicQuaternion<T>& quaternion)
 {
   return Rot2TiltTorsion(Quat2Rot(quaternion));
 }
 
 /**
  * @brief Determines the unit quaternion corresponding to a given rotation matrix.
- * @param[in] rot_mat A rotation matrix.
- * @return A unit quaternion @f$(q_w, q_x, q_y, q_z)@f$.
+ *
+ * _Shepperd_'s method is used, i.e. the quaternion is found from the products with its
+ * largest component, which are the best conditioned ones for any rotation. These are
+ * selected element by element, rather than computed in a separate branch for each case.
+ * @param[in] rot_mat A rotation matrix. If it drifted from orthogonality, the result is
+ * still a unit quaternion, yet you may correct the matrix with Orthonormalize() first.
+ * @return A unit quaternion @f$(q_w, q_x, q_y, q_z)@f$, with @f$q_w \geq 0@f$.
  */
-Quaternion Rot2Quat(const grabnum::Matrix3d& rot_mat);
+template <typename T>
+BasicQuaternion<T> Rot2Quat(const grabnum::Matrix3<T>& rot_mat);
 
 /**
  * @brief Determines the unit quaternion corresponding to a given rotation based on
@@ -575,7 +797,8 @@ Quaternion Rot2Quat(const grabnum::Matrix3d& rot_mat);
  * @return A unit quaternion.
  * @see EulerXYZ2Rot() Quat2EulerXYZ()
  */
-inline Quaternion EulerXYZ2Quat(const double alpha, const double beta, const double gamma)
+template <typename T>
+inline BasicQuaternion<T> EulerXYZ2Quat(const T alpha, const T beta, const T gamma)
 {
   return Rot2Quat(EulerXYZ2Rot(alpha, beta, gamma));
 }
@@ -587,7 +810,8 @@ inline Quaternion EulerXYZ2Quat(const double alpha, const double beta, const dou
  * @return A unit quaternion.
  * @see EulerXYZ2Quat()
  */
-inline Quaternion EulerXYZ2Quat(const grabnum::Vector3d& angles)
+template <typename T>
+inline BasicQuaternion<T> EulerXYZ2Quat(const grabnum::Vector3<T>& angles)
 {
   return EulerXYZ2Quat(angles(1), angles(2), angles(3));
 }
@@ -602,7 +826,8 @@ inline Quaternion EulerXYZ2Quat(const grabnum::Vector3d& angles)
  * @return A unit quaternion.
  * @see RPY2Rot() Quat2RPY()
  */
-inline Quaternion RPY2Quat(const double roll, const double pitch, const double yaw)
+template <typename T>
+inline BasicQuaternion<T> RPY2Quat(const T roll, const T pitch, const T yaw)
 {
   return Rot2Quat(RPY2Rot(roll, pitch, yaw));
 }
@@ -614,7 +839,8 @@ inline Quaternion RPY2Quat(const double roll, const double pitch, const double y
  * @return A unit quaternion.
  * @see RPY2Quat()
  */
-inline Quaternion RPY2Quat(const grabnum::Vector3d& rpy)
+template <typename T>
+inline BasicQuaternion<T> RPY2Quat(const grabnum::Vector3<T>& rpy)
 {
   return RPY2Quat(rpy(1), rpy(2), rpy(3));
 }
@@ -629,7 +855,8 @@ inline Quaternion RPY2Quat(const grabnum::Vector3d& rpy)
  * @return A unit quaternion.
  * @see EulerZYZ2Rot() Quat2EulerZYZ()
  */
-inline Quaternion EulerZYZ2Quat(const double alpha, const double beta, const double gamma)
+template <typename T>
+inline BasicQuaternion<T> EulerZYZ2Quat(const T alpha, const T beta, const T gamma)
 {
   return Rot2Quat(EulerZYZ2Rot(alpha, beta, gamma));
 }
@@ -641,7 +868,8 @@ inline Quaternion EulerZYZ2Quat(const double alpha, const double beta, const dou
  * @return A unit quaternion.
  * @see EulerZYZ2Quat()
  */
-inline Quaternion EulerZYZ2Quat(const grabnum::Vector3d& angles)
+template <typename T>
+inline BasicQuaternion<T> EulerZYZ2Quat(const grabnum::Vector3<T>& angles)
 {
   return EulerZYZ2Quat(angles(1), angles(2), angles(3));
 }
@@ -656,8 +884,9 @@ inline Quaternion EulerZYZ2Quat(const grabnum::Vector3d& angles)
  * @return A unit quaternion.
  * @see TiltTorsion2Rot() Quat2TiltTorsion()
  */
-inline Quaternion TiltTorsion2Quat(const double tilt_azimuth, const double tilt,
-                                   const double torsion)
+template <typename T>
+inline BasicQuaternion<T> TiltTorsion2Quat(const T tilt_azimuth, const T tilt,
+                                           const T torsion)
 {
   return Rot2Quat(TiltTorsion2Rot(tilt_azimuth, tilt, torsion));
 }
@@ -669,7 +898,8 @@ inline Quaternion TiltTorsion2Quat(const double tilt_azimuth, const double tilt,
  * @return A unit quaternion.
  * @see TiltTorsion2Quat()
  */
-inline Quaternion TiltTorsion2Quat(const grabnum::Vector3d& angles)
+template <typename T>
+inline BasicQuaternion<T> TiltTorsion2Quat(const grabnum::Vector3<T>& angles)
 {
   return TiltTorsion2Quat(angles(1), angles(2), angles(3));
 }
@@ -692,13 +922,23 @@ inline Quaternion TiltTorsion2Quat(const grabnum::Vector3d& angles)
  * \otimes \mathbf{p}(^\mathcal{A}\mathbf{r}) \otimes
  * (^\mathcal{A}\boldsymbol\varepsilon_\mathcal{B})^{-1}
  * @f]
- * @param[in] quat A quaternion representing the rotation.
+ * which, for a unit quaternion, is evaluated without any quaternion product as:
+ * @f[
+ * \mathbf{t} = 2\,\mathbf{q}_v \times \mathbf{r} \qquad
+ * \mathbf{r}' = \mathbf{r} + q_w\mathbf{t} + \mathbf{q}_v \times \mathbf{t}
+ * @f]
+ * i.e. with 18 multiplications and 12 additions, fewer than building the rotation matrix
+ * with Quat2Rot() and multiplying it by the vector.
+ * @param[in] quat A unit quaternion representing the rotation.
  * @param[in] vect The 3D vector to be rotated.
  * @return A rotated 3D vector.
  * @note Recall from QuatInverse() that for unit quaternions
  * @f$\mathbf{q}^{-1} = \mathbf{q}^*@f$.
+ * @see grabgeom::batch::QuatRotate()
  */
-grabnum::Vector3d QuatRotate(const Quaternion& quat, const grabnum::Vector3d& vect);
+template <typename T>
+grabnum::Vector3<T> QuatRotate(const BasicQuaternion<T>& quat,
+                               const grabnum::Vector3<T>& vect);
 
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of a quaternion
@@ -706,9 +946,10 @@ grabnum::Vector3d QuatRotate(const Quaternion& quat, const grabnum::Vector3d& ve
  *
  * @param[in] quaternion The orientation expressed by a unitary quaternion
  * @f$(q_w, q_x, q_y, q_z)@f$.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-grabnum::MatrixXd<3, 4> HtfQuat(const Quaternion& quaternion);
+template <typename T>
+grabnum::Matrix<T, 3, 4> HtfQuat(const BasicQuaternion<T>& quaternion);
 
 /**
  * @brief Time-derivative of transformation matrix @f$\mathbf{H}@f$ between the
@@ -721,13 +962,77 @@ grabnum::MatrixXd<3, 4> HtfQuat(const Quaternion& quaternion);
  *
  * @param[in] quaternion_dot The orientation speed expressed by a quaternion
  * @f$\dot{\boldsymbol{\epsilon}}_q@f$.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-inline grabnum::MatrixXd<3, 4> DHtfQuat(const Quaternion& quaternion_dot)
+template <typename T>
+inline grabnum::Matrix<T, 3, 4> DHtfQuat(const BasicQuaternion<T>& quaternion_dot)
 {
   return HtfQuat(quaternion_dot);
 }
 
+/**
+ * @brief Product of the transformation matrix @f$\mathbf{H}@f$ of a quaternion and a
+ * 4-vector, without building the matrix.
+ *
+ * @f[
+ * \mathbf{H}(\boldsymbol{\epsilon}_q)\,\mathbf{x} = 2\left(q_w\mathbf{x}_v - x_w
+ * \mathbf{q}_v + \mathbf{q}_v \times \mathbf{x}_v\right)
+ * @f]
+ * For instance, the angular velocity is @f$\boldsymbol\omega =
+ * \mathbf{H}(\boldsymbol{\epsilon}_q)\,\dot{\boldsymbol{\epsilon}}_q@f$.
+ * @param[in] quaternion The orientation expressed by a unitary quaternion
+ * @f$(q_w, q_x, q_y, q_z)@f$.
+ * @param[in] vect The 4-vector @f$\mathbf{x} = (x_w, x_x, x_y, x_z)@f$, e.g. a
+ * quaternion time-derivative.
+ * @return The 3D vector @f$\mathbf{H}\mathbf{x}@f$.
+ * @see HtfQuat()
+ */
+template <typename T>
+grabnum::Vector3<T> HtfQuatMul(const BasicQuaternion<T>& quaternion,
+                               const BasicQuaternion<T>& vect);
+
+/**
+ * @brief Product of the transpose of the transformation matrix @f$\mathbf{H}@f$ of a
+ * quaternion and a 3D vector, without building the matrix.
+ *
+ * @f[
+ * \mathbf{H}^T(\boldsymbol{\epsilon}_q)\,\mathbf{y} = 2\begin{bmatrix}
+ *    -\mathbf{q}_v \cdot \mathbf{y} \\ q_w\mathbf{y} - \mathbf{q}_v \times \mathbf{y}
+ *    \end{bmatrix}
+ * @f]
+ * For instance, it maps the moment of a cable into the row of a jacobian w.r.t. the
+ * quaternion.
+ * @param[in] quaternion The orientation expressed by a unitary quaternion
+ * @f$(q_w, q_x, q_y, q_z)@f$.
+ * @param[in] vect The 3D vector @f$\mathbf{y}@f$.
+ * @return The 4-vector @f$\mathbf{H}^T\mathbf{y}@f$.
+ * @see HtfQuat()
+ */
+template <typename T>
+grabnum::VectorX<T, 4> HtfQuatTransposeMul(const BasicQuaternion<T>& quaternion,
+                                           const grabnum::Vector3<T>& vect);
+
+/**
+ * @brief Product of the time-derivative of the transformation matrix @f$\mathbf{H}@f$
+ * and a 4-vector, without building the matrix.
+ *
+ * @param[in] quaternion_dot The orientation speed expressed by a quaternion
+ * @f$\dot{\boldsymbol{\epsilon}}_q@f$.
+ * @param[in] vect The 4-vector @f$\mathbf{x}@f$.
+ * @return The 3D vector @f$\dot{\mathbf{H}}\mathbf{x}@f$.
+ * @note Being @f$\dot{\mathbf{H}}(\dot{\boldsymbol{\epsilon}}_q)\,
+ * \dot{\boldsymbol{\epsilon}}_q = \mathbf{0}@f$, the angular acceleration is simply
+ * @f$\boldsymbol\alpha = \mathbf{H}(\boldsymbol{\epsilon}_q)\,
+ * \ddot{\boldsymbol{\epsilon}}_q@f$.
+ * @see DHtfQuat() HtfQuatMul()
+ */
+template <typename T>
+inline grabnum::Vector3<T> DHtfQuatMul(const BasicQuaternion<T>& quaternion_dot,
+                                       const BasicQuaternion<T>& vect)
+{
+  return HtfQuatMul(quaternion_dot, vect);
+}
+
 } // end namespace grabgeom
 
 #endif // GRABCOMMON_LIBGEOM_QUATERNIONS_H
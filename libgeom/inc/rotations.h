@@ -49,6 +49,15 @@
  * @f$\boldsymbol\omega@f$ is placed in the origin, and its direction coincides with the
  * instantaneous rotation axis of the rigid body.
  * @n The form of @f$\mathbf{H}@f$ specifically depends on the parametrization used.
+ *
+ * @note
+ * ### Scalar types ###
+ * @note
+ * All functions are templated on the scalar type of the angles, which is also the one of
+ * the resulting matrices and vectors. The library is instantiated for @c double and
+ * @c float: the latter halves memory traffic and doubles the width of SIMD registers,
+ * at the cost of a relative accuracy of about @f$10^{-7}@f$ instead of
+ * @f$10^{-16}@f$.
  */
 
 #ifndef GRABCOMMON_LIBGEOM_ROTATIONS_H
@@ -76,9 +85,10 @@ namespace grabgeom {
  * @f]
  *
  * @param[in] angle Rotation angle in radians.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d RotX(const double angle);
+template <typename T>
+grabnum::Matrix3<T> RotX(const T angle);
 
 /**
  * @brief Elementary rotation around @f$Y@f$-axis.
@@ -95,9 +105,10 @@ grabnum::Matrix3d RotX(const double angle);
  * @f]
  *
  * @param[in] angle Rotation angle in radians.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d RotY(const double angle);
+template <typename T>
+grabnum::Matrix3<T> RotY(const T angle);
 
 /**
  * @brief Elementary rotation around @f$Z@f$-axis.
@@ -114,9 +125,10 @@ grabnum::Matrix3d RotY(const double angle);
  * @f]
  *
  * @param[in] angle Rotation angle in radians.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d RotZ(const double angle);
+template <typename T>
+grabnum::Matrix3<T> RotZ(const T angle);
 
 /**
  * @brief Rotation matrix based on _Tait-Bryan_ angles convention and @f$X_1Y_2Z_3@f$
@@ -144,9 +156,10 @@ grabnum::Matrix3d RotZ(const double angle);
  * @param[in] alpha [rad] Rotation angle about @f$x_0@f$-axis.
  * @param[in] beta [rad] Rotation angle about @f$y_1@f$-axis.
  * @param[in] gamma [rad] Rotation angle about @f$z_2@f$-axis.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d EulerXYZ2Rot(const double alpha, const double beta, const double gamma);
+template <typename T>
+grabnum::Matrix3<T> EulerXYZ2Rot(const T alpha, const T beta, const T gamma);
 /**
  * @brief Rotation matrix based on _Tait-Bryan_ angles convention and @f$X_1Y_2Z_3@f$
  *order.
@@ -171,9 +184,10 @@ grabnum::Matrix3d EulerXYZ2Rot(const double alpha, const double beta, const doub
  * @f]
  *
  * @param[in] angles [rad] _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-inline grabnum::Matrix3d EulerXYZ2Rot(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> EulerXYZ2Rot(const grabnum::Vector3<T>& angles)
 {
   return EulerXYZ2Rot(angles(1), angles(2), angles(3));
 }
@@ -198,9 +212,10 @@ inline grabnum::Matrix3d EulerXYZ2Rot(const grabnum::Vector3d& angles)
  * @param[in] roll [rad] Rolling angle (about @f$x_0@f$-axis).
  * @param[in] pitch [rad] Pitching angle (about @f$y_0@f$-axis).
  * @param[in] yaw [rad] Yawing angle (about @f$z_0@f$-axis).
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d RPY2Rot(const double roll, const double pitch, const double yaw);
+template <typename T>
+grabnum::Matrix3<T> RPY2Rot(const T roll, const T pitch, const T yaw);
 /**
  * @brief Rotation matrix based on _Roll, Pitch, Yaw_ angles convention (from aviation).
  *
@@ -219,9 +234,10 @@ grabnum::Matrix3d RPY2Rot(const double roll, const double pitch, const double ya
  * @f]
  *
  * @param[in] rpy [rad]  _Roll, pitch, yaw_ angles @f$(\phi,\theta,\psi)@f$ vector.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-inline grabnum::Matrix3d RPY2Rot(const grabnum::Vector3d& rpy)
+template <typename T>
+inline grabnum::Matrix3<T> RPY2Rot(const grabnum::Vector3<T>& rpy)
 {
   return RPY2Rot(rpy(1), rpy(2), rpy(3));
 }
@@ -251,9 +267,10 @@ inline grabnum::Matrix3d RPY2Rot(const grabnum::Vector3d& rpy)
  * @param[in] alpha [rad] Rotation angle about @f$z_0@f$-axis.
  * @param[in] beta [rad] Rotation angle about @f$y_1@f$-axis.
  * @param[in] gamma [rad] Rotation angle about @f$z_2@f$-axis.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-grabnum::Matrix3d EulerZYZ2Rot(const double alpha, const double beta, const double gamma);
+template <typename T>
+grabnum::Matrix3<T> EulerZYZ2Rot(const T alpha, const T beta, const T gamma);
 /**
  * @brief Rotation matrix based on _Euler_ angles convention and @f$Z_1Y_2Z_3@f$ order.
  *
@@ -277,9 +294,10 @@ grabnum::Matrix3d EulerZYZ2Rot(const double alpha, const double beta, const doub
  * @f]
  *
  * @param[in] angles [rad] _Euler_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  */
-inline grabnum::Matrix3d EulerZYZ2Rot(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> EulerZYZ2Rot(const grabnum::Vector3<T>& angles)
 {
   return EulerZYZ2Rot(angles(1), angles(2), angles(3));
 }
@@ -302,11 +320,11 @@ inline grabnum::Matrix3d EulerZYZ2Rot(const grabnum::Vector3d& angles)
  * @param[in] tilt_azimuth [rad] Tilt-azimuth angle (about @f$z_0@f$-axis).
  * @param[in] tilt [rad] Tilt angle (about @f$y_1@f$-axis).
  * @param[in] torsion [rad] Torsion angle (about @f$z_2@f$-axis).
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  * @see RotZYZ()
  */
-grabnum::Matrix3d TiltTorsion2Rot(const double tilt_azimuth, const double tilt,
-                                  const double torsion);
+template <typename T>
+grabnum::Matrix3<T> TiltTorsion2Rot(const T tilt_azimuth, const T tilt, const T torsion);
 /**
  * @brief Rotation matrix based on _tilt-and-torsion_ angle system.
  *
@@ -323,10 +341,11 @@ grabnum::Matrix3d TiltTorsion2Rot(const double tilt_azimuth, const double tilt,
  * @f]
  *
  * @param[in] angles [rad] _Tilt-and-torsion_ angles @f$(\phi,\theta,\tau)@f$ vector.
- * @return A 3x3 orthogonal matrix (double).
+ * @return A 3x3 orthogonal matrix.
  * @see RotZYZ()
  */
-inline grabnum::Matrix3d TiltTorsion2Rot(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> TiltTorsion2Rot(const grabnum::Vector3<T>& angles)
 {
   return TiltTorsion2Rot(angles(1), angles(2), angles(3));
 }
@@ -334,37 +353,69 @@ inline grabnum::Matrix3d TiltTorsion2Rot(const grabnum::Vector3d& angles)
 /**
  * @brief Obtain _Tait-Bryan_ angles (Euler with @f$X_1Y_2Z_3@f$ order) out of a rotation
  * matrix.
- * @param[in] rot_mat An orthogonal rotation matrix (double).
+ * @param[in] rot_mat An orthogonal rotation matrix.
  * @return A 3D vector with _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ in radians.
+ * @note Angles are found without branches, but they are only as accurate as @a rot_mat is
+ * orthogonal. Correct a drifting matrix with Orthonormalize() first.
  * @see EulerXYZ2Rot()
  */
-grabnum::Vector3d Rot2EulerXYZ(const grabnum::Matrix3d& rot_mat);
+template <typename T>
+grabnum::Vector3<T> Rot2EulerXYZ(const grabnum::Matrix3<T>& rot_mat);
 
 /**
  * @brief Obtain _Roll, Pitch, Yaw_ angles out of a rotation matrix.
- * @param[in] rot_mat An orthogonal rotation matrix (double).
+ * @param[in] rot_mat An orthogonal rotation matrix.
  * @return A 3D vector with _Roll, Pitch, Yaw_ angles @f$(\phi,\theta,\psi)@f$ in radians.
+ * @note Angles are found without branches, but they are only as accurate as @a rot_mat is
+ * orthogonal. Correct a drifting matrix with Orthonormalize() first.
  * @see RPY2Rot()
  */
-grabnum::Vector3d Rot2RPY(const grabnum::Matrix3d& rot_mat);
+template <typename T>
+grabnum::Vector3<T> Rot2RPY(const grabnum::Matrix3<T>& rot_mat);
 
 /**
  * @brief Obtain _Euler_ angles (Euler with @f$Z_1Y_2Z_3@f$ order) out of a rotation
  * matrix.
- * @param[in] rot_mat An orthogonal rotation matrix (double).
+ * @param[in] rot_mat An orthogonal rotation matrix.
  * @return A 3D vector with _Euler_ angles @f$(\alpha,\beta,\gamma)@f$ in radians.
  * @see EulerZYZ2Rot()
  */
-grabnum::Vector3d Rot2EulerZYZ(const grabnum::Matrix3d& rot_mat);
+template <typename T>
+grabnum::Vector3<T> Rot2EulerZYZ(const grabnum::Matrix3<T>& rot_mat);
 
 /**
  * @brief Obtain _tilt-and-torsion_ angles (Euler variant with @f$Z_1Y_2Z_3@f$ order) out
  * of a rotation matrix.
- * @param[in] rot_mat An orthogonal rotation matrix (double).
+ * @param[in] rot_mat An orthogonal rotation matrix.
  * @return A 3D vector with _tilt-and-torsion_ angles @f$(\phi,\theta,\tau)@f$ in radians.
  * @see TiltTorsion2Rot()
  */
-grabnum::Vector3d Rot2TiltTorsion(const grabnum::Matrix3d& rot_mat);
+template <typename T>
+grabnum::Vector3<T> Rot2TiltTorsion(const grabnum::Matrix3<T>& rot_mat);
+
+/**
+ * @brief Correct a matrix that drifted from orthogonality, e.g. because it was
+ * integrated over time or received from an external tracker.
+ *
+ * Each iteration is a _Newton-Schulz_ step towards the closest orthogonal matrix:
+ * @f[
+ * \mathbf{R}_{k+1} = rac{1}{2}\mathbf{R}_k\left(3\mathbf{I} -
+ * \mathbf{R}_k^T\mathbf{R}_k
+ight)
+ * @f]
+ * which squares the orthogonality error @f$\|\mathbf{R}^T\mathbf{R} - \mathbf{I}\|@f$,
+ * so that a single iteration per control cycle is enough to keep a slowly drifting
+ * matrix orthogonal up to round-off errors. Unlike _Gram-Schmidt_, all columns are
+ * corrected alike and there are neither branches nor square roots.
+ * @param[in] rot_mat A matrix close to a rotation matrix, i.e. whose singular values are
+ * all close to 1 (the iteration converges for any value within
+ * @f$(0, \sqrt{3})@f$).
+ * @param[in] iterations (Optional) The number of iterations. Default is 1.
+ * @return The corrected rotation matrix.
+ */
+template <typename T>
+grabnum::Matrix3<T> Orthonormalize(const grabnum::Matrix3<T>& rot_mat,
+                                   const uint8_t iterations = 1);
 
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of Tait-Bryan
@@ -373,44 +424,35 @@ grabnum::Vector3d Rot2TiltTorsion(const grabnum::Matrix3d& rot_mat);
  *
  * @param[in] alpha [rad] Rotation angle about @f$x_0@f$-axis.
  * @param[in] beta [rad] Rotation angle about @f$y_1@f$-axis.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-grabnum::Matrix3d HtfXYZ(const double alpha, const double beta);
+template <typename T>
+grabnum::Matrix3<T> HtfXYZ(const T alpha, const T beta);
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of _Tait-Bryan_
  *angles and angular
  * velocity vector @f$\boldsymbol\omega@f$.
  *
  * @param[in] angles [rad] _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-inline grabnum::Matrix3d HtfXYZ(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> HtfXYZ(const grabnum::Vector3<T>& angles)
 {
   return HtfXYZ(angles(1), angles(2));
 }
 
-/**
- * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of
- * _Roll, Pitch, Yaw_ angles and angular velocity vector @f$\boldsymbol\omega@f$.
- *
- * @param[in] roll [rad] Rolling angle (about @f$x_0@f$-axis).
- * @param[in] pitch [rad] Pitching angle (about @f$y_0@f$-axis).
- * @return A 3x3 matrix (double).
- * @see RotRPY()
- */
-grabnum::Matrix3d HtfRPY(const double roll, const double pitch);
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of
  * _Roll, Pitch, Yaw_ angles and angular velocity vector @f$\boldsymbol\omega@f$.
  *
  * @param[in] rpy [rad]  _Roll, pitch, yaw_ angles @f$(\phi,\theta,\psi)@f$ vector.
- * @return A 3x3 matrix (double).
- * @see HtfRPY()
+ * @return A 3x3 matrix.
+ * @note Roll angle does not appear in @f$\mathbf{H}@f$, which depends on pitch and yaw
+ * angles only.
+ * @see RPY2Rot()
  */
-inline grabnum::Matrix3d HtfRPY(const grabnum::Vector3d& rpy)
-{
-  return HtfRPY(rpy(1), rpy(2));
-}
+template <typename T> grabnum::Matrix3<T> HtfRPY(const grabnum::Vector3<T>& rpy);
 
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of
@@ -418,17 +460,19 @@ inline grabnum::Matrix3d HtfRPY(const grabnum::Vector3d& rpy)
  *
  * @param[in] tilt_azimuth [rad] Tilt-azimuth angle (about @f$z_0@f$-axis).
  * @param[in] tilt [rad] Tilt angle (about @f$y_1@f$-axis).
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-grabnum::Matrix3d HtfTiltTorsion(const double tilt_azimuth, const double tilt);
+template <typename T>
+grabnum::Matrix3<T> HtfTiltTorsion(const T tilt_azimuth, const T tilt);
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of
  * _tilt-and-torsion_ angles and angular velocity vector @f$\boldsymbol\omega@f$.
  *
  * @param[in] angles [rad] _Tilt-and-torsion_ angles @f$(\phi,\theta,\tau)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-inline grabnum::Matrix3d HtfTiltTorsion(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> HtfTiltTorsion(const grabnum::Vector3<T>& angles)
 {
   return HtfTiltTorsion(angles(1), angles(2));
 }
@@ -439,17 +483,19 @@ inline grabnum::Matrix3d HtfTiltTorsion(const grabnum::Vector3d& angles)
  *
  * @param[in] alpha [rad] Rotation angle about @f$z_0@f$-axis.
  * @param[in] beta [rad] Rotation angle about @f$y_1@f$-axis.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-grabnum::Matrix3d HtfZYZ(const double alpha, const double beta);
+template <typename T>
+grabnum::Matrix3<T> HtfZYZ(const T alpha, const T beta);
 /**
  * @brief Transformation matrix @f$\mathbf{H}@f$ between the derivative of _Euler_ angles
  * and angular velocity vector @f$\boldsymbol\omega@f$.
  *
  * @param[in] angles [rad] _Euler_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  */
-inline grabnum::Matrix3d HtfZYZ(const grabnum::Vector3d& angles)
+template <typename T>
+inline grabnum::Matrix3<T> HtfZYZ(const grabnum::Vector3<T>& angles)
 {
   return HtfZYZ(angles(1), angles(2));
 }
@@ -468,11 +514,12 @@ inline grabnum::Matrix3d HtfZYZ(const grabnum::Vector3d& angles)
  * @param[in] alpha_dot [rad/s] Time derivative of rotation angle alpha about
  *@f$x_0@f$-axis.
  * @param[in] beta_dot [rad/s] Time derivative of rotation angle about @f$y_1@f$-axis.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfXYZ()
  */
-grabnum::Matrix3d DHtfXYZ(const double alpha, const double beta, const double alpha_dot,
-                          const double beta_dot);
+template <typename T>
+grabnum::Matrix3<T> DHtfXYZ(const T alpha, const T beta, const T alpha_dot,
+                            const T beta_dot);
 /**
  * @brief Time derivative of transformation matrix between the derivative of _Tait-Bryan_
  * angles and angular velocity vector @f$\boldsymbol\omega@f$.
@@ -485,33 +532,16 @@ grabnum::Matrix3d DHtfXYZ(const double alpha, const double beta, const double al
  * @param[in] angles [rad] _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
  * @param[in] angles_dot [rad] _Tait-Bryan_ angles derivatives
  * @f$(\dot\alpha,\dot\beta,\dot\gamma)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfXYZ()
  */
-inline grabnum::Matrix3d DHtfXYZ(const grabnum::Vector3d& angles,
-                                 const grabnum::Vector3d& angles_dot)
+template <typename T>
+inline grabnum::Matrix3<T> DHtfXYZ(const grabnum::Vector3<T>& angles,
+                                   const grabnum::Vector3<T>& angles_dot)
 {
   return DHtfXYZ(angles(1), angles(2), angles_dot(1), angles_dot(2));
 }
 
-/**
- * @brief Time derivative of transformation matrix between the derivative of
- * _Roll, Pitch, Yaw_ angles and angular velocity vector @f$\boldsymbol\omega@f$.
- *
- * @f[
- * \mathbf{\dot{H}}(\boldsymbol\epsilon, \boldsymbol{\dot{\epsilon}}) =
- * \frac{d\mathbf{H}(\boldsymbol\epsilon)}{dt}
- * @f]
- *
- * @param[in] roll [rad] Rolling angle (about @f$x_0@f$-axis).
- * @param[in] pitch [rad] Pitching angle (about @f$y_0@f$-axis).
- * @param[in] roll_dot [rad/s] Time derivative of rolling angle (about @f$x_0@f$-axis).
- * @param[in] pitch_dot [rad/s] Time derivative of pitching angle (about @f$y_0@f$-axis).
- * @return A 3x3 matrix (double).
- * @see HtfRPY()
- */
-grabnum::Matrix3d DHtfRPY(const double roll, const double pitch, const double roll_dot,
-                          const double pitch_dot);
 /**
  * @brief Time derivative of transformation matrix between the derivative of _Euler_
  * angles and angular velocity vector @f$\boldsymbol\omega@f$.
@@ -524,14 +554,12 @@ grabnum::Matrix3d DHtfRPY(const double roll, const double pitch, const double ro
  * @param[in] rpy [rad]  _Roll, pitch, yaw_ angles @f$(\phi,\theta,\psi)@f$ vector.
  * @param[in] rpy_dot [rad] _Roll, pitch, yaw_ angles derivatives
  * @f$(\dot\phi,\dot\theta,\dot\psi)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfRPY()
  */
-inline grabnum::Matrix3d DHtfRPY(const grabnum::Vector3d& rpy,
-                                 const grabnum::Vector3d& rpy_dot)
-{
-  return DHtfRPY(rpy(1), rpy(2), rpy_dot(1), rpy_dot(2));
-}
+template <typename T>
+grabnum::Matrix3<T> DHtfRPY(const grabnum::Vector3<T>& rpy,
+                            const grabnum::Vector3<T>& rpy_dot);
 
 /**
  * @brief Time derivative of transformation matrix between the derivative of _Euler_
@@ -548,11 +576,12 @@ inline grabnum::Matrix3d DHtfRPY(const grabnum::Vector3d& rpy,
  *@f$z_0@f$-axis.
  * @param[in] beta_dot [rad/s] Time derivative of rotation angle _beta_ about
  *@f$y_1@f$-axis.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfXYZ()
  */
-grabnum::Matrix3d DHtfZYZ(const double alpha, const double beta, const double alpha_dot,
-                          const double beta_dot);
+template <typename T>
+grabnum::Matrix3<T> DHtfZYZ(const T alpha, const T beta, const T alpha_dot,
+                            const T beta_dot);
 /**
  * @brief Time derivative of transformation matrix between the derivative of _Euler_
  * angles and angular velocity vector @f$\boldsymbol\omega@f$.
@@ -565,11 +594,12 @@ grabnum::Matrix3d DHtfZYZ(const double alpha, const double beta, const double al
  * @param[in] angles [rad] _Euler_ angles @f$(\alpha,\beta,\gamma)@f$ vector.
  * @param[in] angles_dot [rad] _Euler_ angles derivatives
  * @f$(\dot\alpha,\dot\beta,\dot\gamma)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfXYZ()
  */
-inline grabnum::Matrix3d DHtfZYZ(const grabnum::Vector3d& angles,
-                                 const grabnum::Vector3d& angles_dot)
+template <typename T>
+inline grabnum::Matrix3<T> DHtfZYZ(const grabnum::Vector3<T>& angles,
+                                   const grabnum::Vector3<T>& angles_dot)
 {
   return DHtfZYZ(angles(1), angles(2), angles_dot(1), angles_dot(2));
 }
@@ -589,11 +619,12 @@ inline grabnum::Matrix3d DHtfZYZ(const grabnum::Vector3d& angles,
  * @param[in] tilt_azimuth_dot [rad/s] Time derivative of tilt-azimuth angle (about
  *@f$x_0@f$-axis).
  * @param[in] tilt_dot [rad/s] Time derivative of tilt angle (about @f$y_1@f$-axis).
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfTiltTorsion()
  */
-grabnum::Matrix3d DHtfTiltTorsion(const double tilt_azimuth, const double tilt,
-                                  const double tilt_azimuth_dot, const double tilt_dot);
+template <typename T>
+grabnum::Matrix3<T> DHtfTiltTorsion(const T tilt_azimuth, const T tilt,
+                                    const T tilt_azimuth_dot, const T tilt_dot);
 /**
  * @brief Time derivative of transformation matrix between the derivative of
  *tilt-and-torsion
@@ -607,15 +638,197 @@ grabnum::Matrix3d DHtfTiltTorsion(const double tilt_azimuth, const double tilt,
  * @param[in] angles [rad] _Tilt-and-torsion_ angles @f$(\phi,\theta,\tau)@f$ vector.
  * @param[in] angles_dot [rad] _Tilt-and-torsion_ angles derivatives
  * @f$(\dot\phi,\dot\theta,\dot\tau)@f$ vector.
- * @return A 3x3 matrix (double).
+ * @return A 3x3 matrix.
  * @see HtfTiltTorsion()
  */
-inline grabnum::Matrix3d DHtfTiltTorsion(const grabnum::Vector3d& angles,
-                                         const grabnum::Vector3d& angles_dot)
+template <typename T>
+inline grabnum::Matrix3<T> DHtfTiltTorsion(const grabnum::Vector3<T>& angles,
+                                           const grabnum::Vector3<T>& angles_dot)
 {
   return DHtfTiltTorsion(angles(1), angles(2), angles_dot(1), angles_dot(2));
 }
 
+/**
+ * @brief Sines and cosines of the three angles of a rotation parametrization.
+ *
+ * The rotation matrix of an orientation and its transformation matrices
+ * @f$\mathbf{H}@f$ and @f$\dot{\mathbf{H}}@f$ all depend on the same trigonometric
+ * functions of its angles, which are the most expensive part of their computation.
+ * Evaluating them once into this structure and passing it to the overloads below, e.g.
+ * @code
+ * const AnglesSinCos<double> trig(rpy);
+ * rot_mat = RPY2Rot(trig);
+ * h_mat   = HtfRPY(trig);
+ * dh_mat  = DHtfRPY(trig, rpy_dot);
+ * @endcode
+ * gives the same matrices with a single @c sin and @c cos per angle. Each matrix is then
+ * written entry by entry in closed form, without composing elementary rotations.
+ */
+template <typename T> struct AnglesSinCos
+{
+  T s1 = 0; /**< sine of the first angle. */
+  T c1 = 1; /**< cosine of the first angle. */
+  T s2 = 0; /**< sine of the second angle. */
+  T c2 = 1; /**< cosine of the second angle. */
+  T s3 = 0; /**< sine of the third angle. */
+  T c3 = 1; /**< cosine of the third angle. */
+
+  /**
+   * @brief Default constructor, corresponding to null angles.
+   */
+  AnglesSinCos() {}
+  /**
+   * @brief Full constructor.
+   * @param[in] angle1 [rad] First angle of the parametrization.
+   * @param[in] angle2 [rad] Second angle of the parametrization.
+   * @param[in] angle3 [rad] Third angle of the parametrization.
+   */
+  AnglesSinCos(const T angle1, const T angle2, const T angle3)
+    : s1(std::sin(angle1)), c1(std::cos(angle1)), s2(std::sin(angle2)),
+      c2(std::cos(angle2)), s3(std::sin(angle3)), c3(std::cos(angle3))
+  {}
+  /**
+   * @brief Constructor from a vector of angles.
+   * @param[in] angles [rad] The three angles of the parametrization.
+   */
+  explicit AnglesSinCos(const grabnum::Vector3<T>& angles)
+    : AnglesSinCos(angles(1), angles(2), angles(3))
+  {}
+};
+
+/**
+ * @brief Rotation matrix based on _Tait-Bryan_ angles, given their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @return A 3x3 orthogonal matrix.
+ * @see EulerXYZ2Rot(const T, const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> EulerXYZ2Rot(const AnglesSinCos<T>& trig);
+/**
+ * @brief Rotation matrix based on _Roll, Pitch, Yaw_ angles, given their sines and
+ * cosines.
+ *
+ * @param[in] trig Sines and cosines of _roll, pitch, yaw_ angles
+ * @f$(\phi,\theta,\psi)@f$.
+ * @return A 3x3 orthogonal matrix.
+ * @see RPY2Rot(const T, const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> RPY2Rot(const AnglesSinCos<T>& trig);
+/**
+ * @brief Rotation matrix based on _Euler_ angles, given their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Euler_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @return A 3x3 orthogonal matrix.
+ * @see EulerZYZ2Rot(const T, const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> EulerZYZ2Rot(const AnglesSinCos<T>& trig);
+/**
+ * @brief Rotation matrix based on _tilt-and-torsion_ angles, given their sines and
+ * cosines.
+ *
+ * The trigonometric functions of @f$\tau - \phi@f$ are obtained from the ones of
+ * @f$\phi@f$ and @f$\tau@f$ by angle difference identities.
+ * @param[in] trig Sines and cosines of _tilt-and-torsion_ angles
+ * @f$(\phi,\theta,\tau)@f$.
+ * @return A 3x3 orthogonal matrix.
+ * @see TiltTorsion2Rot(const T, const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> TiltTorsion2Rot(const AnglesSinCos<T>& trig);
+
+/**
+ * @brief Transformation matrix @f$\mathbf{H}@f$ of _Tait-Bryan_ angles, given their
+ * sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @return A 3x3 matrix.
+ * @see HtfXYZ(const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> HtfXYZ(const AnglesSinCos<T>& trig);
+/**
+ * @brief Transformation matrix @f$\mathbf{H}@f$ of _Roll, Pitch, Yaw_ angles, given
+ * their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _roll, pitch, yaw_ angles
+ * @f$(\phi,\theta,\psi)@f$.
+ * @return A 3x3 matrix.
+ * @see HtfRPY(const grabnum::Vector3<T>&)
+ */
+template <typename T> grabnum::Matrix3<T> HtfRPY(const AnglesSinCos<T>& trig);
+/**
+ * @brief Transformation matrix @f$\mathbf{H}@f$ of _Euler_ angles, given their sines
+ * and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Euler_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @return A 3x3 matrix.
+ * @see HtfZYZ(const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> HtfZYZ(const AnglesSinCos<T>& trig);
+/**
+ * @brief Transformation matrix @f$\mathbf{H}@f$ of _tilt-and-torsion_ angles, given
+ * their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _tilt-and-torsion_ angles
+ * @f$(\phi,\theta,\tau)@f$.
+ * @return A 3x3 matrix.
+ * @see HtfTiltTorsion(const T, const T)
+ */
+template <typename T> grabnum::Matrix3<T> HtfTiltTorsion(const AnglesSinCos<T>& trig);
+
+/**
+ * @brief Time derivative of transformation matrix of _Tait-Bryan_ angles, given their
+ * sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @param[in] angles_dot [rad/s] _Tait-Bryan_ angles derivatives
+ * @f$(\dot\alpha,\dot\beta,\dot\gamma)@f$ vector.
+ * @return A 3x3 matrix.
+ * @see DHtfXYZ(const T, const T, const T, const T)
+ */
+template <typename T>
+grabnum::Matrix3<T> DHtfXYZ(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& angles_dot);
+/**
+ * @brief Time derivative of transformation matrix of _Roll, Pitch, Yaw_ angles, given
+ * their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _roll, pitch, yaw_ angles
+ * @f$(\phi,\theta,\psi)@f$.
+ * @param[in] rpy_dot [rad/s] _Roll, pitch, yaw_ angles derivatives
+ * @f$(\dot\phi,\dot\theta,\dot\psi)@f$ vector.
+ * @return A 3x3 matrix.
+ * @see DHtfRPY(const grabnum::Vector3<T>&, const grabnum::Vector3<T>&)
+ */
+template <typename T>
+grabnum::Matrix3<T> DHtfRPY(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& rpy_dot);
+/**
+ * @brief Time derivative of transformation matrix of _Euler_ angles, given their sines
+ * and cosines.
+ *
+ * @param[in] trig Sines and cosines of _Euler_ angles @f$(\alpha,\beta,\gamma)@f$.
+ * @param[in] angles_dot [rad/s] _Euler_ angles derivatives
+ * @f$(\dot\alpha,\dot\beta,\dot\gamma)@f$ vector.
+ * @return A 3x3 matrix.
+ * @see DHtfZYZ(const T, const T, const T, const T)
+ */
+template <typename T>
+grabnum::Matrix3<T> DHtfZYZ(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& angles_dot);
+/**
+ * @brief Time derivative of transformation matrix of _tilt-and-torsion_ angles, given
+ * their sines and cosines.
+ *
+ * @param[in] trig Sines and cosines of _tilt-and-torsion_ angles
+ * @f$(\phi,\theta,\tau)@f$.
+ * @param[in] angles_dot [rad/s] _Tilt-and-torsion_ angles derivatives
+ * @f$(\dot\phi,\dot\theta,\dot\tau)@f$ vector.
+ * @return A 3x3 matrix.
+ * @see DHtfTiltTorsion(const T, const T, const T, const T)
+ */
+template <typename T>
+grabnum::Matrix3<T> DHtfTiltTorsion(const AnglesSinCos<T>& trig,
+                                    const grabnum::Vector3<T>& angles_dot);
+
 } // end namespace grabgeom
 
 #endif // GRABCOMMON_LIBGEOM_ROTATIONS_H
@@ -0,0 +1,245 @@
+/**
+ * @file rotations_batch.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing batch conversions between orientation parametrizations and
+ * batch interpolations of orientations, to be included in the GRAB geometric library.
+ *
+ * Offline trajectories are made of hundreds of thousands of poses, whose conversion one
+ * at a time through RPY2Quat(), Quat2Rot() or Rot2EulerXYZ() is dominated by calls to
+ * trigonometric functions. The functions in this file convert a whole trajectory at
+ * once, evaluating sines, cosines and arctangents with the vectorized kernels of
+ * grabnum::simd, and can split it among several threads with ParallelConvert():
+ * @code
+ * std::vector<double> rpy(3 * samples), quat(4 * samples); // filled column by column
+ * grabgeom::batch::ParallelConvert(grabgeom::batch::RPY2Quat<double>, rpy.data(),
+ *                                  quat.data(), samples, samples);
+ * @endcode
+ * Likewise, QuatSlerp(), QuatNlerp() and QuatSquad() sample a whole segment of an
+ * interpolated orientation trajectory at once, while QuatRotate() and Rotate() apply
+ * the same rotation to many vectors, such as the attach points of all cables.
+ *
+ * @note
+ * ### Buffers layout ###
+ * @note
+ * All buffers are structures of arrays: the same component of all samples is stored
+ * contiguously, and two components of the same sample are @a stride elements apart.
+ * Components are ordered as follows:
+ * - angles: @f$(\alpha,\beta,\gamma)@f$ or @f$(\phi,\theta,\psi)@f$, i.e. 3 components;
+ * - quaternions: @f$(q_w, q_x, q_y, q_z)@f$, i.e. 4 components;
+ * - rotation matrices: @f$(r_{11}, r_{12}, r_{13}, r_{21}, \dots, r_{33})@f$, i.e. 9
+ * components in row-major order.
+ * @note
+ * Hence a buffer holds at least @f$(n - 1) \cdot stride + size@f$ elements, where
+ * @f$n@f$ is the number of components. Input and output buffers must not overlap.
+ */
+
+#ifndef GRABCOMMON_LIBGEOM_ROTATIONS_BATCH_H
+#define GRABCOMMON_LIBGEOM_ROTATIONS_BATCH_H
+
+#include "quaternions.h"
+
+/**
+ * @brief Namespace for GRAB geometric library.
+ */
+namespace grabgeom {
+
+/**
+ * @brief Namespace for batch conversions over structure-of-arrays buffers.
+ */
+namespace batch {
+
+/**
+ * Signature shared by all batch conversions, so that they can be split by
+ * ParallelConvert().
+ */
+template <typename T>
+using Conversion = void (*)(const T*, T*, const uint32_t, const uint32_t);
+
+/**
+ * @brief Batch version of grabgeom::EulerXYZ2Rot().
+ * @param[in] angles [rad] _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ of all samples.
+ * @param[out] rot_mats The rotation matrices of all samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void EulerXYZ2Rot(const T* angles, T* rot_mats, const uint32_t size,
+                  const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::RPY2Rot().
+ * @param[in] rpy [rad] _Roll, Pitch, Yaw_ angles @f$(\phi,\theta,\psi)@f$ of all
+ * samples.
+ * @param[out] rot_mats The rotation matrices of all samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void RPY2Rot(const T* rpy, T* rot_mats, const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::RPY2Quat().
+ *
+ * Quaternions are computed in closed form from the sines and cosines of the half angles,
+ * instead of going through the rotation matrix.
+ * @param[in] rpy [rad] _Roll, Pitch, Yaw_ angles @f$(\phi,\theta,\psi)@f$ of all
+ * samples.
+ * @param[out] quaternions The unit quaternions of all samples, with @f$q_w \geq 0@f$.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void RPY2Quat(const T* rpy, T* quaternions, const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::Quat2Rot().
+ * @param[in] quaternions The unit quaternions of all samples.
+ * @param[out] rot_mats The rotation matrices of all samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void Quat2Rot(const T* quaternions, T* rot_mats, const uint32_t size,
+              const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::Quat2RPY().
+ *
+ * Only the elements of the rotation matrix needed by Rot2RPY() are computed.
+ * @param[in] quaternions The unit quaternions of all samples.
+ * @param[out] rpy [rad] _Roll, Pitch, Yaw_ angles @f$(\phi,\theta,\psi)@f$ of all
+ * samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void Quat2RPY(const T* quaternions, T* rpy, const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::Rot2EulerXYZ().
+ * @param[in] rot_mats The rotation matrices of all samples.
+ * @param[out] angles [rad] _Tait-Bryan_ angles @f$(\alpha,\beta,\gamma)@f$ of all
+ * samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void Rot2EulerXYZ(const T* rot_mats, T* angles, const uint32_t size,
+                  const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::Rot2RPY().
+ * @param[in] rot_mats The rotation matrices of all samples.
+ * @param[out] rpy [rad] _Roll, Pitch, Yaw_ angles @f$(\phi,\theta,\psi)@f$ of all
+ * samples.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ */
+template <typename T>
+void Rot2RPY(const T* rot_mats, T* rpy, const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::QuatRotate(), rotating many vectors by the same
+ * quaternion.
+ * @param[in] quat A unit quaternion representing the rotation.
+ * @param[in] vects The 3D vectors to be rotated.
+ * @param[out] rotated The rotated 3D vectors. It may be the same buffer of @a vects.
+ * @param[in] size The number of vectors.
+ * @param[in] stride The distance between two components of the same vector, in all
+ * buffers.
+ */
+template <typename T>
+void QuatRotate(const BasicQuaternion<T>& quat, const T* vects, T* rotated,
+                const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Rotate many vectors by the same rotation matrix.
+ * @param[in] rot_mat A rotation matrix.
+ * @param[in] vects The 3D vectors to be rotated.
+ * @param[out] rotated The rotated 3D vectors. It may be the same buffer of @a vects.
+ * @param[in] size The number of vectors.
+ * @param[in] stride The distance between two components of the same vector, in all
+ * buffers.
+ */
+template <typename T>
+void Rotate(const grabnum::Matrix3<T>& rot_mat, const T* vects, T* rotated,
+            const uint32_t size, const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::QuatSlerp(), to sample a whole segment.
+ * @param[in] start The unit quaternion at @f$t = 0@f$.
+ * @param[in] end The unit quaternion at @f$t = 1@f$.
+ * @param[in] params A buffer of @a size interpolation parameters @f$t_i \in [0, 1]@f$.
+ * @param[out] quaternions The interpolated unit quaternions at all parameters.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample.
+ */
+template <typename T>
+void QuatSlerp(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::QuatNlerp(), to sample a whole segment.
+ * @param[in] start The unit quaternion at @f$t = 0@f$.
+ * @param[in] end The unit quaternion at @f$t = 1@f$.
+ * @param[in] params A buffer of @a size interpolation parameters @f$t_i \in [0, 1]@f$.
+ * @param[out] quaternions The interpolated unit quaternions at all parameters.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample.
+ */
+template <typename T>
+void QuatNlerp(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride);
+
+/**
+ * @brief Batch version of grabgeom::QuatSquad(), to sample a whole segment.
+ * @param[in] start The unit quaternion @f$\mathbf{q}_i@f$ at @f$t = 0@f$.
+ * @param[in] start_ctrl The control point @f$\mathbf{a}_i@f$ of @a start.
+ * @param[in] end_ctrl The control point @f$\mathbf{a}_{i+1}@f$ of @a end.
+ * @param[in] end The unit quaternion @f$\mathbf{q}_{i+1}@f$ at @f$t = 1@f$.
+ * @param[in] params A buffer of @a size interpolation parameters @f$t_i \in [0, 1]@f$.
+ * @param[out] quaternions The interpolated unit quaternions at all parameters.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample.
+ */
+template <typename T>
+void QuatSquad(const BasicQuaternion<T>& start, const BasicQuaternion<T>& start_ctrl,
+               const BasicQuaternion<T>& end_ctrl, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride);
+
+/**
+ * @brief Split a batch conversion among several threads.
+ *
+ * Samples are divided in contiguous chunks, one per thread, the last one being
+ * converted by the calling thread. Batches too small to pay off the start of a thread
+ * are converted by the calling thread only.
+ * @param[in] conversion Any of the batch conversions between parametrizations above.
+ * @param[in] src The input buffer of @a conversion.
+ * @param[out] dst The output buffer of @a conversion.
+ * @param[in] size The number of samples.
+ * @param[in] stride The distance between two components of the same sample, in all
+ * buffers.
+ * @param[in] threads (Optional) The maximum number of threads, including the calling
+ * one. Default is 0, i.e. the number of concurrent threads supported by the hardware.
+ */
+template <typename T>
+void ParallelConvert(Conversion<T> conversion, const T* src, T* dst,
+                     const uint32_t size, const uint32_t stride,
+                     const uint8_t threads = 0);
+
+} // end namespace batch
+
+} // end namespace grabgeom
+
+#endif // GRABCOMMON_LIBGEOM_ROTATIONS_BATCH_H
@@ -4,7 +4,7 @@ QT       -= gui
 
 TARGET = libgeom_test
 
-CONFIG   += console c++11
+CONFIG   += console c++14 thread
 CONFIG   -= app_bundle
 
 TEMPLATE = app
@@ -17,12 +17,14 @@ DEFINES += QT_DEPRECATED_WARNINGS
 
 HEADERS += \
     $$PWD/inc/rotations.h \
-    $$PWD/inc/quaternions.h
+    $$PWD/inc/quaternions.h \
+    $$PWD/inc/rotations_batch.h
 
 SOURCES += \
     $$PWD/src/rotations.cpp \
     $$PWD/src/quaternions.cpp \
-    $$PWD/test/libgeom_test.cpp
+    $$PWD/src/rotations_batch.cpp \
+    $$PWD/tests/libgeom_test.cpp
 
 INCLUDEPATH += $$PWD/inc
 
@@ -9,11 +9,12 @@
 
 namespace grabgeom {
 
-grabnum::Matrix3d Quat2Rot(const Quaternion& q)
+template <typename T>
+grabnum::Matrix3<T> Quat2Rot(const BasicQuaternion<T>& q)
 {
   assert(q.IsUnitary());
 
-  grabnum::Matrix3d rot;
+  grabnum::Matrix3<T> rot;
   rot(1, 1) = q.w * q.w + q.x * q.x - q.y * q.y - q.z * q.z;
   rot(1, 2) = 2 * (q.x * q.y - q.w * q.z);
   rot(1, 3) = 2 * (q.x * q.z + q.w * q.y);
@@ -26,58 +27,231 @@ grabnum::Matrix3d Quat2Rot(const Quaternion& q)
   return rot;
 }
 
-Quaternion Rot2Quat(const grabnum::Matrix3d& rot_mat)
+template <typename T>
+BasicQuaternion<T> Rot2Quat(const grabnum::Matrix3<T>& rot_mat)
 {
-  Quaternion q_square;
-  Quaternion q;
-  q_square.w = 0.25 * (1 + rot_mat(1, 1) + rot_mat(2, 2) + rot_mat(3, 3));
-  q_square.x = 0.25 * (1 + rot_mat(1, 1) - rot_mat(2, 2) - rot_mat(3, 3));
-  q_square.y = 0.25 * (1 - rot_mat(1, 1) + rot_mat(2, 2) - rot_mat(3, 3));
-  q_square.z = 0.25 * (1 - rot_mat(1, 1) - rot_mat(2, 2) + rot_mat(3, 3));
-  switch (q_square.q().MaxIdx())
-  {
-    case 1:
-      q.w = sqrt(q_square.w);
-      q.x = 0.25 * (rot_mat(3, 2) - rot_mat(2, 3)) / q.w;
-      q.y = 0.25 * (rot_mat(1, 3) - rot_mat(3, 1)) / q.w;
-      q.z = 0.25 * (rot_mat(2, 1) - rot_mat(1, 2)) / q.w;
-      break;
-    case 2:
-      q.x = sqrt(q_square.x);
-      q.w = 0.25 * (rot_mat(3, 2) - rot_mat(2, 3)) / q.x;
-      q.y = 0.25 * (rot_mat(1, 2) - rot_mat(2, 1)) / q.x;
-      q.z = 0.25 * (rot_mat(1, 3) - rot_mat(3, 1)) / q.x;
-      break;
-    case 3:
-      q.y = sqrt(q_square.y);
-      q.w = 0.25 * (rot_mat(1, 3) - rot_mat(3, 1)) / q.y;
-      q.x = 0.25 * (rot_mat(1, 2) - rot_mat(2, 1)) / q.y;
-      q.z = 0.25 * (rot_mat(2, 3) - rot_mat(3, 2)) / q.y;
-      break;
-    case 4:
-      q.z = sqrt(q_square.z);
-      q.w = 0.25 * (rot_mat(2, 1) - rot_mat(1, 2)) / q.z;
-      q.x = 0.25 * (rot_mat(1, 3) - rot_mat(3, 1)) / q.z;
-      q.y = 0.25 * (rot_mat(2, 3) - rot_mat(3, 2)) / q.z;
-      break;
-  }
-  return q;
+  // Shepperd's method: the products 4 q_i q_j are all sums and differences of the matrix
+  // elements, i.e. the diagonal ones (4 q_i^2)...
+  const T* r = rot_mat.Data();
+  const T ww = 1 + r[0] + r[4] + r[8];
+  const T xx = 1 + r[0] - r[4] - r[8];
+  const T yy = 1 - r[0] + r[4] - r[8];
+  const T zz = 1 - r[0] - r[4] + r[8];
+  // ...and the off-diagonal ones.
+  const T wx = r[7] - r[5];
+  const T wy = r[2] - r[6];
+  const T wz = r[3] - r[1];
+  const T xy = r[1] + r[3];
+  const T xz = r[2] + r[6];
+  const T yz = r[5] + r[7];
+  // The products with the largest component are the best conditioned ones. They are
+  // selected element by element, with no switch over the index of the largest one.
+  const bool x_over_w   = xx > ww;
+  const bool z_over_y   = zz > yy;
+  const bool zy_over_xw = (z_over_y ? zz : yy) > (x_over_w ? xx : ww);
+  T prods[4];
+  prods[0] = zy_over_xw ? (z_over_y ? wz : wy) : (x_over_w ? wx : ww);
+  prods[1] = zy_over_xw ? (z_over_y ? xz : xy) : (x_over_w ? xx : wx);
+  prods[2] = zy_over_xw ? (z_over_y ? yz : yy) : (x_over_w ? xy : wy);
+  prods[3] = zy_over_xw ? (z_over_y ? zz : yz) : (x_over_w ? xz : wz);
+  // Normalizing these products, instead of dividing them by 4 q_i, yields a unit
+  // quaternion even if the matrix drifted from orthogonality. The sign makes q_w
+  // non-negative.
+  const T scale = std::copysign(1 / std::sqrt(prods[0] * prods[0] + prods[1] * prods[1] +
+                                              prods[2] * prods[2] + prods[3] * prods[3]),
+                                prods[0]);
+  return BasicQuaternion<T>(scale * prods[0], scale * prods[1], scale * prods[2],
+                            scale * prods[3]);
 }
 
-grabnum::Vector3d QuatRotate(const Quaternion& quat, const grabnum::Vector3d& vect)
+template <typename T>
+grabnum::Vector3<T> QuatRotate(const BasicQuaternion<T>& quat,
+                               const grabnum::Vector3<T>& vect)
 {
   assert(quat.IsUnitary());
 
-  Quaternion vect_ext(0., vect); // pure quaternion
-  return (quat * vect_ext * quat.Conj()).v();
+  // Expansion of q * (0, r) * q^*, using |q| = 1.
+  const T tx = 2 * (quat.y * vect(3) - quat.z * vect(2));
+  const T ty = 2 * (quat.z * vect(1) - quat.x * vect(3));
+  const T tz = 2 * (quat.x * vect(2) - quat.y * vect(1));
+  grabnum::Vector3<T> rotated;
+  rotated(1) = vect(1) + quat.w * tx + quat.y * tz - quat.z * ty;
+  rotated(2) = vect(2) + quat.w * ty + quat.z * tx - quat.x * tz;
+  rotated(3) = vect(3) + quat.w * tz + quat.x * ty - quat.y * tx;
+  return rotated;
 }
 
-grabnum::MatrixXd<3, 4> HtfQuat(const Quaternion& quat)
+template <typename T>
+grabnum::Matrix<T, 3, 4> HtfQuat(const BasicQuaternion<T>& quat)
 {
-  grabnum::MatrixXd<3, 4> hmat;
+  grabnum::Matrix<T, 3, 4> hmat;
   hmat.SetCol(1, -quat.v());
-  hmat.SetBlock(1, 2, grabnum::Skew(quat.v()) + grabnum::Matrix3d(quat.w));
+  hmat.SetBlock(1, 2, grabnum::Skew(quat.v()) + grabnum::Matrix3<T>(quat.w));
   return 2. * hmat;
 }
 
+template <typename T>
+grabnum::Vector3<T> HtfQuatMul(const BasicQuaternion<T>& quat,
+                               const BasicQuaternion<T>& vect)
+{
+  grabnum::Vector3<T> prod;
+  prod(1) = 2 * (quat.w * vect.x - vect.w * quat.x + quat.y * vect.z - quat.z * vect.y);
+  prod(2) = 2 * (quat.w * vect.y - vect.w * quat.y + quat.z * vect.x - quat.x * vect.z);
+  prod(3) = 2 * (quat.w * vect.z - vect.w * quat.z + quat.x * vect.y - quat.y * vect.x);
+  return prod;
+}
+
+template <typename T>
+grabnum::VectorX<T, 4> HtfQuatTransposeMul(const BasicQuaternion<T>& quat,
+                                           const grabnum::Vector3<T>& vect)
+{
+  grabnum::VectorX<T, 4> prod;
+  prod(1) = -2 * (quat.x * vect(1) + quat.y * vect(2) + quat.z * vect(3));
+  prod(2) = 2 * (quat.w * vect(1) - quat.y * vect(3) + quat.z * vect(2));
+  prod(3) = 2 * (quat.w * vect(2) - quat.z * vect(1) + quat.x * vect(3));
+  prod(4) = 2 * (quat.w * vect(3) - quat.x * vect(2) + quat.y * vect(1));
+  return prod;
+}
+
+namespace {
+
+// Spherical interpolation along the arc between start and end, whichever its length.
+template <typename T>
+BasicQuaternion<T> SlerpArc(const BasicQuaternion<T>& start,
+                            const BasicQuaternion<T>& end, const T param)
+{
+  const BasicQuaternion<T> diff = end - start;
+  const BasicQuaternion<T> sum  = end + start;
+  const T angle =
+    2 * std::atan2(std::sqrt(QuatDot(diff, diff)), std::sqrt(QuatDot(sum, sum)));
+  if (angle < std::numeric_limits<T>::epsilon())
+    return (1 - param) * start + param * end;
+  const T sin_angle = std::sin(angle);
+  return (std::sin((1 - param) * angle) / sin_angle) * start +
+         (std::sin(param * angle) / sin_angle) * end;
+}
+
+} // end anonymous namespace
+
+template <typename T> BasicQuaternion<T> QuatExp(const BasicQuaternion<T>& quat)
+{
+  const T angle = std::sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z);
+  const T scale = std::exp(quat.w);
+  // sin(angle) / angle, whose limit is 1 in 0.
+  const T sinc =
+    angle < std::numeric_limits<T>::epsilon() ? 1 : std::sin(angle) / angle;
+  return BasicQuaternion<T>(scale * std::cos(angle), scale * sinc * quat.x,
+                            scale * sinc * quat.y, scale * sinc * quat.z);
+}
+
+template <typename T> BasicQuaternion<T> QuatLog(const BasicQuaternion<T>& quat)
+{
+  const T vect_norm = std::sqrt(quat.x * quat.x + quat.y * quat.y + quat.z * quat.z);
+  const T norm      = std::sqrt(SQUARE(quat.w) + SQUARE(vect_norm));
+  if (vect_norm < std::numeric_limits<T>::epsilon() * norm)
+  {
+    // Real quaternion: atan2(|v|, w) / |v| tends to 1 / w if positive, otherwise the
+    // angle is pi about an arbitrary axis.
+    if (quat.w > 0)
+      return BasicQuaternion<T>(std::log(norm), quat.x / quat.w, quat.y / quat.w,
+                                quat.z / quat.w);
+    return BasicQuaternion<T>(std::log(norm), static_cast<T>(M_PI), 0, 0);
+  }
+  const T scale = std::atan2(vect_norm, quat.w) / vect_norm;
+  return BasicQuaternion<T>(std::log(norm), scale * quat.x, scale * quat.y,
+                            scale * quat.z);
+}
+
+template <typename T>
+BasicQuaternion<T> QuatSlerp(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& end, const T param)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  return SlerpArc(start, QuatDot(start, end) < 0 ? -end : end, param);
+}
+
+template <typename T>
+BasicQuaternion<T> QuatNlerp(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& end, const T param)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  // 2 / (1 + n^2) differs from 1 / n by about (1 - n^2)^2 / 8, i.e. less than the
+  // machine epsilon within this tolerance.
+  static const T kFastNormalizationTol =
+    std::sqrt(8 * std::numeric_limits<T>::epsilon());
+
+  BasicQuaternion<T> quat =
+    start + param * ((QuatDot(start, end) < 0 ? -end : end) - start);
+  const T squared_norm = QuatDot(quat, quat);
+  if (std::abs(1 - squared_norm) < kFastNormalizationTol)
+    return quat *= 2 / (1 + squared_norm);
+  return quat *= 1 / std::sqrt(squared_norm);
+}
+
+template <typename T>
+BasicQuaternion<T> QuatSquad(const BasicQuaternion<T>& start,
+                             const BasicQuaternion<T>& start_ctrl,
+                             const BasicQuaternion<T>& end_ctrl,
+                             const BasicQuaternion<T>& end, const T param)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  return SlerpArc(SlerpArc(start, end, param), SlerpArc(start_ctrl, end_ctrl, param),
+                  2 * param * (1 - param));
+}
+
+template <typename T>
+BasicQuaternion<T> QuatSquadControlPoint(const BasicQuaternion<T>& prev,
+                                         const BasicQuaternion<T>& current,
+                                         const BasicQuaternion<T>& next)
+{
+  assert(prev.IsUnitary() && current.IsUnitary() && next.IsUnitary());
+
+  const BasicQuaternion<T> current_inv = current.Conj();
+  BasicQuaternion<T> tangent = QuatLog(current_inv * next) + QuatLog(current_inv * prev);
+  tangent *= static_cast<T>(-0.25);
+  return current * QuatExp(tangent);
+}
+
+// Explicit instantiations.
+template grabnum::Matrix3<float> Quat2Rot<float>(const Quaternionf&);
+template grabnum::Matrix3<double> Quat2Rot<double>(const Quaternion&);
+template Quaternionf Rot2Quat<float>(const grabnum::Matrix3<float>&);
+template Quaternion Rot2Quat<double>(const grabnum::Matrix3<double>&);
+template grabnum::Vector3<float> QuatRotate<float>(const Quaternionf&,
+                                                   const grabnum::Vector3<float>&);
+template grabnum::Vector3<double> QuatRotate<double>(const Quaternion&,
+                                                     const grabnum::Vector3<double>&);
+template grabnum::Matrix<float, 3, 4> HtfQuat<float>(const Quaternionf&);
+template grabnum::Matrix<double, 3, 4> HtfQuat<double>(const Quaternion&);
+template grabnum::Vector3<float> HtfQuatMul<float>(const Quaternionf&,
+                                                   const Quaternionf&);
+template grabnum::Vector3<double> HtfQuatMul<double>(const Quaternion&,
+                                                     const Quaternion&);
+template grabnum::VectorX<float, 4>
+HtfQuatTransposeMul<float>(const Quaternionf&, const grabnum::Vector3<float>&);
+template grabnum::VectorX<double, 4>
+HtfQuatTransposeMul<double>(const Quaternion&, const grabnum::Vector3<double>&);
+template Quaternionf QuatExp<float>(const Quaternionf&);
+template Quaternion QuatExp<double>(const Quaternion&);
+template Quaternionf QuatLog<float>(const Quaternionf&);
+template Quaternion QuatLog<double>(const Quaternion&);
+template Quaternionf QuatSlerp<float>(const Quaternionf&, const Quaternionf&,
+                                      const float);
+template Quaternion QuatSlerp<double>(const Quaternion&, const Quaternion&, const double);
+template Quaternionf QuatNlerp<float>(const Quaternionf&, const Quaternionf&,
+                                      const float);
+template Quaternion QuatNlerp<double>(const Quaternion&, const Quaternion&, const double);
+template Quaternionf QuatSquad<float>(const Quaternionf&, const Quaternionf&,
+                                      const Quaternionf&, const Quaternionf&,
+                                      const float);
+template Quaternion QuatSquad<double>(const Quaternion&, const Quaternion&,
+                                      const Quaternion&, const Quaternion&, const double);
+template Quaternionf QuatSquadControlPoint<float>(const Quaternionf&, const Quaternionf&,
+                                                  const Quaternionf&);
+template Quaternion QuatSquadControlPoint<double>(const Quaternion&, const Quaternion&,
+                                                  const Quaternion&);
+
 } // end namespace grabgeom
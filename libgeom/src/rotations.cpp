@@ -10,222 +10,421 @@
 namespace grabgeom
 {
 
-grabnum::Matrix3d RotX(const double angle)
+namespace {
+
+// A single Newton-Schulz iteration of Orthonormalize().
+template <typename T>
+grabnum::Matrix3<T> OrthonormalizeStep(const grabnum::Matrix3<T>& rot_mat)
 {
-  grabnum::Matrix3d rot(1.0);
-  rot(2, 2) = cos(angle);
+  static constexpr T kHalf = static_cast<T>(0.5);
+  // Symmetric correction (3 I - R^T R) / 2, from the dot products of the columns of R.
+  const T* r   = rot_mat.Data();
+  const T c_11 = 3 * kHalf - kHalf * (r[0] * r[0] + r[3] * r[3] + r[6] * r[6]);
+  const T c_22 = 3 * kHalf - kHalf * (r[1] * r[1] + r[4] * r[4] + r[7] * r[7]);
+  const T c_33 = 3 * kHalf - kHalf * (r[2] * r[2] + r[5] * r[5] + r[8] * r[8]);
+  const T c_12 = -kHalf * (r[0] * r[1] + r[3] * r[4] + r[6] * r[7]);
+  const T c_13 = -kHalf * (r[0] * r[2] + r[3] * r[5] + r[6] * r[8]);
+  const T c_23 = -kHalf * (r[1] * r[2] + r[4] * r[5] + r[7] * r[8]);
+  grabnum::Matrix3<T> corrected;
+  T* c = corrected.Data();
+  for (uint8_t i = 0; i < 9; i += 3)
+  {
+    c[i]     = r[i] * c_11 + r[i + 1] * c_12 + r[i + 2] * c_13;
+    c[i + 1] = r[i] * c_12 + r[i + 1] * c_22 + r[i + 2] * c_23;
+    c[i + 2] = r[i] * c_13 + r[i + 1] * c_23 + r[i + 2] * c_33;
+  }
+  return corrected;
+}
+
+} // end anonymous namespace
+
+template <typename T>
+grabnum::Matrix3<T> RotX(const T angle)
+{
+  grabnum::Matrix3<T> rot(1.0);
+  rot(2, 2) = std::cos(angle);
   rot(3, 3) = rot(2, 2);
-  rot(3, 2) = sin(angle);
+  rot(3, 2) = std::sin(angle);
   rot(2, 3) = -rot(3, 2);
   return rot;
 }
 
-grabnum::Matrix3d RotY(const double angle)
+template <typename T>
+grabnum::Matrix3<T> RotY(const T angle)
 {
-  grabnum::Matrix3d rot(1.0);
-  rot(1, 1) = cos(angle);
+  grabnum::Matrix3<T> rot(1.0);
+  rot(1, 1) = std::cos(angle);
   rot(3, 3) = rot(1, 1);
-  rot(1, 3) = sin(angle);
+  rot(1, 3) = std::sin(angle);
   rot(3, 1) = -rot(1, 3);
   return rot;
 }
 
-grabnum::Matrix3d RotZ(const double angle)
+template <typename T>
+grabnum::Matrix3<T> RotZ(const T angle)
 {
-  grabnum::Matrix3d rot(1.0);
-  rot(1, 1) = cos(angle);
+  grabnum::Matrix3<T> rot(1.0);
+  rot(1, 1) = std::cos(angle);
   rot(2, 2) = rot(1, 1);
-  rot(2, 1) = sin(angle);
+  rot(2, 1) = std::sin(angle);
   rot(1, 2) = -rot(2, 1);
   return rot;
 }
 
-grabnum::Matrix3d EulerXYZ2Rot(const double alpha, const double beta, const double gamma)
+template <typename T>
+grabnum::Matrix3<T> EulerXYZ2Rot(const T alpha, const T beta, const T gamma)
 {
-  grabnum::Matrix3d rot;
-  rot = RotX(alpha) * RotY(beta) * RotZ(gamma);
-  return rot;
+  return EulerXYZ2Rot(AnglesSinCos<T>(alpha, beta, gamma));
 }
 
-grabnum::Matrix3d RPY2Rot(const double roll, const double pitch, const double yaw)
+template <typename T>
+grabnum::Matrix3<T> RPY2Rot(const T roll, const T pitch, const T yaw)
 {
-  grabnum::Matrix3d rot;
-  rot = RotZ(yaw) * RotY(pitch) * RotX(roll);
-  return rot;
+  return RPY2Rot(AnglesSinCos<T>(roll, pitch, yaw));
 }
 
-grabnum::Matrix3d EulerZYZ2Rot(const double alpha, const double beta, const double gamma)
+template <typename T>
+grabnum::Matrix3<T> EulerZYZ2Rot(const T alpha, const T beta, const T gamma)
 {
-  grabnum::Matrix3d rot;
-  rot = RotZ(alpha) * RotY(beta) * RotZ(gamma);
-  return rot;
+  return EulerZYZ2Rot(AnglesSinCos<T>(alpha, beta, gamma));
 }
 
-grabnum::Matrix3d TiltTorsion2Rot(const double tilt_azimuth, const double tilt,
-                                  const double torsion)
+template <typename T>
+grabnum::Matrix3<T> TiltTorsion2Rot(const T tilt_azimuth, const T tilt, const T torsion)
 {
   return EulerZYZ2Rot(tilt_azimuth, tilt, torsion - tilt_azimuth);
 }
 
-grabnum::Vector3d Rot2EulerXYZ(const grabnum::Matrix3d& rot_mat)
+template <typename T>
+grabnum::Vector3<T> Rot2EulerXYZ(const grabnum::Matrix3<T>& rot_mat)
 {
-  grabnum::Vector3d angles;
-  angles(1) = atan2(-rot_mat(2, 3), rot_mat(3, 3));  // alpha
-  angles(2) = atan2(rot_mat(1, 3), sqrt(SQUARE(rot_mat(1, 1)) + SQUARE(rot_mat(1, 2))));  // beta
-  angles(3) = atan2(-rot_mat(1, 2), rot_mat(1, 1));  // gamma
+  grabnum::Vector3<T> angles;
+  angles(1) = std::atan2(-rot_mat(2, 3), rot_mat(3, 3));  // alpha
+  angles(2) = std::atan2(rot_mat(1, 3), // beta
+                         std::sqrt(SQUARE(rot_mat(1, 1)) + SQUARE(rot_mat(1, 2))));
+  angles(3) = std::atan2(-rot_mat(1, 2), rot_mat(1, 1));  // gamma
   return angles;
 }
 
-grabnum::Vector3d Rot2RPY(const grabnum::Matrix3d& rot_mat)
+template <typename T>
+grabnum::Vector3<T> Rot2RPY(const grabnum::Matrix3<T>& rot_mat)
 {
-  grabnum::Vector3d rpy;
-  rpy(1) = atan2(rot_mat(3, 2), rot_mat(3, 3)); // roll
-  rpy(2) =
-    atan2(-rot_mat(3, 1), sqrt(SQUARE(rot_mat(3, 2)) + SQUARE(rot_mat(3, 3)))); // pitch
-  rpy(3) = atan2(rot_mat(2, 1), rot_mat(1, 1));                                 // yaw
+  grabnum::Vector3<T> rpy;
+  rpy(1) = std::atan2(rot_mat(3, 2), rot_mat(3, 3)); // roll
+  rpy(2) = std::atan2(-rot_mat(3, 1),
+                      std::sqrt(SQUARE(rot_mat(3, 2)) + SQUARE(rot_mat(3, 3)))); // pitch
+  rpy(3) = std::atan2(rot_mat(2, 1), rot_mat(1, 1));                            // yaw
   return rpy;
 }
 
-grabnum::Vector3d Rot2EulerZYZ(const grabnum::Matrix3d& rot_mat)
+template <typename T>
+grabnum::Vector3<T> Rot2EulerZYZ(const grabnum::Matrix3<T>& rot_mat)
 {
-  grabnum::Vector3d angles;
-  angles(1) = atan2(rot_mat(2, 3), rot_mat(1, 3));  // alpha
-  angles(2) = atan2(sqrt(SQUARE(rot_mat(1, 3)) + SQUARE(rot_mat(2, 3))), rot_mat(3, 3)); // beta
-  angles(3) = atan2(rot_mat(3, 2), -rot_mat(3, 1)); // gamma
+  grabnum::Vector3<T> angles;
+  angles(1) = std::atan2(rot_mat(2, 3), rot_mat(1, 3));  // alpha
+  angles(2) = std::atan2(std::sqrt(SQUARE(rot_mat(1, 3)) + SQUARE(rot_mat(2, 3))), // beta
+                         rot_mat(3, 3));
+  angles(3) = std::atan2(rot_mat(3, 2), -rot_mat(3, 1)); // gamma
   return angles;
 }
 
-grabnum::Vector3d Rot2TiltTorsion(const grabnum::Matrix3d& rot_mat)
+template <typename T>
+grabnum::Vector3<T> Rot2TiltTorsion(const grabnum::Matrix3<T>& rot_mat)
 {
-  grabnum::Vector3d angles = Rot2EulerZYZ(rot_mat);
+  grabnum::Vector3<T> angles = Rot2EulerZYZ(rot_mat);
   angles(3) += angles(1); // tau
   return angles;
 }
 
-grabnum::Matrix3d HtfXYZ(const double alpha, const double beta)
+template <typename T>
+grabnum::Matrix3<T> Orthonormalize(const grabnum::Matrix3<T>& rot_mat,
+                                   const uint8_t iterations)
+{
+  if (iterations == 0)
+    return rot_mat;
+  grabnum::Matrix3<T> ortho_mat = OrthonormalizeStep(rot_mat);
+  for (uint8_t k = 1; k < iterations; ++k)
+    ortho_mat = OrthonormalizeStep(ortho_mat);
+  return ortho_mat;
+}
+
+template <typename T>
+grabnum::Matrix3<T> HtfXYZ(const T alpha, const T beta)
+{
+  return HtfXYZ(AnglesSinCos<T>(alpha, beta, 0));
+}
+
+template <typename T> grabnum::Matrix3<T> HtfRPY(const grabnum::Vector3<T>& rpy)
 {
-  grabnum::Matrix3d hmat(1.0);
-  double cos_beta = cos(beta);
-  hmat(1, 3) = sin(beta);
-  hmat(2, 2) = cos(alpha);
-  hmat(3, 2) = sin(alpha);
-  hmat(2, 3) = -hmat(3, 2) * cos_beta;
-  hmat(3, 3) = hmat(2, 2) * cos_beta;
+  return HtfRPY(AnglesSinCos<T>(0, rpy(2), rpy(3)));
+}
+
+template <typename T>
+grabnum::Matrix3<T> HtfZYZ(const T alpha, const T beta)
+{
+  return HtfZYZ(AnglesSinCos<T>(alpha, beta, 0));
+}
+
+template <typename T>
+grabnum::Matrix3<T> HtfTiltTorsion(const T tilt_azimuth, const T tilt)
+{
+  return HtfTiltTorsion(AnglesSinCos<T>(tilt_azimuth, tilt, 0));
+}
+
+template <typename T>
+grabnum::Matrix3<T> DHtfXYZ(const T alpha, const T beta, const T alpha_dot,
+                            const T beta_dot)
+{
+  return DHtfXYZ(AnglesSinCos<T>(alpha, beta, 0),
+                 grabnum::Vector3<T>({alpha_dot, beta_dot, 0}));
+}
+
+template <typename T>
+grabnum::Matrix3<T> DHtfRPY(const grabnum::Vector3<T>& rpy,
+                            const grabnum::Vector3<T>& rpy_dot)
+{
+  return DHtfRPY(AnglesSinCos<T>(0, rpy(2), rpy(3)), rpy_dot);
+}
+
+template <typename T>
+grabnum::Matrix3<T> DHtfZYZ(const T alpha, const T beta, const T alpha_dot,
+                            const T beta_dot)
+{
+  return DHtfZYZ(AnglesSinCos<T>(alpha, beta, 0),
+                 grabnum::Vector3<T>({alpha_dot, beta_dot, 0}));
+}
+
+template <typename T>
+grabnum::Matrix3<T> DHtfTiltTorsion(const T tilt_azimuth, const T tilt,
+                                    const T tilt_azimuth_dot, const T tilt_dot)
+{
+  return DHtfTiltTorsion(AnglesSinCos<T>(tilt_azimuth, tilt, 0),
+                         grabnum::Vector3<T>({tilt_azimuth_dot, tilt_dot, 0}));
+}
+
+//------ Builders from sines and cosines ---------------------------------------------//
+
+template <typename T> grabnum::Matrix3<T> EulerXYZ2Rot(const AnglesSinCos<T>& trig)
+{
+  // Closed form of RotX(alpha) * RotY(beta) * RotZ(gamma).
+  const T s2c3 = trig.s2 * trig.c3;
+  const T s2s3 = trig.s2 * trig.s3;
+  grabnum::Matrix3<T> rot;
+  rot(1, 1) = trig.c2 * trig.c3;
+  rot(1, 2) = -trig.c2 * trig.s3;
+  rot(1, 3) = trig.s2;
+  rot(2, 1) = trig.c1 * trig.s3 + trig.s1 * s2c3;
+  rot(2, 2) = trig.c1 * trig.c3 - trig.s1 * s2s3;
+  rot(2, 3) = -trig.s1 * trig.c2;
+  rot(3, 1) = trig.s1 * trig.s3 - trig.c1 * s2c3;
+  rot(3, 2) = trig.s1 * trig.c3 + trig.c1 * s2s3;
+  rot(3, 3) = trig.c1 * trig.c2;
+  return rot;
+}
+
+template <typename T> grabnum::Matrix3<T> RPY2Rot(const AnglesSinCos<T>& trig)
+{
+  // Closed form of RotZ(yaw) * RotY(pitch) * RotX(roll).
+  const T c3s2 = trig.c3 * trig.s2;
+  const T s3s2 = trig.s3 * trig.s2;
+  grabnum::Matrix3<T> rot;
+  rot(1, 1) = trig.c3 * trig.c2;
+  rot(1, 2) = c3s2 * trig.s1 - trig.s3 * trig.c1;
+  rot(1, 3) = c3s2 * trig.c1 + trig.s3 * trig.s1;
+  rot(2, 1) = trig.s3 * trig.c2;
+  rot(2, 2) = s3s2 * trig.s1 + trig.c3 * trig.c1;
+  rot(2, 3) = s3s2 * trig.c1 - trig.c3 * trig.s1;
+  rot(3, 1) = -trig.s2;
+  rot(3, 2) = trig.c2 * trig.s1;
+  rot(3, 3) = trig.c2 * trig.c1;
+  return rot;
+}
+
+template <typename T> grabnum::Matrix3<T> EulerZYZ2Rot(const AnglesSinCos<T>& trig)
+{
+  // Closed form of RotZ(alpha) * RotY(beta) * RotZ(gamma).
+  const T c2c3 = trig.c2 * trig.c3;
+  const T c2s3 = trig.c2 * trig.s3;
+  grabnum::Matrix3<T> rot;
+  rot(1, 1) = trig.c1 * c2c3 - trig.s1 * trig.s3;
+  rot(1, 2) = -trig.c1 * c2s3 - trig.s1 * trig.c3;
+  rot(1, 3) = trig.c1 * trig.s2;
+  rot(2, 1) = trig.s1 * c2c3 + trig.c1 * trig.s3;
+  rot(2, 2) = -trig.s1 * c2s3 + trig.c1 * trig.c3;
+  rot(2, 3) = trig.s1 * trig.s2;
+  rot(3, 1) = -trig.s2 * trig.c3;
+  rot(3, 2) = trig.s2 * trig.s3;
+  rot(3, 3) = trig.c2;
+  return rot;
+}
+
+template <typename T> grabnum::Matrix3<T> TiltTorsion2Rot(const AnglesSinCos<T>& trig)
+{
+  // Euler angles (phi, theta, tau - phi), with sin(tau - phi) and cos(tau - phi) from
+  // angle difference identities.
+  AnglesSinCos<T> euler_trig = trig;
+  euler_trig.s3              = trig.s3 * trig.c1 - trig.c3 * trig.s1;
+  euler_trig.c3              = trig.c3 * trig.c1 + trig.s3 * trig.s1;
+  return EulerZYZ2Rot(euler_trig);
+}
+
+template <typename T> grabnum::Matrix3<T> HtfXYZ(const AnglesSinCos<T>& trig)
+{
+  grabnum::Matrix3<T> hmat;
+  hmat(1, 1) = 1.0;
+  hmat(1, 3) = trig.s2;
+  hmat(2, 2) = trig.c1;
+  hmat(2, 3) = -trig.s1 * trig.c2;
+  hmat(3, 2) = trig.s1;
+  hmat(3, 3) = trig.c1 * trig.c2;
   return hmat;
 }
 
-grabnum::Matrix3d HtfRPY(const double roll, const double pitch)
+template <typename T> grabnum::Matrix3<T> HtfRPY(const AnglesSinCos<T>& trig)
 {
-  grabnum::Matrix3d hmat;
-  double c1 = cos(roll);
-  double s1 = sin(roll);
-  double c2 = cos(pitch);
-  hmat(1, 2) = -s1;
-  hmat(1, 3) = c1 * c2;
-  hmat(2, 2) = c1;
-  hmat(2, 3) = s1 * c2;
-  hmat(3, 1) = 1.0;
-  hmat(3, 3) = sin(pitch);
+  grabnum::Matrix3<T> hmat;
+  hmat(1, 1) = trig.c3 * trig.c2;
+  hmat(1, 2) = -trig.s3;
+  hmat(2, 1) = trig.s3 * trig.c2;
+  hmat(2, 2) = trig.c3;
+  hmat(3, 1) = -trig.s2;
+  hmat(3, 3) = 1.0;
   return hmat;
 }
 
-grabnum::Matrix3d HtfZYZ(const double alpha, const double beta)
+template <typename T> grabnum::Matrix3<T> HtfZYZ(const AnglesSinCos<T>& trig)
 {
-  grabnum::Matrix3d hmat;
-  double sin_beta = sin(beta);
-  hmat(1, 2) = -sin(alpha);
-  hmat(2, 2) = cos(alpha);
-  hmat(1, 3) = hmat(2, 2) * sin_beta;
-  hmat(2, 3) = -hmat(1, 2) * sin_beta;
+  grabnum::Matrix3<T> hmat;
+  hmat(1, 2) = -trig.s1;
+  hmat(1, 3) = trig.c1 * trig.s2;
+  hmat(2, 2) = trig.c1;
+  hmat(2, 3) = trig.s1 * trig.s2;
   hmat(3, 1) = 1.0;
-  hmat(3, 3) = cos(beta);
+  hmat(3, 3) = trig.c2;
   return hmat;
 }
 
-grabnum::Matrix3d HtfTiltTorsion(const double tilt_azimuth, const double tilt)
+template <typename T> grabnum::Matrix3<T> HtfTiltTorsion(const AnglesSinCos<T>& trig)
 {
-  grabnum::Matrix3d hmat;
-  double c1 = cos(tilt_azimuth);
-  double s1 = sin(tilt_azimuth);
-  double c2 = cos(tilt);
-  double s2 = sin(tilt);
-  hmat(1, 1) = -c1 * s2;
-  hmat(1, 2) = -s1;
+  grabnum::Matrix3<T> hmat;
+  hmat(1, 1) = -trig.c1 * trig.s2;
+  hmat(1, 2) = -trig.s1;
   hmat(1, 3) = -hmat(1, 1);
-  hmat(2, 1) = -s1 * s2;
-  hmat(2, 2) = c1;
+  hmat(2, 1) = -trig.s1 * trig.s2;
+  hmat(2, 2) = trig.c1;
   hmat(2, 3) = -hmat(2, 1);
-  hmat(3, 1) = 1.0 - c2;
-  hmat(3, 2) = 0.0;
-  hmat(3, 3) = c2;
+  hmat(3, 1) = 1 - trig.c2;
+  hmat(3, 3) = trig.c2;
   return hmat;
 }
 
-grabnum::Matrix3d DHtfXYZ(const double alpha, const double beta, const double alpha_dot,
-                          const double beta_dot)
+template <typename T>
+grabnum::Matrix3<T> DHtfXYZ(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& angles_dot)
 {
-  grabnum::Matrix3d hmat_dot;
-  double c1 = cos(alpha);
-  double s1 = sin(alpha);
-  double c2 = cos(beta);
-  double s2 = sin(beta);
-  hmat_dot(1, 3) = c2 * beta_dot;
-  hmat_dot(2, 2) = -s1 * alpha_dot;
-  hmat_dot(3, 2) = c1 * alpha_dot;
-  hmat_dot(2, 3) = -c1 * c2 * alpha_dot + s1 * s2 * beta_dot;
-  hmat_dot(3, 3) = -s1 * c2 * alpha_dot - c1 * s2 * beta_dot;
+  const T alpha_dot = angles_dot(1);
+  const T beta_dot  = angles_dot(2);
+  grabnum::Matrix3<T> hmat_dot;
+  hmat_dot(1, 3) = trig.c2 * beta_dot;
+  hmat_dot(2, 2) = -trig.s1 * alpha_dot;
+  hmat_dot(3, 2) = trig.c1 * alpha_dot;
+  hmat_dot(2, 3) = -trig.c1 * trig.c2 * alpha_dot + trig.s1 * trig.s2 * beta_dot;
+  hmat_dot(3, 3) = -trig.s1 * trig.c2 * alpha_dot - trig.c1 * trig.s2 * beta_dot;
   return hmat_dot;
 }
 
-grabnum::Matrix3d DHtfRPY(const double roll, const double pitch, const double roll_dot,
-                          const double pitch_dot)
+template <typename T>
+grabnum::Matrix3<T> DHtfRPY(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& rpy_dot)
 {
-  grabnum::Matrix3d hmat_dot;
-  double c1 = cos(roll);
-  double s1 = sin(roll);
-  double c2 = cos(pitch);
-  double s2 = sin(pitch);
-  hmat_dot(1, 2) = -c1 * roll_dot;
-  hmat_dot(1, 3) = -s1 * c2 * roll_dot - c1 * s2 * pitch_dot;
-  hmat_dot(2, 2) = -s1 * roll_dot;
-  hmat_dot(2, 3) = c1 * c2 * roll_dot - s1 * s2 * pitch_dot;
-  hmat_dot(3, 3) = -c2 * pitch_dot;
+  const T pitch_dot = rpy_dot(2);
+  const T yaw_dot   = rpy_dot(3);
+  grabnum::Matrix3<T> hmat_dot;
+  hmat_dot(1, 1) = -trig.s3 * trig.c2 * yaw_dot - trig.c3 * trig.s2 * pitch_dot;
+  hmat_dot(1, 2) = -trig.c3 * yaw_dot;
+  hmat_dot(2, 1) = trig.c3 * trig.c2 * yaw_dot - trig.s3 * trig.s2 * pitch_dot;
+  hmat_dot(2, 2) = -trig.s3 * yaw_dot;
+  hmat_dot(3, 1) = -trig.c2 * pitch_dot;
   return hmat_dot;
 }
 
-grabnum::Matrix3d DHtfZYZ(const double alpha, const double beta, const double alpha_dot,
-                          const double beta_dot)
+template <typename T>
+grabnum::Matrix3<T> DHtfZYZ(const AnglesSinCos<T>& trig,
+                            const grabnum::Vector3<T>& angles_dot)
 {
-  grabnum::Matrix3d hmat_dot;
-  double c1 = cos(alpha);
-  double s1 = sin(alpha);
-  double c2 = cos(beta);
-  double s2 = sin(beta);
-  hmat_dot(1, 2) = -c1 * alpha_dot;
-  hmat_dot(1, 3) = -s1 * s2 * alpha_dot + c1 * c2 * beta_dot;
-  hmat_dot(2, 2) = -s1 * alpha_dot;
-  hmat_dot(2, 3) = c1 * s2 * alpha_dot + s1 * s2 * beta_dot;
-  hmat_dot(3, 3) = -s2 * beta_dot;
+  const T alpha_dot = angles_dot(1);
+  const T beta_dot  = angles_dot(2);
+  grabnum::Matrix3<T> hmat_dot;
+  hmat_dot(1, 2) = -trig.c1 * alpha_dot;
+  hmat_dot(1, 3) = -trig.s1 * trig.s2 * alpha_dot + trig.c1 * trig.c2 * beta_dot;
+  hmat_dot(2, 2) = -trig.s1 * alpha_dot;
+  hmat_dot(2, 3) = trig.c1 * trig.s2 * alpha_dot + trig.s1 * trig.c2 * beta_dot;
+  hmat_dot(3, 3) = -trig.s2 * beta_dot;
   return hmat_dot;
 }
 
-grabnum::Matrix3d DHtfTiltTorsion(const double tilt_azimuth, const double tilt,
-                                  const double tilt_azimuth_dot, const double tilt_dot)
+template <typename T>
+grabnum::Matrix3<T> DHtfTiltTorsion(const AnglesSinCos<T>& trig,
+                                    const grabnum::Vector3<T>& angles_dot)
 {
-  grabnum::Matrix3d hmat_dot;
-  double c1 = cos(tilt_azimuth);
-  double s1 = sin(tilt_azimuth);
-  double c2 = cos(tilt);
-  double s2 = sin(tilt);
-  hmat_dot(1, 1) = s1 * s2 * tilt_azimuth_dot - c1 * c2 * tilt_dot;
-  hmat_dot(1, 2) = -c1 * tilt_azimuth_dot;
+  const T tilt_azimuth_dot = angles_dot(1);
+  const T tilt_dot         = angles_dot(2);
+  grabnum::Matrix3<T> hmat_dot;
+  hmat_dot(1, 1) = trig.s1 * trig.s2 * tilt_azimuth_dot - trig.c1 * trig.c2 * tilt_dot;
+  hmat_dot(1, 2) = -trig.c1 * tilt_azimuth_dot;
   hmat_dot(1, 3) = -hmat_dot(1, 1);
-  hmat_dot(2, 1) = -c1 * s2 * tilt_azimuth_dot - s1 * c2 * tilt_dot;
-  hmat_dot(2, 2) = -s1 * tilt_azimuth_dot;
+  hmat_dot(2, 1) = -trig.c1 * trig.s2 * tilt_azimuth_dot - trig.s1 * trig.c2 * tilt_dot;
+  hmat_dot(2, 2) = -trig.s1 * tilt_azimuth_dot;
   hmat_dot(2, 3) = -hmat_dot(2, 1);
-  hmat_dot(3, 1) = s2 * tilt_dot;
+  hmat_dot(3, 1) = trig.s2 * tilt_dot;
   hmat_dot(3, 3) = -hmat_dot(3, 1);
   return hmat_dot;
 }
 
+// Explicit instantiations.
+#define GRABGEOM_INSTANTIATE_ROTATIONS(T)                                                \
+  template grabnum::Matrix3<T> RotX<T>(const T);                                         \
+  template grabnum::Matrix3<T> RotY<T>(const T);                                         \
+  template grabnum::Matrix3<T> RotZ<T>(const T);                                         \
+  template grabnum::Matrix3<T> EulerXYZ2Rot<T>(const T, const T, const T);               \
+  template grabnum::Matrix3<T> RPY2Rot<T>(const T, const T, const T);                    \
+  template grabnum::Matrix3<T> EulerZYZ2Rot<T>(const T, const T, const T);               \
+  template grabnum::Matrix3<T> TiltTorsion2Rot<T>(const T, const T, const T);            \
+  template grabnum::Vector3<T> Rot2EulerXYZ<T>(const grabnum::Matrix3<T>&);              \
+  template grabnum::Vector3<T> Rot2RPY<T>(const grabnum::Matrix3<T>&);                   \
+  template grabnum::Vector3<T> Rot2EulerZYZ<T>(const grabnum::Matrix3<T>&);              \
+  template grabnum::Vector3<T> Rot2TiltTorsion<T>(const grabnum::Matrix3<T>&);           \
+  template grabnum::Matrix3<T> Orthonormalize<T>(const grabnum::Matrix3<T>&,             \
+                                                 const uint8_t);                         \
+  template grabnum::Matrix3<T> HtfXYZ<T>(const T, const T);                              \
+  template grabnum::Matrix3<T> HtfRPY<T>(const grabnum::Vector3<T>&);                    \
+  template grabnum::Matrix3<T> HtfZYZ<T>(const T, const T);                              \
+  template grabnum::Matrix3<T> HtfTiltTorsion<T>(const T, const T);                      \
+  template grabnum::Matrix3<T> DHtfXYZ<T>(const T, const T, const T, const T);           \
+  template grabnum::Matrix3<T> DHtfRPY<T>(const grabnum::Vector3<T>&,                    \
+                                          const grabnum::Vector3<T>&);                   \
+  template grabnum::Matrix3<T> DHtfZYZ<T>(const T, const T, const T, const T);           \
+  template grabnum::Matrix3<T> DHtfTiltTorsion<T>(const T, const T, const T, const T);   \
+  template grabnum::Matrix3<T> EulerXYZ2Rot<T>(const AnglesSinCos<T>&);                  \
+  template grabnum::Matrix3<T> RPY2Rot<T>(const AnglesSinCos<T>&);                       \
+  template grabnum::Matrix3<T> EulerZYZ2Rot<T>(const AnglesSinCos<T>&);                  \
+  template grabnum::Matrix3<T> TiltTorsion2Rot<T>(const AnglesSinCos<T>&);               \
+  template grabnum::Matrix3<T> HtfXYZ<T>(const AnglesSinCos<T>&);                        \
+  template grabnum::Matrix3<T> HtfRPY<T>(const AnglesSinCos<T>&);                        \
+  template grabnum::Matrix3<T> HtfZYZ<T>(const AnglesSinCos<T>&);                        \
+  template grabnum::Matrix3<T> HtfTiltTorsion<T>(const AnglesSinCos<T>&);                \
+  template grabnum::Matrix3<T> DHtfXYZ<T>(const AnglesSinCos<T>&,                        \
+                                          const grabnum::Vector3<T>&);                   \
+  template grabnum::Matrix3<T> DHtfRPY<T>(const AnglesSinCos<T>&,                        \
+                                          const grabnum::Vector3<T>&);                   \
+  template grabnum::Matrix3<T> DHtfZYZ<T>(const AnglesSinCos<T>&,                        \
+                                          const grabnum::Vector3<T>&);                   \
+  template grabnum::Matrix3<T> DHtfTiltTorsion<T>(const AnglesSinCos<T>&,                \
+                                                  const grabnum::Vector3<T>&);
+
+GRABGEOM_INSTANTIATE_ROTATIONS(float)
+GRABGEOM_INSTANTIATE_ROTATIONS(double)
+
+#undef GRABGEOM_INSTANTIATE_ROTATIONS
+
 } // end namespace grabgeom
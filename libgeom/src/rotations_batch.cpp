@@ -0,0 +1,530 @@
+/**
+ * @file rotations_batch.cpp
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions of rotations_batch.h.
+ */
+
+#include "rotations_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "simd.h"
+
+namespace grabgeom
+{
+namespace batch
+{
+
+namespace
+{
+
+// Samples converted at once, so that intermediate results stay in L1 cache.
+constexpr uint32_t kBlockSize = 256;
+// Below this number of samples per thread, starting a thread costs more than it saves.
+constexpr uint32_t kMinSamplesPerThread = 16384;
+
+// Offset of the (row, col) element of a rotation matrix in a structure of arrays.
+inline uint32_t RotOffset(const uint8_t row, const uint8_t col, const uint32_t stride)
+{
+  return (3 * (row - 1) + col - 1) * stride;
+}
+
+// Sines and cosines of the 3 angles of a block of samples, scaled by a given factor.
+template <typename T> struct BlockSinCos
+{
+  T sin[3][kBlockSize];
+  T cos[3][kBlockSize];
+
+  BlockSinCos(const T* angles, const uint32_t stride, const uint32_t count,
+              const T scale = 1)
+  {
+    T scaled[kBlockSize];
+    for (uint8_t k = 0; k < 3; ++k)
+    {
+      const T* src = angles + k * stride;
+      if (scale != 1)
+      {
+        for (uint32_t i = 0; i < count; ++i)
+          scaled[i] = scale * src[i];
+        src = scaled;
+      }
+      grabnum::simd::SinCos(src, sin[k], cos[k], count);
+    }
+  }
+};
+
+// Angle spanned by the arc between two unit quaternions, see grabgeom::QuatSlerp().
+template <typename T>
+T ArcAngle(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end)
+{
+  const BasicQuaternion<T> diff = end - start;
+  const BasicQuaternion<T> sum  = end + start;
+  return 2 * std::atan2(std::sqrt(QuatDot(diff, diff)), std::sqrt(QuatDot(sum, sum)));
+}
+
+// Weights of the spherical interpolation at the given parameters, between unit
+// quaternions spanning the given angles, i.e. sin((1 - t) angle) / sin(angle) and
+// sin(t angle) / sin(angle).
+template <typename T>
+void SlerpWeights(const T* angles, const T* params, T* start_weights, T* end_weights,
+                  const uint32_t count)
+{
+  // Output buffers hold the arguments of the sines first.
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    start_weights[i] = (1 - params[i]) * angles[i];
+    end_weights[i]   = params[i] * angles[i];
+  }
+  T sin_angles[kBlockSize], start_sin[kBlockSize], end_sin[kBlockSize];
+  T unused_cos[kBlockSize];
+  grabnum::simd::SinCos(angles, sin_angles, unused_cos, count);
+  grabnum::simd::SinCos(start_weights, start_sin, unused_cos, count);
+  grabnum::simd::SinCos(end_weights, end_sin, unused_cos, count);
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    if (angles[i] < std::numeric_limits<T>::epsilon())
+    {
+      start_weights[i] = 1 - params[i];
+      end_weights[i]   = params[i];
+      continue;
+    }
+    start_weights[i] = start_sin[i] / sin_angles[i];
+    end_weights[i]   = end_sin[i] / sin_angles[i];
+  }
+}
+
+// Writes the weighted sums of two fixed quaternions in a block of a structure of arrays.
+template <typename T>
+void Blend(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end,
+           const T* start_weights, const T* end_weights, T* const quat[4],
+           const uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    quat[0][i] = start_weights[i] * start.w + end_weights[i] * end.w;
+    quat[1][i] = start_weights[i] * start.x + end_weights[i] * end.x;
+    quat[2][i] = start_weights[i] * start.y + end_weights[i] * end.y;
+    quat[3][i] = start_weights[i] * start.z + end_weights[i] * end.z;
+  }
+}
+
+} // end anonymous namespace
+
+template <typename T>
+void EulerXYZ2Rot(const T* angles, T* rot_mats, const uint32_t size,
+                  const uint32_t stride)
+{
+  T* r[9];
+  for (uint8_t k = 0; k < 9; ++k)
+    r[k] = rot_mats + k * stride;
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    const BlockSinCos<T> trig(angles + begin, stride, count);
+    // Same closed form of grabgeom::EulerXYZ2Rot(const AnglesSinCos<T>&).
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const T s1 = trig.sin[0][i], c1 = trig.cos[0][i];
+      const T s2 = trig.sin[1][i], c2 = trig.cos[1][i];
+      const T s3 = trig.sin[2][i], c3 = trig.cos[2][i];
+      const uint32_t j = begin + i;
+      r[0][j]          = c2 * c3;
+      r[1][j]          = -c2 * s3;
+      r[2][j]          = s2;
+      r[3][j]          = c1 * s3 + s1 * s2 * c3;
+      r[4][j]          = c1 * c3 - s1 * s2 * s3;
+      r[5][j]          = -s1 * c2;
+      r[6][j]          = s1 * s3 - c1 * s2 * c3;
+      r[7][j]          = s1 * c3 + c1 * s2 * s3;
+      r[8][j]          = c1 * c2;
+    }
+  }
+}
+
+template <typename T>
+void RPY2Rot(const T* rpy, T* rot_mats, const uint32_t size, const uint32_t stride)
+{
+  T* r[9];
+  for (uint8_t k = 0; k < 9; ++k)
+    r[k] = rot_mats + k * stride;
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    const BlockSinCos<T> trig(rpy + begin, stride, count);
+    // Same closed form of grabgeom::RPY2Rot(const AnglesSinCos<T>&).
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const T s1 = trig.sin[0][i], c1 = trig.cos[0][i];
+      const T s2 = trig.sin[1][i], c2 = trig.cos[1][i];
+      const T s3 = trig.sin[2][i], c3 = trig.cos[2][i];
+      const uint32_t j = begin + i;
+      r[0][j]          = c3 * c2;
+      r[1][j]          = c3 * s2 * s1 - s3 * c1;
+      r[2][j]          = c3 * s2 * c1 + s3 * s1;
+      r[3][j]          = s3 * c2;
+      r[4][j]          = s3 * s2 * s1 + c3 * c1;
+      r[5][j]          = s3 * s2 * c1 - c3 * s1;
+      r[6][j]          = -s2;
+      r[7][j]          = c2 * s1;
+      r[8][j]          = c2 * c1;
+    }
+  }
+}
+
+template <typename T>
+void RPY2Quat(const T* rpy, T* quaternions, const uint32_t size, const uint32_t stride)
+{
+  T* q[4];
+  for (uint8_t k = 0; k < 4; ++k)
+    q[k] = quaternions + k * stride;
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    const BlockSinCos<T> trig(rpy + begin, stride, count, static_cast<T>(0.5));
+    // Product of the elementary rotations q_z(yaw) * q_y(pitch) * q_x(roll).
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const T s1 = trig.sin[0][i], c1 = trig.cos[0][i];
+      const T s2 = trig.sin[1][i], c2 = trig.cos[1][i];
+      const T s3 = trig.sin[2][i], c3 = trig.cos[2][i];
+      const T w    = c1 * c2 * c3 + s1 * s2 * s3;
+      const T sign = w < 0 ? -1 : 1;
+      const uint32_t j = begin + i;
+      q[0][j]          = sign * w;
+      q[1][j]          = sign * (s1 * c2 * c3 - c1 * s2 * s3);
+      q[2][j]          = sign * (c1 * s2 * c3 + s1 * c2 * s3);
+      q[3][j]          = sign * (c1 * c2 * s3 - s1 * s2 * c3);
+    }
+  }
+}
+
+template <typename T>
+void Quat2Rot(const T* quaternions, T* rot_mats, const uint32_t size,
+              const uint32_t stride)
+{
+  const T* qw = quaternions;
+  const T* qx = quaternions + stride;
+  const T* qy = quaternions + 2 * stride;
+  const T* qz = quaternions + 3 * stride;
+  T* r[9];
+  for (uint8_t k = 0; k < 9; ++k)
+    r[k] = rot_mats + k * stride;
+  // No trigonometric function here: a plain loop is vectorized by the compiler.
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    const T w = qw[i], x = qx[i], y = qy[i], z = qz[i];
+    r[0][i]   = w * w + x * x - y * y - z * z;
+    r[1][i]   = 2 * (x * y - w * z);
+    r[2][i]   = 2 * (x * z + w * y);
+    r[3][i]   = 2 * (x * y + w * z);
+    r[4][i]   = w * w - x * x + y * y - z * z;
+    r[5][i]   = 2 * (y * z - w * x);
+    r[6][i]   = 2 * (x * z - w * y);
+    r[7][i]   = 2 * (y * z + w * x);
+    r[8][i]   = w * w - x * x - y * y + z * z;
+  }
+}
+
+template <typename T>
+void Quat2RPY(const T* quaternions, T* rpy, const uint32_t size, const uint32_t stride)
+{
+  const T* qw = quaternions;
+  const T* qx = quaternions + stride;
+  const T* qy = quaternions + 2 * stride;
+  const T* qz = quaternions + 3 * stride;
+  T r11[kBlockSize], r21[kBlockSize], minus_r31[kBlockSize];
+  T r32[kBlockSize], r33[kBlockSize], hypot[kBlockSize];
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const uint32_t j = begin + i;
+      const T w = qw[j], x = qx[j], y = qy[j], z = qz[j];
+      r11[i]       = w * w + x * x - y * y - z * z;
+      r21[i]       = 2 * (x * y + w * z);
+      minus_r31[i] = 2 * (w * y - x * z);
+      r32[i]       = 2 * (y * z + w * x);
+      r33[i]       = w * w - x * x - y * y + z * z;
+      hypot[i]     = std::sqrt(r32[i] * r32[i] + r33[i] * r33[i]);
+    }
+    grabnum::simd::Atan2(r32, r33, rpy + begin, count);
+    grabnum::simd::Atan2(minus_r31, hypot, rpy + stride + begin, count);
+    grabnum::simd::Atan2(r21, r11, rpy + 2 * stride + begin, count);
+  }
+}
+
+template <typename T>
+void Rot2EulerXYZ(const T* rot_mats, T* angles, const uint32_t size,
+                  const uint32_t stride)
+{
+  const T* r11 = rot_mats + RotOffset(1, 1, stride);
+  const T* r12 = rot_mats + RotOffset(1, 2, stride);
+  const T* r13 = rot_mats + RotOffset(1, 3, stride);
+  const T* r23 = rot_mats + RotOffset(2, 3, stride);
+  const T* r33 = rot_mats + RotOffset(3, 3, stride);
+  T minus_r[kBlockSize], hypot[kBlockSize];
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    for (uint32_t i = 0; i < count; ++i)
+      minus_r[i] = -r23[begin + i];
+    grabnum::simd::Atan2(minus_r, r33 + begin, angles + begin, count); // alpha
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const uint32_t j = begin + i;
+      hypot[i]         = std::sqrt(r11[j] * r11[j] + r12[j] * r12[j]);
+    }
+    grabnum::simd::Atan2(r13 + begin, hypot, angles + stride + begin, count); // beta
+    for (uint32_t i = 0; i < count; ++i)
+      minus_r[i] = -r12[begin + i];
+    grabnum::simd::Atan2(minus_r, r11 + begin, angles + 2 * stride + begin,
+                         count); // gamma
+  }
+}
+
+template <typename T>
+void Rot2RPY(const T* rot_mats, T* rpy, const uint32_t size, const uint32_t stride)
+{
+  const T* r11 = rot_mats + RotOffset(1, 1, stride);
+  const T* r21 = rot_mats + RotOffset(2, 1, stride);
+  const T* r31 = rot_mats + RotOffset(3, 1, stride);
+  const T* r32 = rot_mats + RotOffset(3, 2, stride);
+  const T* r33 = rot_mats + RotOffset(3, 3, stride);
+  T minus_r31[kBlockSize], hypot[kBlockSize];
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const uint32_t j = begin + i;
+      minus_r31[i]     = -r31[j];
+      hypot[i]         = std::sqrt(r32[j] * r32[j] + r33[j] * r33[j]);
+    }
+    grabnum::simd::Atan2(r32 + begin, r33 + begin, rpy + begin, count);  // roll
+    grabnum::simd::Atan2(minus_r31, hypot, rpy + stride + begin, count); // pitch
+    grabnum::simd::Atan2(r21 + begin, r11 + begin, rpy + 2 * stride + begin,
+                         count); // yaw
+  }
+}
+
+template <typename T>
+void QuatRotate(const BasicQuaternion<T>& quat, const T* vects, T* rotated,
+                const uint32_t size, const uint32_t stride)
+{
+  assert(quat.IsUnitary());
+
+  const T* x_in = vects;
+  const T* y_in = vects + stride;
+  const T* z_in = vects + 2 * stride;
+  T* x_out      = rotated;
+  T* y_out      = rotated + stride;
+  T* z_out      = rotated + 2 * stride;
+  // Same expansion of grabgeom::QuatRotate(), vectorized by the compiler.
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    const T x  = x_in[i], y = y_in[i], z = z_in[i];
+    const T tx = 2 * (quat.y * z - quat.z * y);
+    const T ty = 2 * (quat.z * x - quat.x * z);
+    const T tz = 2 * (quat.x * y - quat.y * x);
+    x_out[i]   = x + quat.w * tx + quat.y * tz - quat.z * ty;
+    y_out[i]   = y + quat.w * ty + quat.z * tx - quat.x * tz;
+    z_out[i]   = z + quat.w * tz + quat.x * ty - quat.y * tx;
+  }
+}
+
+template <typename T>
+void Rotate(const grabnum::Matrix3<T>& rot_mat, const T* vects, T* rotated,
+            const uint32_t size, const uint32_t stride)
+{
+  const T* r    = rot_mat.Data();
+  const T* x_in = vects;
+  const T* y_in = vects + stride;
+  const T* z_in = vects + 2 * stride;
+  T* x_out      = rotated;
+  T* y_out      = rotated + stride;
+  T* z_out      = rotated + 2 * stride;
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    const T x = x_in[i], y = y_in[i], z = z_in[i];
+    x_out[i]  = r[0] * x + r[1] * y + r[2] * z;
+    y_out[i]  = r[3] * x + r[4] * y + r[5] * z;
+    z_out[i]  = r[6] * x + r[7] * y + r[8] * z;
+  }
+}
+
+template <typename T>
+void QuatSlerp(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  const BasicQuaternion<T> arc_end = QuatDot(start, end) < 0 ? -end : end;
+  T angles[kBlockSize];
+  std::fill(angles, angles + kBlockSize, ArcAngle(start, arc_end));
+  T start_weights[kBlockSize], end_weights[kBlockSize];
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    T* const quat[4]     = {quaternions + begin, quaternions + stride + begin,
+                            quaternions + 2 * stride + begin,
+                            quaternions + 3 * stride + begin};
+    SlerpWeights(angles, params + begin, start_weights, end_weights, count);
+    Blend(start, arc_end, start_weights, end_weights, quat, count);
+  }
+}
+
+template <typename T>
+void QuatNlerp(const BasicQuaternion<T>& start, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  const BasicQuaternion<T> arc_end = QuatDot(start, end) < 0 ? -end : end;
+  const BasicQuaternion<T> delta   = arc_end - start;
+  T* qw = quaternions;
+  T* qx = quaternions + stride;
+  T* qy = quaternions + 2 * stride;
+  T* qz = quaternions + 3 * stride;
+  // Square roots are vectorized by the compiler, so there is no gain in the rational
+  // approximation of grabgeom::QuatNlerp() here.
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    const T w = start.w + params[i] * delta.w;
+    const T x = start.x + params[i] * delta.x;
+    const T y = start.y + params[i] * delta.y;
+    const T z = start.z + params[i] * delta.z;
+    const T inv_norm = 1 / std::sqrt(w * w + x * x + y * y + z * z);
+    qw[i]            = w * inv_norm;
+    qx[i]            = x * inv_norm;
+    qy[i]            = y * inv_norm;
+    qz[i]            = z * inv_norm;
+  }
+}
+
+template <typename T>
+void QuatSquad(const BasicQuaternion<T>& start, const BasicQuaternion<T>& start_ctrl,
+               const BasicQuaternion<T>& end_ctrl, const BasicQuaternion<T>& end,
+               const T* params, T* quaternions, const uint32_t size,
+               const uint32_t stride)
+{
+  assert(start.IsUnitary() && end.IsUnitary());
+
+  const T keys_angle  = ArcAngle(start, end);
+  const T ctrls_angle = ArcAngle(start_ctrl, end_ctrl);
+  T keys[4][kBlockSize], ctrls[4][kBlockSize];
+  T* const keys_quat[4]  = {keys[0], keys[1], keys[2], keys[3]};
+  T* const ctrls_quat[4] = {ctrls[0], ctrls[1], ctrls[2], ctrls[3]};
+  T angles[kBlockSize], squad_params[kBlockSize], chords[kBlockSize];
+  T start_weights[kBlockSize], end_weights[kBlockSize];
+  for (uint32_t begin = 0; begin < size; begin += kBlockSize)
+  {
+    const uint32_t count = std::min(kBlockSize, size - begin);
+    // Slerps between keyframes and between control points, along the same parameters.
+    std::fill(angles, angles + count, keys_angle);
+    SlerpWeights(angles, params + begin, start_weights, end_weights, count);
+    Blend(start, end, start_weights, end_weights, keys_quat, count);
+    std::fill(angles, angles + count, ctrls_angle);
+    SlerpWeights(angles, params + begin, start_weights, end_weights, count);
+    Blend(start_ctrl, end_ctrl, start_weights, end_weights, ctrls_quat, count);
+
+    // Slerps between the two, which span a different angle at each sample.
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      T diff_norm = 0;
+      T sum_norm  = 0;
+      for (uint8_t k = 0; k < 4; ++k)
+      {
+        diff_norm += SQUARE(ctrls[k][i] - keys[k][i]);
+        sum_norm += SQUARE(ctrls[k][i] + keys[k][i]);
+      }
+      chords[i]       = std::sqrt(diff_norm);
+      angles[i]       = std::sqrt(sum_norm);
+      squad_params[i] = 2 * params[begin + i] * (1 - params[begin + i]);
+    }
+    grabnum::simd::Atan2(chords, angles, angles, count);
+    for (uint32_t i = 0; i < count; ++i)
+      angles[i] *= 2;
+    SlerpWeights(angles, squad_params, start_weights, end_weights, count);
+    for (uint8_t k = 0; k < 4; ++k)
+    {
+      T* quat = quaternions + k * stride + begin;
+      for (uint32_t i = 0; i < count; ++i)
+        quat[i] = start_weights[i] * keys[k][i] + end_weights[i] * ctrls[k][i];
+    }
+  }
+}
+
+template <typename T>
+void ParallelConvert(Conversion<T> conversion, const T* src, T* dst,
+                     const uint32_t size, const uint32_t stride, const uint8_t threads)
+{
+  uint32_t threads_num = threads > 0 ? threads : std::thread::hardware_concurrency();
+  threads_num          = std::min(threads_num, size / kMinSamplesPerThread);
+  if (threads_num <= 1)
+  {
+    conversion(src, dst, size, stride);
+    return;
+  }
+
+  // Chunks are made of whole cache lines, so that threads never write on the same one.
+  static constexpr uint32_t kLineSize = 64 / sizeof(T);
+  const uint32_t chunk_size =
+    ((size + threads_num - 1) / threads_num + kLineSize - 1) / kLineSize * kLineSize;
+  std::vector<std::thread> workers;
+  workers.reserve(threads_num - 1);
+  uint32_t begin = 0;
+  for (; begin + chunk_size < size; begin += chunk_size)
+  {
+    try
+    {
+      workers.emplace_back(conversion, src + begin, dst + begin, chunk_size, stride);
+    }
+    catch (const std::system_error&)
+    {
+      break; // no more threads available: the rest is converted by the calling one
+    }
+  }
+  conversion(src + begin, dst + begin, size - begin, stride);
+  for (std::thread& worker : workers)
+    worker.join();
+}
+
+// Explicit instantiations.
+#define GRABGEOM_INSTANTIATE_ROTATIONS_BATCH(T)                                          \
+  template void EulerXYZ2Rot<T>(const T*, T*, const uint32_t, const uint32_t);           \
+  template void RPY2Rot<T>(const T*, T*, const uint32_t, const uint32_t);                \
+  template void RPY2Quat<T>(const T*, T*, const uint32_t, const uint32_t);               \
+  template void Quat2Rot<T>(const T*, T*, const uint32_t, const uint32_t);               \
+  template void Quat2RPY<T>(const T*, T*, const uint32_t, const uint32_t);               \
+  template void Rot2EulerXYZ<T>(const T*, T*, const uint32_t, const uint32_t);           \
+  template void Rot2RPY<T>(const T*, T*, const uint32_t, const uint32_t);                \
+  template void QuatRotate<T>(const BasicQuaternion<T>&, const T*, T*, const uint32_t,   \
+                              const uint32_t);                                           \
+  template void Rotate<T>(const grabnum::Matrix3<T>&, const T*, T*, const uint32_t,      \
+                          const uint32_t);                                               \
+  template void QuatSlerp<T>(const BasicQuaternion<T>&, const BasicQuaternion<T>&,       \
+                             const T*, T*, const uint32_t, const uint32_t);              \
+  template void QuatNlerp<T>(const BasicQuaternion<T>&, const BasicQuaternion<T>&,       \
+                             const T*, T*, const uint32_t, const uint32_t);              \
+  template void QuatSquad<T>(const BasicQuaternion<T>&, const BasicQuaternion<T>&,       \
+                             const BasicQuaternion<T>&, const BasicQuaternion<T>&,       \
+                             const T*, T*, const uint32_t, const uint32_t);              \
+  template void ParallelConvert<T>(Conversion<T>, const T*, T*, const uint32_t,          \
+                                   const uint32_t, const uint8_t);
+
+GRABGEOM_INSTANTIATE_ROTATIONS_BATCH(float)
+GRABGEOM_INSTANTIATE_ROTATIONS_BATCH(double)
+
+#undef GRABGEOM_INSTANTIATE_ROTATIONS_BATCH
+
+} // end namespace batch
+} // end namespace grabgeom
@@ -1,20 +1,476 @@
 #include <QString>
 #include <QtTest>
 
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
 #include "rotations.h"
 #include "quaternions.h"
+#include "rotations_batch.h"
+
+namespace {
+
+/**
+ * @brief Central finite difference of a matrix function of three angles along the
+ * direction of their derivatives.
+ */
+template <class MatFun>
+grabnum::Matrix3d CentralDiff(const MatFun& fun, const grabnum::Vector3d& angles,
+                              const grabnum::Vector3d& angles_dot)
+{
+  static constexpr double kStep = 1e-6;
+  const grabnum::Matrix3d fwd   = fun(angles + kStep * angles_dot);
+  const grabnum::Matrix3d bwd   = fun(angles - kStep * angles_dot);
+  return (fwd - bwd) / (2.0 * kStep);
+}
+
+/**
+ * @brief Angular velocity as the axial vector of @f$\dot{\mathbf{R}}\mathbf{R}^T@f$,
+ * with @f$\dot{\mathbf{R}}@f$ given by finite differences.
+ */
+template <class RotFun>
+grabnum::Vector3d FiniteDiffAngularVel(const RotFun& rot, const grabnum::Vector3d& angles,
+                                       const grabnum::Vector3d& angles_dot)
+{
+  const grabnum::Matrix3d skew =
+    CentralDiff(rot, angles, angles_dot) * rot(angles).Transpose();
+  return grabnum::Vector3d({skew(3, 2), skew(1, 3), skew(2, 1)});
+}
+
+/**
+ * @brief Copies the components of the k-th sample of a structure-of-arrays buffer into a
+ * matrix, in row-major order.
+ */
+template <uint8_t rows, uint8_t cols>
+grabnum::Matrix<double, rows, cols> Gather(const std::vector<double>& buffer,
+                                           const uint32_t stride, const uint32_t k)
+{
+  grabnum::Matrix<double, rows, cols> sample;
+  for (uint8_t i = 0; i < rows * cols; ++i)
+    sample.Data()[i] = buffer[i * stride + k];
+  return sample;
+}
+
+/**
+ * @brief Copies a matrix into the k-th sample of a structure-of-arrays buffer, in
+ * row-major order.
+ */
+template <uint8_t rows, uint8_t cols>
+void Scatter(const grabnum::Matrix<double, rows, cols>& sample, const uint32_t stride,
+             const uint32_t k, std::vector<double>* buffer)
+{
+  for (uint8_t i = 0; i < rows * cols; ++i)
+    (*buffer)[i * stride + k] = sample.Data()[i];
+}
+
+/**
+ * @brief Checks whether two quaternions represent the same orientation.
+ */
+bool IsSameOrientation(const grabgeom::Quaternion& lhs, const grabgeom::Quaternion& rhs,
+                       const double tol)
+{
+  return lhs.IsApprox(rhs, tol) || lhs.IsApprox(-rhs, tol);
+}
+
+} // end anonymous namespace
 
+/**
+ * @brief The LibgeomTest class
+ */
 class LibgeomTest : public QObject
 {
   Q_OBJECT
 
 private Q_SLOTS:
-  void testCase1();
+  /**
+   * @brief Checks closed form rotation matrices against products of elementary
+   * rotations and their transformation matrices against finite differences.
+   */
+  void testAnglesSinCos();
+
+  /**
+   * @brief Checks batch conversions against their scalar counterparts.
+   */
+  void testBatchConversions();
+
+  /**
+   * @brief Checks quaternion comparisons, products and inverses.
+   */
+  void testQuaternionAlgebra();
+
+  /**
+   * @brief Checks quaternion interpolations and their batch versions.
+   */
+  void testQuaternionInterpolation();
+
+  /**
+   * @brief Checks quaternion products against the matrices they replace.
+   */
+  void testQuaternionProducts();
+
+  /**
+   * @brief Checks conversions from rotation matrices to quaternions and the correction
+   * of drifting rotation matrices.
+   */
+  void testRot2Quat();
 };
 
-void LibgeomTest::testCase1()
+void LibgeomTest::testAnglesSinCos()
+{
+  const grabnum::Vector3d angles({0.3, -1.1, 2.4});
+  const grabnum::Vector3d angles_dot({-0.7, 0.4, 1.3});
+  const grabgeom::AnglesSinCos<double> trig(angles);
+  const double a = angles(1);
+  const double b = angles(2);
+  const double c = angles(3);
+
+  // Tait-Bryan angles
+  const auto rot_xyz = [](const grabnum::Vector3d& x) {
+    return grabgeom::EulerXYZ2Rot(x);
+  };
+  grabnum::Matrix3d rot_mat = grabgeom::RotX(a) * grabgeom::RotY(b) * grabgeom::RotZ(c);
+  QVERIFY(grabgeom::EulerXYZ2Rot(trig).IsApprox(rot_mat, 1e-12));
+  QVERIFY(grabgeom::EulerXYZ2Rot(a, b, c).IsApprox(rot_mat, 1e-12));
+  grabnum::Vector3d omega = grabgeom::HtfXYZ(trig) * angles_dot;
+  QVERIFY(omega.IsApprox(FiniteDiffAngularVel(rot_xyz, angles, angles_dot), 1e-8));
+  QVERIFY(grabgeom::DHtfXYZ(trig, angles_dot)
+            .IsApprox(CentralDiff([](const grabnum::Vector3d& x) {
+                        return grabgeom::HtfXYZ(x);
+                      }, angles, angles_dot), 1e-8));
+
+  // Roll, pitch, yaw angles
+  const auto rot_rpy = [](const grabnum::Vector3d& x) { return grabgeom::RPY2Rot(x); };
+  rot_mat = grabgeom::RotZ(c) * grabgeom::RotY(b) * grabgeom::RotX(a);
+  QVERIFY(grabgeom::RPY2Rot(trig).IsApprox(rot_mat, 1e-12));
+  QVERIFY(grabgeom::RPY2Rot(a, b, c).IsApprox(rot_mat, 1e-12));
+  omega = grabgeom::HtfRPY(trig) * angles_dot;
+  QVERIFY(omega.IsApprox(FiniteDiffAngularVel(rot_rpy, angles, angles_dot), 1e-8));
+  QVERIFY(grabgeom::DHtfRPY(trig, angles_dot)
+            .IsApprox(CentralDiff([](const grabnum::Vector3d& x) {
+                        return grabgeom::HtfRPY(x);
+                      }, angles, angles_dot), 1e-8));
+
+  // Euler angles
+  const auto rot_zyz = [](const grabnum::Vector3d& x) {
+    return grabgeom::EulerZYZ2Rot(x);
+  };
+  rot_mat = grabgeom::RotZ(a) * grabgeom::RotY(b) * grabgeom::RotZ(c);
+  QVERIFY(grabgeom::EulerZYZ2Rot(trig).IsApprox(rot_mat, 1e-12));
+  QVERIFY(grabgeom::EulerZYZ2Rot(a, b, c).IsApprox(rot_mat, 1e-12));
+  omega = grabgeom::HtfZYZ(trig) * angles_dot;
+  QVERIFY(omega.IsApprox(FiniteDiffAngularVel(rot_zyz, angles, angles_dot), 1e-8));
+  QVERIFY(grabgeom::DHtfZYZ(trig, angles_dot)
+            .IsApprox(CentralDiff([](const grabnum::Vector3d& x) {
+                        return grabgeom::HtfZYZ(x);
+                      }, angles, angles_dot), 1e-8));
+
+  // Tilt-and-torsion angles
+  const auto rot_tt = [](const grabnum::Vector3d& x) {
+    return grabgeom::TiltTorsion2Rot(x);
+  };
+  rot_mat = grabgeom::RotZ(a) * grabgeom::RotY(b) * grabgeom::RotZ(c - a);
+  QVERIFY(grabgeom::TiltTorsion2Rot(trig).IsApprox(rot_mat, 1e-12));
+  QVERIFY(grabgeom::TiltTorsion2Rot(a, b, c).IsApprox(rot_mat, 1e-12));
+  omega = grabgeom::HtfTiltTorsion(trig) * angles_dot;
+  QVERIFY(omega.IsApprox(FiniteDiffAngularVel(rot_tt, angles, angles_dot), 1e-8));
+  QVERIFY(grabgeom::DHtfTiltTorsion(trig, angles_dot)
+            .IsApprox(CentralDiff([](const grabnum::Vector3d& x) {
+                        return grabgeom::HtfTiltTorsion(x);
+                      }, angles, angles_dot), 1e-8));
+}
+
+void LibgeomTest::testBatchConversions()
 {
-  QVERIFY2(true, "Failure");
+  // Neither a multiple of the block size nor of any SIMD width, with padded buffers.
+  static constexpr uint32_t kSize   = 2 * 256 + 5;
+  static constexpr uint32_t kStride = kSize + 3;
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> angle(-M_PI, M_PI);
+  std::normal_distribution<double> normal;
+  std::vector<double> angles(3 * kStride);
+  std::vector<double> rot_mats(9 * kStride);
+  std::vector<double> quaternions(4 * kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d sample({angle(generator), angle(generator) / 2,
+                                    angle(generator)});
+    Scatter(sample, kStride, k, &angles);
+    Scatter(grabgeom::RPY2Rot(sample), kStride, k, &rot_mats);
+    const grabgeom::Quaternion quat(normal(generator), normal(generator),
+                                    normal(generator), normal(generator));
+    Scatter(quat.Normalized().q(), kStride, k, &quaternions);
+  }
+
+  std::vector<double> batch_rot_mats(9 * kStride);
+  std::vector<double> batch_quaternions(4 * kStride);
+  std::vector<double> batch_angles(3 * kStride);
+  grabgeom::batch::EulerXYZ2Rot(angles.data(), batch_rot_mats.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Matrix3d rot_mat = Gather<3, 3>(batch_rot_mats, kStride, k);
+    const grabnum::Vector3d sample  = Gather<3, 1>(angles, kStride, k);
+    QVERIFY(rot_mat.IsApprox(grabgeom::EulerXYZ2Rot(sample), 1e-12));
+  }
+
+  grabgeom::batch::RPY2Rot(angles.data(), batch_rot_mats.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Matrix3d rot_mat = Gather<3, 3>(batch_rot_mats, kStride, k);
+    QVERIFY(rot_mat.IsApprox(grabgeom::RPY2Rot(Gather<3, 1>(angles, kStride, k)), 1e-12));
+  }
+
+  grabgeom::batch::RPY2Quat(angles.data(), batch_quaternions.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabgeom::Quaternion quat = Gather<4, 1>(batch_quaternions, kStride, k);
+    QVERIFY(quat.IsUnitary());
+    QVERIFY(grabgeom::Quat2Rot(quat).IsApprox(Gather<3, 3>(rot_mats, kStride, k), 1e-12));
+  }
+
+  grabgeom::batch::Quat2Rot(quaternions.data(), batch_rot_mats.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Matrix3d rot_mat = Gather<3, 3>(batch_rot_mats, kStride, k);
+    const grabgeom::Quaternion quat = Gather<4, 1>(quaternions, kStride, k);
+    QVERIFY(rot_mat.IsApprox(grabgeom::Quat2Rot(quat), 1e-12));
+  }
+
+  grabgeom::batch::Quat2RPY(quaternions.data(), batch_angles.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d rpy     = Gather<3, 1>(batch_angles, kStride, k);
+    const grabgeom::Quaternion quat = Gather<4, 1>(quaternions, kStride, k);
+    QVERIFY(rpy.IsApprox(grabgeom::Quat2RPY(quat), 1e-12));
+  }
+
+  grabgeom::batch::Rot2EulerXYZ(rot_mats.data(), batch_angles.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d sample  = Gather<3, 1>(batch_angles, kStride, k);
+    const grabnum::Matrix3d rot_mat = Gather<3, 3>(rot_mats, kStride, k);
+    QVERIFY(sample.IsApprox(grabgeom::Rot2EulerXYZ(rot_mat), 1e-12));
+  }
+
+  grabgeom::batch::Rot2RPY(rot_mats.data(), batch_angles.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d rpy     = Gather<3, 1>(batch_angles, kStride, k);
+    const grabnum::Matrix3d rot_mat = Gather<3, 3>(rot_mats, kStride, k);
+    QVERIFY(rpy.IsApprox(grabgeom::Rot2RPY(rot_mat), 1e-12));
+  }
+
+  // Long enough trajectories are split among threads, with the same results.
+  static constexpr uint32_t kLongSize = 3 * 16384 + 7;
+  std::vector<double> long_angles(3 * kLongSize);
+  for (double& value : long_angles)
+    value = angle(generator);
+  std::vector<double> serial_quaternions(4 * kLongSize);
+  std::vector<double> parallel_quaternions(4 * kLongSize);
+  grabgeom::batch::RPY2Quat(long_angles.data(), serial_quaternions.data(), kLongSize,
+                            kLongSize);
+  grabgeom::batch::ParallelConvert(grabgeom::batch::RPY2Quat<double>, long_angles.data(),
+                                   parallel_quaternions.data(), kLongSize, kLongSize, 4);
+  for (uint32_t i = 0; i < 4 * kLongSize; ++i)
+    QVERIFY(grabnum::IsClose(parallel_quaternions[i], serial_quaternions[i], 1e-15));
+}
+
+void LibgeomTest::testQuaternionAlgebra()
+{
+  const grabgeom::Quaternion p(1.0, 2.0, 3.0, 4.0);
+  const grabgeom::Quaternion q(5.0, 6.0, 7.0, 8.0);
+
+  // Quaternions differing in the scalar part only are different.
+  QVERIFY(p == grabgeom::Quaternion(1.0, 2.0, 3.0, 4.0));
+  QVERIFY(p != grabgeom::Quaternion(-1.0, 2.0, 3.0, 4.0));
+  QVERIFY(!(p == grabgeom::Quaternion(-1.0, 2.0, 3.0, 4.0)));
+
+  // Hamilton product, computed by hand.
+  QVERIFY((p * q).IsApprox(grabgeom::Quaternion(-60.0, 12.0, 30.0, 24.0), 1e-12));
+  QVERIFY((q * p).IsApprox(grabgeom::Quaternion(-60.0, 20.0, 14.0, 32.0), 1e-12));
+
+  // Inverse of a non-unit quaternion.
+  const grabgeom::Quaternion identity(1.0, 0.0, 0.0, 0.0);
+  QVERIFY((p * p.Inv()).IsApprox(identity, 1e-12));
+  QVERIFY((p.Inv() * p).IsApprox(identity, 1e-12));
+
+  // Logarithm and exponential maps are inverse of each other, also for non-unit and
+  // real quaternions.
+  QVERIFY(grabgeom::QuatExp(grabgeom::QuatLog(p)).IsApprox(p, 1e-12));
+  const grabgeom::Quaternion unit = q.Normalized();
+  QVERIFY(grabgeom::QuatExp(grabgeom::QuatLog(unit)).IsApprox(unit, 1e-12));
+  const grabgeom::Quaternion real(2.0, 0.0, 0.0, 0.0);
+  QVERIFY(grabgeom::QuatExp(grabgeom::QuatLog(real)).IsApprox(real, 1e-12));
+}
+
+void LibgeomTest::testQuaternionInterpolation()
+{
+  // Unit quaternions
+  const grabgeom::Quaternion prev(0.9, 0.3, 0.1, 0.3);
+  const grabgeom::Quaternion start(0.7, 0.1, 0.7, 0.1);
+  const grabgeom::Quaternion end(0.1, 0.7, 0.1, 0.7);
+  const grabgeom::Quaternion next(-0.3, 0.9, 0.3, 0.1);
+  const grabgeom::Quaternion start_ctrl =
+    grabgeom::QuatSquadControlPoint(prev, start, end);
+  const grabgeom::Quaternion end_ctrl = grabgeom::QuatSquadControlPoint(start, end, next);
+
+  // Endpoints
+  QVERIFY(grabgeom::QuatSlerp(start, end, 0.0).IsApprox(start, 1e-12));
+  QVERIFY(grabgeom::QuatSlerp(start, end, 1.0).IsApprox(end, 1e-12));
+  QVERIFY(grabgeom::QuatNlerp(start, end, 0.0).IsApprox(start, 1e-12));
+  QVERIFY(grabgeom::QuatNlerp(start, end, 1.0).IsApprox(end, 1e-12));
+  QVERIFY(grabgeom::QuatSquad(start, start_ctrl, end_ctrl, end, 0.0)
+            .IsApprox(start, 1e-12));
+  QVERIFY(grabgeom::QuatSquad(start, start_ctrl, end_ctrl, end, 1.0)
+            .IsApprox(end, 1e-12));
+
+  // Unit norm along the path, with slerp at constant angular velocity. The opposite end
+  // quaternion is the same orientation, hence it gives the same shortest path.
+  const grabgeom::Quaternion end_rel = start.Conj() * end;
+  const double angle = std::atan2(grabnum::Norm(end_rel.v()), std::abs(end_rel.w));
+  for (uint8_t i = 0; i <= 10; ++i)
+  {
+    const double t                  = i / 10.0;
+    const grabgeom::Quaternion slerp = grabgeom::QuatSlerp(start, end, t);
+    const grabgeom::Quaternion nlerp = grabgeom::QuatNlerp(start, end, t);
+    QVERIFY(slerp.IsUnitary());
+    QVERIFY(nlerp.IsUnitary());
+    QVERIFY(grabgeom::QuatSquad(start, start_ctrl, end_ctrl, end, t).IsUnitary());
+    const grabgeom::Quaternion slerp_rel = start.Conj() * slerp;
+    QVERIFY(grabnum::IsClose(std::atan2(grabnum::Norm(slerp_rel.v()), slerp_rel.w),
+                             t * angle, 1e-12));
+    QVERIFY(grabgeom::QuatSlerp(start, -end, t).IsApprox(slerp, 1e-12));
+    QVERIFY(grabgeom::QuatNlerp(start, -end, t).IsApprox(nlerp, 1e-12));
+  }
+
+  // Batch versions, on a size that is neither a multiple of the block size nor of any
+  // SIMD width.
+  static constexpr uint32_t kSize   = 256 + 7;
+  static constexpr uint32_t kStride = kSize + 1;
+  std::vector<double> params(kSize);
+  for (uint32_t k = 0; k < kSize; ++k)
+    params[k] = static_cast<double>(k) / (kSize - 1);
+  std::vector<double> quaternions(4 * kStride);
+  grabgeom::batch::QuatSlerp(start, end, params.data(), quaternions.data(), kSize,
+                             kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabgeom::Quaternion quat = Gather<4, 1>(quaternions, kStride, k);
+    QVERIFY(quat.IsApprox(grabgeom::QuatSlerp(start, end, params[k]), 1e-12));
+  }
+  grabgeom::batch::QuatNlerp(start, end, params.data(), quaternions.data(), kSize,
+                             kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabgeom::Quaternion quat = Gather<4, 1>(quaternions, kStride, k);
+    QVERIFY(quat.IsApprox(grabgeom::QuatNlerp(start, end, params[k]), 1e-12));
+  }
+  grabgeom::batch::QuatSquad(start, start_ctrl, end_ctrl, end, params.data(),
+                             quaternions.data(), kSize, kStride);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabgeom::Quaternion quat = Gather<4, 1>(quaternions, kStride, k);
+    QVERIFY(quat.IsApprox(
+      grabgeom::QuatSquad(start, start_ctrl, end_ctrl, end, params[k]), 1e-12));
+  }
+}
+
+void LibgeomTest::testQuaternionProducts()
+{
+  const grabgeom::Quaternion quat(0.3, -0.1, 0.9, 0.3);
+  const grabgeom::Quaternion quat_dot(-0.3, 0.5, 0.2, -0.8);
+  const grabgeom::Quaternion x(0.9, -1.2, 0.4, 2.5);
+  const grabnum::Vector3d vect({0.3, -1.5, 0.8});
+
+  const grabnum::Vector3d rotated = grabgeom::Quat2Rot(quat) * vect;
+  QVERIFY(grabgeom::QuatRotate(quat, vect).IsApprox(rotated, 1e-12));
+
+  const grabnum::Matrix<double, 3, 4> h_mat = grabgeom::HtfQuat(quat);
+  grabnum::Vector3d product                 = h_mat * x.q();
+  QVERIFY(grabgeom::HtfQuatMul(quat, x).IsApprox(product, 1e-12));
+  const grabnum::VectorXd<4> transpose_product = h_mat.Transpose() * vect;
+  QVERIFY(grabgeom::HtfQuatTransposeMul(quat, vect).IsApprox(transpose_product, 1e-12));
+  product = grabgeom::DHtfQuat(quat_dot) * x.q();
+  QVERIFY(grabgeom::DHtfQuatMul(quat_dot, x).IsApprox(product, 1e-12));
+
+  // The derivative of H times the quaternion derivative vanishes, whatever the latter.
+  product = grabgeom::DHtfQuat(quat_dot) * quat_dot.q();
+  QVERIFY(grabnum::Norm(product) < 1e-15);
+  QVERIFY(grabnum::Norm(grabgeom::DHtfQuatMul(x, x)) < 1e-15);
+
+  // Batch rotations, also in place.
+  static constexpr uint32_t kSize = 16 + 3;
+  std::vector<double> vects(3 * kSize);
+  for (uint32_t i = 0; i < vects.size(); ++i)
+    vects[i] = std::sin(1.0 + i);
+  const std::vector<double> original = vects;
+  std::vector<double> rotated_vects(3 * kSize);
+  grabgeom::batch::QuatRotate(quat, vects.data(), rotated_vects.data(), kSize, kSize);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d sample = Gather<3, 1>(rotated_vects, kSize, k);
+    QVERIFY(sample.IsApprox(grabgeom::QuatRotate(quat, Gather<3, 1>(vects, kSize, k)),
+                            1e-12));
+  }
+  grabgeom::batch::QuatRotate(quat, vects.data(), vects.data(), kSize, kSize);
+  for (uint32_t i = 0; i < vects.size(); ++i)
+    QVERIFY(grabnum::IsClose(vects[i], rotated_vects[i], 1e-15));
+
+  const grabnum::Matrix3d rot_mat = grabgeom::Quat2Rot(quat);
+  vects                           = original;
+  grabgeom::batch::Rotate(rot_mat, vects.data(), vects.data(), kSize, kSize);
+  for (uint32_t k = 0; k < kSize; ++k)
+  {
+    const grabnum::Vector3d sample = Gather<3, 1>(vects, kSize, k);
+    const grabnum::Vector3d vect_k = Gather<3, 1>(original, kSize, k);
+    QVERIFY(sample.IsApprox(rot_mat * vect_k, 1e-12));
+  }
+}
+
+void LibgeomTest::testRot2Quat()
+{
+  // Each component in turn is the largest one, also for rotations of 180 degrees and
+  // for quaternions with negative scalar part.
+  const grabgeom::Quaternion quaternions[] = {
+    grabgeom::Quaternion(1.0, 0.0, 0.0, 0.0),
+    grabgeom::Quaternion(0.9, 0.3, -0.2, 0.1),
+    grabgeom::Quaternion(0.2, -0.9, 0.3, 0.1),
+    grabgeom::Quaternion(-0.1, 0.3, 0.9, -0.2),
+    grabgeom::Quaternion(0.3, 0.1, -0.2, -0.9),
+    grabgeom::Quaternion(-0.9, 0.3, 0.2, 0.1),
+    grabgeom::Quaternion(0.0, 1.0, 0.0, 0.0),
+    grabgeom::Quaternion(0.0, 0.0, 1.0, 0.0),
+    grabgeom::Quaternion(0.0, 0.0, 0.0, 1.0),
+    grabgeom::Quaternion(0.0, 0.6, -0.8, 0.0)};
+  for (const grabgeom::Quaternion& quaternion : quaternions)
+  {
+    const grabgeom::Quaternion quat   = quaternion.Normalized();
+    const grabgeom::Quaternion result = grabgeom::Rot2Quat(grabgeom::Quat2Rot(quat));
+    QVERIFY(IsSameOrientation(result, quat, 1e-12));
+    QVERIFY(result.w >= 0.0);
+    QVERIFY(result.IsUnitary());
+  }
+
+  // One correction squares the orthogonality error of a drifting matrix, two bring it to
+  // round-off level, while the rotation is kept.
+  const grabnum::Matrix3d identity(1.0);
+  const grabnum::Matrix3d rot_mat = grabgeom::RPY2Rot(0.7, -0.4, 2.1);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> drift(-1e-6, 1e-6);
+  grabnum::Matrix3d drifting_mat = rot_mat;
+  for (uint8_t i = 1; i <= 3; ++i)
+    for (uint8_t j = 1; j <= 3; ++j)
+      drifting_mat(i, j) += drift(generator);
+  QVERIFY(grabgeom::Orthonormalize(drifting_mat, 0) == drifting_mat);
+  grabnum::Matrix3d ortho_mat = grabgeom::Orthonormalize(drifting_mat);
+  grabnum::Matrix3d gram      = ortho_mat.Transpose() * ortho_mat;
+  QVERIFY(gram.IsApprox(identity, 1e-11));
+  QVERIFY(ortho_mat.IsApprox(rot_mat, 1e-5));
+  ortho_mat = grabgeom::Orthonormalize(drifting_mat, 2);
+  gram      = ortho_mat.Transpose() * ortho_mat;
+  QVERIFY(gram.IsApprox(identity, 4 * std::numeric_limits<double>::epsilon()));
+  QVERIFY(ortho_mat.IsApprox(rot_mat, 1e-5));
 }
 
 QTEST_APPLESS_MAIN(LibgeomTest)
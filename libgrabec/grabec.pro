@@ -1,7 +1,7 @@
 
 QT       -= gui
 
-CONFIG   += c++11 staticlib
+CONFIG   += c++14 staticlib
 CONFIG   -= app_bundle
 
 TEMPLATE = lib
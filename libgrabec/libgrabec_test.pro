@@ -29,7 +29,7 @@ QT       -= gui
 
 TARGET = libgrabec_test
 
-CONFIG   += c++11 console
+CONFIG   += c++14 console
 CONFIG   -= app_bundle
 
 TEMPLATE = app
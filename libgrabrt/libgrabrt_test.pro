@@ -18,7 +18,7 @@ QT       -= gui
 
 TARGET = libgrabrt_test
 
-CONFIG   += console c++11
+CONFIG   += console c++14
 CONFIG   -= app_bundle
 
 TEMPLATE = app
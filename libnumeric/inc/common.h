@@ -9,7 +9,9 @@
 #ifndef GRABCOMMON_LIBNUMERIC_COMMON_H
 #define GRABCOMMON_LIBNUMERIC_COMMON_H
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdlib.h>
 #include <vector>
 
@@ -24,6 +26,19 @@ namespace grabnum {
 
 static constexpr double EPSILON = 1e-7; /**< tolerance for floating point comparison */
 
+template <typename T>
+/**
+ * @brief Default tolerance for the comparison of values of a given scalar type.
+ *
+ * It is EPSILON, unless the type itself is not accurate enough for it: the rounding
+ * errors of a few single precision operations, for instance, already exceed EPSILON.
+ * @return The largest between EPSILON and 32 machine epsilons of type @a T.
+ */
+constexpr double Tolerance()
+{
+  return std::max(EPSILON, 32.0 * static_cast<double>(std::numeric_limits<T>::epsilon()));
+}
+
 template <typename T>
 /**
  * @brief Check whether two floating numbers are close within a certain tolerance.
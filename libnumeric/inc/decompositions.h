@@ -0,0 +1,640 @@
+/**
+ * @file decompositions.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing matrix decompositions to be included in the GRAB numeric
+ * library.
+ *
+ * Each decomposition is an object which factorizes a matrix once, and can then be used
+ * to solve many linear systems, or to compute determinant and inverse, without repeating
+ * the factorization:
+ * @code
+ * LU<double, 6> lu(A);
+ * for (auto& b : rhs)
+ *   x = lu.Solve(b);
+ * @endcode
+ * Inverse and pseudo-inverse functions built on top of them are provided as well.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_DECOMPOSITIONS_H
+#define GRABCOMMON_LIBNUMERIC_DECOMPOSITIONS_H
+
+#include <stdexcept>
+
+#include "matrix_utilities.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+/**
+ * @brief _LU decomposition_ with partial pivoting of a square matrix.
+ *
+ * Given a @f$n\times n@f$ matrix @f$\mathbf{A}@f$, it finds a permutation matrix
+ * @f$\mathbf{P}@f$, a unit lower-triangular matrix @f$\mathbf{L}@f$ and an
+ * upper-triangular matrix @f$\mathbf{U}@f$ such that
+ * @f[
+ * \mathbf{P}\mathbf{A} = \mathbf{L}\mathbf{U}
+ * @f]
+ * The factorization costs @f$O(n^3)@f$, while each following solution costs only
+ * @f$O(n^2)@f$.
+ */
+template <typename T, uint8_t dim> class LU
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in LU!");
+
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  LU() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @see Compute()
+   */
+  explicit LU(const Matrix<T, dim, dim>& matrix) { Compute(matrix); }
+
+  /**
+   * Factorizes a matrix, discarding any previous factorization.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @return A reference to @c *this.
+   */
+  LU& Compute(const Matrix<T, dim, dim>& matrix);
+
+  /**
+   * Checks whether the factorized matrix is invertible.
+   *
+   * @param[in] tol (optional) The absolute value below which a pivot is considered zero.
+   * @return true if all pivots are greater than @a tol in absolute value.
+   */
+  bool IsInvertible(const double tol = EPSILON) const;
+  /**
+   * Returns the determinant of the factorized matrix.
+   *
+   * @return The determinant.
+   */
+  T Det() const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{X} = \mathbf{B}@f$.
+   *
+   * @param[in] rhs A @f$n\times p@f$ matrix or matrix expression @f$\mathbf{B}@f$,
+   * usually a vector.
+   * @return The @f$n\times p@f$ solution @f$\mathbf{X}@f$.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  template <class ExprT>
+  Matrix<T, dim, ExprTraits<ExprT>::kCols> Solve(const MatrixExpr<ExprT>& rhs) const;
+  /**
+   * Returns the inverse of the factorized matrix.
+   *
+   * @return The @f$n\times n@f$ inverse matrix.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  Matrix<T, dim, dim> Inverse() const;
+
+  /**
+   * Returns the compact factorization, with @f$\mathbf{U}@f$ in the upper triangle and
+   * the strictly lower part of @f$\mathbf{L}@f$ below it.
+   *
+   * @return A constant reference to the factorization.
+   */
+  inline const Matrix<T, dim, dim>& GetLU() const { return lu_; }
+  /**
+   * Returns the unit lower-triangular factor @f$\mathbf{L}@f$.
+   *
+   * @return The @f$n\times n@f$ matrix @f$\mathbf{L}@f$.
+   */
+  Matrix<T, dim, dim> GetL() const;
+  /**
+   * Returns the upper-triangular factor @f$\mathbf{U}@f$.
+   *
+   * @return The @f$n\times n@f$ matrix @f$\mathbf{U}@f$.
+   */
+  Matrix<T, dim, dim> GetU() const;
+  /**
+   * Returns the permutation matrix @f$\mathbf{P}@f$.
+   *
+   * @return The @f$n\times n@f$ matrix @f$\mathbf{P}@f$.
+   */
+  Matrix<T, dim, dim> GetP() const;
+
+private:
+  Matrix<T, dim, dim> lu_; /**< compact factorization, see GetLU(). */
+  uint8_t perm_[dim];      /**< original row index of each row of the factorization. */
+  int8_t perm_sign_;       /**< sign of the permutation. */
+  bool singular_;          /**< whether a pivot is exactly zero. */
+};
+
+/**
+ * @brief _QR decomposition_ of a matrix by means of _Householder reflections_.
+ *
+ * Given a @f$m\times n@f$ matrix @f$\mathbf{A}@f$, with @f$m\geq n@f$, it finds an
+ * orthogonal matrix @f$\mathbf{Q}@f$ and an upper-triangular matrix @f$\mathbf{R}@f$
+ * such that
+ * @f[
+ * \mathbf{A} = \mathbf{Q}\mathbf{R}
+ * @f]
+ * It is more expensive than LU, but numerically more robust, and it solves
+ * over-determined systems in the least-squares sense.
+ */
+template <typename T, uint8_t rows, uint8_t cols> class QR
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in QR!");
+  static_assert(rows >= cols, "ERROR: QR is defined only for rows >= cols!");
+
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  QR() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$m\times n@f$ matrix to be factorized.
+   * @see Compute()
+   */
+  explicit QR(const Matrix<T, rows, cols>& matrix) { Compute(matrix); }
+
+  /**
+   * Factorizes a matrix, discarding any previous factorization.
+   *
+   * @param[in] matrix The @f$m\times n@f$ matrix to be factorized.
+   * @return A reference to @c *this.
+   */
+  QR& Compute(const Matrix<T, rows, cols>& matrix);
+
+  /**
+   * Checks whether the factorized matrix has full column rank.
+   *
+   * @param[in] tol (optional) The absolute value below which a diagonal element of
+   * @f$\mathbf{R}@f$ is considered zero.
+   * @return true if all diagonal elements of @f$\mathbf{R}@f$ are greater than @a tol in
+   * absolute value.
+   */
+  bool IsFullRank(const double tol = EPSILON) const;
+  /**
+   * Returns the determinant of the factorized matrix, which must be square.
+   *
+   * @return The determinant.
+   */
+  T Det() const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{X} = \mathbf{B}@f$, in the
+   * least-squares sense if @f$m>n@f$.
+   *
+   * @param[in] rhs A @f$m\times p@f$ matrix or matrix expression @f$\mathbf{B}@f$,
+   * usually a vector.
+   * @return The @f$n\times p@f$ solution @f$\mathbf{X}@f$.
+   * @note Throws a @c std::invalid_argument exception if the matrix is rank deficient.
+   */
+  template <class ExprT>
+  Matrix<T, cols, ExprTraits<ExprT>::kCols> Solve(const MatrixExpr<ExprT>& rhs) const;
+  /**
+   * Returns the inverse of the factorized matrix, which must be square.
+   *
+   * @return The @f$n\times n@f$ inverse matrix.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  Matrix<T, cols, cols> Inverse() const;
+
+  /**
+   * Returns the orthogonal factor @f$\mathbf{Q}@f$.
+   *
+   * @return The @f$m\times m@f$ matrix @f$\mathbf{Q}@f$.
+   */
+  Matrix<T, rows, rows> GetQ() const;
+  /**
+   * Returns the upper-triangular factor @f$\mathbf{R}@f$.
+   *
+   * @return The @f$m\times n@f$ matrix @f$\mathbf{R}@f$.
+   */
+  Matrix<T, rows, cols> GetR() const;
+
+private:
+  static constexpr uint8_t kReflections =
+    rows > cols ? cols : cols - 1; /**< number of Householder reflections. */
+
+  Matrix<T, rows, cols> qr_; /**< @f$\mathbf{R}@f$ and Householder vectors below it. */
+  T tau_[cols];              /**< scale factors of Householder reflections. */
+
+  /**
+   * Applies the reflections to @a matrix, i.e. replaces it by
+   * @f$\mathbf{Q}^T\mathbf{M}@f$.
+   */
+  template <uint8_t n> void ApplyQt(Matrix<T, rows, n>& matrix) const;
+};
+
+/**
+ * @brief Outcome of a LDLT factorization or of its updates.
+ */
+enum LDLTStatus : uint8_t
+{
+  LDLT_SUCCESS,               /**< the matrix is positive-definite and factorized. */
+  LDLT_NOT_POSITIVE_DEFINITE, /**< the matrix is not positive-definite. */
+  LDLT_NOT_COMPUTED           /**< no matrix has been factorized yet. */
+};
+
+/**
+ * @brief _LDLT decomposition_ of a symmetric, positive-definite matrix.
+ *
+ * Given a @f$n\times n@f$ symmetric, positive-definite matrix @f$\mathbf{A}@f$, it finds
+ * a unit lower-triangular matrix @f$\mathbf{L}@f$ and a diagonal matrix
+ * @f$\mathbf{D}@f$ with positive elements such that
+ * @f[
+ * \mathbf{A} = \mathbf{L}\mathbf{D}\mathbf{L}^T
+ * @f]
+ * This is the square-root-free form of the Cholesky decomposition, the Cholesky factor
+ * being @f$\mathbf{L}\mathbf{D}^{1/2}@f$. Unlike Cholesky(), a failure never throws an
+ * exception but is reported as a status code, so that the positive-definiteness of a
+ * stiffness or mass matrix can be checked at every control cycle. Moreover, a rank-1
+ * change of @f$\mathbf{A}@f$ can be folded into the factorization in @f$O(n^2)@f$,
+ * without computing it again.
+ */
+template <typename T, uint8_t dim> class LDLT
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in LDLT!");
+
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  LDLT() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$n\times n@f$ symmetric matrix to be factorized.
+   * @see Compute()
+   */
+  explicit LDLT(const Matrix<T, dim, dim>& matrix) { Compute(matrix); }
+
+  /**
+   * Factorizes a matrix, discarding any previous factorization.
+   *
+   * The factorization stops at the first pivot which is not strictly positive, since the
+   * matrix is not positive-definite.
+   * @param[in] matrix The @f$n\times n@f$ symmetric matrix to be factorized. Only its
+   * lower triangle is read.
+   * @return LDLT_SUCCESS if the matrix is positive-definite, LDLT_NOT_POSITIVE_DEFINITE
+   * otherwise, in which case the decomposition cannot be used.
+   */
+  LDLTStatus Compute(const Matrix<T, dim, dim>& matrix);
+  /**
+   * Updates the factorization of @f$\mathbf{A}@f$ to the one of
+   * @f$\mathbf{A} + \sigma\mathbf{z}\mathbf{z}^T@f$.
+   *
+   * A positive @f$\sigma@f$ gives a rank-1 update, which always succeeds, while a
+   * negative one gives a rank-1 downdate, which succeeds only if the result is still
+   * positive-definite, i.e. if @f$1 + \sigma\mathbf{z}^T\mathbf{A}^{-1}\mathbf{z} > 0@f$.
+   * This is checked beforehand, so that the factorization is left untouched on failure.
+   * @param[in] vect The vector @f$\mathbf{z}@f$.
+   * @param[in] sigma (optional) The scale factor @f$\sigma@f$. Default is 1.
+   * @return LDLT_SUCCESS if the factorization was updated, LDLT_NOT_POSITIVE_DEFINITE if
+   * the result would not be positive-definite, or the status of the current
+   * factorization if this is not valid.
+   */
+  LDLTStatus Update(const Matrix<T, dim, 1>& vect, const T sigma = 1);
+
+  /**
+   * Returns the outcome of the last factorization.
+   *
+   * @return The status of the decomposition.
+   */
+  inline LDLTStatus Status() const { return status_; }
+  /**
+   * Checks whether the factorized matrix is positive-definite.
+   *
+   * @param[in] tol (optional) The value all elements of @f$\mathbf{D}@f$ must exceed, in
+   * order to reject nearly singular matrices as well.
+   * @return true if the factorization succeeded and all elements of @f$\mathbf{D}@f$ are
+   * greater than @a tol.
+   */
+  bool IsPositiveDefinite(const double tol = 0) const;
+  /**
+   * Returns the determinant of the factorized matrix.
+   *
+   * @return The determinant, i.e. the product of the elements of @f$\mathbf{D}@f$.
+   * @note The factorization must have succeeded.
+   */
+  T Det() const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{X} = \mathbf{B}@f$.
+   *
+   * @param[in] rhs A @f$n\times p@f$ matrix or matrix expression @f$\mathbf{B}@f$,
+   * usually a vector.
+   * @return The @f$n\times p@f$ solution @f$\mathbf{X}@f$.
+   * @note The factorization must have succeeded. This is only asserted, so that no
+   * exception is ever thrown: check Status() first.
+   */
+  template <class ExprT>
+  Matrix<T, dim, ExprTraits<ExprT>::kCols> Solve(const MatrixExpr<ExprT>& rhs) const;
+
+  /**
+   * Returns the unit lower-triangular factor @f$\mathbf{L}@f$.
+   *
+   * @return The @f$n\times n@f$ matrix @f$\mathbf{L}@f$.
+   */
+  Matrix<T, dim, dim> GetL() const;
+  /**
+   * Returns the diagonal of @f$\mathbf{D}@f$.
+   *
+   * @return The @f$n@f$-dimensional vector of the diagonal elements of @f$\mathbf{D}@f$.
+   */
+  Matrix<T, dim, 1> GetD() const;
+
+private:
+  Matrix<T, dim, dim> ldl_;               /**< strict lower part of @f$\mathbf{L}@f$
+                                               and @f$\mathbf{D}@f$ on the diagonal. */
+  LDLTStatus status_ = LDLT_NOT_COMPUTED; /**< outcome of the last factorization. */
+};
+
+/**
+ * @brief _Eigendecomposition_ of a symmetric matrix by means of the _cyclic Jacobi
+ * method_.
+ *
+ * Given a @f$n\times n@f$ symmetric matrix @f$\mathbf{A}@f$, it finds an orthogonal
+ * matrix @f$\mathbf{V}@f$, whose columns are the eigenvectors, and a diagonal matrix
+ * @f$\boldsymbol{\Lambda}@f$ of the real eigenvalues such that
+ * @f[
+ * \mathbf{A} = \mathbf{V}\boldsymbol{\Lambda}\mathbf{V}^T
+ * @f]
+ * The off-diagonal elements are annihilated one at a time by plane rotations, sweeping
+ * the matrix until they are negligible. The convergence is quadratic, so that a
+ * @f$3\times 3@f$ or @f$6\times 6@f$ matrix, e.g. a stiffness or mass matrix, takes a
+ * handful of sweeps to be diagonalized to machine precision. No memory is allocated on
+ * the heap.
+ */
+template <typename T, uint8_t dim> class SymmetricEigen
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in SymmetricEigen!");
+
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  SymmetricEigen() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$n\times n@f$ symmetric matrix to be decomposed.
+   * @param[in] compute_vectors (optional) If false, only the eigenvalues are computed.
+   * @see Compute()
+   */
+  explicit SymmetricEigen(const Matrix<T, dim, dim>& matrix,
+                          const bool compute_vectors = true)
+  {
+    Compute(matrix, compute_vectors);
+  }
+
+  /**
+   * Decomposes a matrix, discarding any previous decomposition.
+   *
+   * @param[in] matrix The @f$n\times n@f$ symmetric matrix to be decomposed. Only its
+   * upper triangle is read.
+   * @param[in] compute_vectors (optional) If false, only the eigenvalues are computed,
+   * which saves about half of the operations.
+   * @return A reference to @c *this.
+   */
+  SymmetricEigen& Compute(const Matrix<T, dim, dim>& matrix,
+                          const bool compute_vectors = true);
+
+  /**
+   * Checks whether the Jacobi sweeps converged within their maximum number.
+   *
+   * @return true if the off-diagonal elements became negligible.
+   */
+  inline bool HasConverged() const { return converged_; }
+  /**
+   * Returns the eigenvalues, sorted in ascending order.
+   *
+   * @return A constant reference to the @f$n@f$-dimensional vector of eigenvalues.
+   */
+  inline const Matrix<T, dim, 1>& GetEigenvalues() const { return values_; }
+  /**
+   * Returns the orthonormal eigenvectors, as columns of @f$\mathbf{V}@f$ sorted as the
+   * eigenvalues.
+   *
+   * @return A constant reference to the @f$n\times n@f$ matrix @f$\mathbf{V}@f$.
+   * @note Only available if the decomposition was computed with @a compute_vectors.
+   */
+  inline const Matrix<T, dim, dim>& GetEigenvectors() const { return vectors_; }
+
+private:
+  static constexpr uint8_t kMaxSweeps = 32; /**< limit of Jacobi sweeps. */
+
+  Matrix<T, dim, 1> values_;    /**< eigenvalues, see GetEigenvalues(). */
+  Matrix<T, dim, dim> vectors_; /**< eigenvectors, see GetEigenvectors(). */
+  bool converged_ = false;      /**< whether the sweeps converged. */
+};
+
+/**
+ * @brief _Singular value decomposition_ of a matrix by means of the _one-sided Jacobi
+ * method_.
+ *
+ * Given a generic @f$m\times n@f$ matrix @f$\mathbf{A}@f$, it finds the thin
+ * decomposition
+ * @f[
+ * \mathbf{A} = \mathbf{U}\boldsymbol{\Sigma}\mathbf{V}^T
+ * @f]
+ * where, being @f$k = \min(m, n)@f$, @f$\boldsymbol{\Sigma}@f$ is the @f$k\times k@f$
+ * diagonal matrix of the non-negative singular values, while @f$\mathbf{U}@f$ and
+ * @f$\mathbf{V}@f$ are @f$m\times k@f$ and @f$n\times k@f$ matrices with orthonormal
+ * columns. Plane rotations are applied to the columns of @f$\mathbf{A}@f$, or of its
+ * transpose if @f$m<n@f$, until they are mutually orthogonal: their norms are then the
+ * singular values. Compared to the bidiagonalization-based methods, this is simpler and
+ * more accurate for the small matrices of robotics, such as a jacobian or a structure
+ * matrix, whose condition number and rank can then be monitored online. No memory is
+ * allocated on the heap.
+ */
+template <typename T, uint8_t rows, uint8_t cols> class SVD
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in SVD!");
+
+public:
+  static constexpr uint8_t kMinDim = rows < cols ? rows : cols; /**< @f$k@f$ */
+  static constexpr uint8_t kMaxDim = rows < cols ? cols : rows; /**< @f$\max(m, n)@f$ */
+
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  SVD() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$m\times n@f$ matrix to be decomposed.
+   * @param[in] compute_vectors (optional) If false, only the singular values are
+   * computed.
+   * @see Compute()
+   */
+  explicit SVD(const Matrix<T, rows, cols>& matrix, const bool compute_vectors = true)
+  {
+    Compute(matrix, compute_vectors);
+  }
+
+  /**
+   * Decomposes a matrix, discarding any previous decomposition.
+   *
+   * @param[in] matrix The @f$m\times n@f$ matrix to be decomposed.
+   * @param[in] compute_vectors (optional) If false, only the singular values are
+   * computed, which is enough for the condition number and the rank.
+   * @return A reference to @c *this.
+   */
+  SVD& Compute(const Matrix<T, rows, cols>& matrix, const bool compute_vectors = true);
+
+  /**
+   * Checks whether the Jacobi sweeps converged within their maximum number.
+   *
+   * @return true if all columns became mutually orthogonal.
+   */
+  inline bool HasConverged() const { return converged_; }
+  /**
+   * Returns the singular values, sorted in descending order.
+   *
+   * @return A constant reference to the @f$k@f$-dimensional vector of singular values.
+   */
+  inline const Matrix<T, kMinDim, 1>& GetSingularValues() const { return values_; }
+  /**
+   * Returns the 2-norm condition number of the decomposed matrix.
+   *
+   * @return The ratio between the largest and the smallest singular value, which is
+   * infinite if the matrix is rank deficient.
+   */
+  T Condition() const;
+  /**
+   * Returns the numerical rank of the decomposed matrix.
+   *
+   * @param[in] tol (optional) The singular value, relative to the largest one, below
+   * which it is considered zero.
+   * @return The number of singular values greater than @a tol times the largest one.
+   */
+  uint8_t Rank(const double tol = EPSILON) const;
+  /**
+   * Returns the left singular vectors.
+   *
+   * @return The @f$m\times k@f$ matrix @f$\mathbf{U}@f$. Columns corresponding to null
+   * singular values are zero if @f$m\geq n@f$.
+   * @note Only available if the decomposition was computed with @a compute_vectors.
+   */
+  Matrix<T, rows, kMinDim> GetU() const;
+  /**
+   * Returns the right singular vectors.
+   *
+   * @return The @f$n\times k@f$ matrix @f$\mathbf{V}@f$. Columns corresponding to null
+   * singular values are zero if @f$m<n@f$.
+   * @note Only available if the decomposition was computed with @a compute_vectors.
+   */
+  Matrix<T, cols, kMinDim> GetV() const;
+
+private:
+  static constexpr uint8_t kMaxSweeps = 32; /**< limit of Jacobi sweeps. */
+
+  Matrix<T, kMaxDim, kMinDim> work_; /**< orthogonalized columns, then normalized. */
+  Matrix<T, kMinDim, kMinDim> rot_;  /**< accumulated rotations. */
+  Matrix<T, kMinDim, 1> values_;     /**< singular values, see GetSingularValues(). */
+  bool converged_ = false;           /**< whether the sweeps converged. */
+};
+
+/**
+ * Inverse of a square matrix.
+ *
+ * Matrices up to @f$4\times 4@f$ are inverted in closed form, while larger ones are
+ * factorized by LU decomposition.
+ *
+ * @param[in] matrix The @f$n\times n@f$ matrix to be inverted.
+ * @return The @f$n\times n@f$ inverse matrix.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+ * @see LU::Inverse()
+ */
+template <typename T, uint8_t dim>
+Matrix<T, dim, dim> Inverse(const Matrix<T, dim, dim>& matrix);
+
+/**
+ * Inverse of a @f$2\times 2@f$ matrix in closed form.
+ *
+ * @param[in] matrix The matrix to be inverted.
+ * @return The inverse matrix.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+ */
+template <typename T> Matrix<T, 2, 2> Inverse(const Matrix<T, 2, 2>& matrix);
+
+/**
+ * Inverse of a @f$3\times 3@f$ matrix in closed form.
+ *
+ * @param[in] matrix The matrix to be inverted.
+ * @return The inverse matrix.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+ */
+template <typename T> Matrix<T, 3, 3> Inverse(const Matrix<T, 3, 3>& matrix);
+
+/**
+ * Inverse of a @f$4\times 4@f$ matrix in closed form.
+ *
+ * @param[in] matrix The matrix to be inverted.
+ * @return The inverse matrix.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+ */
+template <typename T> Matrix<T, 4, 4> Inverse(const Matrix<T, 4, 4>& matrix);
+
+/**
+ * Inverse of a square matrix expression.
+ *
+ * @param[in] matrix The matrix expression to be inverted.
+ * @return The inverse of the evaluated expression.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+ */
+template <class ExprT>
+Matrix<typename ExprTraits<ExprT>::Scalar, ExprTraits<ExprT>::kRows,
+       ExprTraits<ExprT>::kCols>
+Inverse(const MatrixExpr<ExprT>& matrix);
+
+/**
+ * _Moore-Penrose pseudo-inverse_ of a matrix.
+ *
+ * Given a generic @f$m\times n@f$ matrix @f$\mathbf{A}@f$, its pseudo-inverse
+ * @f$\mathbf{A}^+@f$ gives the minimum-norm, least-squares solution
+ * @f$\mathbf{x} = \mathbf{A}^+\mathbf{b}@f$ of @f$\mathbf{A}\mathbf{x} = \mathbf{b}@f$,
+ * both for over- and under-determined systems. If @f$\mathbf{A}@f$ has full rank, this is
+ * @f$(\mathbf{A}^T\mathbf{A})^{-1}\mathbf{A}^T@f$ or
+ * @f$\mathbf{A}^T(\mathbf{A}\mathbf{A}^T)^{-1}@f$ respectively.
+ * It is computed by a _complete orthogonal decomposition_, i.e. a QR decomposition with
+ * column pivoting which reveals the rank of @f$\mathbf{A}@f$, followed by a QR
+ * decomposition of the resulting upper-trapezoidal factor. No memory is allocated on the
+ * heap.
+ *
+ * @param[in] matrix The @f$m\times n@f$ matrix @f$\mathbf{A}@f$.
+ * @param[in] tol (optional) The column norm below which the remaining part of
+ * @f$\mathbf{A}@f$ is considered zero, i.e. which determines its rank.
+ * @return The @f$n\times m@f$ pseudo-inverse @f$\mathbf{A}^+@f$.
+ */
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, cols, rows> PseudoInverse(const Matrix<T, rows, cols>& matrix,
+                                    const double tol = EPSILON);
+
+/**
+ * _Moore-Penrose pseudo-inverse_ of a matrix expression.
+ *
+ * @param[in] matrix The @f$m\times n@f$ matrix expression @f$\mathbf{A}@f$.
+ * @param[in] tol (optional) The column norm below which the remaining part of
+ * @f$\mathbf{A}@f$ is considered zero.
+ * @return The @f$n\times m@f$ pseudo-inverse of the evaluated expression.
+ * @see PseudoInverse()
+ */
+template <class ExprT>
+Matrix<typename ExprTraits<ExprT>::Scalar, ExprTraits<ExprT>::kCols,
+       ExprTraits<ExprT>::kRows>
+PseudoInverse(const MatrixExpr<ExprT>& matrix, const double tol = EPSILON);
+
+} //  end namespace grabnum
+
+#include "../src/decompositions.tcc"
+
+#endif // GRABCOMMON_LIBNUMERIC_DECOMPOSITIONS_H
@@ -14,7 +14,9 @@
 #define GRABCOMMON_LIBNUMERIC_MATRIX_H_
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <initializer_list>
 #include <typeinfo>
 
 #include "common.h"
@@ -30,6 +32,10 @@
 #include <iomanip>
 #endif
 
+#include "simd.h"
+#include "matrix_expressions.h"
+#include "matrix_view.h"
+
 /**
  * @brief Namespace for GRAB numeric library.
  */
@@ -40,19 +46,30 @@ namespace grabnum
  * A Matlab-alike implementation of a matrix class to simplify and speed up standard
  * operations and make it MCU-friendly.
  *
+ * Elements are stored row-by-row in a contiguous buffer. When SIMD kernels are enabled
+ * (see simd.h), the buffer is padded to a whole number of SIMD registers, and the padding
+ * elements are kept at zero. The buffer has no extra alignment, since kernels use
+ * unaligned loads and stores and over-aligned types cannot be allocated with @c new or
+ * @c std::vector before C++17.
+ *
+ * The matrix is itself a MatrixExpr, so it can be mixed freely with lazy element-wise
+ * expressions (see matrix_expressions.h), which are evaluated in place on assignment.
+ *
  * @note Indexing starts at 1 instead of 0 (like in Matlab)!
  */
-template <typename T, uint8_t rows, uint8_t cols> class Matrix
+template <typename T, uint8_t rows, uint8_t cols>
+class Matrix: public MatrixExpr<Matrix<T, rows, cols>>
 {
 public:
   using Matrix_t = Matrix<T, rows, cols>; /**< practical typedef for local use */
 
+  static constexpr uint16_t kStorageSize =
+    simd::PaddedSize<T, rows * cols>::value; /**< number of stored elements. */
+
   /**
-   * Default empty constructor.
-   *
-   * @todo initialize to zero anyway
+   * Default constructor of a matrix of zeros.
    */
-  Matrix();
+  constexpr Matrix();
   /**
    * Constructor for empty or identity matrix.
    *
@@ -60,8 +77,9 @@ public:
    * 0 for initializing an empty matrix.
    * @see SetZero()
    * @see SetIdentity()
+   * @note Only square matrices can be built at compile time with a non-zero @a scalar.
    */
-  Matrix(T scalar);
+  constexpr Matrix(T scalar);
   /**
    * Full constructor.
    * Fills the matrix row-by-row with the elements of @a values.
@@ -70,15 +88,36 @@ public:
    * @param[in] size The number of elements in the vector.
    * @see Fill()
    */
-  Matrix(const T* values, const uint16_t size);
+  constexpr Matrix(const T* values, const uint16_t size);
+  /**
+   * Full constructor.
+   * Fills the matrix row-by-row with the elements of @a values, which must be exactly
+   * @f$m\times n@f$. Constant matrices can be built at compile time this way, e.g.:
+   * @code
+   * static constexpr Matrix2d kRot90 = {0., -1., 1., 0.};
+   * @endcode
+   *
+   * @param[in] values A list of @a T values.
+   */
+  constexpr Matrix(std::initializer_list<T> values);
   /**
    * Full constructor.
    * Fills the matrix row-by-row with the elements of @a values.
    *
    * @param[in] values A standard @a T vector.
    * @see Fill()
+   * @note On real-time paths prefer the other constructors, which do not require the
+   * caller to allocate a vector on the heap.
    */
   Matrix(const std::vector<T>& values);
+  /**
+   * Full constructor.
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] values A standard array of @f$m\times n@f$ @a T elements.
+   * @see Fill()
+   */
+  constexpr Matrix(const std::array<T, rows * cols>& values);
   /**
    * Parametrized constructor from another matrix with the same shape and size.
    * Makes a copy of the given matrix. It also handle automatic casting in case of
@@ -86,38 +125,49 @@ public:
    *
    * @param[in] other The copied matrix.
    */
-  template <typename T2> Matrix(const Matrix<T2, rows, cols>& other);
+  template <typename T2> constexpr Matrix(const Matrix<T2, rows, cols>& other);
+  /**
+   * Constructor from a matrix expression with the same shape and size.
+   * Evaluates the expression element-by-element straight into the new matrix. It also
+   * handle automatic casting in case of different types.
+   *
+   * @param[in] other The expression to be evaluated. If it has dynamic size, its
+   * dimensions are checked at run time.
+   */
+  template <class ExprT, typename = typename std::enable_if<
+                           HaveSameSize<Matrix<T, rows, cols>, ExprT>::value>::type>
+  constexpr Matrix(const MatrixExpr<ExprT>& other);
 
   /**
    * Returns numbers of rows.
    *
    * @return A size.
    */
-  uint8_t Rows() const { return rows; }
+  constexpr uint8_t Rows() const { return rows; }
   /**
    * Returns numbers of rows.
    *
    * @return A size.
    */
-  uint8_t Cols() const { return cols; }
+  constexpr uint8_t Cols() const { return cols; }
   /**
    * Returns the matrix size, i.e. @f$m\times n@f$.
    *
    * @return A size.
    */
-  uint16_t Size() const { return rows * cols; }
+  constexpr uint16_t Size() const { return rows * cols; }
   /**
    * Returns the maximum value inside the matrix.
    *
    * @return The maximum value.
    */
-  inline T Max() const { return this(MaxIdx()); }
+  inline T Max() const { return Data()[MaxIdx() - 1]; }
   /**
    * Returns the minimum value inside the matrix.
    *
    * @return The minimum value.
    */
-  inline T Min() const { return this(MinIdx()); }
+  inline T Min() const { return Data()[MinIdx() - 1]; }
   /**
    * Returns the linear index of the maximum value inside the matrix.
    *
@@ -152,13 +202,39 @@ public:
    *
    * @return A pointer to the data of the matrix.
    */
-  inline T* Data() { return *elements_; }
+  constexpr T* Data() { return elements_; }
   /**
    * Give read-only access to the matrix data.
    *
    * @return A pointer to the data of the matrix.
    */
-  inline const T* Data() const { return *elements_; }
+  constexpr const T* Data() const { return elements_; }
+  /**
+   * Give read-only access to a single entry of the unraveled matrix.
+   *
+   * This is the element access used by matrix expressions.
+   * @param[in] index The 0-based linear index of the desired entry.
+   * @return The i-th entry of the matrix.
+   */
+  constexpr const T& Coeff(const uint16_t index) const { return elements_[index]; }
+  /**
+   * Give read-only access to a single entry of the matrix.
+   *
+   * This is the element access used by matrix expressions.
+   * @param[in] row The 0-based row index of the desired entry.
+   * @param[in] col The 0-based column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the matrix.
+   */
+  constexpr const T& Coeff(const uint8_t row, const uint8_t col) const
+  {
+    return elements_[row * cols + col];
+  }
+  /**
+   * Returns the matrix itself, for compatibility with matrix expressions.
+   *
+   * @return A constant reference to @c *this.
+   */
+  constexpr const Matrix_t& Eval() const { return *this; }
 
   /**
    * Conversion operator.
@@ -172,6 +248,15 @@ public:
    */
   template <typename NewT>
   Matrix<T, rows, cols>& operator=(const Matrix<NewT, rows, cols>& other);
+  /**
+   * Assign operator from a matrix expression.
+   * The expression is evaluated element-by-element straight into @c *this.
+   *
+   * @param[in] other The expression to be evaluated.
+   * @return A reference to @c *this.
+   * @note Element-wise expressions can safely refer to @c *this (e.g. `a = b - a`).
+   */
+  template <class ExprT> constexpr Matrix_t& operator=(const MatrixExpr<ExprT>& other);
   /**
    * Give read-only access to a single entry of the matrix.
    *
@@ -180,9 +265,9 @@ public:
    * @return The (@a row , @a col ) entry of the matrix.
    * @note Matrix indexing starts from 1 like in Matlab.
    */
-  inline const T& operator()(const uint8_t row, const uint8_t column) const
+  constexpr const T& operator()(const uint8_t row, const uint8_t column) const
   {
-    return elements_[row - 1][column - 1];
+    return elements_[(row - 1) * cols + column - 1];
   }
   /**
    * Give access to a single entry of the matrix.
@@ -192,9 +277,9 @@ public:
    * @return The (@a row , @a col ) entry of the matrix.
    * @note Matrix indexing starts from 1 like in Matlab.
    */
-  inline T& operator()(const uint8_t row, const uint8_t column)
+  constexpr T& operator()(const uint8_t row, const uint8_t column)
   {
-    return elements_[row - 1][column - 1];
+    return elements_[(row - 1) * cols + column - 1];
   }
   /**
    * Give read-only access to a single entry of the unraveled matrix.
@@ -205,11 +290,9 @@ public:
    * @note Matrix indexing starts from 1 like in Matlab and read row-by-row,
    * top-to-bottom.
    */
-  inline const T& operator()(const uint8_t lin_index) const
+  constexpr const T& operator()(const uint8_t lin_index) const
   {
-    uint8_t row = (lin_index - 1) / cols;
-    uint8_t column = (lin_index - 1) % cols;
-    return elements_[row][column];
+    return elements_[lin_index - 1];
   }
   /**
    * Give access to a single entry of the unraveled matrix.
@@ -220,35 +303,8 @@ public:
    * @note Matrix indexing starts from 1 like in Matlab and read row-by-row,
    * top-to-bottom.
    */
-  inline T& operator()(const uint8_t lin_index)
-  {
-    uint8_t row = (lin_index - 1) / cols;
-    uint8_t column = (lin_index - 1) % cols;
-    return elements_[row][column];
-  }
+  constexpr T& operator()(const uint8_t lin_index) { return elements_[lin_index - 1]; }
 
-  /**
-   * Operator for element-wise comparison (equal).
-   *
-   * @param[in] other The matrix to be compared against.
-   * @return true if each element of @c *this and @a other are all exactly equal.
-   * @warning When using floating point scalar values you probably should rather use a
-   * fuzzy comparison such as IsApprox().
-   * @see operator!=
-   * @see IsApprox()
-   */
-  bool operator==(const Matrix_t& other) const;
-  /**
-   * Operator for element-wise comparison (different).
-   *
-   * @param[in] other The matrix to be compared against.
-   * @return true if at least one element of @c *this and @a other are not exactly equal.
-   * @warning When using floating point scalar values you probably should rather use a
-   * fuzzy comparison such as IsApprox().
-   * @see operator==
-   * @see IsApprox()
-   */
-  bool operator!=(const Matrix_t& other) const;
   /**
    * Replaces @c *this by @c *this + the scalar value @a scalar.
    *
@@ -263,6 +319,13 @@ public:
    * @return A reference to @c *this.
    */
   Matrix_t& operator+=(const Matrix_t& other);
+  /**
+   * Replaces @c *this by @c *this + @a other, where @a other is a matrix expression.
+   *
+   * @param[in] other The expression to be added to @c *this.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> Matrix_t& operator+=(const MatrixExpr<ExprT>& other);
   /**
    * Replaces @c *this by @c *this - the scalar value @a scalar.
    *
@@ -277,6 +340,13 @@ public:
    * @return A reference to @c *this.
    */
   Matrix_t& operator-=(const Matrix_t& other);
+  /**
+   * Replaces @c *this by @c *this - @a other, where @a other is a matrix expression.
+   *
+   * @param[in] other The expression to be subtracted to @c *this.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> Matrix_t& operator-=(const MatrixExpr<ExprT>& other);
   /**
    * Replaces @c *this by @c *this * the scalar value @a scalar.
    *
@@ -297,7 +367,8 @@ public:
    *
    * @param[in] start_row The first row in the block.
    * @param[in] start_col The first column in the block.
-   * @param[in] other The submatrix to be used to replace the block of  @c *this.
+   * @param[in] other The submatrix (or matrix expression) to be used to replace the
+   * block of  @c *this.
    * @return A reference to @c *this.
    * @note @a block_rows must be <= m - @a start_row, likewise @a block_cols <= n -
    * @a start_col, where @f$m\times n@f$ are the dimensions of @c *this. In other words,
@@ -305,18 +376,19 @@ public:
    * @see SetFromBlock()
    * @todo example
    */
-  template <uint8_t block_rows, uint8_t block_cols>
+  template <class ExprT>
   Matrix_t& SetBlock(const uint8_t start_row, const uint8_t start_col,
-                     const Matrix<T, block_rows, block_cols>& other);
+                     const MatrixExpr<ExprT>& other);
   /**
    * Sets a column of @c *this with the elements of a 1D matrix.
    *
    * @param[in] col The index of the column to be replaced.
-   * @param[in] matrix1d The 1D vertical matrix to be used to replace the column of  @c
-   **this.
+   * @param[in] matrix1d The 1D vertical matrix (or matrix expression) to be used to
+   * replace the column of  @c *this.
    * @return A reference to @c *this.
    */
-  Matrix_t& SetCol(const uint8_t col, const Matrix<T, rows, 1>& matrix1d);
+  template <class ExprT>
+  Matrix_t& SetCol(const uint8_t col, const MatrixExpr<ExprT>& matrix1d);
   /**
    * Sets a column of @c *this with the elements of a standard vector.
    *
@@ -335,6 +407,23 @@ public:
    * @return A reference to @c *this.
    */
   Matrix_t& SetCol(const uint8_t col, const std::vector<T>& vect);
+  /**
+   * Sets a column of @c *this with a list of elements.
+   *
+   * @param[in] col The index of the column to be replaced.
+   * @param[in] vect The list of elements to be used to replace the column of @c *this.
+   * Its length must be the number of rows.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& SetCol(const uint8_t col, std::initializer_list<T> vect);
+  /**
+   * Sets a column of @c *this with the elements of a standard array.
+   *
+   * @param[in] col The index of the column to be replaced.
+   * @param[in] vect The standard array to be used to replace the column of @c *this.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& SetCol(const uint8_t col, const std::array<T, rows>& vect);
   /**
    * Replaces @c *this with a block of @a other.
    *
@@ -361,11 +450,12 @@ public:
    * Sets a row of @c *this with the elements of a 1D matrix.
    *
    * @param[in] row The index of the row to be replaced.
-   * @param[in] matrix1d The 1D horizontal matrix to be used to replace the row of  @c
-   **this.
+   * @param[in] matrix1d The 1D horizontal matrix (or matrix expression) to be used to
+   * replace the row of  @c *this.
    * @return A reference to @c *this.
    */
-  Matrix_t& SetRow(const uint8_t row, const Matrix<T, 1, cols>& matrix1d);
+  template <class ExprT>
+  Matrix_t& SetRow(const uint8_t row, const MatrixExpr<ExprT>& matrix1d);
   /**
    * Sets a row of @c *this with the elements of a standard vector.
    *
@@ -384,6 +474,23 @@ public:
    * @return A reference to @c *this.
    */
   Matrix_t& SetRow(const uint8_t row, const std::vector<T>& vect);
+  /**
+   * Sets a row of @c *this with a list of elements.
+   *
+   * @param[in] row The index of the row to be replaced.
+   * @param[in] vect The list of elements to be used to replace the row of @c *this. Its
+   * length must be the number of columns.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& SetRow(const uint8_t row, std::initializer_list<T> vect);
+  /**
+   * Sets a row of @c *this with the elements of a standard array.
+   *
+   * @param[in] row The index of the row to be replaced.
+   * @param[in] vect The standard array to be used to replace the row of @c *this.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& SetRow(const uint8_t row, const std::array<T, cols>& vect);
   /**
    * Sets the matrix to an empty matrix.
    *
@@ -405,6 +512,20 @@ public:
    * @return A reference to @c *this.
    */
   Matrix_t& Fill(const std::vector<T>& values);
+  /**
+   * Fills the matrix row-by-row with a list of elements.
+   *
+   * @param[in] values A list of @f$m\times n@f$ @a T elements.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& Fill(std::initializer_list<T> values);
+  /**
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] values A standard array of @f$m\times n@f$ @a T elements.
+   * @return A reference to @c *this.
+   */
+  Matrix_t& Fill(const std::array<T, rows * cols>& values);
 
   /**
    * Returns the transposed matrix.
@@ -455,6 +576,63 @@ public:
   Matrix<T, blk_rows, blk_cols> GetBlock(const uint8_t start_row,
                                          const uint8_t start_col) const;
 
+  /**
+   * Returns a writable view of a row of the matrix, without copying it.
+   *
+   * @param[in] row The index of the row.
+   * @return A 1-dimensional view (aka an horizontal vector) of the row.
+   * @see MatrixView
+   */
+  MatrixView<T, 1, cols, cols> Row(const uint8_t row);
+  /**
+   * Returns a read-only view of a row of the matrix, without copying it.
+   *
+   * @param[in] row The index of the row.
+   * @return A 1-dimensional view (aka an horizontal vector) of the row.
+   * @see MatrixView
+   */
+  MatrixView<const T, 1, cols, cols> Row(const uint8_t row) const;
+  /**
+   * Returns a writable view of a column of the matrix, without copying it.
+   *
+   * @param[in] col The index of the column.
+   * @return A 1-dimensional view (aka a vertical vector) of the column.
+   * @see MatrixView
+   */
+  MatrixView<T, rows, 1, cols> Col(const uint8_t col);
+  /**
+   * Returns a read-only view of a column of the matrix, without copying it.
+   *
+   * @param[in] col The index of the column.
+   * @return A 1-dimensional view (aka a vertical vector) of the column.
+   * @see MatrixView
+   */
+  MatrixView<const T, rows, 1, cols> Col(const uint8_t col) const;
+  /**
+   * Returns a writable view of a block of the matrix, without copying it.
+   *
+   * The number of rows and columns of the block are specified in the template arguments.
+   * @param[in] start_row The starting row of the block.
+   * @param[in] start_col The starting column of the block.
+   * @return A view of the block.
+   * @see MatrixView
+   */
+  template <uint8_t blk_rows, uint8_t blk_cols>
+  MatrixView<T, blk_rows, blk_cols, cols> Block(const uint8_t start_row,
+                                                const uint8_t start_col);
+  /**
+   * Returns a read-only view of a block of the matrix, without copying it.
+   *
+   * The number of rows and columns of the block are specified in the template arguments.
+   * @param[in] start_row The starting row of the block.
+   * @param[in] start_col The starting column of the block.
+   * @return A view of the block.
+   * @see MatrixView
+   */
+  template <uint8_t blk_rows, uint8_t blk_cols>
+  MatrixView<const T, blk_rows, blk_cols, cols> Block(const uint8_t start_row,
+                                                      const uint8_t start_col) const;
+
   /**
    * Check if the matrix is square, i.e. @a m = @a n.
    *
@@ -478,8 +656,10 @@ public:
    * @f]
    * where @f$\mathbf{L}@f$ is called the _Cholesky factor_ of @f$\mathbf{A}@f$, and can
    * be interpreted as a generalized square root of @f$\mathbf{A}@f$.
+   * The check never throws and does not allocate memory, so it can be performed at every
+   * control cycle.
    * @return true if matrix is positive-definite.
-   * @see Cholesky()
+   * @see Cholesky() LDLT
    */
   bool IsPositiveDefinite() const;
   /**
@@ -495,7 +675,12 @@ public:
   bool IsApprox(const Matrix<T, rows, cols>& other, const double tol = EPSILON) const;
 
 private:
-  T elements_[rows][cols]; /**< for easy internal access to matrix elements. */
+  T elements_[kStorageSize]; /**< row-major matrix elements, plus SIMD padding. */
+
+  /**
+   * Sets to zero the padding elements at the end of the storage, if any.
+   */
+  void ClearPadding();
 };
 
 ///////////////////////////////////////////////////////////////////////////////
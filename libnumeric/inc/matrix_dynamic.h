@@ -0,0 +1,496 @@
+/**
+ * @file matrix_dynamic.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the dynamic-size matrix class of the GRAB numeric library.
+ *
+ * The fixed-size matrix class needs its dimensions at compile time, which is not possible
+ * for quantities depending on run-time parameters, like the number of cables of a robot.
+ * The dynamic-size matrix offers the same interface and takes part in the same
+ * expressions of the fixed-size one, so that the two can be freely mixed:
+ * @code
+ * MatrixX<double> W(6, params.actuators.size()); // structure matrix
+ * W.Block<3, 1>(1, i) = cable.vers_n;             // fixed-size column, no copy
+ * Vector6d wrench = W * tension;                  // dynamic product, fixed-size result
+ * @endcode
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_DYNAMIC_H
+#define GRABCOMMON_LIBNUMERIC_MATRIX_DYNAMIC_H
+
+#include "matrix.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+template <typename T> struct ExprTraits<MatrixX<T>>
+{
+  using Scalar                   = T;
+  static constexpr uint8_t kRows = kDynamic;
+  static constexpr uint8_t kCols = kDynamic;
+};
+
+template <typename T> struct ExprNested<MatrixX<T>>
+{
+  using type = const MatrixX<T>&;
+};
+
+/**
+ * A Matlab-alike implementation of a matrix class whose dimensions are set at run time.
+ *
+ * Elements are stored row-by-row in a contiguous buffer, like in the fixed-size matrix.
+ * Small matrices (up to @ref kInlineSize elements) are stored inside the object itself
+ * and never touch the heap, which makes them safe to use in real-time loops. Larger ones
+ * are allocated on the heap, unless they are mapped on an external buffer (e.g. a memory
+ * pool reserved beforehand) through Map().
+ *
+ * The matrix is itself a MatrixExpr with dynamic dimensions: it can be used as operand
+ * together with fixed-size matrices, views and expressions, and its dimensions are
+ * checked at run time. Products involving a dynamic-size matrix always return a
+ * dynamic-size matrix, which can be assigned to a fixed-size one of matching dimensions.
+ *
+ * @note Indexing starts at 1 instead of 0 (like in Matlab)!
+ */
+template <typename T> class MatrixX: public MatrixExpr<MatrixX<T>>
+{
+public:
+  using Scalar = T; /**< type of the elements. */
+
+  static constexpr uint16_t kInlineSize =
+    72; /**< max number of elements stored inline (e.g. a 6x12 matrix). */
+
+  /**
+   * Default constructor of an empty 0x0 matrix.
+   */
+  MatrixX();
+  /**
+   * Constructor of a zero matrix.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   */
+  MatrixX(const uint16_t rows, const uint16_t cols);
+  /**
+   * Constructor for empty or identity matrix.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @param[in] scalar A scalar value to be duplicated on the diagonal of the matrix. Use
+   * 0 for initializing an empty matrix.
+   * @see SetZero()
+   * @see SetIdentity()
+   */
+  MatrixX(const uint16_t rows, const uint16_t cols, const T scalar);
+  /**
+   * Full constructor.
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @param[in] values A constant pointer to a constant @a T vector.
+   * @param[in] size The number of elements in the vector.
+   * @see Fill()
+   */
+  MatrixX(const uint16_t rows, const uint16_t cols, const T* values, const uint32_t size);
+  /**
+   * Full constructor.
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @param[in] values A standard @a T vector.
+   * @see Fill()
+   */
+  MatrixX(const uint16_t rows, const uint16_t cols, const std::vector<T>& values);
+  /**
+   * Full constructor.
+   * Fills the matrix row-by-row with a list of elements, without allocating them on the
+   * heap first.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @param[in] values A list of @f$m\times n@f$ @a T elements.
+   * @see Fill()
+   */
+  MatrixX(const uint16_t rows, const uint16_t cols, std::initializer_list<T> values);
+  /**
+   * Constructor from any matrix expression, including fixed-size matrices.
+   * Evaluates the expression element-by-element straight into the new matrix.
+   *
+   * @param[in] other The expression to be evaluated.
+   */
+  template <class ExprT> MatrixX(const MatrixExpr<ExprT>& other);
+  /**
+   * Copy constructor.
+   * The new matrix always owns its elements, even if @a other is mapped on an external
+   * buffer.
+   *
+   * @param[in] other The copied matrix.
+   */
+  MatrixX(const MatrixX& other);
+  /**
+   * Move constructor.
+   * Heap and external buffers are handed over without copying any element.
+   *
+   * @param[in] other The moved matrix, which is left empty.
+   */
+  MatrixX(MatrixX&& other) noexcept;
+  ~MatrixX();
+
+  /**
+   * Creates a matrix which refers to an external buffer, without copying it.
+   *
+   * The matrix reads and writes straight into @a buffer and never reallocates it, so it
+   * can not be resized beyond its original size.
+   * @param[in] buffer A row-major buffer of at least @a rows * @a cols elements.
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @return A matrix mapped on @a buffer.
+   * @warning The matrix is only valid as long as @a buffer is alive.
+   */
+  static MatrixX Map(T* buffer, const uint16_t rows, const uint16_t cols);
+  /**
+   * Creates a matrix which refers to the elements of a fixed-size matrix, without copying
+   * them.
+   *
+   * @param[in] matrix The fixed-size matrix to be mapped.
+   * @return A matrix with the same dimensions of @a matrix, mapped on its elements.
+   * @see Map()
+   */
+  template <uint8_t rows, uint8_t cols> static MatrixX Map(Matrix<T, rows, cols>& matrix);
+
+  /**
+   * Returns numbers of rows.
+   *
+   * @return A size.
+   */
+  inline uint16_t Rows() const { return rows_; }
+  /**
+   * Returns numbers of columns.
+   *
+   * @return A size.
+   */
+  inline uint16_t Cols() const { return cols_; }
+  /**
+   * Returns the matrix size, i.e. @f$m\times n@f$.
+   *
+   * @return A size.
+   */
+  inline uint32_t Size() const { return static_cast<uint32_t>(rows_) * cols_; }
+  /**
+   * Give full access to the matrix data.
+   *
+   * @return A pointer to the data of the matrix.
+   */
+  inline T* Data() { return data_; }
+  /**
+   * Give read-only access to the matrix data.
+   *
+   * @return A pointer to the data of the matrix.
+   */
+  inline const T* Data() const { return data_; }
+  /**
+   * Give read-only access to a single entry of the unraveled matrix.
+   *
+   * This is the element access used by matrix expressions.
+   * @param[in] index The 0-based linear index of the desired entry.
+   * @return The i-th entry of the matrix.
+   */
+  inline const T& Coeff(const uint32_t index) const { return data_[index]; }
+  /**
+   * Give read-only access to a single entry of the matrix.
+   *
+   * This is the element access used by matrix expressions.
+   * @param[in] row The 0-based row index of the desired entry.
+   * @param[in] col The 0-based column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the matrix.
+   */
+  inline const T& Coeff(const uint16_t row, const uint16_t col) const
+  {
+    return data_[row * cols_ + col];
+  }
+  /**
+   * Returns the matrix itself, for compatibility with matrix expressions.
+   *
+   * @return A constant reference to @c *this.
+   */
+  inline const MatrixX& Eval() const { return *this; }
+
+  /**
+   * Changes the dimensions of the matrix and sets all its elements to zero.
+   *
+   * No memory is allocated if the new size fits the current storage.
+   * @param[in] rows The new number of rows.
+   * @param[in] cols The new number of columns.
+   * @return A reference to @c *this.
+   */
+  MatrixX& Resize(const uint16_t rows, const uint16_t cols);
+
+  /**
+   * Copy assignment operator.
+   *
+   * @param[in] other The matrix to be copied.
+   * @return A reference to @c *this.
+   */
+  MatrixX& operator=(const MatrixX& other);
+  /**
+   * Move assignment operator.
+   *
+   * @param[in] other The matrix to be moved, which is left empty.
+   * @return A reference to @c *this.
+   * @note If @c *this is mapped on an external buffer, elements are copied instead.
+   */
+  MatrixX& operator=(MatrixX&& other) noexcept;
+  /**
+   * Assign operator from a matrix expression.
+   * The matrix is resized to the expression dimensions, then the expression is evaluated
+   * element-by-element straight into @c *this.
+   *
+   * @param[in] other The expression to be evaluated.
+   * @return A reference to @c *this.
+   * @note Element-wise expressions can safely refer to @c *this (e.g. `a = b - a`).
+   */
+  template <class ExprT> MatrixX& operator=(const MatrixExpr<ExprT>& other);
+  /**
+   * Give access to a single entry of the matrix.
+   *
+   * param[in] row The row index of the desired entry.
+   * param[in] col The column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the matrix.
+   */
+  inline T& operator()(const uint16_t row, const uint16_t col)
+  {
+    return data_[(row - 1) * cols_ + col - 1];
+  }
+  /**
+   * Give read-only access to a single entry of the matrix.
+   *
+   * param[in] row The row index of the desired entry.
+   * param[in] col The column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the matrix.
+   */
+  inline const T& operator()(const uint16_t row, const uint16_t col) const
+  {
+    return data_[(row - 1) * cols_ + col - 1];
+  }
+  /**
+   * Give access to a single entry of the unraveled matrix.
+   *
+   * param[in] lin_index The linear index of the desired entry.
+   * @return The i-th entry of the matrix.
+   */
+  inline T& operator()(const uint32_t lin_index) { return data_[lin_index - 1]; }
+  /**
+   * Give read-only access to a single entry of the unraveled matrix.
+   *
+   * param[in] lin_index The linear index of the desired entry.
+   * @return The i-th entry of the matrix.
+   */
+  inline const T& operator()(const uint32_t lin_index) const
+  {
+    return data_[lin_index - 1];
+  }
+  /**
+   * Operator for the sum with a scalar.
+   *
+   * @param[in] scalar The scalar value to be added to each element.
+   * @return A reference to @c *this.
+   */
+  MatrixX& operator+=(const T& scalar);
+  /**
+   * Operator for the sum with a matrix expression of the same size.
+   *
+   * @param[in] other The matrix expression to be added.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> MatrixX& operator+=(const MatrixExpr<ExprT>& other);
+  /**
+   * Operator for the subtraction of a scalar.
+   *
+   * @param[in] scalar The scalar value to be subtracted from each element.
+   * @return A reference to @c *this.
+   */
+  MatrixX& operator-=(const T& scalar);
+  /**
+   * Operator for the subtraction of a matrix expression of the same size.
+   *
+   * @param[in] other The matrix expression to be subtracted.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> MatrixX& operator-=(const MatrixExpr<ExprT>& other);
+  /**
+   * Operator for the multiplication by a scalar.
+   *
+   * @param[in] scalar The factor by which each element is multiplied.
+   * @return A reference to @c *this.
+   */
+  MatrixX& operator*=(const T& scalar);
+  /**
+   * Operator for the division by a scalar.
+   *
+   * @param[in] scalar The factor by which each element is divided.
+   * @return A reference to @c *this.
+   */
+  MatrixX& operator/=(const T& scalar);
+
+  /**
+   * Sets all the elements of the matrix to zero.
+   *
+   * @return A reference to @c *this.
+   */
+  MatrixX& SetZero();
+  /**
+   * Sets the matrix to identity.
+   *
+   * If the matrix is not square, ones are placed on the main diagonal only.
+   * @return A reference to @c *this.
+   */
+  MatrixX& SetIdentity();
+  /**
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] values A constant pointer to a constant @a T vector.
+   * @param[in] size The number of elements in the vector, equal to Size().
+   * @return A reference to @c *this.
+   */
+  MatrixX& Fill(const T* values, const uint32_t size);
+  /**
+   * Fills the matrix row-by-row with the elements of @a values.
+   *
+   * @param[in] values A standard @a T vector, with Size() elements.
+   * @return A reference to @c *this.
+   */
+  MatrixX& Fill(const std::vector<T>& values);
+  /**
+   * Fills the matrix row-by-row with a list of elements.
+   *
+   * @param[in] values A list of @a T elements, with Size() elements.
+   * @return A reference to @c *this.
+   */
+  MatrixX& Fill(std::initializer_list<T> values);
+  /**
+   * Fills the matrix row-by-row with the elements of a standard array.
+   *
+   * @param[in] values A standard array of @a T elements, with Size() elements.
+   * @return A reference to @c *this.
+   */
+  template <size_t size> MatrixX& Fill(const std::array<T, size>& values);
+  /**
+   * Replaces a block of the matrix with a matrix expression.
+   *
+   * @param[in] start_row The starting row of the block to be replaced.
+   * @param[in] start_col The starting column of the block to be replaced.
+   * @param[in] other The matrix or matrix expression to be copied in the block.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT>
+  MatrixX& SetBlock(const uint16_t start_row, const uint16_t start_col,
+                    const MatrixExpr<ExprT>& other);
+  /**
+   * Replaces a row of the matrix.
+   *
+   * @param[in] row The index of the row to be replaced.
+   * @param[in] matrix1d An horizontal vector or vector expression with Cols() elements.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT>
+  MatrixX& SetRow(const uint16_t row, const MatrixExpr<ExprT>& matrix1d);
+  /**
+   * Replaces a column of the matrix.
+   *
+   * @param[in] col The index of the column to be replaced.
+   * @param[in] matrix1d A vertical vector or vector expression with Rows() elements.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT>
+  MatrixX& SetCol(const uint16_t col, const MatrixExpr<ExprT>& matrix1d);
+
+  /**
+   * Extracts a row of the matrix.
+   *
+   * @param[in] row The index of the row.
+   * @return A @f$1\times n@f$ matrix.
+   */
+  MatrixX GetRow(const uint16_t row) const;
+  /**
+   * Extracts a column of the matrix.
+   *
+   * @param[in] col The index of the column.
+   * @return A @f$m\times 1@f$ matrix.
+   */
+  MatrixX GetCol(const uint16_t col) const;
+  /**
+   * Extracts a block of the matrix, whose dimensions are known at compile time.
+   *
+   * @param[in] start_row The starting row of the block.
+   * @param[in] start_col The starting column of the block.
+   * @return A fixed-size copy of the block.
+   */
+  template <uint8_t blk_rows, uint8_t blk_cols>
+  Matrix<T, blk_rows, blk_cols> GetBlock(const uint16_t start_row,
+                                         const uint16_t start_col) const;
+  /**
+   * Returns a writable view of a block of the matrix, without copying it.
+   *
+   * The number of rows and columns of the block are specified in the template arguments,
+   * so that the view can be mixed with fixed-size matrices.
+   * @param[in] start_row The starting row of the block.
+   * @param[in] start_col The starting column of the block.
+   * @return A view of the block.
+   * @see MatrixView
+   */
+  template <uint8_t blk_rows, uint8_t blk_cols>
+  MatrixView<T, blk_rows, blk_cols, kDynamic> Block(const uint16_t start_row,
+                                                    const uint16_t start_col);
+  /**
+   * Returns a read-only view of a block of the matrix, without copying it.
+   *
+   * @param[in] start_row The starting row of the block.
+   * @param[in] start_col The starting column of the block.
+   * @return A view of the block.
+   * @see MatrixView
+   */
+  template <uint8_t blk_rows, uint8_t blk_cols>
+  MatrixView<const T, blk_rows, blk_cols, kDynamic> Block(const uint16_t start_row,
+                                                          const uint16_t start_col) const;
+
+  /**
+   * Returns the transposed matrix.
+   *
+   * @return A @f$n\times m@f$ matrix.
+   */
+  MatrixX Transpose() const;
+  /**
+   * Checks if the matrix is square.
+   *
+   * @return true if the number of rows equals the number of columns.
+   */
+  inline bool IsSquare() const { return rows_ == cols_; }
+
+private:
+  T inline_elements_[kInlineSize]; /**< inline storage of small matrices. */
+
+  T* data_;           /**< row-major matrix elements. */
+  uint16_t rows_;     /**< number of rows. */
+  uint16_t cols_;     /**< number of columns. */
+  uint32_t capacity_; /**< number of elements which fit the current storage. */
+  bool external_;     /**< whether elements are stored in an external buffer. */
+
+  /**
+   * Makes sure the storage fits @a size elements, reallocating it if needed.
+   * Previous elements are not preserved.
+   */
+  void Reserve(const uint32_t size);
+  /**
+   * Releases heap storage, if any, and falls back to inline storage.
+   */
+  void Release();
+};
+
+} //  end namespace grabnum
+
+#include "../src/matrix_dynamic.tcc"
+
+#endif // GRABCOMMON_LIBNUMERIC_MATRIX_DYNAMIC_H
@@ -0,0 +1,491 @@
+/**
+ * @file matrix_expressions.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the expression templates used by the matrix class of the GRAB
+ * numeric library.
+ *
+ * Element-wise operations between matrices (sums, differences, scalar products, etc.)
+ * do not return a matrix, but a lightweight expression object which only stores
+ * references to its operands. The whole expression is evaluated in a single loop when it
+ * is assigned to a matrix, so that a compound expression like
+ * @code
+ * vers_n = vers_u * cos_psi + vers_k * sin_psi;
+ * @endcode
+ * does not create any temporary matrix.
+ *
+ * Matrix products are not element-wise, so they are always evaluated eagerly and return a
+ * plain matrix.
+ *
+ * Dynamic-size matrices take part in expressions too: their dimensions are marked as
+ * @ref kDynamic at compile time and checked at run time instead.
+ * @warning Since expressions hold references to their operands, they should never be
+ * stored in an @c auto variable, but always assigned to a matrix.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_EXPRESSIONS_H
+#define GRABCOMMON_LIBNUMERIC_MATRIX_EXPRESSIONS_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <type_traits>
+
+#include "common.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+template <typename T, uint8_t rows, uint8_t cols> class Matrix;
+template <typename T> class MatrixX;
+
+/**
+ * Value of a compile-time dimension which is only known at run time.
+ */
+static constexpr uint8_t kDynamic = 0;
+
+/**
+ * @brief Compile-time properties of a matrix expression.
+ *
+ * Each specialization exposes the scalar type @c Scalar and the dimensions @c kRows and
+ * @c kCols of the expression, which are @ref kDynamic for dynamic-size expressions.
+ */
+template <class ExprT> struct ExprTraits;
+
+template <typename T, uint8_t rows, uint8_t cols> struct ExprTraits<Matrix<T, rows, cols>>
+{
+  using Scalar                   = T;
+  static constexpr uint8_t kRows = rows;
+  static constexpr uint8_t kCols = cols;
+};
+
+/**
+ * @brief Type used by an expression to store one of its operands.
+ *
+ * Matrices are stored by reference, while expressions are small objects and are stored
+ * by value, so that the temporary nodes of a compound expression are not left dangling.
+ */
+template <class ExprT> struct ExprNested
+{
+  using type = const ExprT;
+};
+
+template <typename T, uint8_t rows, uint8_t cols> struct ExprNested<Matrix<T, rows, cols>>
+{
+  using type = const Matrix<T, rows, cols>&;
+};
+
+/**
+ * @brief Matrix type holding the result of an expression with the given dimensions.
+ *
+ * This is a fixed-size matrix when both dimensions are known at compile time, a
+ * dynamic-size matrix otherwise.
+ */
+template <typename T, uint8_t rows, uint8_t cols> struct PlainObject
+{
+  using type = typename std::conditional<rows == kDynamic || cols == kDynamic, MatrixX<T>,
+                                         Matrix<T, rows, cols>>::type;
+};
+
+/**
+ * Whether two compile-time dimensions may match, i.e. they are equal or at least one of
+ * them is only known at run time.
+ *
+ * @param[in] dim1 A compile-time dimension.
+ * @param[in] dim2 A compile-time dimension.
+ * @return true if @a dim1 and @a dim2 may match.
+ */
+constexpr bool DimsMatch(const uint8_t dim1, const uint8_t dim2)
+{
+  return dim1 == dim2 || dim1 == kDynamic || dim2 == kDynamic;
+}
+
+/**
+ * @brief Whether two expressions may have the same size.
+ *
+ * Only compile-time dimensions are checked here, dynamic ones are checked at run time.
+ */
+template <class LhsT, class RhsT> struct HaveSameSize
+{
+  static constexpr bool value =
+    DimsMatch(ExprTraits<LhsT>::kRows, ExprTraits<RhsT>::kRows) &&
+    DimsMatch(ExprTraits<LhsT>::kCols, ExprTraits<RhsT>::kCols);
+};
+
+/**
+ * @brief Whether an expression has at least one dimension only known at run time.
+ */
+template <class ExprT> struct IsDynamic
+{
+  static constexpr bool value =
+    ExprTraits<ExprT>::kRows == kDynamic || ExprTraits<ExprT>::kCols == kDynamic;
+};
+
+/**
+ * @brief Base class of all matrix expressions, including the matrix class itself.
+ *
+ * This is a CRTP base which gives access to the actual expression type and provides
+ * some read-only utilities to all expressions. Every derived class must implement:
+ * - `Rows()` and `Cols()`, returning the run-time dimensions of the expression;
+ * - `Coeff(index)`, returning the element at the given 0-based row-major linear index;
+ * - `Coeff(row, col)`, returning the element at the given 0-based position.
+ * .
+ */
+template <class ExprT> class MatrixExpr
+{
+public:
+  using Scalar = typename ExprTraits<ExprT>::Scalar; /**< type of the elements. */
+  using PlainType =
+    typename PlainObject<Scalar, ExprTraits<ExprT>::kRows, ExprTraits<ExprT>::kCols>::
+      type; /**< matrix type an expression evaluates to. */
+
+  /**
+   * Gives access to the actual expression.
+   *
+   * @return A constant reference to the derived expression.
+   */
+  constexpr const ExprT& Self() const { return static_cast<const ExprT&>(*this); }
+
+  /**
+   * Evaluates the expression into a matrix.
+   *
+   * @return The evaluated matrix.
+   */
+  constexpr PlainType Eval() const { return PlainType(Self()); }
+
+  /**
+   * Returns the value of a single entry of the expression.
+   *
+   * param[in] row The row index of the desired entry.
+   * param[in] col The column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the expression.
+   * @note Indexing starts from 1 like in Matlab.
+   */
+  constexpr Scalar operator()(const uint8_t row, const uint8_t col) const
+  {
+    return Self().Coeff(static_cast<uint8_t>(row - 1), static_cast<uint8_t>(col - 1));
+  }
+  /**
+   * Returns the value of a single entry of the unraveled expression.
+   *
+   * param[in] lin_index The linear index of the desired entry.
+   * @return The i-th entry of the expression.
+   * @note Indexing starts from 1 like in Matlab and read row-by-row, top-to-bottom.
+   */
+  constexpr Scalar operator()(const uint8_t lin_index) const
+  {
+    return Self().Coeff(static_cast<uint16_t>(lin_index - 1));
+  }
+
+  /**
+   * Returns the transposed of the evaluated expression.
+   *
+   * @return The transposed matrix.
+   */
+  typename PlainObject<Scalar, ExprTraits<ExprT>::kCols, ExprTraits<ExprT>::kRows>::type
+  Transpose() const
+  {
+    return Eval().Transpose();
+  }
+
+  /**
+   * Fuzzy element-wise comparison with another expression of the same size.
+   *
+   * @param[in] other The expression to be compared against.
+   * @param[in] tol (optional) The difference below which two single entries are
+   * considered equal.
+   * @return true if each element of the two expressions are all equal up to a certain
+   * tolerance.
+   */
+  template <class OtherT>
+  bool IsApprox(const MatrixExpr<OtherT>& other, const double tol = EPSILON) const
+  {
+    static_assert(HaveSameSize<ExprT, OtherT>::value,
+                  "ERROR: matrix dimensions mismatch in IsApprox()!");
+    assert(Self().Rows() == other.Self().Rows() && Self().Cols() == other.Self().Cols());
+    const uint32_t size = static_cast<uint32_t>(Self().Rows()) * Self().Cols();
+    for (uint32_t i = 0; i < size; ++i)
+      if (!IsClose<Scalar>(Self().Coeff(i), other.Self().Coeff(i), tol))
+        return false;
+    return true;
+  }
+};
+
+//----- Element-wise operations ------------------------------------------------------//
+
+/**
+ * @brief Element-wise sum.
+ */
+struct SumOp
+{
+  template <typename T> constexpr T operator()(const T& lhs, const T& rhs) const
+  {
+    return lhs + rhs;
+  }
+};
+
+/**
+ * @brief Element-wise difference.
+ */
+struct DiffOp
+{
+  template <typename T> constexpr T operator()(const T& lhs, const T& rhs) const
+  {
+    return lhs - rhs;
+  }
+};
+
+/**
+ * @brief Element-wise product.
+ */
+struct CwiseProdOp
+{
+  template <typename T> constexpr T operator()(const T& lhs, const T& rhs) const
+  {
+    return lhs * rhs;
+  }
+};
+
+/**
+ * @brief Element-wise opposite.
+ */
+template <typename T> struct NegateOp
+{
+  constexpr T operator()(const T& value) const { return -value; }
+};
+
+/**
+ * @brief Sum of each element with a scalar.
+ */
+template <typename T> struct ScalarSumOp
+{
+  T scalar; /**< scalar value to be added. */
+
+  constexpr T operator()(const T& value) const { return value + scalar; }
+};
+
+/**
+ * @brief Difference between each element and a scalar.
+ */
+template <typename T> struct ScalarDiffOp
+{
+  T scalar; /**< scalar value to be subtracted. */
+
+  constexpr T operator()(const T& value) const { return value - scalar; }
+};
+
+/**
+ * @brief Difference between a scalar and each element.
+ */
+template <typename T> struct ScalarRDiffOp
+{
+  T scalar; /**< scalar value each element is subtracted from. */
+
+  constexpr T operator()(const T& value) const { return scalar - value; }
+};
+
+/**
+ * @brief Product of each element by a scalar.
+ */
+template <typename T> struct ScalarProdOp
+{
+  T scalar; /**< scalar factor. */
+
+  constexpr T operator()(const T& value) const { return value * scalar; }
+};
+
+/**
+ * @brief Quotient of each element by a scalar.
+ */
+template <typename T> struct ScalarQuotOp
+{
+  T scalar; /**< scalar divisor. */
+
+  constexpr T operator()(const T& value) const { return value / scalar; }
+};
+
+//----- Expression nodes -------------------------------------------------------------//
+
+template <class OpT, class LhsT, class RhsT> class CwiseBinaryExpr;
+template <class OpT, class ArgT> class CwiseUnaryExpr;
+
+template <class OpT, class LhsT, class RhsT>
+struct ExprTraits<CwiseBinaryExpr<OpT, LhsT, RhsT>>
+{
+  // A fixed dimension of either operand is known for the whole expression.
+  using Scalar                   = typename ExprTraits<LhsT>::Scalar;
+  static constexpr uint8_t kRows = ExprTraits<LhsT>::kRows != kDynamic
+                                     ? ExprTraits<LhsT>::kRows
+                                     : ExprTraits<RhsT>::kRows;
+  static constexpr uint8_t kCols = ExprTraits<LhsT>::kCols != kDynamic
+                                     ? ExprTraits<LhsT>::kCols
+                                     : ExprTraits<RhsT>::kCols;
+};
+
+template <class OpT, class ArgT> struct ExprTraits<CwiseUnaryExpr<OpT, ArgT>>
+{
+  using Scalar                   = typename ExprTraits<ArgT>::Scalar;
+  static constexpr uint8_t kRows = ExprTraits<ArgT>::kRows;
+  static constexpr uint8_t kCols = ExprTraits<ArgT>::kCols;
+};
+
+/**
+ * @brief Lazy element-wise operation between two expressions of the same size and type.
+ */
+template <class OpT, class LhsT, class RhsT>
+class CwiseBinaryExpr: public MatrixExpr<CwiseBinaryExpr<OpT, LhsT, RhsT>>
+{
+  static_assert(HaveSameSize<LhsT, RhsT>::value,
+                "ERROR: matrix dimensions mismatch in element-wise operation!");
+  static_assert(std::is_same<typename ExprTraits<LhsT>::Scalar,
+                             typename ExprTraits<RhsT>::Scalar>::value,
+                "ERROR: matrix types mismatch in element-wise operation!");
+
+public:
+  using Scalar = typename ExprTraits<LhsT>::Scalar; /**< type of the elements. */
+
+  /**
+   * Full constructor.
+   *
+   * @param[in] lhs The left-hand side operand.
+   * @param[in] rhs The right-hand side operand.
+   */
+  constexpr CwiseBinaryExpr(const LhsT& lhs, const RhsT& rhs) : lhs_(lhs), rhs_(rhs)
+  {
+    assert(lhs.Rows() == rhs.Rows() && lhs.Cols() == rhs.Cols());
+  }
+
+  constexpr uint16_t Rows() const { return lhs_.Rows(); }
+  constexpr uint16_t Cols() const { return lhs_.Cols(); }
+
+  constexpr Scalar Coeff(const uint32_t index) const
+  {
+    return OpT()(lhs_.Coeff(index), rhs_.Coeff(index));
+  }
+  constexpr Scalar Coeff(const uint16_t row, const uint16_t col) const
+  {
+    return OpT()(lhs_.Coeff(row, col), rhs_.Coeff(row, col));
+  }
+
+private:
+  typename ExprNested<LhsT>::type lhs_;
+  typename ExprNested<RhsT>::type rhs_;
+};
+
+/**
+ * @brief Lazy element-wise operation on a single expression.
+ *
+ * The operation object may carry a state, such as a scalar factor.
+ */
+template <class OpT, class ArgT>
+class CwiseUnaryExpr: public MatrixExpr<CwiseUnaryExpr<OpT, ArgT>>
+{
+public:
+  using Scalar = typename ExprTraits<ArgT>::Scalar; /**< type of the elements. */
+
+  /**
+   * Full constructor.
+   *
+   * @param[in] arg The operand.
+   * @param[in] op The operation to be applied to each element of @a arg.
+   */
+  constexpr CwiseUnaryExpr(const ArgT& arg, const OpT& op) : arg_(arg), op_(op) {}
+
+  constexpr uint16_t Rows() const { return arg_.Rows(); }
+  constexpr uint16_t Cols() const { return arg_.Cols(); }
+
+  constexpr Scalar Coeff(const uint32_t index) const { return op_(arg_.Coeff(index)); }
+  constexpr Scalar Coeff(const uint16_t row, const uint16_t col) const
+  {
+    return op_(arg_.Coeff(row, col));
+  }
+
+private:
+  typename ExprNested<ArgT>::type arg_;
+  OpT op_;
+};
+
+/**
+ * @brief Whether the product of two fixed-size expressions is a row-column matrix
+ * product.
+ */
+template <class LhsT, class RhsT> struct IsMatrixProduct
+{
+  static constexpr bool value = !IsDynamic<LhsT>::value && !IsDynamic<RhsT>::value &&
+                                ExprTraits<LhsT>::kCols == ExprTraits<RhsT>::kRows;
+};
+
+/**
+ * @brief Whether the product of two expressions, at least one of which has dynamic size,
+ * is a row-column matrix product.
+ *
+ * Products involving a dynamic-size expression are always row-column products.
+ */
+template <class LhsT, class RhsT> struct IsDynamicProduct
+{
+  static constexpr bool value =
+    (IsDynamic<LhsT>::value || IsDynamic<RhsT>::value) &&
+    DimsMatch(ExprTraits<LhsT>::kCols, ExprTraits<RhsT>::kRows);
+};
+
+/**
+ * @brief Whether the product of two expressions is an element-wise vector product.
+ *
+ * This is the case of two vectors with the same orientation and size, which can not be
+ * multiplied row-by-column.
+ */
+template <class LhsT, class RhsT> struct IsCwiseProduct
+{
+  static constexpr bool value =
+    !IsMatrixProduct<LhsT, RhsT>::value && !IsDynamic<LhsT>::value &&
+    !IsDynamic<RhsT>::value && ExprTraits<LhsT>::kRows == ExprTraits<RhsT>::kRows &&
+    ExprTraits<LhsT>::kCols == ExprTraits<RhsT>::kCols &&
+    (ExprTraits<LhsT>::kRows == 1 || ExprTraits<LhsT>::kCols == 1);
+};
+
+//----- Comparison -------------------------------------------------------------------//
+
+/**
+ * Operator for element-wise comparison (equal).
+ *
+ * Operands can be matrices or expressions of any type, as long as they have the same
+ * dimensions. Elements of different types are compared without casting them to a
+ * common matrix type first.
+ * @param[in] lhs A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] rhs A @f$m\times n@f$ matrix or matrix expression.
+ * @return true if each element of @a lhs and @a rhs are all exactly equal.
+ * @warning When using floating point scalar values you probably should rather use a
+ * fuzzy comparison such as Matrix::IsApprox().
+ */
+template <class LhsT, class RhsT>
+constexpr bool operator==(const MatrixExpr<LhsT>& lhs, const MatrixExpr<RhsT>& rhs)
+{
+  static_assert(HaveSameSize<LhsT, RhsT>::value,
+                "ERROR: matrix dimensions mismatch in comparison!");
+  if (lhs.Self().Rows() != rhs.Self().Rows() || lhs.Self().Cols() != rhs.Self().Cols())
+    return false;
+  const uint32_t size = static_cast<uint32_t>(lhs.Self().Rows()) * lhs.Self().Cols();
+  for (uint32_t i = 0; i < size; ++i)
+    if (lhs.Self().Coeff(i) != rhs.Self().Coeff(i))
+      return false;
+  return true;
+}
+
+/**
+ * Operator for element-wise comparison (different).
+ *
+ * @param[in] lhs A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] rhs A @f$m\times n@f$ matrix or matrix expression.
+ * @return true if at least one element of @a lhs and @a rhs are not exactly equal.
+ * @see operator==()
+ */
+template <class LhsT, class RhsT>
+constexpr bool operator!=(const MatrixExpr<LhsT>& lhs, const MatrixExpr<RhsT>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+} //  end namespace grabnum
+
+#endif // GRABCOMMON_LIBNUMERIC_MATRIX_EXPRESSIONS_H
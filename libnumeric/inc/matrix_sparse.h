@@ -0,0 +1,400 @@
+/**
+ * @file matrix_sparse.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the sparse matrix class of the GRAB numeric library and the
+ * structured linear solvers working on it.
+ *
+ * The structure matrix of a robot with many cables, or the matrices of several robots
+ * simulated together, are mostly made of zeros: each cable only couples a few
+ * coordinates, and different robots are not coupled at all. Storing only the non-zero
+ * entries, and factorizing only the band or the independent blocks they form, makes
+ * cost and memory grow linearly with the size of the model instead of cubically:
+ * @code
+ * std::vector<Triplet<double>> entries = {{1, 1, 4.0}, {1, 2, -1.0}, ...};
+ * SparseMatrix<double> A(n, n, entries);
+ * SparseLU<double> lu(A);              // dense, banded or block solver, chosen for A
+ * MatrixX<double> x = lu.Solve(b);
+ * @endcode
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_SPARSE_H
+#define GRABCOMMON_LIBNUMERIC_MATRIX_SPARSE_H
+
+#include <stdexcept>
+#include <vector>
+
+#include "matrix_dynamic.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+/**
+ * @brief A single entry of a sparse matrix, as (row, column, value).
+ *
+ * @note Indexing starts at 1, like in the matrix class.
+ */
+template <typename T> struct Triplet
+{
+  uint16_t row; /**< row index of the entry. */
+  uint16_t col; /**< column index of the entry. */
+  T value;      /**< value of the entry. */
+};
+
+/**
+ * A sparse matrix in _compressed sparse row_ (CSR) format.
+ *
+ * Only the stored entries are kept, row by row, each row sorted by column index. The
+ * pattern of stored entries is fixed at construction, while their values can be updated
+ * in place through Values(), e.g. to refresh a structure matrix at each control cycle
+ * without any allocation.
+ *
+ * @note Indexing starts at 1 instead of 0 (like in Matlab)!
+ */
+template <typename T> class SparseMatrix
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in SparseMatrix!");
+
+public:
+  /**
+   * Default constructor of an empty 0x0 matrix.
+   */
+  SparseMatrix() : SparseMatrix(0, 0) {}
+  /**
+   * Constructor of a matrix with no stored entries, i.e. a zero matrix.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   */
+  SparseMatrix(const uint16_t rows, const uint16_t cols);
+  /**
+   * Constructor from a list of entries, in any order.
+   *
+   * @param[in] rows The number of rows.
+   * @param[in] cols The number of columns.
+   * @param[in] entries The entries to be stored. Entries with the same indices are
+   * summed.
+   */
+  SparseMatrix(const uint16_t rows, const uint16_t cols,
+               const std::vector<Triplet<T>>& entries);
+  /**
+   * Constructor from a dense matrix or matrix expression.
+   *
+   * @param[in] dense The matrix to be compressed.
+   * @param[in] tol (optional) The absolute value up to which an entry is not stored.
+   */
+  template <class ExprT>
+  explicit SparseMatrix(const MatrixExpr<ExprT>& dense, const T tol = 0);
+
+  /**
+   * Returns the number of rows.
+   *
+   * @return The number of rows.
+   */
+  inline uint16_t Rows() const { return rows_; }
+  /**
+   * Returns the number of columns.
+   *
+   * @return The number of columns.
+   */
+  inline uint16_t Cols() const { return cols_; }
+  /**
+   * Returns the number of stored entries.
+   *
+   * @return The number of stored entries.
+   */
+  inline uint32_t NonZeros() const { return static_cast<uint32_t>(values_.size()); }
+
+  /**
+   * Returns the value of a single entry.
+   *
+   * @param[in] row The row index of the entry.
+   * @param[in] col The column index of the entry.
+   * @return The (@a row , @a col ) entry, zero if it is not stored.
+   */
+  T operator()(const uint16_t row, const uint16_t col) const;
+
+  /**
+   * Returns the offsets of the first stored entry of each row, followed by the number of
+   * stored entries.
+   *
+   * @return @a rows + 1 offsets into ColIndices() and Values().
+   */
+  inline const std::vector<uint32_t>& RowOffsets() const { return row_offsets_; }
+  /**
+   * Returns the column indices of the stored entries, starting from 0.
+   *
+   * @return The column index of each stored entry.
+   */
+  inline const std::vector<uint16_t>& ColIndices() const { return col_indices_; }
+  /**
+   * Returns the values of the stored entries, which can be modified in place.
+   *
+   * @return The value of each stored entry.
+   */
+  inline std::vector<T>& Values() { return values_; }
+  inline const std::vector<T>& Values() const { return values_; }
+
+  /**
+   * Returns the largest distance of a stored entry below the diagonal.
+   *
+   * @return The number of non-zero sub-diagonals.
+   */
+  uint16_t LowerBandwidth() const;
+  /**
+   * Returns the largest distance of a stored entry above the diagonal.
+   *
+   * @return The number of non-zero super-diagonals.
+   */
+  uint16_t UpperBandwidth() const;
+
+  /**
+   * Returns the transposed matrix, with the same stored entries.
+   *
+   * @return The transposed sparse matrix.
+   */
+  SparseMatrix Transpose() const;
+  /**
+   * Expands the matrix into a dense one.
+   *
+   * @return The dense matrix.
+   */
+  MatrixX<T> ToDense() const;
+
+private:
+  uint16_t rows_;
+  uint16_t cols_;
+  std::vector<uint32_t> row_offsets_;
+  std::vector<uint16_t> col_indices_;
+  std::vector<T> values_;
+};
+
+/**
+ * Product of a sparse matrix with a dense matrix or matrix expression, usually a vector.
+ *
+ * @param[in] lhs A @f$m\times n@f$ sparse matrix.
+ * @param[in] rhs A @f$n\times p@f$ matrix or matrix expression.
+ * @return The @f$m\times p@f$ dense product, which costs @f$O(p\,nnz)@f$ only.
+ */
+template <typename T, class ExprT>
+MatrixX<T> operator*(const SparseMatrix<T>& lhs, const MatrixExpr<ExprT>& rhs);
+
+/**
+ * @brief _LU decomposition_ with partial pivoting of a square banded matrix.
+ *
+ * Given a @f$n\times n@f$ matrix @f$\mathbf{A}@f$ whose entries are zero farther than
+ * @f$k_l@f$ positions below and @f$k_u@f$ positions above the diagonal, the factors
+ * @f$\mathbf{L}@f$ and @f$\mathbf{U}@f$ of
+ * @f$\mathbf{P}\mathbf{A} = \mathbf{L}\mathbf{U}@f$ stay within a band of @f$k_l@f$
+ * and @f$k_l + k_u@f$ diagonals respectively. Both are stored in place of the band
+ * only, so that the factorization costs
+ * @f$O(n k_l (k_l + k_u))@f$ and each solution @f$O(n (k_l + k_u))@f$. When the band
+ * covers the whole matrix, it reduces to a dense LU.
+ */
+template <typename T> class BandedLU
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in BandedLU!");
+
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  BandedLU() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @see Compute()
+   */
+  explicit BandedLU(const SparseMatrix<T>& matrix) { Compute(matrix); }
+
+  /**
+   * Factorizes a matrix, discarding any previous factorization.
+   *
+   * The band is the smallest one containing all the stored entries of @a matrix. The
+   * storage of the previous factorization is reused whenever large enough.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @return A reference to @c *this.
+   */
+  BandedLU& Compute(const SparseMatrix<T>& matrix);
+
+  /**
+   * Returns the size of the factorized matrix.
+   *
+   * @return The number of rows (and columns) @f$n@f$.
+   */
+  inline uint16_t Size() const { return size_; }
+  /**
+   * Returns the number of sub-diagonals of the factorized matrix.
+   *
+   * @return The lower bandwidth @f$k_l@f$.
+   */
+  inline uint16_t LowerBandwidth() const { return lower_; }
+  /**
+   * Returns the number of super-diagonals of the factorized matrix.
+   *
+   * @return The upper bandwidth @f$k_u@f$.
+   */
+  inline uint16_t UpperBandwidth() const { return upper_; }
+
+  /**
+   * Checks whether the factorized matrix is invertible.
+   *
+   * @param[in] tol (optional) The absolute value below which a pivot is considered zero.
+   * @return true if all pivots are greater than @a tol in absolute value.
+   */
+  bool IsInvertible(const double tol = EPSILON) const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{x} = \mathbf{b}@f$ in place.
+   *
+   * @param[in,out] vect A pointer to the @f$n@f$ constant terms @f$\mathbf{b}@f$, which
+   * are replaced by the solution @f$\mathbf{x}@f$.
+   * @param[in] stride (optional) The distance between two consecutive elements of
+   * @a vect.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  void SolveInPlace(T* vect, const uint32_t stride = 1) const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{X} = \mathbf{B}@f$.
+   *
+   * @param[in] rhs A @f$n\times p@f$ matrix or matrix expression @f$\mathbf{B}@f$,
+   * usually a vector.
+   * @return The @f$n\times p@f$ solution @f$\mathbf{X}@f$.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  template <class ExprT> MatrixX<T> Solve(const MatrixExpr<ExprT>& rhs) const;
+
+private:
+  uint16_t size_  = 0; /**< size of the factorized matrix. */
+  uint16_t lower_ = 0; /**< sub-diagonals of A and L. */
+  uint16_t upper_ = 0; /**< super-diagonals of A. */
+  uint16_t fill_  = 0; /**< super-diagonals of U, i.e. lower_ + upper_ at most. */
+  uint16_t width_ = 0; /**< stored diagonals per row, i.e. lower_ + fill_ + 1. */
+  std::vector<T> band_;          /**< row i stores columns i - lower_ to i + fill_. */
+  std::vector<uint16_t> pivots_; /**< row swapped with the i-th one at the i-th step. */
+  bool singular_ = false;        /**< whether the factorized matrix is singular. */
+
+  inline T& At(const uint16_t row, const uint16_t col)
+  {
+    return band_[static_cast<size_t>(row) * width_ + col + lower_ - row];
+  }
+  inline const T& At(const uint16_t row, const uint16_t col) const
+  {
+    return band_[static_cast<size_t>(row) * width_ + col + lower_ - row];
+  }
+};
+
+/**
+ * @brief Structure of a sparse matrix exploited by SparseLU.
+ */
+enum SparseStructure
+{
+  DENSE,         /**< no useful structure, factorized as a whole. */
+  BANDED,        /**< entries concentrated around the diagonal. */
+  BLOCK_DIAGONAL /**< independent blocks, e.g. several robots, each one factorized on
+                     its own. */
+};
+
+/**
+ * Selects the cheapest way to factorize a square sparse matrix.
+ *
+ * Unknowns are first split into independent groups, i.e. the connected components of the
+ * pattern of @f$\mathbf{A} + \mathbf{A}^T@f$. Then, a matrix made of more than one group
+ * is block-diagonal up to a permutation, and a matrix whose band is narrow enough to
+ * save at least half of the dense cost is banded. Small matrices, which fit in cache
+ * anyway, are always dense.
+ *
+ * @param[in] matrix A @f$n\times n@f$ sparse matrix.
+ * @return The structure to be exploited.
+ */
+template <typename T>
+SparseStructure SelectSparseStructure(const SparseMatrix<T>& matrix);
+
+/**
+ * @brief LU factorization of a square sparse matrix, exploiting its structure.
+ *
+ * According to SelectSparseStructure(), the matrix is factorized by a single dense
+ * LU, by a single banded LU, or, if it is block-diagonal up to a permutation, by one
+ * banded LU per block. In the latter case each block is solved on its own, so that the
+ * cost grows linearly with the number of blocks (e.g. of robots), and each block also
+ * benefits from its own band if any.
+ */
+template <typename T> class SparseLU
+{
+public:
+  /**
+   * Default constructor of an empty decomposition.
+   * Call Compute() before using it.
+   */
+  SparseLU() {}
+  /**
+   * Full constructor.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @see Compute()
+   */
+  explicit SparseLU(const SparseMatrix<T>& matrix) { Compute(matrix); }
+
+  /**
+   * Factorizes a matrix, discarding any previous factorization.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @return A reference to @c *this.
+   */
+  SparseLU& Compute(const SparseMatrix<T>& matrix);
+  /**
+   * Factorizes a matrix, discarding any previous factorization, with a given structure.
+   *
+   * @param[in] matrix The @f$n\times n@f$ matrix to be factorized.
+   * @param[in] structure The structure to be exploited, e.g. to compare alternatives.
+   * @return A reference to @c *this.
+   */
+  SparseLU& Compute(const SparseMatrix<T>& matrix, const SparseStructure structure);
+
+  /**
+   * Returns the structure exploited by the factorization.
+   *
+   * @return The structure of the factorized matrix.
+   */
+  inline SparseStructure Structure() const { return structure_; }
+  /**
+   * Returns the number of independently factorized blocks.
+   *
+   * @return The number of blocks, 1 unless the structure is @ref BLOCK_DIAGONAL.
+   */
+  inline uint16_t Blocks() const { return static_cast<uint16_t>(blocks_.size()); }
+
+  /**
+   * Checks whether the factorized matrix is invertible.
+   *
+   * @param[in] tol (optional) The absolute value below which a pivot is considered zero.
+   * @return true if all pivots are greater than @a tol in absolute value.
+   */
+  bool IsInvertible(const double tol = EPSILON) const;
+  /**
+   * Solves the linear system @f$\mathbf{A}\mathbf{X} = \mathbf{B}@f$.
+   *
+   * @param[in] rhs A @f$n\times p@f$ matrix or matrix expression @f$\mathbf{B}@f$,
+   * usually a vector.
+   * @return The @f$n\times p@f$ solution @f$\mathbf{X}@f$.
+   * @note Throws a @c std::invalid_argument exception if the matrix is singular.
+   */
+  template <class ExprT> MatrixX<T> Solve(const MatrixExpr<ExprT>& rhs) const;
+
+private:
+  SparseStructure structure_ = DENSE;
+  std::vector<BandedLU<T>> blocks_;
+  std::vector<uint16_t> block_offsets_; // first entry of each block in indices_
+  std::vector<uint16_t> indices_;       // original indices of the unknowns, by block
+};
+
+} //  end namespace grabnum
+
+#include "../src/matrix_sparse.tcc"
+
+#endif // GRABCOMMON_LIBNUMERIC_MATRIX_SPARSE_H
@@ -13,12 +13,15 @@
 #define GRABCOMMON_LIBNUMERIC_MATRIX_UTILITIES_H
 
 #include "matrix.h"
+#include "matrix_dynamic.h"
 
 /**
  * @brief Namespace for GRAB numeric library.
  */
 namespace grabnum {
 
+template <typename T, uint8_t dim> class LU;
+
 #if (MCU_TARGET == 0)
 /**
  * Print function for matrix.
@@ -29,229 +32,240 @@ namespace grabnum {
  */
 template <typename T, uint8_t rows, uint8_t cols>
 std::ostream& operator<<(std::ostream& stream, const Matrix<T, rows, cols>& matrix);
+
+/**
+ * Print function for matrix expressions.
+ *
+ * @param[in] stream A std output stream.
+ * @param[in] expr A @f$m\times n@f$ matrix expression.
+ * @return A reference to the input stream.
+ */
+template <class ExprT>
+std::ostream& operator<<(std::ostream& stream, const MatrixExpr<ExprT>& expr);
 #endif
 
 /**
  * Addition between a scalar and a matrix.
  *
  * @param[in] scalar A scalar value.
- * @param[in] matrix A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix, result of the addition.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression, result of the addition.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const T& scalar, const Matrix<T, rows, cols>& matrix);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarSumOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator+(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix);
 
 /**
  * Addition between a matrix and a scalar.
  *
- * @param[in] matrix A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
  * @param[in] scalar A scalar value.
- * @return A @f$m\times n@f$ matrix.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const Matrix<T, rows, cols>& matrix, const T& scalar);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarSumOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator+(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar);
 
 /**
  * Addition between two matrices.
  *
- * @param[in] matrix1 A @f$m\times n@f$ matrix.
- * @param[in] matrix2 A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix1 A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix2 A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const Matrix<T, rows, cols>& matrix1,
-                                const Matrix<T, rows, cols>& matrix2);
+template <class LhsT, class RhsT>
+constexpr CwiseBinaryExpr<SumOp, LhsT, RhsT>
+operator+(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2);
 
 /**
  * Subtraction between a scalar and a matrix.
  *
  * @param[in] scalar A scalar value.
- * @param[in] matrix A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const T& scalar, const Matrix<T, rows, cols>& matrix);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarRDiffOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix);
 
 /**
  * Subtraction between a matrix and a scalar.
  *
- * @param[in] matrix A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
  * @param[in] scalar A scalar value.
- * @return A @f$m\times n@f$ matrix, result of the subtraction.
+ * @return A @f$m\times n@f$ lazy expression, result of the subtraction.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix, const T& scalar);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarDiffOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar);
 
 /**
  * Subtraction between two matrices.
  *
- * @param[in] matrix1 A @f$m\times n@f$ matrix.
- * @param[in] matrix2 A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix1 A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix2 A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix1,
-                                const Matrix<T, rows, cols>& matrix2);
+template <class LhsT, class RhsT>
+constexpr CwiseBinaryExpr<DiffOp, LhsT, RhsT>
+operator-(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2);
 
 /**
  * Returns the opposite of a matrix.
  * This is equivalent to multiplication by -1.
  *
- * @param[in] matrix A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix);
+template <class ExprT>
+constexpr CwiseUnaryExpr<NegateOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const MatrixExpr<ExprT>& matrix);
 
 /**
  * Row-column matrix multiplication.
+ * This includes the outer product between a vertical and an horizontal vector.
  *
- * @param[in] matrix1 A @f$m\times n@f$ matrix.
- * @param[in] matrix2 A @f$n\times p@f$ matrix.
+ * @param[in] matrix1 A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix2 A @f$n\times p@f$ matrix or matrix expression.
  * @return A @f$m\times p@f$ matrix.
+ * @note The product is evaluated immediately, since each element of the result depends
+ * on several elements of the operands. Operands which are expressions are evaluated
+ * once beforehand.
  */
-template <typename T, uint8_t rows1, uint8_t dim_common, uint8_t cols2>
-Matrix<T, rows1, cols2> operator*(const Matrix<T, rows1, dim_common>& matrix1,
-                                  const Matrix<T, dim_common, cols2>& matrix2);
+template <class LhsT, class RhsT>
+typename std::enable_if<IsMatrixProduct<LhsT, RhsT>::value,
+                        Matrix<typename ExprTraits<LhsT>::Scalar, ExprTraits<LhsT>::kRows,
+                               ExprTraits<RhsT>::kCols>>::type
+operator*(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2);
 
 /**
- * Outer product operation.
+ * Row-column matrix multiplication, where at least one operand has dynamic size.
  *
- * @param[in] vvect A m-dimensional vertical vector.
- * @param[in] hvect A n-dimensional horizontal vector.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix1 A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix2 A @f$n\times p@f$ matrix or matrix expression.
+ * @return A @f$m\times p@f$ dynamic-size matrix.
+ * @note Inner dimensions are checked at run time.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const VectorX<T, rows>& vvect,
-                                const Matrix<T, 1, cols>& hvect);
+template <class LhsT, class RhsT>
+typename std::enable_if<IsDynamicProduct<LhsT, RhsT>::value,
+                        MatrixX<typename ExprTraits<LhsT>::Scalar>>::type
+operator*(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2);
 
 /**
- * Scalar product operation.
+ * Element-wise vector multiplication.
  *
- * @param[in] scalar A scalar value.
- * @param[in] matrix A @f$m\times n@f$ matrix.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] vect1 A m-dimensional vertical (horizontal) vector or vector expression.
+ * @param[in] vect2 A m-dimensional vertical (horizontal) vector or vector expression.
+ * @return A m-dimensional vertical (horizontal) lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const T& scalar, const Matrix<T, rows, cols>& matrix);
+template <class LhsT, class RhsT>
+constexpr typename std::enable_if<IsCwiseProduct<LhsT, RhsT>::value,
+                                  CwiseBinaryExpr<CwiseProdOp, LhsT, RhsT>>::type
+operator*(const MatrixExpr<LhsT>& vect1, const MatrixExpr<RhsT>& vect2);
 
 /**
  * Scalar product operation.
  *
- * @param[in] matrix A @f$m\times n@f$ matrix.
  * @param[in] scalar A scalar value.
- * @return A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const Matrix<T, rows, cols>& matrix, const T& scalar);
-
-/**
- * Element-wise vector multiplication.
- *
- * @param[in] vvect1 A m-dimensional vertical vector.
- * @param[in] vvect2 A m-dimensional vertical vector.
- * @return A m-dimensional vertical vector.
- */
-template <typename T, uint8_t rows>
-VectorX<T, rows> operator*(const VectorX<T, rows>& vvect1,
-                           const VectorX<T, rows>& vvect2);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarProdOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator*(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix);
 
 /**
- * Element-wise vector multiplication.
+ * Scalar product operation.
  *
- * @param[in] hvect1 A m-dimensional horizontal vector.
- * @param[in] hvect2 A m-dimensional horizontal vector.
- * @return A m-dimensional horizontal vector.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] scalar A scalar value.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t cols>
-Matrix<T, 1, cols> operator*(const Matrix<T, 1, cols>& hvect1,
-                             const Matrix<T, 1, cols>& hvect2);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarProdOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator*(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar);
 
 /**
  * Matrix division by scalar operation.
  *
- * @param[in] matrix A @f$m\times n@f$ matrix.
+ * @param[in] matrix A @f$m\times n@f$ matrix or matrix expression.
  * @param[in] scalar A scalar value.
- * @return A @f$m\times n@f$ matrix.
+ * @return A @f$m\times n@f$ lazy expression.
  */
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator/(const Matrix<T, rows, cols>& matrix, const T& scalar);
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarQuotOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator/(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar);
 
 /**
  * Matrix horizontal concatenation.
  *
- * @param[in] matrix_lx A @f$m\times n@f$ matrix.
- * @param[in] matrix_rx A @f$m\times p@f$ matrix.
+ * @param[in] matrix_lx A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix_rx A @f$m\times p@f$ matrix or matrix expression.
  * @return A @f$m\times (n+p)@f$ matrix.
  */
-template <typename T, uint8_t rows, uint8_t cols1, uint8_t cols2>
-Matrix<T, rows, cols1 + cols2> HorzCat(const Matrix<T, rows, cols1>& matrix_lx,
-                                       const Matrix<T, rows, cols2>& matrix_rx);
+template <class LhsT, class RhsT>
+Matrix<typename ExprTraits<LhsT>::Scalar, ExprTraits<LhsT>::kRows,
+       ExprTraits<LhsT>::kCols + ExprTraits<RhsT>::kCols>
+HorzCat(const MatrixExpr<LhsT>& matrix_lx, const MatrixExpr<RhsT>& matrix_rx);
 
 /**
  * Matrix vertical concatenation.
  *
- * @param[in] matrix_up A @f$m\times n@f$ matrix.
- * @param[in] matrix_down A @f$p\times n@f$ matrix.
+ * @param[in] matrix_up A @f$m\times n@f$ matrix or matrix expression.
+ * @param[in] matrix_down A @f$p\times n@f$ matrix or matrix expression.
  * @return A @f$(m+p)\times n@f$ matrix.
  */
-template <typename T, uint8_t rows1, uint8_t rows2, uint8_t cols>
-Matrix<T, rows1 + rows2, cols> VertCat(const Matrix<T, rows1, cols>& matrix_up,
-                                       const Matrix<T, rows2, cols>& matrix_down);
+template <class UpT, class DownT>
+Matrix<typename ExprTraits<UpT>::Scalar,
+       ExprTraits<UpT>::kRows + ExprTraits<DownT>::kRows, ExprTraits<UpT>::kCols>
+VertCat(const MatrixExpr<UpT>& matrix_up, const MatrixExpr<DownT>& matrix_down);
 
 /**
  * Vector dot-product operation.
+ * Vectors can be either vertical or horizontal, as long as they have the same length.
  *
- * @param[in] vvect1 A m-dimensional vertical vector.
- * @param[in] vvect2 A m-dimensional vertical vector.
- * @return A scalar value.
- */
-template <typename T, uint8_t dim>
-T Dot(const VectorX<T, dim>& vvect1, const VectorX<T, dim>& vvect2);
-
-/**
- * Vector dot-product operation.
- *
- * @param[in] hvect A m-dimensional horizontal vector.
- * @param[in] vvect A m-dimensional vertical vector.
- * @return A scalar value.
- */
-template <typename T, uint8_t dim>
-T Dot(const Matrix<T, 1, dim>& hvect, const VectorX<T, dim>& vvect);
-
-/**
- * Vector L2-norm (i.e. Euclidean norm).
- *
- * @param[in] vvect A m-dimensional vertical vector.
+ * @param[in] vect1 A m-dimensional vector or vector expression.
+ * @param[in] vect2 A m-dimensional vector or vector expression.
  * @return A scalar value.
  */
-template <typename T, uint8_t dim> double Norm(const VectorX<T, dim>& vvect);
+template <class LhsT, class RhsT>
+typename ExprTraits<LhsT>::Scalar Dot(const MatrixExpr<LhsT>& vect1,
+                                      const MatrixExpr<RhsT>& vect2);
 
 /**
  * Vector L2-norm (i.e. Euclidean norm).
  *
- * @param[in] hvect A m-dimensional horizontal vector.
+ * @param[in] vect A m-dimensional vertical or horizontal vector, or vector expression.
  * @return A scalar value.
  */
-template <typename T, uint8_t dim> double Norm(const Matrix<T, 1, dim>& hvect);
+template <class ExprT> double Norm(const MatrixExpr<ExprT>& vect);
 
 /**
  * Vector cross-product operation.
  *
- * @param[in] vvect3d1 A 3-dimensional vertical vector.
- * @param[in] vvect3d2 A 3-dimensional vertical vector.
- * @return A 3x3 matrix.
+ * @param[in] vvect3d1 A 3-dimensional vertical vector or vector expression.
+ * @param[in] vvect3d2 A 3-dimensional vertical vector or vector expression.
+ * @return A 3-dimensional vertical vector.
  */
-template <typename T>
-Vector3<T> Cross(const Vector3<T>& vvect3d1, const Vector3<T>& vvect3d2);
+template <class LhsT, class RhsT>
+Vector3<typename ExprTraits<LhsT>::Scalar> Cross(const MatrixExpr<LhsT>& vvect3d1,
+                                                 const MatrixExpr<RhsT>& vvect3d2);
 
 /**
  * Computes the skew-symmetric matrix of a 3D vector.
  *
- * @param[in] vvect3d A 3-dimensional vertical vector.
+ * @param[in] vvect3d A 3-dimensional vertical vector or vector expression.
  * @return A 3x3 matrix.
  */
-template <typename T> Matrix3<T> Skew(const Vector3<T>& vvect3d);
+template <class ExprT>
+Matrix3<typename ExprTraits<ExprT>::Scalar> Skew(const MatrixExpr<ExprT>& vvect3d);
 
 /**
  * Function to get cofactor of a matrix given entry position.
@@ -271,13 +285,36 @@ Matrix<T, rows - 1, cols - 1> GetCofactor(const Matrix<T, rows, cols>& matrix,
                                           const uint8_t p, const uint8_t q);
 
 /**
- * Recursive function for finding determinant of matrix using cofactors approach.
+ * Determinant of a square matrix.
+ *
+ * Up to @f$5\times 5@f$ matrices the determinant is found recursively using cofactors
+ * approach, which is exact for integer types. Since its cost grows as @f$O(n!)@f$, larger
+ * matrices are factorized instead by LU decomposition at @f$O(n^3)@f$ cost (integer
+ * types are factorized in double precision and the result rounded).
  *
  * @param[in] matrix The matrix whose determinant is to be found.
  * @return The determinant of the matrix.
+ * @see LU::Det()
  */
 template <typename T, uint8_t dim> T Det(const Matrix<T, dim, dim>& matrix);
 
+/**
+ * Determinant of a @f$1\times 1@f$ matrix, i.e. its only element.
+ *
+ * @param[in] matrix The matrix whose determinant is to be found.
+ * @return The determinant of the matrix.
+ */
+template <typename T> T Det(const Matrix<T, 1, 1>& matrix);
+
+/**
+ * Determinant of a square matrix expression.
+ *
+ * @param[in] matrix The matrix expression whose determinant is to be found.
+ * @return The determinant of the evaluated expression.
+ */
+template <class ExprT>
+typename ExprTraits<ExprT>::Scalar Det(const MatrixExpr<ExprT>& matrix);
+
 /**
  * Returns _Cholesky factor_ of given symmetric, positive-definite matrix.
  *
@@ -290,31 +327,46 @@ template <typename T, uint8_t dim> T Det(const Matrix<T, dim, dim>& matrix);
  * interpreted as a generalized square root of @f$\mathbf{A}@f$.
  * @param[in] matrix The matrix @f$\mathbf{A}@f$ whose Cholesky factor is to be found.
  * @return The Cholesky factor @f$\mathbf{L}@f$ of @f$\mathbf{A}@f$.
- * @note This function is used to check whether a matrix is positive-definite by
- * Matrix::IsPositiveDefinite().
+ * @note Throws a @c std::invalid_argument exception if the matrix is not
+ * positive-definite. Where exceptions must be avoided, e.g. in a real-time loop, use
+ * LDLT or Matrix::IsPositiveDefinite() instead.
  */
 template <typename T, uint8_t dim>
 MatrixXd<dim, dim> Cholesky(const Matrix<T, dim, dim>& matrix);
 
+/**
+ * Returns _Cholesky factor_ of given symmetric, positive-definite matrix expression.
+ *
+ * @param[in] matrix The matrix expression @f$\mathbf{A}@f$ whose Cholesky factor is to
+ * be found.
+ * @return The Cholesky factor @f$\mathbf{L}@f$ of @f$\mathbf{A}@f$.
+ * @see Cholesky()
+ */
+template <class ExprT>
+MatrixXd<ExprTraits<ExprT>::kRows, ExprTraits<ExprT>::kCols>
+Cholesky(const MatrixExpr<ExprT>& matrix);
+
 /**
  * Mean value of a vector.
  *
- * @param[in] vvect A m-dimensional vertical vector.
+ * @param[in] vvect A m-dimensional vertical vector or vector expression.
  * @return A scalar value.
  */
-template <typename T, uint8_t dim> double Mean(const VectorX<T, dim>& vvect);
+template <class ExprT> double Mean(const MatrixExpr<ExprT>& vvect);
 
 /**
  * Standard deviation of a vector.
  *
- * @param[in] vvect A m-dimensional vertical vector.
+ * @param[in] vvect A m-dimensional vertical vector or vector expression.
  * @return A scalar value.
  */
-template <typename T, uint8_t dim> double Std(const VectorX<T, dim>& vvect);
+template <class ExprT> double Std(const MatrixExpr<ExprT>& vvect);
 
 } //  end namespace grabnum
 
 // This is a trick to define templated functions in a source file.
 #include "../src/matrix_utilities.tcc"
+// Det() relies on LU for large matrices.
+#include "decompositions.h"
 
 #endif // GRABCOMMON_LIBNUMERIC_MATRIX_UTILITIES_H
@@ -0,0 +1,291 @@
+/**
+ * @file matrix_view.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the non-owning matrix view of the GRAB numeric library.
+ *
+ * A view refers to a rectangular block of an existing matrix (e.g. a single row or
+ * column) without copying it. It can be read as any other matrix expression and, unless
+ * it refers to a constant matrix, it can be assigned in place:
+ * @code
+ * K.Col(j) = f;                      // no copy of K, no temporary column
+ * s += rk_mat(j, k) * K.Col(k);      // no extraction of the k-th column
+ * @endcode
+ * @warning A view is only valid as long as the matrix it refers to is alive. Moreover,
+ * assigning to a view an expression which reads a different, overlapping block of the
+ * same matrix gives undefined results.
+ * @see Matrix::Block()
+ * @see Matrix::Row()
+ * @see Matrix::Col()
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_VIEW_H
+#define GRABCOMMON_LIBNUMERIC_MATRIX_VIEW_H
+
+#include "matrix_expressions.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+template <typename T, uint8_t rows, uint8_t cols, uint8_t stride> class MatrixView;
+
+/**
+ * @brief Distance between two consecutive rows of a view.
+ *
+ * This is a compile-time constant, unless @a stride is @ref kDynamic, in which case it is
+ * stored in the view (e.g. for blocks of a dynamic-size matrix).
+ */
+template <uint8_t stride> class ViewStride
+{
+public:
+  explicit ViewStride(const uint16_t) {}
+
+  /**
+   * Returns the distance between two consecutive rows of the view.
+   *
+   * @return A number of elements.
+   */
+  inline uint16_t Stride() const { return stride; }
+};
+
+template <> class ViewStride<kDynamic>
+{
+public:
+  explicit ViewStride(const uint16_t value) : stride_(value) {}
+
+  /**
+   * Returns the distance between two consecutive rows of the view.
+   *
+   * @return A number of elements.
+   */
+  inline uint16_t Stride() const { return stride_; }
+
+private:
+  uint16_t stride_;
+};
+
+template <typename T, uint8_t rows, uint8_t cols, uint8_t stride>
+struct ExprTraits<MatrixView<T, rows, cols, stride>>
+{
+  using Scalar                   = typename std::remove_const<T>::type;
+  static constexpr uint8_t kRows = rows;
+  static constexpr uint8_t kCols = cols;
+};
+
+/**
+ * @brief Non-owning, strided view of a @f$m\times n@f$ block of a matrix.
+ *
+ * The view stores only a pointer to the first element of the block, while the distance
+ * between two consecutive rows (@a stride) is the number of columns of the parent matrix.
+ * When the parent matrix has dynamic size, @a stride is @ref kDynamic and the actual
+ * distance is stored in the view as well.
+ * If @a T is a constant type, the view is read-only.
+ * Copying a view does not copy any element, while assigning to a view writes the
+ * elements of the referred block.
+ * @note Indexing starts at 1 like in the matrix class.
+ */
+template <typename T, uint8_t rows, uint8_t cols, uint8_t stride>
+class MatrixView: public MatrixExpr<MatrixView<T, rows, cols, stride>>,
+                  private ViewStride<stride>
+{
+public:
+  using Scalar = typename std::remove_const<T>::type; /**< type of the elements. */
+  using ViewStride<stride>::Stride;
+
+  /**
+   * Full constructor.
+   *
+   * @param[in] data A pointer to the first element of the block.
+   * @param[in] row_stride (optional) The distance between two consecutive rows, only used
+   * if @a stride is @ref kDynamic.
+   */
+  explicit MatrixView(T* data, const uint16_t row_stride = stride)
+    : ViewStride<stride>(row_stride), data_(data)
+  {}
+  /**
+   * Copy constructor.
+   * The new view refers to the same block of @a other.
+   *
+   * @param[in] other The view to be copied.
+   */
+  MatrixView(const MatrixView& other) = default;
+  /**
+   * Conversion from a writable view to a read-only view of the same block.
+   *
+   * @param[in] other The writable view.
+   */
+  template <typename U, typename = typename std::enable_if<
+                          std::is_same<const U, T>::value>::type>
+  MatrixView(const MatrixView<U, rows, cols, stride>& other)
+    : ViewStride<stride>(other.Stride()), data_(other.Data())
+  {}
+
+  /**
+   * Returns numbers of rows.
+   *
+   * @return A size.
+   */
+  inline uint8_t Rows() const { return rows; }
+  /**
+   * Returns numbers of columns.
+   *
+   * @return A size.
+   */
+  inline uint8_t Cols() const { return cols; }
+  /**
+   * Returns the view size, i.e. @f$m\times n@f$.
+   *
+   * @return A size.
+   */
+  inline uint16_t Size() const { return rows * cols; }
+  /**
+   * Give access to the referred data.
+   *
+   * @return A pointer to the first element of the block.
+   */
+  inline T* Data() const { return data_; }
+
+  inline Scalar Coeff(const uint16_t index) const
+  {
+    return data_[index / cols * Stride() + index % cols];
+  }
+  inline Scalar Coeff(const uint8_t row, const uint8_t col) const
+  {
+    return data_[row * Stride() + col];
+  }
+
+  /**
+   * Give access to a single entry of the block.
+   *
+   * param[in] row The row index of the desired entry.
+   * param[in] col The column index of the desired entry.
+   * @return The (@a row , @a col ) entry of the block.
+   */
+  inline T& operator()(const uint8_t row, const uint8_t col) const
+  {
+    return data_[(row - 1) * Stride() + col - 1];
+  }
+  /**
+   * Give access to a single entry of the unraveled block.
+   *
+   * param[in] lin_index The linear index of the desired entry.
+   * @return The i-th entry of the block.
+   */
+  inline T& operator()(const uint8_t lin_index) const
+  {
+    return data_[(lin_index - 1) / cols * Stride() + (lin_index - 1) % cols];
+  }
+
+  /**
+   * Copies the elements of another block into the referred one.
+   *
+   * @param[in] other The view whose elements are copied.
+   * @return A reference to @c *this.
+   */
+  MatrixView& operator=(const MatrixView& other)
+  {
+    return *this = static_cast<const MatrixExpr<MatrixView>&>(other);
+  }
+  /**
+   * Evaluates a matrix expression straight into the referred block.
+   *
+   * @param[in] other The expression to be evaluated.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> MatrixView& operator=(const MatrixExpr<ExprT>& other)
+  {
+    const ExprT& expr = other.Self();
+    CheckDims(expr);
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] = static_cast<Scalar>(expr.Coeff(row, col));
+    return *this;
+  }
+  /**
+   * Replaces the referred block by itself + @a other.
+   *
+   * @param[in] other The matrix expression to be added.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> MatrixView& operator+=(const MatrixExpr<ExprT>& other)
+  {
+    const ExprT& expr = other.Self();
+    CheckDims(expr);
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] += expr.Coeff(row, col);
+    return *this;
+  }
+  /**
+   * Replaces the referred block by itself - @a other.
+   *
+   * @param[in] other The matrix expression to be subtracted.
+   * @return A reference to @c *this.
+   */
+  template <class ExprT> MatrixView& operator-=(const MatrixExpr<ExprT>& other)
+  {
+    const ExprT& expr = other.Self();
+    CheckDims(expr);
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] -= expr.Coeff(row, col);
+    return *this;
+  }
+  /**
+   * Multiplies each element of the referred block by the scalar value @a scalar.
+   *
+   * @param[in] scalar The factor by which each element is multiplied.
+   * @return A reference to @c *this.
+   */
+  MatrixView& operator*=(const Scalar& scalar)
+  {
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] *= scalar;
+    return *this;
+  }
+  /**
+   * Divides each element of the referred block by the scalar value @a scalar.
+   *
+   * @param[in] scalar The factor by which each element is divided.
+   * @return A reference to @c *this.
+   */
+  MatrixView& operator/=(const Scalar& scalar)
+  {
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] /= scalar;
+    return *this;
+  }
+
+  /**
+   * Sets all the elements of the referred block to @a value.
+   *
+   * @param[in] value The value to be assigned to each element.
+   * @return A reference to @c *this.
+   */
+  MatrixView& Fill(const Scalar& value)
+  {
+    for (uint8_t row = 0; row < rows; ++row)
+      for (uint8_t col = 0; col < cols; ++col)
+        data_[row * Stride() + col] = value;
+    return *this;
+  }
+
+private:
+  T* data_;
+
+  template <class ExprT> static void CheckDims(const ExprT& expr)
+  {
+    static_assert(HaveSameSize<MatrixView, ExprT>::value,
+                  "ERROR: matrix dimensions mismatch in view assignment!");
+    assert(expr.Rows() == rows && expr.Cols() == cols);
+    (void)expr;
+  }
+};
+
+} //  end namespace grabnum
+
+#endif // GRABCOMMON_LIBNUMERIC_MATRIX_VIEW_H
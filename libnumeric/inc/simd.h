@@ -0,0 +1,1011 @@
+/**
+ * @file simd.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing the SIMD kernels used by the matrix class and the vector batches
+ * of the GRAB numeric library.
+ *
+ * The instruction set is picked at compile time, according to the flags given to the
+ * compiler:
+ * - if `__AVX2__` is defined (e.g. `-mavx2` or `-march=native` on a recent x86 machine),
+ * 256-bit AVX2 kernels are used;
+ * - else if `__SSE2__` is defined (default on any x86-64 target), 128-bit SSE2 kernels
+ * are used;
+ * - otherwise a plain scalar fallback is used.
+ * .
+ * SIMD kernels can be disabled altogether by defining `GRABNUM_DISABLE_SIMD`, and they
+ * are always disabled when building for a MCU target.
+ *
+ * All kernels work on raw row-major buffers and use unaligned loads and stores, so that
+ * they are safe even when a matrix is allocated on a misaligned address (e.g. inside a
+ * @c std::vector in C++11). Only @c float and @c double have vectorized versions, all
+ * other types fall back to the scalar implementation.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_SIMD_H
+#define GRABCOMMON_LIBNUMERIC_SIMD_H
+
+#include <algorithm>
+#include <cmath>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+#if !defined(GRABNUM_DISABLE_SIMD) && !(defined(MCU_TARGET) && MCU_TARGET)
+#if defined(__AVX2__)
+#define GRABNUM_SIMD_AVX2 1 /**< AVX2 kernels are enabled. */
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define GRABNUM_SIMD_SSE2 1 /**< SSE2 kernels are enabled. */
+#include <emmintrin.h>
+#endif
+#endif
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+/**
+ * @brief Namespace for SIMD kernels of GRAB numeric library.
+ */
+namespace simd {
+
+/**
+ * @brief Wrapper of a SIMD register of @a T elements.
+ *
+ * The generic version is empty and marks types without a vectorized implementation.
+ * Specializations expose the number of lanes @c kLanes, whether masked loads and stores
+ * are available (@c kMasked), and the basic arithmetic on a register.
+ */
+template <typename T> struct Pack
+{
+  static constexpr bool kEnabled = false; /**< no SIMD support for this type. */
+  static constexpr uint8_t kLanes = 1;    /**< elements per register. */
+};
+
+#if defined(GRABNUM_SIMD_AVX2)
+
+template <> struct Pack<double>
+{
+  using Reg = __m256d;
+  static constexpr bool kEnabled  = true;
+  static constexpr bool kMasked   = true;
+  static constexpr uint8_t kLanes = 4;
+
+  static inline Reg Zero() { return _mm256_setzero_pd(); }
+  static inline Reg Set1(const double value) { return _mm256_set1_pd(value); }
+  static inline Reg Load(const double* ptr) { return _mm256_loadu_pd(ptr); }
+  static inline void Store(double* ptr, const Reg reg) { _mm256_storeu_pd(ptr, reg); }
+  static inline Reg Add(const Reg a, const Reg b) { return _mm256_add_pd(a, b); }
+  static inline Reg Sub(const Reg a, const Reg b) { return _mm256_sub_pd(a, b); }
+  static inline Reg Mul(const Reg a, const Reg b) { return _mm256_mul_pd(a, b); }
+  static inline Reg MulAdd(const Reg a, const Reg b, const Reg c)
+  {
+#if defined(__FMA__)
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+  }
+  static inline Reg Div(const Reg a, const Reg b) { return _mm256_div_pd(a, b); }
+  static inline Reg Sqrt(const Reg a) { return _mm256_sqrt_pd(a); }
+  static inline Reg Min(const Reg a, const Reg b) { return _mm256_min_pd(a, b); }
+  static inline Reg Max(const Reg a, const Reg b) { return _mm256_max_pd(a, b); }
+  static inline Reg Abs(const Reg a) { return _mm256_andnot_pd(Set1(-0.0), a); }
+  static inline Reg Round(const Reg a)
+  {
+    return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static inline Reg Less(const Reg a, const Reg b)
+  {
+    return _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+  }
+  static inline Reg And(const Reg a, const Reg b) { return _mm256_and_pd(a, b); }
+  static inline Reg Select(const Reg mask, const Reg a, const Reg b)
+  {
+    return _mm256_blendv_pd(b, a, mask);
+  }
+  static inline __m256i Mask(const uint8_t count)
+  {
+    return _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), _mm256_set_epi64x(3, 2, 1, 0));
+  }
+  static inline Reg MaskLoad(const double* ptr, const uint8_t count)
+  {
+    return _mm256_maskload_pd(ptr, Mask(count));
+  }
+  static inline void MaskStore(double* ptr, const uint8_t count, const Reg reg)
+  {
+    _mm256_maskstore_pd(ptr, Mask(count), reg);
+  }
+};
+
+template <> struct Pack<float>
+{
+  using Reg = __m256;
+  static constexpr bool kEnabled  = true;
+  static constexpr bool kMasked   = true;
+  static constexpr uint8_t kLanes = 8;
+
+  static inline Reg Zero() { return _mm256_setzero_ps(); }
+  static inline Reg Set1(const float value) { return _mm256_set1_ps(value); }
+  static inline Reg Load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+  static inline void Store(float* ptr, const Reg reg) { _mm256_storeu_ps(ptr, reg); }
+  static inline Reg Add(const Reg a, const Reg b) { return _mm256_add_ps(a, b); }
+  static inline Reg Sub(const Reg a, const Reg b) { return _mm256_sub_ps(a, b); }
+  static inline Reg Mul(const Reg a, const Reg b) { return _mm256_mul_ps(a, b); }
+  static inline Reg MulAdd(const Reg a, const Reg b, const Reg c)
+  {
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+  static inline Reg Div(const Reg a, const Reg b) { return _mm256_div_ps(a, b); }
+  static inline Reg Sqrt(const Reg a) { return _mm256_sqrt_ps(a); }
+  static inline Reg Min(const Reg a, const Reg b) { return _mm256_min_ps(a, b); }
+  static inline Reg Max(const Reg a, const Reg b) { return _mm256_max_ps(a, b); }
+  static inline Reg Abs(const Reg a) { return _mm256_andnot_ps(Set1(-0.f), a); }
+  static inline Reg Round(const Reg a)
+  {
+    return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+  }
+  static inline Reg Less(const Reg a, const Reg b)
+  {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+  }
+  static inline Reg And(const Reg a, const Reg b) { return _mm256_and_ps(a, b); }
+  static inline Reg Select(const Reg mask, const Reg a, const Reg b)
+  {
+    return _mm256_blendv_ps(b, a, mask);
+  }
+  static inline __m256i Mask(const uint8_t count)
+  {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(count),
+                              _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+  }
+  static inline Reg MaskLoad(const float* ptr, const uint8_t count)
+  {
+    return _mm256_maskload_ps(ptr, Mask(count));
+  }
+  static inline void MaskStore(float* ptr, const uint8_t count, const Reg reg)
+  {
+    _mm256_maskstore_ps(ptr, Mask(count), reg);
+  }
+};
+
+#elif defined(GRABNUM_SIMD_SSE2)
+
+template <> struct Pack<double>
+{
+  using Reg = __m128d;
+  static constexpr bool kEnabled  = true;
+  static constexpr bool kMasked   = false;
+  static constexpr uint8_t kLanes = 2;
+
+  static inline Reg Zero() { return _mm_setzero_pd(); }
+  static inline Reg Set1(const double value) { return _mm_set1_pd(value); }
+  static inline Reg Load(const double* ptr) { return _mm_loadu_pd(ptr); }
+  static inline void Store(double* ptr, const Reg reg) { _mm_storeu_pd(ptr, reg); }
+  static inline Reg Add(const Reg a, const Reg b) { return _mm_add_pd(a, b); }
+  static inline Reg Sub(const Reg a, const Reg b) { return _mm_sub_pd(a, b); }
+  static inline Reg Mul(const Reg a, const Reg b) { return _mm_mul_pd(a, b); }
+  static inline Reg MulAdd(const Reg a, const Reg b, const Reg c)
+  {
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+  }
+  static inline Reg Div(const Reg a, const Reg b) { return _mm_div_pd(a, b); }
+  static inline Reg Sqrt(const Reg a) { return _mm_sqrt_pd(a); }
+  static inline Reg Min(const Reg a, const Reg b) { return _mm_min_pd(a, b); }
+  static inline Reg Max(const Reg a, const Reg b) { return _mm_max_pd(a, b); }
+  static inline Reg Abs(const Reg a) { return _mm_andnot_pd(Set1(-0.0), a); }
+  // SSE2 has no rounding instruction: adding and subtracting 1.5 * 2^52 rounds to the
+  // nearest integer, for |a| < 2^51.
+  static inline Reg Round(const Reg a)
+  {
+    return _mm_sub_pd(_mm_add_pd(a, Set1(6755399441055744.0)), Set1(6755399441055744.0));
+  }
+  static inline Reg Less(const Reg a, const Reg b) { return _mm_cmplt_pd(a, b); }
+  static inline Reg And(const Reg a, const Reg b) { return _mm_and_pd(a, b); }
+  static inline Reg Select(const Reg mask, const Reg a, const Reg b)
+  {
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+  }
+  // Unused, SSE2 has no masked move for doubles.
+  static inline Reg MaskLoad(const double*, const uint8_t) { return Zero(); }
+  static inline void MaskStore(double*, const uint8_t, const Reg) {}
+};
+
+template <> struct Pack<float>
+{
+  using Reg = __m128;
+  static constexpr bool kEnabled  = true;
+  static constexpr bool kMasked   = false;
+  static constexpr uint8_t kLanes = 4;
+
+  static inline Reg Zero() { return _mm_setzero_ps(); }
+  static inline Reg Set1(const float value) { return _mm_set1_ps(value); }
+  static inline Reg Load(const float* ptr) { return _mm_loadu_ps(ptr); }
+  static inline void Store(float* ptr, const Reg reg) { _mm_storeu_ps(ptr, reg); }
+  static inline Reg Add(const Reg a, const Reg b) { return _mm_add_ps(a, b); }
+  static inline Reg Sub(const Reg a, const Reg b) { return _mm_sub_ps(a, b); }
+  static inline Reg Mul(const Reg a, const Reg b) { return _mm_mul_ps(a, b); }
+  static inline Reg MulAdd(const Reg a, const Reg b, const Reg c)
+  {
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+  }
+  static inline Reg Div(const Reg a, const Reg b) { return _mm_div_ps(a, b); }
+  static inline Reg Sqrt(const Reg a) { return _mm_sqrt_ps(a); }
+  static inline Reg Min(const Reg a, const Reg b) { return _mm_min_ps(a, b); }
+  static inline Reg Max(const Reg a, const Reg b) { return _mm_max_ps(a, b); }
+  static inline Reg Abs(const Reg a) { return _mm_andnot_ps(Set1(-0.f), a); }
+  // SSE2 has no rounding instruction: adding and subtracting 1.5 * 2^23 rounds to the
+  // nearest integer, for |a| < 2^22.
+  static inline Reg Round(const Reg a)
+  {
+    return _mm_sub_ps(_mm_add_ps(a, Set1(12582912.f)), Set1(12582912.f));
+  }
+  static inline Reg Less(const Reg a, const Reg b) { return _mm_cmplt_ps(a, b); }
+  static inline Reg And(const Reg a, const Reg b) { return _mm_and_ps(a, b); }
+  static inline Reg Select(const Reg mask, const Reg a, const Reg b)
+  {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+  // Unused, SSE2 has no masked move for floats.
+  static inline Reg MaskLoad(const float*, const uint8_t) { return Zero(); }
+  static inline void MaskStore(float*, const uint8_t, const Reg) {}
+};
+
+#endif
+
+/**
+ * @brief Size of a padded buffer holding @a size elements of type @a T.
+ *
+ * When SIMD kernels are enabled, the buffer is rounded up to a multiple of the register
+ * width, so that element-wise kernels can run on whole registers without a scalar tail.
+ */
+template <typename T, uint16_t size> struct PaddedSize
+{
+  static constexpr uint16_t value = static_cast<uint16_t>(
+    (size + Pack<T>::kLanes - 1) / Pack<T>::kLanes * Pack<T>::kLanes);
+};
+
+//----- Element-wise kernels ---------------------------------------------------------//
+
+/**
+ * Replaces @a dst by @a dst + @a src, element-wise.
+ *
+ * @param[in,out] dst The buffer to be incremented.
+ * @param[in] src The buffer to be added.
+ * @param[in] size The number of elements in both buffers.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type Add(T* dst, const T* src,
+                                                            const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    dst[i] += src[i];
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type Add(T* dst, const T* src,
+                                                           const uint32_t size)
+{
+  using P    = Pack<T>;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(dst + i, P::Add(P::Load(dst + i), P::Load(src + i)));
+  for (; i < size; ++i)
+    dst[i] += src[i];
+}
+
+/**
+ * Replaces @a dst by @a dst - @a src, element-wise.
+ *
+ * @param[in,out] dst The buffer to be decremented.
+ * @param[in] src The buffer to be subtracted.
+ * @param[in] size The number of elements in both buffers.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type Sub(T* dst, const T* src,
+                                                            const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    dst[i] -= src[i];
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type Sub(T* dst, const T* src,
+                                                           const uint32_t size)
+{
+  using P    = Pack<T>;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(dst + i, P::Sub(P::Load(dst + i), P::Load(src + i)));
+  for (; i < size; ++i)
+    dst[i] -= src[i];
+}
+
+/**
+ * Adds the same scalar value to each element of @a dst.
+ *
+ * @param[in,out] dst The buffer to be incremented.
+ * @param[in] scalar The scalar value to be added.
+ * @param[in] size The number of elements in the buffer.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type AddScalar(T* dst, const T scalar,
+                                                                  const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    dst[i] += scalar;
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type AddScalar(T* dst, const T scalar,
+                                                                 const uint32_t size)
+{
+  using P                   = Pack<T>;
+  const typename P::Reg reg = P::Set1(scalar);
+  uint32_t i                = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(dst + i, P::Add(P::Load(dst + i), reg));
+  for (; i < size; ++i)
+    dst[i] += scalar;
+}
+
+/**
+ * Multiplies each element of @a dst by the same scalar value.
+ *
+ * @param[in,out] dst The buffer to be scaled.
+ * @param[in] scalar The scale factor.
+ * @param[in] size The number of elements in the buffer.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type Scale(T* dst, const T scalar,
+                                                              const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    dst[i] *= scalar;
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type Scale(T* dst, const T scalar,
+                                                             const uint32_t size)
+{
+  using P                   = Pack<T>;
+  const typename P::Reg reg = P::Set1(scalar);
+  uint32_t i                = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(dst + i, P::Mul(P::Load(dst + i), reg));
+  for (; i < size; ++i)
+    dst[i] *= scalar;
+}
+
+//----- Matrix kernels ---------------------------------------------------------------//
+
+/**
+ * Row-column product of two row-major matrices.
+ *
+ * @param[in] lhs A @f$m\times n@f$ row-major buffer.
+ * @param[in] rhs A @f$n\times p@f$ row-major buffer.
+ * @param[out] out A @f$m\times p@f$ row-major buffer. It must not overlap with the
+ * inputs.
+ */
+template <typename T, uint8_t rows1, uint8_t dim_common, uint8_t cols2>
+inline typename std::enable_if<!Pack<T>::kEnabled || cols2 == 1>::type
+MatMul(const T* lhs, const T* rhs, T* out)
+{
+  // Matrix-vector products are left to the compiler: with compile-time bounds the dot
+  // products are fully unrolled and contracted.
+  for (uint8_t row = 0; row < rows1; ++row)
+    for (uint8_t col = 0; col < cols2; ++col)
+    {
+      T sum = 0;
+      for (uint8_t j = 0; j < dim_common; ++j)
+        sum += lhs[row * dim_common + j] * rhs[j * cols2 + col];
+      out[row * cols2 + col] = sum;
+    }
+}
+
+template <typename T, uint8_t rows1, uint8_t dim_common, uint8_t cols2>
+inline typename std::enable_if<Pack<T>::kEnabled && (cols2 > 1)>::type
+MatMul(const T* lhs, const T* rhs, T* out)
+{
+  // Each row of the output is a linear combination of the rows of rhs, which are
+  // contiguous in memory: vectorize along the columns.
+  using P = Pack<T>;
+  for (uint8_t row = 0; row < rows1; ++row)
+  {
+    const T* lhs_row = lhs + row * dim_common;
+    T* out_row       = out + row * cols2;
+    uint8_t col      = 0;
+    for (; col + P::kLanes <= cols2; col += P::kLanes)
+    {
+      typename P::Reg acc = P::Zero();
+      for (uint8_t j = 0; j < dim_common; ++j)
+        acc = P::MulAdd(P::Set1(lhs_row[j]), P::Load(rhs + j * cols2 + col), acc);
+      P::Store(out_row + col, acc);
+    }
+    if (col == cols2)
+      continue;
+    const uint8_t count = cols2 - col;
+    if (P::kMasked)
+    {
+      typename P::Reg acc = P::Zero();
+      for (uint8_t j = 0; j < dim_common; ++j)
+        acc =
+          P::MulAdd(P::Set1(lhs_row[j]), P::MaskLoad(rhs + j * cols2 + col, count), acc);
+      P::MaskStore(out_row + col, count, acc);
+    }
+    else
+      for (; col < cols2; ++col)
+      {
+        T sum = 0;
+        for (uint8_t j = 0; j < dim_common; ++j)
+          sum += lhs_row[j] * rhs[j * cols2 + col];
+        out_row[col] = sum;
+      }
+  }
+}
+
+/**
+ * Row-column product of two row-major matrices whose dimensions are only known at run
+ * time.
+ *
+ * @param[in] lhs A @f$m\times n@f$ row-major buffer.
+ * @param[in] rhs A @f$n\times p@f$ row-major buffer.
+ * @param[out] out A @f$m\times p@f$ row-major buffer. It must not overlap with the
+ * inputs.
+ * @param[in] rows1 The number of rows @f$m@f$ of @a lhs.
+ * @param[in] dim_common The number of columns @f$n@f$ of @a lhs.
+ * @param[in] cols2 The number of columns @f$p@f$ of @a rhs.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+MatMul(const T* lhs, const T* rhs, T* out, const uint16_t rows1,
+       const uint16_t dim_common, const uint16_t cols2)
+{
+  for (uint16_t row = 0; row < rows1; ++row)
+    for (uint16_t col = 0; col < cols2; ++col)
+    {
+      T sum = 0;
+      for (uint16_t j = 0; j < dim_common; ++j)
+        sum += lhs[row * dim_common + j] * rhs[j * cols2 + col];
+      out[row * cols2 + col] = sum;
+    }
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+MatMul(const T* lhs, const T* rhs, T* out, const uint16_t rows1,
+       const uint16_t dim_common, const uint16_t cols2)
+{
+  // Same scheme of the fixed-size kernel, with a scalar tail.
+  using P = Pack<T>;
+  for (uint16_t row = 0; row < rows1; ++row)
+  {
+    const T* lhs_row = lhs + row * dim_common;
+    T* out_row       = out + row * cols2;
+    uint16_t col     = 0;
+    for (; col + P::kLanes <= cols2; col += P::kLanes)
+    {
+      typename P::Reg acc = P::Zero();
+      for (uint16_t j = 0; j < dim_common; ++j)
+        acc = P::MulAdd(P::Set1(lhs_row[j]), P::Load(rhs + j * cols2 + col), acc);
+      P::Store(out_row + col, acc);
+    }
+    for (; col < cols2; ++col)
+    {
+      T sum = 0;
+      for (uint16_t j = 0; j < dim_common; ++j)
+        sum += lhs_row[j] * rhs[j * cols2 + col];
+      out_row[col] = sum;
+    }
+  }
+}
+
+/**
+ * Transposes a row-major matrix.
+ *
+ * @param[in] src A @f$m\times n@f$ row-major buffer.
+ * @param[out] dst A @f$n\times m@f$ row-major buffer. It must not overlap with @a src.
+ */
+template <typename T, uint8_t rows, uint8_t cols>
+inline void Transpose(const T* src, T* dst);
+
+/**
+ * @brief Helper for transposing square tiles of a matrix with SIMD shuffles.
+ *
+ * The generic version has a 1x1 tile, i.e. it falls back to a plain element copy.
+ */
+template <typename T> struct TransposeTile
+{
+  static constexpr uint8_t kSize = 1; /**< tile side length. */
+
+  static inline void Apply(const T* src, const uint8_t src_stride, T* dst,
+                           const uint8_t dst_stride)
+  {
+    (void)src_stride;
+    (void)dst_stride;
+    *dst = *src;
+  }
+};
+
+#if defined(GRABNUM_SIMD_AVX2)
+
+template <> struct TransposeTile<double>
+{
+  static constexpr uint8_t kSize = 4;
+
+  static inline void Apply(const double* src, const uint8_t src_stride, double* dst,
+                           const uint8_t dst_stride)
+  {
+    const __m256d r0 = _mm256_loadu_pd(src);
+    const __m256d r1 = _mm256_loadu_pd(src + src_stride);
+    const __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+    const __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+    const __m256d t0 = _mm256_unpacklo_pd(r0, r1); // r00 r10 r02 r12
+    const __m256d t1 = _mm256_unpackhi_pd(r0, r1); // r01 r11 r03 r13
+    const __m256d t2 = _mm256_unpacklo_pd(r2, r3); // r20 r30 r22 r32
+    const __m256d t3 = _mm256_unpackhi_pd(r2, r3); // r21 r31 r23 r33
+    _mm256_storeu_pd(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+
+#elif defined(GRABNUM_SIMD_SSE2)
+
+template <> struct TransposeTile<double>
+{
+  static constexpr uint8_t kSize = 2;
+
+  static inline void Apply(const double* src, const uint8_t src_stride, double* dst,
+                           const uint8_t dst_stride)
+  {
+    const __m128d r0 = _mm_loadu_pd(src);
+    const __m128d r1 = _mm_loadu_pd(src + src_stride);
+    _mm_storeu_pd(dst, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + dst_stride, _mm_unpackhi_pd(r0, r1));
+  }
+};
+
+#endif
+
+#if defined(GRABNUM_SIMD_AVX2) || defined(GRABNUM_SIMD_SSE2)
+
+template <> struct TransposeTile<float>
+{
+  static constexpr uint8_t kSize = 4;
+
+  static inline void Apply(const float* src, const uint8_t src_stride, float* dst,
+                           const uint8_t dst_stride)
+  {
+    __m128 r0 = _mm_loadu_ps(src);
+    __m128 r1 = _mm_loadu_ps(src + src_stride);
+    __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+    __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + dst_stride, r1);
+    _mm_storeu_ps(dst + 2 * dst_stride, r2);
+    _mm_storeu_ps(dst + 3 * dst_stride, r3);
+  }
+};
+
+#endif
+
+template <typename T, uint8_t rows, uint8_t cols>
+inline void Transpose(const T* src, T* dst)
+{
+  using Tile               = TransposeTile<T>;
+  constexpr uint8_t kTile  = Tile::kSize;
+  constexpr uint8_t kRows  = rows / kTile * kTile;
+  constexpr uint8_t kCols  = cols / kTile * kTile;
+  // Full tiles first..
+  for (uint8_t row = 0; row < kRows; row += kTile)
+    for (uint8_t col = 0; col < kCols; col += kTile)
+      Tile::Apply(src + row * cols + col, cols, dst + col * rows + row, rows);
+  // ..then the remaining right and bottom stripes.
+  for (uint8_t row = 0; row < rows; ++row)
+    for (uint8_t col = (row < kRows ? kCols : 0); col < cols; ++col)
+      dst[col * rows + row] = src[row * cols + col];
+}
+
+//----- Structure-of-arrays 3D vector kernels ----------------------------------------//
+
+/**
+ * Dot products of two sets of 3D vectors stored as structure of arrays.
+ *
+ * Each buffer holds the @f$x@f$, @f$y@f$ and @f$z@f$ components of all the vectors one
+ * after the other, @a stride elements apart.
+ *
+ * @param[in] a The first set of vectors.
+ * @param[in] b The second set of vectors.
+ * @param[in] stride The distance between two components of the same vector.
+ * @param[out] out A buffer of @a size elements, the @a i-th one being
+ * @f$\mathbf{a}_i\cdot\mathbf{b}_i@f$.
+ * @param[in] size The number of vectors in each set.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+Dot3(const T* a, const T* b, const uint32_t stride, T* out, const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    out[i] = a[i] * b[i] + a[stride + i] * b[stride + i] +
+             a[2 * stride + i] * b[2 * stride + i];
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+Dot3(const T* a, const T* b, const uint32_t stride, T* out, const uint32_t size)
+{
+  using P    = Pack<T>;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+  {
+    typename P::Reg acc = P::Mul(P::Load(a + i), P::Load(b + i));
+    acc = P::MulAdd(P::Load(a + stride + i), P::Load(b + stride + i), acc);
+    acc = P::MulAdd(P::Load(a + 2 * stride + i), P::Load(b + 2 * stride + i), acc);
+    P::Store(out + i, acc);
+  }
+  for (; i < size; ++i)
+    out[i] = a[i] * b[i] + a[stride + i] * b[stride + i] +
+             a[2 * stride + i] * b[2 * stride + i];
+}
+
+/**
+ * Cross products of two sets of 3D vectors stored as structure of arrays.
+ *
+ * @param[in] a The first set of vectors.
+ * @param[in] b The second set of vectors.
+ * @param[in] stride The distance between two components of the same vector, in all
+ * buffers.
+ * @param[out] out The set of vectors @f$\mathbf{a}_i\times\mathbf{b}_i@f$. It must not
+ * overlap with the inputs.
+ * @param[in] size The number of vectors in each set.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+Cross3(const T* a, const T* b, const uint32_t stride, T* out, const uint32_t size)
+{
+  const T *ax = a, *ay = a + stride, *az = a + 2 * stride;
+  const T *bx = b, *by = b + stride, *bz = b + 2 * stride;
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    out[i]              = ay[i] * bz[i] - az[i] * by[i];
+    out[stride + i]     = az[i] * bx[i] - ax[i] * bz[i];
+    out[2 * stride + i] = ax[i] * by[i] - ay[i] * bx[i];
+  }
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+Cross3(const T* a, const T* b, const uint32_t stride, T* out, const uint32_t size)
+{
+  using P = Pack<T>;
+  const T *ax = a, *ay = a + stride, *az = a + 2 * stride;
+  const T *bx = b, *by = b + stride, *bz = b + 2 * stride;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+  {
+    const typename P::Reg rax = P::Load(ax + i), ray = P::Load(ay + i);
+    const typename P::Reg raz = P::Load(az + i), rbx = P::Load(bx + i);
+    const typename P::Reg rby = P::Load(by + i), rbz = P::Load(bz + i);
+    P::Store(out + i, P::Sub(P::Mul(ray, rbz), P::Mul(raz, rby)));
+    P::Store(out + stride + i, P::Sub(P::Mul(raz, rbx), P::Mul(rax, rbz)));
+    P::Store(out + 2 * stride + i, P::Sub(P::Mul(rax, rby), P::Mul(ray, rbx)));
+  }
+  for (; i < size; ++i)
+  {
+    out[i]              = ay[i] * bz[i] - az[i] * by[i];
+    out[stride + i]     = az[i] * bx[i] - ax[i] * bz[i];
+    out[2 * stride + i] = ax[i] * by[i] - ay[i] * bx[i];
+  }
+}
+
+/**
+ * Euclidean norms of a set of 3D vectors stored as structure of arrays.
+ *
+ * @param[in] a The set of vectors.
+ * @param[in] stride The distance between two components of the same vector.
+ * @param[out] out A buffer of @a size elements, the @a i-th one being
+ * @f$\|\mathbf{a}_i\|@f$.
+ * @param[in] size The number of vectors in the set.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+Norm3(const T* a, const uint32_t stride, T* out, const uint32_t size)
+{
+  Dot3(a, a, stride, out, size);
+  for (uint32_t i = 0; i < size; ++i)
+    out[i] = std::sqrt(out[i]);
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+Norm3(const T* a, const uint32_t stride, T* out, const uint32_t size)
+{
+  using P = Pack<T>;
+  Dot3(a, a, stride, out, size);
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(out + i, P::Sqrt(P::Load(out + i)));
+  for (; i < size; ++i)
+    out[i] = std::sqrt(out[i]);
+}
+
+//----- Trigonometric kernels --------------------------------------------------------//
+
+#if defined(GRABNUM_SIMD_AVX2) || defined(GRABNUM_SIMD_SSE2)
+
+/**
+ * @brief Polynomial approximations used by the vectorized trigonometric kernels.
+ *
+ * Each specialization holds the constants of the range reductions and the minimax
+ * polynomials (from Cephes and fdlibm) of the reduced functions, with an accuracy of a
+ * few ULPs in the precision of @a T.
+ */
+template <typename T> struct TrigPoly;
+
+template <> struct TrigPoly<double>
+{
+  using P   = Pack<double>;
+  using Reg = P::Reg;
+  // pi/2 split in three parts, for an exact reduction of |angle| < 2^20.
+  static constexpr double kPio2Hi  = 1.57079632673412561417e+00;
+  static constexpr double kPio2Mid = 6.07710050630396597660e-11;
+  static constexpr double kPio2Lo  = 2.02226624879595063154e-21;
+  // atan() is reduced around pi/4 above this threshold..
+  static constexpr double kAtanSplit = 0.66;
+  // ..and pi/4, pi/2 and pi are corrected by multiples of this tail.
+  static constexpr double kPiTail = 6.123233995736765886130e-17;
+
+  // sin(r) with z = r^2, for |r| <= pi/4.
+  static inline Reg Sin(const Reg r, const Reg z)
+  {
+    Reg p = P::MulAdd(z, P::Set1(1.58969099521155010221e-10),
+                      P::Set1(-2.50507602534068634195e-08));
+    p     = P::MulAdd(p, z, P::Set1(2.75573137070700676789e-06));
+    p     = P::MulAdd(p, z, P::Set1(-1.98412698298579493134e-04));
+    p     = P::MulAdd(p, z, P::Set1(8.33333333332248946124e-03));
+    p     = P::MulAdd(p, z, P::Set1(-1.66666666666666324348e-01));
+    return P::MulAdd(P::Mul(p, z), r, r);
+  }
+
+  // cos(r) with z = r^2, for |r| <= pi/4.
+  static inline Reg Cos(const Reg z)
+  {
+    Reg p = P::MulAdd(z, P::Set1(-1.13596475577881948265e-11),
+                      P::Set1(2.08757232129817482790e-09));
+    p     = P::MulAdd(p, z, P::Set1(-2.75573143513906633035e-07));
+    p     = P::MulAdd(p, z, P::Set1(2.48015872894767294178e-05));
+    p     = P::MulAdd(p, z, P::Set1(-1.38888888888741095749e-03));
+    p     = P::MulAdd(p, z, P::Set1(4.16666666666666019037e-02));
+    return P::MulAdd(P::Mul(p, z), z, P::MulAdd(z, P::Set1(-0.5), P::Set1(1.0)));
+  }
+
+  // atan(u) with z = u^2, for |u| <= kAtanSplit.
+  static inline Reg Atan(const Reg u, const Reg z)
+  {
+    Reg num = P::MulAdd(z, P::Set1(-8.750608600031904122785e-01),
+                        P::Set1(-1.615753718733365076637e+01));
+    num     = P::MulAdd(num, z, P::Set1(-7.500855792314704667340e+01));
+    num     = P::MulAdd(num, z, P::Set1(-1.228866684490136173410e+02));
+    num     = P::MulAdd(num, z, P::Set1(-6.485021904942025371773e+01));
+    Reg den = P::Add(z, P::Set1(2.485846490142306297962e+01));
+    den     = P::MulAdd(den, z, P::Set1(1.650270098316988542046e+02));
+    den     = P::MulAdd(den, z, P::Set1(4.328810604912902668951e+02));
+    den     = P::MulAdd(den, z, P::Set1(4.853903996359136964868e+02));
+    den     = P::MulAdd(den, z, P::Set1(1.945506571482613964425e+02));
+    return P::MulAdd(P::Mul(u, z), P::Div(num, den), u);
+  }
+};
+
+template <> struct TrigPoly<float>
+{
+  using P   = Pack<float>;
+  using Reg = P::Reg;
+  // pi/2 split in three parts, for an exact reduction of |angle| < 2^13.
+  static constexpr float kPio2Hi  = 1.5703125f;
+  static constexpr float kPio2Mid = 4.837512969970703125e-4f;
+  static constexpr float kPio2Lo  = 7.54978995489188216e-8f;
+  // atan() is reduced around pi/4 above this threshold (tan(pi/8))..
+  static constexpr float kAtanSplit = 0.4142135623730950f;
+  // ..and no correction is needed in single precision.
+  static constexpr float kPiTail = 0.f;
+
+  // sin(r) with z = r^2, for |r| <= pi/4.
+  static inline Reg Sin(const Reg r, const Reg z)
+  {
+    Reg p = P::MulAdd(z, P::Set1(-1.9515295891e-4f), P::Set1(8.3321608736e-3f));
+    p     = P::MulAdd(p, z, P::Set1(-1.6666654611e-1f));
+    return P::MulAdd(P::Mul(p, z), r, r);
+  }
+
+  // cos(r) with z = r^2, for |r| <= pi/4.
+  static inline Reg Cos(const Reg z)
+  {
+    Reg p = P::MulAdd(z, P::Set1(2.443315711809948e-5f), P::Set1(-1.388731625493765e-3f));
+    p     = P::MulAdd(p, z, P::Set1(4.166664568298827e-2f));
+    return P::MulAdd(P::Mul(p, z), z, P::MulAdd(z, P::Set1(-0.5f), P::Set1(1.f)));
+  }
+
+  // atan(u) with z = u^2, for |u| <= kAtanSplit.
+  static inline Reg Atan(const Reg u, const Reg z)
+  {
+    Reg p = P::MulAdd(z, P::Set1(8.05374449538e-2f), P::Set1(-1.38776856032e-1f));
+    p     = P::MulAdd(p, z, P::Set1(1.99777106478e-1f));
+    p     = P::MulAdd(p, z, P::Set1(-3.33329491539e-1f));
+    return P::MulAdd(P::Mul(p, z), u, u);
+  }
+};
+
+/**
+ * Sine and cosine of a register of angles, sharing the same range reduction.
+ *
+ * @param[in] angle The angles in radians.
+ * @param[out] sin The sines of @a angle.
+ * @param[out] cos The cosines of @a angle.
+ */
+template <typename T>
+inline void SinCos(const typename Pack<T>::Reg angle, typename Pack<T>::Reg* sin,
+                   typename Pack<T>::Reg* cos)
+{
+  using P    = Pack<T>;
+  using Poly = TrigPoly<T>;
+  using Reg  = typename P::Reg;
+  // Reduce to r = angle - q * pi/2, with |r| <= pi/4, and the quadrant k = q mod 4.
+  const Reg q = P::Round(P::Mul(angle, P::Set1(static_cast<T>(0.63661977236758134308))));
+  Reg r       = P::MulAdd(q, P::Set1(-Poly::kPio2Hi), angle);
+  r           = P::MulAdd(q, P::Set1(-Poly::kPio2Mid), r);
+  r           = P::MulAdd(q, P::Set1(-Poly::kPio2Lo), r);
+  const Reg k = P::MulAdd(
+    P::Round(P::Mul(P::Sub(q, P::Set1(1.5)), P::Set1(0.25))), P::Set1(-4), q);
+
+  const Reg z         = P::Mul(r, r);
+  const Reg sin_r     = Poly::Sin(r, z);
+  const Reg cos_r     = Poly::Cos(z);
+  const Reg swap      = P::Less(P::Abs(P::Sub(P::Abs(P::Sub(k, P::Set1(2))), P::Set1(1))),
+                           P::Set1(0.5)); // odd quadrant
+  const Reg sin_sign  = P::Less(P::Set1(1.5), k);
+  const Reg cos_sign  = P::Less(P::Abs(P::Sub(k, P::Set1(1.5))), P::Set1(1));
+  const Reg sin_angle = P::Select(swap, cos_r, sin_r);
+  const Reg cos_angle = P::Select(swap, sin_r, cos_r);
+  *sin = P::Select(sin_sign, P::Sub(P::Zero(), sin_angle), sin_angle);
+  *cos = P::Select(cos_sign, P::Sub(P::Zero(), cos_angle), cos_angle);
+}
+
+/**
+ * Four-quadrant arctangent of two registers.
+ *
+ * @param[in] y The ordinates.
+ * @param[in] x The abscissae.
+ * @return The angles in @f$[-\pi, \pi]@f$ of the points @f$(x, y)@f$. Unlike
+ * @c std::atan2(), signed zeros are not told apart and @f$(0, 0)@f$ yields 0.
+ */
+template <typename T>
+inline typename Pack<T>::Reg Atan2(const typename Pack<T>::Reg y,
+                                   const typename Pack<T>::Reg x)
+{
+  using P    = Pack<T>;
+  using Poly = TrigPoly<T>;
+  using Reg  = typename P::Reg;
+  // Reduce to the first octant, t = min(|x|, |y|) / max(|x|, |y|) in [0, 1]..
+  const Reg abs_x = P::Abs(x);
+  const Reg abs_y = P::Abs(y);
+  const Reg den   = P::Max(abs_x, abs_y);
+  Reg t =
+    P::Select(P::Less(P::Zero(), den), P::Div(P::Min(abs_x, abs_y), den), P::Zero());
+  // ..and then around pi/4 if still too far from 0.
+  const Reg split = P::Less(P::Set1(Poly::kAtanSplit), t);
+  t = P::Select(split, P::Div(P::Sub(t, P::Set1(1)), P::Add(t, P::Set1(1))), t);
+  Reg angle = P::Add(Poly::Atan(t, P::Mul(t, t)),
+                     P::Select(split, P::Set1(static_cast<T>(0.5) * Poly::kPiTail),
+                               P::Zero()));
+  angle = P::Add(angle, P::Select(split, P::Set1(static_cast<T>(0.78539816339744830962)),
+                                  P::Zero()));
+  // Back to the original octant and quadrant.
+  angle = P::Select(P::Less(abs_x, abs_y),
+                    P::Add(P::Sub(P::Set1(static_cast<T>(1.57079632679489661923)), angle),
+                           P::Set1(Poly::kPiTail)),
+                    angle);
+  angle = P::Select(P::Less(x, P::Zero()),
+                    P::Add(P::Sub(P::Set1(static_cast<T>(3.14159265358979323846)), angle),
+                           P::Set1(2 * Poly::kPiTail)),
+                    angle);
+  return P::Select(P::Less(y, P::Zero()), P::Sub(P::Zero(), angle), angle);
+}
+
+#endif
+
+/**
+ * Sines and cosines of a buffer of angles.
+ *
+ * The vectorized version uses polynomial approximations accurate to a few ULPs for
+ * angles up to @f$2^{20}@f$ (double) or @f$2^{13}@f$ (float) radians in magnitude.
+ *
+ * @param[in] angles A buffer of angles in radians.
+ * @param[out] sin A buffer of @a size elements, receiving the sines of @a angles.
+ * @param[out] cos A buffer of @a size elements, receiving the cosines of @a angles.
+ * @param[in] size The number of elements in all buffers.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+SinCos(const T* angles, T* sin, T* cos, const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+  {
+    sin[i] = std::sin(angles[i]);
+    cos[i] = std::cos(angles[i]);
+  }
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+SinCos(const T* angles, T* sin, T* cos, const uint32_t size)
+{
+  using P = Pack<T>;
+  typename P::Reg sin_reg, cos_reg;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+  {
+    SinCos<T>(P::Load(angles + i), &sin_reg, &cos_reg);
+    P::Store(sin + i, sin_reg);
+    P::Store(cos + i, cos_reg);
+  }
+  if (i == size)
+    return;
+  // The tail goes through the same approximation, so that all results are consistent.
+  T tail[P::kLanes] = {};
+  std::copy(angles + i, angles + size, tail);
+  SinCos<T>(P::Load(tail), &sin_reg, &cos_reg);
+  P::Store(tail, sin_reg);
+  std::copy(tail, tail + size - i, sin + i);
+  P::Store(tail, cos_reg);
+  std::copy(tail, tail + size - i, cos + i);
+}
+
+/**
+ * Four-quadrant arctangents of two buffers.
+ *
+ * @param[in] y A buffer of ordinates.
+ * @param[in] x A buffer of abscissae.
+ * @param[out] out A buffer of @a size elements, receiving the angles of the points
+ * @f$(x_i, y_i)@f$ in @f$[-\pi, \pi]@f$.
+ * @param[in] size The number of elements in all buffers.
+ */
+template <typename T>
+inline typename std::enable_if<!Pack<T>::kEnabled>::type
+Atan2(const T* y, const T* x, T* out, const uint32_t size)
+{
+  for (uint32_t i = 0; i < size; ++i)
+    out[i] = std::atan2(y[i], x[i]);
+}
+
+template <typename T>
+inline typename std::enable_if<Pack<T>::kEnabled>::type
+Atan2(const T* y, const T* x, T* out, const uint32_t size)
+{
+  using P    = Pack<T>;
+  uint32_t i = 0;
+  for (; i + P::kLanes <= size; i += P::kLanes)
+    P::Store(out + i, Atan2<T>(P::Load(y + i), P::Load(x + i)));
+  if (i == size)
+    return;
+  T tail_y[P::kLanes] = {};
+  T tail_x[P::kLanes] = {};
+  std::copy(y + i, y + size, tail_y);
+  std::copy(x + i, x + size, tail_x);
+  P::Store(tail_y, Atan2<T>(P::Load(tail_y), P::Load(tail_x)));
+  std::copy(tail_y, tail_y + size - i, out + i);
+}
+
+} // end namespace simd
+
+} // end namespace grabnum
+
+#endif // GRABCOMMON_LIBNUMERIC_SIMD_H
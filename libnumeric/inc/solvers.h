@@ -8,7 +8,13 @@
 #ifndef GRABCOMMON_LIBNUMERIC_SOLVERS_H
 #define GRABCOMMON_LIBNUMERIC_SOLVERS_H
 
-#include "matrix.h"
+#include <array>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include "decompositions.h"
+#include "matrix_sparse.h"
 
 /**
  * @brief Namespace for GRAB numeric library.
@@ -37,6 +43,9 @@ namespace solvers
  * @param[in] _mat A @f$m \times m@f$ square matrix of coefficients @f$\mathbf{A}@f$.
  * @param[in] _vect A @f$m@f$-dimensional vector of constant terms @f$\mathbf{b}@f$.
  * @return A @f$m@f$-dimensional vector with the solution @f$\mathbf{x}@f$.
+ * @note The matrix is factorized at each call. When solving many systems with the same
+ * matrix, factorize it once with LU and call LU::Solve() instead.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
  */
 template <typename T, uint8_t dim>
 VectorX<T, dim> Linsolve(const Matrix<T, dim, dim>& _mat, const VectorX<T, dim>& _vect);
@@ -47,12 +56,28 @@ VectorX<T, dim> Linsolve(const Matrix<T, dim, dim>& _mat, const VectorX<T, dim>&
  * @param[in] _mat A @f$m \times m@f$ square matrix of coefficients @f$\mathbf{A}@f$.
  * @param[in] _vect A @f$m@f$-dimensional vector of constant terms @f$\mathbf{b}@f$.
  * @param[out] result A @f$m@f$-dimensional vector with the solution @f$\mathbf{x}@f$.
+ * @note Throws a @c std::invalid_argument exception if the matrix is singular.
  * @see Linsolve()
  */
 template <typename T, uint8_t dim>
 void Linsolve(const Matrix<T, dim, dim>& _mat, const VectorX<T, dim>& _vect,
               VectorX<T, dim>& result);
 
+/**
+ * Solve a @f$m \times m@f$ sparse linear system in matrix form.
+ *
+ * The structure of the matrix is detected with SelectSparseStructure() and exploited by
+ * SparseLU, so that banded and block-diagonal systems, e.g. the ones of large cable
+ * robots or of several robots at once, avoid the cubic cost of a dense factorization.
+ * @param[in] mat A @f$m \times m@f$ sparse square matrix of coefficients
+ * @f$\mathbf{A}@f$.
+ * @param[in] vect A @f$m \times k@f$ matrix of constant terms, one system per column.
+ * @return A @f$m \times k@f$ matrix with the solutions.
+ * @see Linsolve()
+ */
+template <typename T, class ExprT>
+MatrixX<T> Linsolve(const SparseMatrix<T>& mat, const MatrixExpr<ExprT>& vect);
+
 /**
  * Solve a @f$m \times m@f$ linear system in matrix form where the coefficients matrix is
  * upper-triangular.
@@ -78,6 +103,33 @@ template <typename T, uint8_t dim>
 void LinsolveUp(const Matrix<T, dim, dim>& mat, const VectorX<T, dim>& vect,
                 VectorX<T, dim>& result);
 
+/**
+ * @brief Reusable state of NonLinsolveJacobian().
+ *
+ * Passing the same workspace to successive calls, e.g. one per control cycle, avoids
+ * re-creating the solver state each time, and gives access to the residual and jacobian
+ * at the last iterate.
+ */
+template <typename T, uint8_t dim> struct NewtonWorkspace
+{
+  VectorX<T, dim> residual;     /**< residual at the last iterate. */
+  Matrix<T, dim, dim> jacobian; /**< jacobian at the last iterate. */
+  VectorX<T, dim> step;         /**< last _Newton_ step. */
+  LU<T, dim> lu;                /**< factorization of the jacobian. */
+};
+
+/**
+ * @brief Reusable state of fsolveB().
+ * @see NewtonWorkspace
+ */
+template <typename T, uint8_t dim> struct BroydenWorkspace
+{
+  VectorX<T, dim> residual;     /**< residual at the last iterate. */
+  Matrix<T, dim, dim> jacobian; /**< _Broyden_ approximation of the jacobian. */
+  VectorX<T, dim> step;         /**< last quasi-_Newton_ step. */
+  LU<T, dim> lu;                /**< factorization of the approximated jacobian. */
+};
+
 /**
  * Solve a non-linear system??
  *
@@ -86,12 +138,44 @@ void LinsolveUp(const Matrix<T, dim, dim>& mat, const VectorX<T, dim>& vect,
  * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
  * @todo this.
  * @return A scalar with the number of iterations.
+ * @note Iterations stop early, keeping the last iterate, if the jacobian is singular.
  */
 template <typename T, uint8_t dim>
 int NonLinsolveJacobian(void (*fun_ptr)(VectorX<T, dim>&, Matrix<T, dim, dim>&,
                                         const VectorX<T, dim>&),
                         VectorX<T, dim>& solution, const uint8_t nmax = 100);
 
+/**
+ * Solve a square non-linear system with _Newton_'s method.
+ *
+ * @param[in] fun Callable with signature
+ * `void(VectorX<T, n>& residual, Matrix<T, n, n>& jacobian, const VectorX<T, n>& x)`,
+ * e.g. a lambda capturing the parameters of the problem. Unlike a function pointer, it
+ * can be inlined in the iteration loop.
+ * @param[in,out] solution Initial guess, replaced by the solution.
+ * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
+ * @return A scalar with the number of iterations.
+ * @note Iterations stop early, keeping the last iterate, if the jacobian is singular.
+ */
+template <typename T, uint8_t dim, class FunT>
+int NonLinsolveJacobian(FunT&& fun, VectorX<T, dim>& solution, const uint8_t nmax = 100);
+
+/**
+ * Solve a square non-linear system with _Newton_'s method, reusing a workspace.
+ *
+ * @param[in] fun Callable computing residual and jacobian at a point.
+ * @param[in,out] solution Initial guess, replaced by the solution.
+ * @param[in,out] workspace The solver state, holding residual and jacobian at the
+ * solution on return.
+ * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
+ * @return A scalar with the number of iterations.
+ * @see NonLinsolveJacobian()
+ * @note Iterations stop early, keeping the last iterate, if the jacobian is singular.
+ */
+template <typename T, uint8_t dim, class FunT>
+int NonLinsolveJacobian(FunT&& fun, VectorX<T, dim>& solution,
+                        NewtonWorkspace<T, dim>& workspace, const uint8_t nmax = 100);
+
 /**
  * Solve a non-linear system??
  *
@@ -100,35 +184,603 @@ int NonLinsolveJacobian(void (*fun_ptr)(VectorX<T, dim>&, Matrix<T, dim, dim>&,
  * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
  * @todo this.
  * @return A scalar with the number of iterations.
+ * @note Iterations stop early, keeping the last iterate, if the approximated jacobian is
+ * singular.
  */
 template <typename T, uint8_t dim>
 int fsolveB(void (*fun_ptr)(VectorX<T, dim>&, const VectorX<T, dim>&),
             VectorX<T, dim>& solution, const uint8_t nmax = 100);
 
+/**
+ * Solve a square non-linear system with _Broyden_'s method, which needs no jacobian.
+ *
+ * @param[in] fun Callable with signature
+ * `void(VectorX<T, n>& residual, const VectorX<T, n>& x)`.
+ * @param[in,out] solution Initial guess, replaced by the solution.
+ * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
+ * @return A scalar with the number of iterations.
+ * @note Iterations stop early, keeping the last iterate, if the approximated jacobian is
+ * singular.
+ */
+template <typename T, uint8_t dim, class FunT>
+int fsolveB(FunT&& fun, VectorX<T, dim>& solution, const uint8_t nmax = 100);
+
+/**
+ * Solve a square non-linear system with _Broyden_'s method, reusing a workspace.
+ *
+ * @param[in] fun Callable computing the residual at a point.
+ * @param[in,out] solution Initial guess, replaced by the solution.
+ * @param[in,out] workspace The solver state.
+ * @param[in] nmax (Optional) Maximum number of iterations. Default is 100.
+ * @return A scalar with the number of iterations.
+ * @see fsolveB()
+ * @note Iterations stop early, keeping the last iterate, if the approximated jacobian is
+ * singular.
+ */
+template <typename T, uint8_t dim, class FunT>
+int fsolveB(FunT&& fun, VectorX<T, dim>& solution, BroydenWorkspace<T, dim>& workspace,
+            const uint8_t nmax = 100);
+
+/**
+ * @brief Termination reason of an iterative solver.
+ */
+enum SolverStatus
+{
+  CONVERGED_RESIDUAL, /**< the norm of the residual fell below its tolerance. */
+  CONVERGED_STEP,     /**< the norm of the step fell below its tolerance. */
+  CONVERGED_GRADIENT, /**< the norm of the gradient fell below its tolerance. */
+  MAX_ITERATIONS,     /**< the iteration budget was exhausted. */
+  MAX_TIME,           /**< the time budget was exhausted. */
+  NUMERIC_FAILURE,    /**< the residual or its jacobian are not finite. */
+  INFEASIBLE          /**< the constraints cannot be satisfied. */
+};
+
+/**
+ * @brief Options of LevenbergMarquardt().
+ */
+template <typename T> struct LevMarOptions
+{
+  uint16_t max_iter = 100;   /**< maximum number of iterations. */
+  double max_time   = 0.0;   /**< [_s_] time budget, or 0 for none. */
+  T ftol            = 1e-9;  /**< tolerance on the norm of the residual. */
+  T xtol            = 1e-9;  /**< relative tolerance on the norm of the step. */
+  T gtol            = 1e-12; /**< tolerance on the infinity norm of the gradient. */
+  T damping         = 1e-3;  /**< initial damping, relative to the largest diagonal
+                                  element of @f$\mathbf{J}^T\mathbf{J}@f$. */
+};
+
+/**
+ * @brief Convergence diagnostics of an iterative solver.
+ */
+template <typename T> struct SolverReport
+{
+  SolverStatus status;  /**< termination reason. */
+  uint16_t iterations;  /**< number of iterations, i.e. of linear systems solved. */
+  uint16_t evaluations; /**< number of calls to the residual function. */
+  T residual_norm;      /**< norm of the residual at the solution. */
+  T damping;            /**< damping at termination. */
+  double elapsed;       /**< [_s_] time spent in the solver. */
+
+  /**
+   * Checks whether the solver met any of its convergence criteria.
+   *
+   * @return _True_ if the solver converged, _false_ if it ran out of budget or failed.
+   */
+  bool Converged() const { return status <= CONVERGED_GRADIENT; }
+};
+
+/**
+ * Solve a non-linear least-squares problem with the _Levenberg-Marquardt_ method.
+ *
+ * Given a residual function @f$\mathbf{f}(\mathbf{x}) \in \mathbb{R}^m@f$, with
+ * @f$\mathbf{x} \in \mathbb{R}^n@f$ and @f$m \geq n@f$ or @f$m<n@f$ alike, it finds a
+ * local minimum of @f$\frac{1}{2}\|\mathbf{f}(\mathbf{x})\|^2@f$ by taking damped
+ * _Gauss-Newton_ steps
+ * @f[
+ * (\mathbf{J}^T\mathbf{J} + \mu\mathbf{I})\mathbf{h} = -\mathbf{J}^T\mathbf{f}
+ * @f]
+ * where the damping @f$\mu@f$ is adapted at each iteration according to the ratio
+ * between the actual and the predicted decrease of the cost (_Nielsen_'s strategy).
+ * Steps which do not decrease the cost are rejected and retried with a larger damping,
+ * so that the method behaves like _Newton_ close to the solution and like gradient
+ * descent far from it.
+ *
+ * Iterations stop when a convergence criterion is met, or when the iteration or time
+ * budget is exhausted, so that the solver can run within a control cycle.
+ * @param[in] fun Callable with signature
+ * `void(VectorX<T, m>& residual, Matrix<T, m, n>& jacobian, const VectorX<T, n>& x)`.
+ * @param[in,out] solution Initial guess, replaced by the best solution found.
+ * @param[in] options (Optional) Tolerances and budgets.
+ * @return The convergence diagnostics.
+ * @note The number of residuals @f$m@f$ cannot be deduced from a generic callable, so
+ * it must be given explicitly, e.g. `LevenbergMarquardt<8>(fun, pose)`.
+ */
+template <uint8_t rows, typename T, uint8_t cols, class FunT>
+SolverReport<T> LevenbergMarquardt(FunT&& fun, VectorX<T, cols>& solution,
+                                   const LevMarOptions<T>& options = LevMarOptions<T>());
+
+/**
+ * Solve a non-linear least-squares problem with the _Levenberg-Marquardt_ method.
+ *
+ * @param[in] fun_ptr Pointer to function computing residual and jacobian at a point.
+ * @param[in,out] solution Initial guess, replaced by the best solution found.
+ * @param[in] options (Optional) Tolerances and budgets.
+ * @return The convergence diagnostics.
+ * @see LevenbergMarquardt()
+ */
+template <typename T, uint8_t rows, uint8_t cols>
+SolverReport<T> LevenbergMarquardt(void (*fun_ptr)(VectorX<T, rows>&,
+                                                   Matrix<T, rows, cols>&,
+                                                   const VectorX<T, cols>&),
+                                   VectorX<T, cols>& solution,
+                                   const LevMarOptions<T>& options = LevMarOptions<T>());
+
+/**
+ * @brief Options of QuadProg().
+ */
+template <typename T> struct QPOptions
+{
+  uint16_t max_iter = 50;    /**< maximum number of iterations. */
+  double max_time   = 0.0;   /**< [_s_] time budget, or 0 for none. */
+  T tol             = 1e-9;  /**< tolerance on bound violations and multipliers signs,
+                                  relative to their scale. */
+  T eqtol           = 1e-6;  /**< tolerance on the residual of the equality constraints,
+                                  relative to the norm of their constant terms. */
+  T regularization  = 1e-12; /**< regularization of the equality constraints, relative
+                                  to the largest diagonal element of the hessian. */
+};
+
+/**
+ * @brief Reusable state of QuadProg().
+ *
+ * The active set found by a call is the starting guess of the next one, so that a
+ * sequence of similar problems, e.g. one per control cycle, is solved in one or two
+ * iterations each. Fill #active_set with zeros to start from scratch.
+ */
+template <typename T, uint8_t n, uint8_t m> struct QPWorkspace
+{
+  static_assert(n + m <= 255, "ERROR: too many variables and constraints in QuadProg!");
+
+  std::array<int8_t, n> active_set{}; /**< -1 if a variable is at its lower bound, 1 if
+                                           at its upper bound, 0 if free. */
+  VectorX<T, m> eq_multipliers;       /**< multipliers of the equality constraints. */
+  VectorX<T, n> bound_multipliers;    /**< multipliers of the bounds, zero if free. */
+  Matrix<T, n + m, n + m> kkt;        /**< KKT matrix of the last iteration. */
+  LU<T, n + m> lu;                    /**< factorization of the KKT matrix. */
+};
+
+/**
+ * Solve a convex quadratic program with equality constraints and bounds.
+ *
+ * It finds
+ * @f[
+ * \min_{\mathbf{x}} \frac{1}{2}\mathbf{x}^T\mathbf{H}\mathbf{x} + \mathbf{f}^T\mathbf{x}
+ * \quad \text{s.t.} \quad \mathbf{A}\mathbf{x} = \mathbf{b}, \quad
+ * \mathbf{l} \leq \mathbf{x} \leq \mathbf{u}
+ * @f]
+ * with a _primal-dual active-set_ method. Each iteration fixes the variables of the
+ * active set at their bounds, solves the KKT system of the remaining equality-constrained
+ * problem, and then frees the fixed variables whose multiplier has the wrong sign and
+ * fixes the free ones which violate a bound. This is _Júdice_ and _Pires_' block
+ * principal pivoting: all changes are made at once while they reduce the number of
+ * violations, otherwise only the violating variable with the largest index is changed
+ * (_Murty_'s rule), which guarantees termination.
+ *
+ * The equality constraints are regularized by a tiny penalty, so that the KKT matrix is
+ * never singular. As a consequence, when they cannot be met within the bounds, the
+ * solution found is the one which violates them the least (in the least-squares sense)
+ * and the status is INFEASIBLE.
+ *
+ * All storage is fixed-size and kept in the workspace, whose active set warm-starts the
+ * next call.
+ * @param[in] hessian A @f$n \times n@f$ symmetric positive definite matrix
+ * @f$\mathbf{H}@f$.
+ * @param[in] gradient A @f$n@f$-dimensional vector @f$\mathbf{f}@f$.
+ * @param[in] eq_mat A @f$m \times n@f$ matrix of equality constraints @f$\mathbf{A}@f$.
+ * @param[in] eq_vect A @f$m@f$-dimensional vector of constant terms @f$\mathbf{b}@f$.
+ * @param[in] lower A @f$n@f$-dimensional vector of lower bounds @f$\mathbf{l}@f$.
+ * @param[in] upper A @f$n@f$-dimensional vector of upper bounds @f$\mathbf{u}@f$.
+ * @param[out] solution The solution @f$\mathbf{x}@f$.
+ * @param[in,out] workspace The solver state, including the active set used as guess.
+ * @param[in] options (Optional) Tolerances and budgets.
+ * @return The convergence diagnostics, where the residual is the norm of
+ * @f$\mathbf{A}\mathbf{x} - \mathbf{b}@f$ and the damping is the regularization.
+ * @note Bounds must satisfy @f$\mathbf{l} \leq \mathbf{u}@f$. Infinite bounds are
+ * allowed.
+ */
+template <typename T, uint8_t n, uint8_t m>
+SolverReport<T> QuadProg(const Matrix<T, n, n>& hessian, const VectorX<T, n>& gradient,
+                         const Matrix<T, m, n>& eq_mat, const VectorX<T, m>& eq_vect,
+                         const VectorX<T, n>& lower, const VectorX<T, n>& upper,
+                         VectorX<T, n>& solution, QPWorkspace<T, n, m>& workspace,
+                         const QPOptions<T>& options = QPOptions<T>());
+
+/**
+ * @brief Reusable state of RKSolver().
+ * @see NewtonWorkspace
+ */
+template <typename T, uint8_t dim> struct RKWorkspace
+{
+  Matrix<T, dim, 6> stages;   /**< derivatives at the stages of the method. */
+  VectorX<T, dim> increment;  /**< weighted sum of the stages. */
+  VectorX<T, dim> state;      /**< state where the derivative is evaluated. */
+  VectorX<T, dim> derivative; /**< derivative at @ref state. */
+};
+
 /**
  * @brief _Runge–Kutta–Fehlberg method_ for the numerical solution of ODEs.
  *
  * The _Runge–Kutta–Fehlberg method_ (or _Fehlberg method_) is an algorithm in numerical
  * analysis for the numerical solution of ordinary differential equations. It is a method
- *of order
- * @f$O(h^4)@f$ with an error estimator of order @f$O(h^5)@f$.
+ * of order @f$O(h^4)@f$ with an error estimator of order @f$O(h^5)@f$.
  * @param[in] fun_ptr Pointer to differential equation of type
  * @f$\dot{\mathbf{y}} = f(t, \mathbf{y}), \mathbf{y} \in \mathbb{R}^m@f$. The arguments
- * of such function @f$f@f$ are (_time instant_ @f$t@f$ [s], _input vector_ @f$\mathbf{y}@f$,
- * _output vector_ @f$\dot{\mathbf{y}}@f$).
+ * of such function @f$f@f$ are (_time instant_ @f$t@f$ [s], _input vector_
+ * @f$\mathbf{y}@f$, _output vector_ @f$\dot{\mathbf{y}}@f$).
  * @param[in] time _n_-dimensional time vector with time step @f$h = t_k - t_{k-1}@f$ [s].
  * @param[in] y0 Values of @f$\mathbf{y}@f$ at initial time @f$t_0@f$, i.e.
  * @f$\mathbf{y}_0@f$.
  * @param[out] sol @f$m \times n@f$ solution matrix, where _i-th_ column represents the
  * solution of the problem at instant @f$t_i@f$, i.e. @f$\mathbf{y}_i@f$.
  */
-template <typename T, uint8_t dim, size_t t_steps>
-void RKSolver(void (*fun_ptr)(const T, const VectorX<T, dim>, VectorX<T, dim>),
+template <typename T, uint8_t dim, uint8_t t_steps>
+void RKSolver(void (*fun_ptr)(const T, const VectorX<T, dim>&, VectorX<T, dim>&),
               const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
               Matrix<T, dim, t_steps>& sol);
 
+/**
+ * @brief _Runge–Kutta–Fehlberg method_ for the numerical solution of ODEs.
+ *
+ * @param[in] fun Callable with signature
+ * `void(const T t, const VectorX<T, m>& y, VectorX<T, m>& y_dot)`, e.g. a lambda
+ * capturing the parameters of the system.
+ * @param[in] time _n_-dimensional time vector with time step @f$h = t_k - t_{k-1}@f$ [s].
+ * @param[in] y0 Values of @f$\mathbf{y}@f$ at initial time @f$t_0@f$.
+ * @param[out] sol @f$m \times n@f$ solution matrix.
+ * @see RKSolver()
+ */
+template <typename T, uint8_t dim, uint8_t t_steps, class FunT>
+void RKSolver(FunT&& fun, const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
+              Matrix<T, dim, t_steps>& sol);
+
+/**
+ * @brief _Runge–Kutta–Fehlberg method_ for the numerical solution of ODEs, reusing a
+ * workspace.
+ *
+ * @param[in] fun Callable computing the derivative of the state.
+ * @param[in] time _n_-dimensional time vector with time step @f$h = t_k - t_{k-1}@f$ [s].
+ * @param[in] y0 Values of @f$\mathbf{y}@f$ at initial time @f$t_0@f$.
+ * @param[out] sol @f$m \times n@f$ solution matrix.
+ * @param[in,out] workspace The solver state.
+ * @see RKSolver()
+ */
+template <typename T, uint8_t dim, uint8_t t_steps, class FunT>
+void RKSolver(FunT&& fun, const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
+              Matrix<T, dim, t_steps>& sol, RKWorkspace<T, dim>& workspace);
+
+/**
+ * @brief Termination reason of an ODE integration.
+ */
+enum ODEStatus
+{
+  END_REACHED,    /**< the final time was reached. */
+  INTERRUPTED,    /**< the step callback requested to stop. */
+  MAX_STEPS,      /**< the step budget was exhausted. */
+  STEP_UNDERFLOW  /**< the step needed to meet the tolerances became too small. */
+};
+
+/**
+ * @brief Options of DormandPrince().
+ */
+template <typename T> struct ODEOptions
+{
+  T rel_tol          = 1e-6;   /**< relative tolerance on the local error. */
+  T abs_tol          = 1e-9;   /**< absolute tolerance on the local error. */
+  T initial_step     = 0;      /**< [_s_] first step, or 0 to estimate it. */
+  T max_step         = 0;      /**< [_s_] largest allowed step, or 0 for none. */
+  uint32_t max_steps = 100000; /**< maximum number of accepted and rejected steps. */
+};
+
+/**
+ * @brief Diagnostics of an ODE integration.
+ */
+template <typename T> struct ODEReport
+{
+  ODEStatus status;        /**< termination reason. */
+  T time;                  /**< [_s_] time reached. */
+  T last_step;             /**< [_s_] size of the last accepted step. */
+  uint32_t accepted_steps; /**< number of accepted steps. */
+  uint32_t rejected_steps; /**< number of steps rejected by the error control. */
+  uint32_t evaluations;    /**< number of calls to the differential equation. */
+};
+
+/**
+ * @brief Dense output of an accepted step of DormandPrince().
+ *
+ * It interpolates the solution anywhere within the step with a 4th-order continuous
+ * extension of the method, at the cost of a few vector operations and no further
+ * evaluation of the differential equation. This allows to sample the solution at any
+ * rate, independently of the steps chosen by the error control.
+ */
+template <typename T, uint8_t dim> class DenseOutput
+{
+public:
+  /**
+   * Returns the time at the beginning of the step.
+   *
+   * @return [_s_] The time @f$t_k@f$.
+   */
+  T GetStartTime() const { return start_time_; }
+  /**
+   * Returns the time at the end of the step.
+   *
+   * @return [_s_] The time @f$t_{k+1}@f$.
+   */
+  T GetEndTime() const { return start_time_ + step_; }
+  /**
+   * Returns the solution at the beginning of the step.
+   *
+   * @return The state @f$\mathbf{y}_k@f$.
+   */
+  const VectorX<T, dim>& GetStartState() const { return coeffs_[0]; }
+  /**
+   * Returns the solution at the end of the step.
+   *
+   * @return The state @f$\mathbf{y}_{k+1}@f$.
+   */
+  const VectorX<T, dim>& GetEndState() const { return end_state_; }
+
+  /**
+   * Interpolates the solution within the step.
+   *
+   * @param[in] time [_s_] A time in @f$[t_k, t_{k+1}]@f$.
+   * @return The interpolated state @f$\mathbf{y}(t)@f$.
+   */
+  VectorX<T, dim> Evaluate(const T time) const;
+
+private:
+  template <typename U, uint8_t n, class FunT, class CallbackT>
+  friend ODEReport<U> DormandPrince(FunT&&, const U, const U, VectorX<U, n>&,
+                                    const ODEOptions<U>&, CallbackT&&);
+
+  T start_time_;
+  T step_;
+  VectorX<T, dim> end_state_;
+  VectorX<T, dim> coeffs_[5]; /**< coefficients of the interpolating polynomial. */
+};
+
+/**
+ * Integrate a system of ODEs with the adaptive _Dormand-Prince_ method (RK45).
+ *
+ * It solves @f$\dot{\mathbf{y}} = f(t, \mathbf{y})@f$ from @f$t_0@f$ to @f$t_f@f$
+ * with an explicit _Runge-Kutta_ pair of orders 5 and 4, which share the same 7
+ * stages. The difference between the two solutions estimates the local error, which
+ * drives the size of each step so that
+ * @f[
+ * \sqrt{\frac{1}{m}\sum_i\left(\frac{e_i}{\epsilon_a + \epsilon_r|y_i|}\right)^2}
+ * \leq 1
+ * @f]
+ * Since the last stage of a step is the first of the next one, each step costs 6
+ * evaluations of @f$f@f$.
+ *
+ * Unlike RKSolver(), neither the number of steps nor the output times must be known in
+ * advance: each accepted step is handed to a callback as DenseOutput, from which the
+ * solution can be sampled or stored as needed, so that long trajectories can be
+ * integrated in constant memory.
+ * @param[in] fun Callable with signature
+ * `void(const T t, const VectorX<T, m>& y, VectorX<T, m>& y_dot)`.
+ * @param[in] start_time [_s_] Initial time @f$t_0@f$.
+ * @param[in] end_time [_s_] Final time @f$t_f > t_0@f$.
+ * @param[in,out] state Initial state @f$\mathbf{y}_0@f$, replaced by the state at the
+ * time reached.
+ * @param[in] options Tolerances and budget.
+ * @param[in] callback Callable with signature `bool(const DenseOutput<T, m>& step)`,
+ * called after each accepted step. Integration stops if it returns _false_.
+ * @return The integration diagnostics.
+ * @note Throws a @c std::invalid_argument exception if @f$t_f \leq t_0@f$ or if the
+ * tolerances are not positive.
+ */
+template <typename T, uint8_t dim, class FunT, class CallbackT>
+ODEReport<T> DormandPrince(FunT&& fun, const T start_time, const T end_time,
+                           VectorX<T, dim>& state, const ODEOptions<T>& options,
+                           CallbackT&& callback);
+
+/**
+ * Integrate a system of ODEs with the adaptive _Dormand-Prince_ method (RK45), keeping
+ * only the final state.
+ *
+ * @param[in] fun Callable computing the derivative of the state.
+ * @param[in] start_time [_s_] Initial time @f$t_0@f$.
+ * @param[in] end_time [_s_] Final time @f$t_f > t_0@f$.
+ * @param[in,out] state Initial state, replaced by the state at the time reached.
+ * @param[in] options (Optional) Tolerances and budget.
+ * @return The integration diagnostics.
+ * @see DormandPrince()
+ */
+template <typename T, uint8_t dim, class FunT>
+ODEReport<T> DormandPrince(FunT&& fun, const T start_time, const T end_time,
+                           VectorX<T, dim>& state,
+                           const ODEOptions<T>& options = ODEOptions<T>());
+
+/**
+ * @brief Fixed-step integrator of ODEs with the classic 4th-order _Runge-Kutta_ method.
+ *
+ * It advances @f$\dot{\mathbf{y}} = f(t, \mathbf{y})@f$ by one step at a time, e.g. by
+ * one control period per real-time cycle, at the cost of exactly 4 evaluations of
+ * @f$f@f$, without any allocation or branch on the state. All intermediate vectors are
+ * kept in the object, which should therefore be created once, before the real-time loop:
+ * @code
+ * auto stepper = solvers::MakeRK4Stepper<double, 12>(
+ *   [&params](double t, const VectorXd<12>& y, VectorXd<12>& y_dot) { ... });
+ * while (running)
+ *   stepper.Step(t, y, kCyclePeriod);
+ * @endcode
+ * @tparam FunT Callable with signature
+ * `void(const T t, const VectorX<T, m>& y, VectorX<T, m>& y_dot)`.
+ * @see MakeRK4Stepper()
+ */
+template <typename T, uint8_t dim, class FunT> class RK4Stepper
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in RK4Stepper!");
+
+public:
+  /**
+   * Full constructor.
+   *
+   * @param[in] fun The differential equation @f$f@f$.
+   */
+  explicit RK4Stepper(FunT fun) : fun_(std::move(fun)) {}
+
+  /**
+   * Advances the solution by one step.
+   *
+   * @param[in] time [_s_] Time @f$t_k@f$ at the beginning of the step.
+   * @param[in,out] state State @f$\mathbf{y}_k@f$, replaced by @f$\mathbf{y}_{k+1}@f$.
+   * @param[in] dt [_s_] Step size.
+   */
+  void Step(const T time, VectorX<T, dim>& state, const T dt);
+
+private:
+  FunT fun_;
+  VectorX<T, dim> k1_, k2_, k3_, k4_, stage_;
+};
+
+/**
+ * @brief Fixed-step _semi-implicit_ (or _symplectic_) _Euler_ integrator of second-order
+ * ODEs.
+ *
+ * The state @f$\mathbf{y} = [\mathbf{q}^T, \mathbf{v}^T]^T@f$ stacks positions and
+ * velocities, and @f$f@f$ returns @f$[\mathbf{v}^T, \mathbf{a}^T]^T@f$ like for
+ * RK4Stepper, so that the same model can be used with either stepper. Velocities are
+ * updated first and then used to update positions:
+ * @f[
+ * \mathbf{v}_{k+1} = \mathbf{v}_k + \Delta t\,\mathbf{a}(t_k, \mathbf{q}_k,
+ * \mathbf{v}_k) \qquad \mathbf{q}_{k+1} = \mathbf{q}_k + \Delta t\,\mathbf{v}_{k+1}
+ * @f]
+ * It is only first-order accurate, but it costs a single evaluation of @f$f@f$ per step
+ * and does not drift in energy on conservative systems, like stiff cable springs.
+ * @tparam FunT Callable with signature
+ * `void(const T t, const VectorX<T, m>& y, VectorX<T, m>& y_dot)`.
+ * @see MakeSemiImplicitEulerStepper()
+ */
+template <typename T, uint8_t dim, class FunT> class SemiImplicitEulerStepper
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in SemiImplicitEulerStepper!");
+  static_assert(dim % 2 == 0,
+                "ERROR: state must stack positions and velocities of equal size!");
+
+public:
+  /**
+   * Full constructor.
+   *
+   * @param[in] fun The differential equation @f$f@f$.
+   */
+  explicit SemiImplicitEulerStepper(FunT fun) : fun_(std::move(fun)) {}
+
+  /**
+   * Advances the solution by one step.
+   *
+   * @param[in] time [_s_] Time @f$t_k@f$ at the beginning of the step.
+   * @param[in,out] state State @f$\mathbf{y}_k@f$, replaced by @f$\mathbf{y}_{k+1}@f$.
+   * @param[in] dt [_s_] Step size.
+   */
+  void Step(const T time, VectorX<T, dim>& state, const T dt);
+
+private:
+  FunT fun_;
+  VectorX<T, dim> derivative_;
+};
+
+/**
+ * @brief Fixed-step _velocity Verlet_ integrator of second-order ODEs.
+ *
+ * The state stacks positions and velocities like for SemiImplicitEulerStepper. Each step
+ * costs 2 evaluations of @f$f@f$:
+ * @f[
+ * \mathbf{q}_{k+1} = \mathbf{q}_k + \Delta t\,\mathbf{v}_k +
+ * \frac{\Delta t^2}{2}\mathbf{a}_k \qquad
+ * \mathbf{v}_{k+1} = \mathbf{v}_k + \frac{\Delta t}{2}(\mathbf{a}_k + \mathbf{a}_{k+1})
+ * @f]
+ * where @f$\mathbf{a}_{k+1}@f$ is evaluated at the new positions and at the mid-step
+ * velocities, so that velocity-dependent forces, like damping, are handled too. It is
+ * second-order accurate and symplectic for velocity-independent forces.
+ * @tparam FunT Callable with signature
+ * `void(const T t, const VectorX<T, m>& y, VectorX<T, m>& y_dot)`.
+ * @see MakeVerletStepper()
+ */
+template <typename T, uint8_t dim, class FunT> class VerletStepper
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in VerletStepper!");
+  static_assert(dim % 2 == 0,
+                "ERROR: state must stack positions and velocities of equal size!");
+
+public:
+  /**
+   * Full constructor.
+   *
+   * @param[in] fun The differential equation @f$f@f$.
+   */
+  explicit VerletStepper(FunT fun) : fun_(std::move(fun)) {}
+
+  /**
+   * Advances the solution by one step.
+   *
+   * @param[in] time [_s_] Time @f$t_k@f$ at the beginning of the step.
+   * @param[in,out] state State @f$\mathbf{y}_k@f$, replaced by @f$\mathbf{y}_{k+1}@f$.
+   * @param[in] dt [_s_] Step size.
+   */
+  void Step(const T time, VectorX<T, dim>& state, const T dt);
+
+private:
+  FunT fun_;
+  VectorX<T, dim> derivative_;
+};
+
+/**
+ * Creates a RK4Stepper, deducing the type of the callable.
+ *
+ * @param[in] fun The differential equation, e.g. a lambda.
+ * @return The stepper, e.g. `auto stepper = MakeRK4Stepper<double, 12>(fun);`.
+ */
+template <typename T, uint8_t dim, class FunT>
+RK4Stepper<T, dim, typename std::decay<FunT>::type> MakeRK4Stepper(FunT&& fun)
+{
+  return RK4Stepper<T, dim, typename std::decay<FunT>::type>(std::forward<FunT>(fun));
+}
+
+/**
+ * Creates a SemiImplicitEulerStepper, deducing the type of the callable.
+ *
+ * @param[in] fun The differential equation, e.g. a lambda.
+ * @return The stepper.
+ */
+template <typename T, uint8_t dim, class FunT>
+SemiImplicitEulerStepper<T, dim, typename std::decay<FunT>::type>
+MakeSemiImplicitEulerStepper(FunT&& fun)
+{
+  return SemiImplicitEulerStepper<T, dim, typename std::decay<FunT>::type>(
+    std::forward<FunT>(fun));
+}
+
+/**
+ * Creates a VerletStepper, deducing the type of the callable.
+ *
+ * @param[in] fun The differential equation, e.g. a lambda.
+ * @return The stepper.
+ */
+template <typename T, uint8_t dim, class FunT>
+VerletStepper<T, dim, typename std::decay<FunT>::type> MakeVerletStepper(FunT&& fun)
+{
+  return VerletStepper<T, dim, typename std::decay<FunT>::type>(std::forward<FunT>(fun));
+}
+
 } // end namespace solvers
 
 } // end namespace grabnum
 
+// This is a trick to define templated functions in a source file.
+#include "../src/solvers.cpp"
+
 #endif // GRABCOMMON_LIBNUMERIC_SOLVERS_H
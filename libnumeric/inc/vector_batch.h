@@ -0,0 +1,176 @@
+/**
+ * @file vector_batch.h
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing a batch of 3D vectors stored as structure of arrays, and the
+ * vectorized kernels working on it.
+ *
+ * Per-cable quantities, like the attach points or the pulley versors of a CDPR, are
+ * usually processed one 3D vector at a time, which leaves most of a SIMD register
+ * unused. A batch stores the same quantity for many cables (or many candidate poses)
+ * component by component, so that each kernel processes several vectors per
+ * instruction:
+ * @code
+ * Vector3Batchd<8> pos_DA, vers_i, vers_j;       // one lane per cable
+ * std::array<double, 8> swivel_ang =
+ *   Atan2(Dot(vers_j, pos_DA), Dot(vers_i, pos_DA)); // all swivel angles at once
+ * @endcode
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_VECTOR_BATCH_H
+#define GRABCOMMON_LIBNUMERIC_VECTOR_BATCH_H
+
+#include <array>
+
+#include "matrix.h"
+
+/**
+ * @brief Namespace for GRAB numeric library.
+ */
+namespace grabnum {
+
+/**
+ * A batch of @a size 3D vectors stored as structure of arrays.
+ *
+ * All @f$x@f$ components are stored contiguously, followed by all @f$y@f$ and all
+ * @f$z@f$ components. Each set of components is padded like the storage of a fixed-size
+ * matrix, so that kernels can run on whole SIMD registers.
+ *
+ * @note Indexing of the vectors in the batch starts at 1, like in the matrix class.
+ */
+template <typename T, uint16_t size> class Vector3Batch
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: batch kernels are available for floating point types only!");
+
+public:
+  static constexpr uint16_t kStride =
+    simd::PaddedSize<T, size>::value; /**< distance between two components. */
+
+  /**
+   * Default constructor.
+   * Sets all vectors to zero.
+   */
+  constexpr Vector3Batch() : elements_{} {}
+
+  /**
+   * Returns the number of vectors in the batch.
+   *
+   * @return The number of vectors in the batch.
+   */
+  constexpr uint16_t Size() const { return size; }
+
+  /**
+   * Returns a pointer to the @f$x@f$ components of all vectors.
+   *
+   * @return A pointer to @a size contiguous elements.
+   */
+  T* X() { return elements_; }
+  const T* X() const { return elements_; }
+  /**
+   * Returns a pointer to the @f$y@f$ components of all vectors.
+   *
+   * @return A pointer to @a size contiguous elements.
+   */
+  T* Y() { return elements_ + kStride; }
+  const T* Y() const { return elements_ + kStride; }
+  /**
+   * Returns a pointer to the @f$z@f$ components of all vectors.
+   *
+   * @return A pointer to @a size contiguous elements.
+   */
+  T* Z() { return elements_ + 2 * kStride; }
+  const T* Z() const { return elements_ + 2 * kStride; }
+  /**
+   * Returns a pointer to the whole structure of arrays, whose components are kStride
+   * elements apart.
+   *
+   * @return A pointer to the @f$x@f$ component of the first vector.
+   */
+  T* Data() { return elements_; }
+  const T* Data() const { return elements_; }
+
+  /**
+   * Returns a vector of the batch.
+   *
+   * @param[in] index The index of the vector, starting from 1.
+   * @return A copy of the @a index-th vector.
+   */
+  Vector3<T> Get(const uint16_t index) const;
+  /**
+   * Replaces a vector of the batch.
+   *
+   * @param[in] index The index of the vector, starting from 1.
+   * @param[in] vect The new value of the @a index-th vector.
+   * @return A reference to @c *this.
+   */
+  Vector3Batch& Set(const uint16_t index, const Vector3<T>& vect);
+
+private:
+  T elements_[3 * kStride]; /**< x, y and z components, each padded to kStride. */
+};
+
+template <uint16_t size>
+using Vector3Batchf = Vector3Batch<float, size>; /**< batch of 3D vectors of float */
+template <uint16_t size>
+using Vector3Batchd = Vector3Batch<double, size>; /**< batch of 3D vectors of double */
+
+/**
+ * Computes the dot products of two batches of 3D vectors, lane by lane.
+ *
+ * @param[in] vects1 The first batch of vectors.
+ * @param[in] vects2 The second batch of vectors.
+ * @return The dot products @f$\mathbf{a}_i\cdot\mathbf{b}_i@f$.
+ */
+template <typename T, uint16_t size>
+std::array<T, size> Dot(const Vector3Batch<T, size>& vects1,
+                        const Vector3Batch<T, size>& vects2);
+
+/**
+ * Computes the cross products of two batches of 3D vectors, lane by lane.
+ *
+ * @param[in] vects1 The first batch of vectors.
+ * @param[in] vects2 The second batch of vectors.
+ * @return The cross products @f$\mathbf{a}_i\times\mathbf{b}_i@f$.
+ */
+template <typename T, uint16_t size>
+Vector3Batch<T, size> Cross(const Vector3Batch<T, size>& vects1,
+                            const Vector3Batch<T, size>& vects2);
+
+/**
+ * Computes the euclidean norms of a batch of 3D vectors.
+ *
+ * @param[in] vects The batch of vectors.
+ * @return The norms @f$\|\mathbf{a}_i\|@f$.
+ */
+template <typename T, uint16_t size>
+std::array<T, size> Norm(const Vector3Batch<T, size>& vects);
+
+/**
+ * Computes the four-quadrant arctangents of two batches of coordinates.
+ *
+ * @param[in] y The ordinates.
+ * @param[in] x The abscissae.
+ * @return The angles of the points @f$(x_i, y_i)@f$ in @f$[-\pi, \pi]@f$.
+ * @see simd::Atan2()
+ */
+template <typename T, size_t size>
+std::array<T, size> Atan2(const std::array<T, size>& y, const std::array<T, size>& x);
+
+/**
+ * Computes sines and cosines of a batch of angles in a single pass.
+ *
+ * @param[in] angles The angles in radians.
+ * @param[out] sin The sines of @a angles.
+ * @param[out] cos The cosines of @a angles.
+ * @see simd::SinCos()
+ */
+template <typename T, size_t size>
+void SinCos(const std::array<T, size>& angles, std::array<T, size>* sin,
+            std::array<T, size>* cos);
+
+} //  end namespace grabnum
+
+#include "../src/vector_batch.tcc"
+
+#endif // GRABCOMMON_LIBNUMERIC_VECTOR_BATCH_H
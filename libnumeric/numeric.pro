@@ -1,14 +1,25 @@
 
 HEADERS += \
+    $$PWD/inc/simd.h \
+    $$PWD/inc/matrix_expressions.h \
+    $$PWD/inc/matrix_view.h \
     $$PWD/inc/matrix.h \
+    $$PWD/inc/matrix_dynamic.h \
+    $$PWD/inc/matrix_sparse.h \
+    $$PWD/inc/vector_batch.h \
     $$PWD/inc/matrix_utilities.h \
+    $$PWD/inc/decompositions.h \
     $$PWD/inc/solvers.h \
     $$PWD/inc/filters.h \
     $$PWD/inc/common.h
 
 SOURCES += \
     $$PWD/src/matrix.cpp \
+    $$PWD/src/matrix_dynamic.tcc \
+    $$PWD/src/matrix_sparse.tcc \
+    $$PWD/src/vector_batch.tcc \
     $$PWD/src/matrix_utilities.tcc \
+    $$PWD/src/decompositions.tcc \
     $$PWD/src/solvers.cpp \
     $$PWD/src/filters.cpp
 
@@ -16,7 +27,7 @@ INCLUDEPATH += $$PWD/inc
 
 QT           -= gui
 
-CONFIG   += c++11 staticlib
+CONFIG   += c++14 staticlib
 CONFIG    -= app_bundle
 
 TEMPLATE = lib
@@ -26,3 +37,9 @@ TEMPLATE = lib
 # depend on your compiler). Please consult the documentation of the
 # deprecated API in order to know how to port your code away from it.
 DEFINES += QT_DEPRECATED_WARNINGS
+
+# Matrix kernels are vectorized according to the instruction sets enabled at compile
+# time (AVX2, SSE2 or none). Uncomment to target the instruction set of the host, or
+# define GRABNUM_DISABLE_SIMD to force the scalar fallback.
+# QMAKE_CXXFLAGS += -march=native
+# DEFINES += GRABNUM_DISABLE_SIMD
@@ -0,0 +1,890 @@
+/**
+ * @file decompositions.tcc
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions and implementation of matrix decompositions.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_DECOMPOSITIONS_H
+#error Do not include this file directly, include decompositions.h instead
+#endif
+
+#include <assert.h>
+
+namespace grabnum {
+
+//----- Householder reflections ------------------------------------------------------//
+
+// Turns the vector x, of given size and distance between consecutive elements, into a
+// Householder vector v, with v(0) = 1 implicit, such that (I - tau * v * v^T) * x is
+// aligned to the first axis. The first element of x is replaced by the only non-zero
+// element of the reflected vector, while tau is returned, being 0 if no reflection is
+// needed.
+template <typename T> T MakeHouseholder(T* x, const uint16_t size, const uint16_t stride)
+{
+  T norm_sq = 0;
+  for (uint16_t i = 0; i < size; ++i)
+    norm_sq += x[i * stride] * x[i * stride];
+  const T head = x[0];
+  if (norm_sq == head * head)
+    return 0;
+  // The sign of the reflected element is chosen to avoid cancellation.
+  const T beta = head > 0 ? -std::sqrt(norm_sq) : std::sqrt(norm_sq);
+  for (uint16_t i = 1; i < size; ++i)
+    x[i * stride] /= head - beta;
+  x[0] = beta;
+  return (beta - head) / beta;
+}
+
+// Applies the reflection (I - tau * v * v^T) to the vector y, both of given size.
+template <typename T>
+void ApplyHouseholder(const T* v, const uint16_t v_stride, const T tau, T* y,
+                      const uint16_t y_stride, const uint16_t size)
+{
+  if (tau == 0)
+    return;
+  T w = y[0];
+  for (uint16_t i = 1; i < size; ++i)
+    w += v[i * v_stride] * y[i * y_stride];
+  w *= tau;
+  y[0] -= w;
+  for (uint16_t i = 1; i < size; ++i)
+    y[i * y_stride] -= w * v[i * v_stride];
+}
+
+//----- LU ---------------------------------------------------------------------------//
+
+template <typename T, uint8_t dim>
+LU<T, dim>& LU<T, dim>::Compute(const Matrix<T, dim, dim>& matrix)
+{
+  lu_        = matrix;
+  perm_sign_ = 1;
+  singular_  = false;
+  for (uint8_t i = 0; i < dim; ++i)
+    perm_[i] = i;
+
+  T* a = lu_.Data();
+  for (uint8_t k = 0; k < dim; ++k)
+  {
+    // Partial pivoting: bring the largest element of the k-th column on the diagonal.
+    uint8_t pivot = k;
+    for (uint8_t i = k + 1; i < dim; ++i)
+      if (std::abs(a[i * dim + k]) > std::abs(a[pivot * dim + k]))
+        pivot = i;
+    if (pivot != k)
+    {
+      std::swap_ranges(a + k * dim, a + (k + 1) * dim, a + pivot * dim);
+      std::swap(perm_[k], perm_[pivot]);
+      perm_sign_ = -perm_sign_;
+    }
+    if (a[k * dim + k] == 0)
+    {
+      singular_ = true;
+      continue;
+    }
+    // Gaussian elimination below the pivot, multipliers are stored in place.
+    for (uint8_t i = k + 1; i < dim; ++i)
+    {
+      const T factor = a[i * dim + k] /= a[k * dim + k];
+      for (uint8_t j = k + 1; j < dim; ++j)
+        a[i * dim + j] -= factor * a[k * dim + j];
+    }
+  }
+  return *this;
+}
+
+template <typename T, uint8_t dim> bool LU<T, dim>::IsInvertible(const double tol) const
+{
+  for (uint8_t i = 0; i < dim; ++i)
+    if (std::abs(lu_.Data()[i * dim + i]) <= tol)
+      return false;
+  return true;
+}
+
+template <typename T, uint8_t dim> T LU<T, dim>::Det() const
+{
+  T det = perm_sign_;
+  for (uint8_t i = 0; i < dim; ++i)
+    det *= lu_.Data()[i * dim + i];
+  return det;
+}
+
+template <typename T, uint8_t dim>
+template <class ExprT>
+Matrix<T, dim, ExprTraits<ExprT>::kCols>
+LU<T, dim>::Solve(const MatrixExpr<ExprT>& rhs) const
+{
+  static constexpr uint8_t kRhsCols = ExprTraits<ExprT>::kCols;
+  static_assert(ExprTraits<ExprT>::kRows == dim && !IsDynamic<ExprT>::value,
+                "ERROR: invalid right-hand side dimensions in LU::Solve()!");
+  if (singular_)
+    throw std::invalid_argument("Matrix must be non-singular!");
+
+  const ExprT& b = rhs.Self();
+  const T* a     = lu_.Data();
+  Matrix<T, dim, kRhsCols> x;
+  T* y = x.Data();
+  // Forward substitution on the permuted right-hand side, L has unit diagonal.
+  for (uint8_t i = 0; i < dim; ++i)
+    for (uint8_t col = 0; col < kRhsCols; ++col)
+    {
+      T sum = static_cast<T>(b.Coeff(perm_[i], col));
+      for (uint8_t k = 0; k < i; ++k)
+        sum -= a[i * dim + k] * y[k * kRhsCols + col];
+      y[i * kRhsCols + col] = sum;
+    }
+  // Backward substitution.
+  for (uint8_t i = dim; i-- > 0;)
+    for (uint8_t col = 0; col < kRhsCols; ++col)
+    {
+      T sum = y[i * kRhsCols + col];
+      for (uint8_t k = i + 1; k < dim; ++k)
+        sum -= a[i * dim + k] * y[k * kRhsCols + col];
+      y[i * kRhsCols + col] = sum / a[i * dim + i];
+    }
+  return x;
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, dim> LU<T, dim>::Inverse() const
+{
+  return Solve(Matrix<T, dim, dim>(1));
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, dim> LU<T, dim>::GetL() const
+{
+  Matrix<T, dim, dim> lower(1);
+  for (uint8_t row = 2; row <= dim; ++row)
+    for (uint8_t col = 1; col < row; ++col)
+      lower(row, col) = lu_(row, col);
+  return lower;
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, dim> LU<T, dim>::GetU() const
+{
+  Matrix<T, dim, dim> upper;
+  for (uint8_t row = 1; row <= dim; ++row)
+    for (uint8_t col = row; col <= dim; ++col)
+      upper(row, col) = lu_(row, col);
+  return upper;
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, dim> LU<T, dim>::GetP() const
+{
+  Matrix<T, dim, dim> permutation;
+  for (uint8_t row = 0; row < dim; ++row)
+    permutation(row + 1, perm_[row] + 1) = 1;
+  return permutation;
+}
+
+//----- QR ---------------------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+QR<T, rows, cols>& QR<T, rows, cols>::Compute(const Matrix<T, rows, cols>& matrix)
+{
+  qr_ = matrix;
+  std::fill(tau_, tau_ + cols, T(0));
+
+  T* a = qr_.Data();
+  for (uint8_t k = 0; k < kReflections; ++k)
+  {
+    T* v    = a + k * cols + k;
+    tau_[k] = MakeHouseholder(v, rows - k, cols);
+    // Apply the reflection to the remaining columns.
+    for (uint8_t j = k + 1; j < cols; ++j)
+      ApplyHouseholder(v, cols, tau_[k], v + j - k, cols, rows - k);
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+bool QR<T, rows, cols>::IsFullRank(const double tol) const
+{
+  for (uint8_t i = 0; i < cols; ++i)
+    if (std::abs(qr_.Data()[i * cols + i]) <= tol)
+      return false;
+  return true;
+}
+
+template <typename T, uint8_t rows, uint8_t cols> T QR<T, rows, cols>::Det() const
+{
+  static_assert(rows == cols, "ERROR: QR::Det() is defined only for square matrices!");
+  T det = 1;
+  for (uint8_t i = 0; i < cols; ++i)
+  {
+    det *= qr_.Data()[i * cols + i];
+    // Each actual reflection has determinant -1.
+    if (tau_[i] != 0)
+      det = -det;
+  }
+  return det;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <uint8_t n>
+void QR<T, rows, cols>::ApplyQt(Matrix<T, rows, n>& matrix) const
+{
+  const T* a = qr_.Data();
+  T* b       = matrix.Data();
+  for (uint8_t k = 0; k < kReflections; ++k)
+    for (uint8_t j = 0; j < n; ++j)
+      ApplyHouseholder(a + k * cols + k, cols, tau_[k], b + k * n + j, n, rows - k);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, cols, ExprTraits<ExprT>::kCols>
+QR<T, rows, cols>::Solve(const MatrixExpr<ExprT>& rhs) const
+{
+  static constexpr uint8_t kRhsCols = ExprTraits<ExprT>::kCols;
+  static_assert(ExprTraits<ExprT>::kRows == rows && !IsDynamic<ExprT>::value,
+                "ERROR: invalid right-hand side dimensions in QR::Solve()!");
+  if (!IsFullRank(0))
+    throw std::invalid_argument("Matrix must have full column rank!");
+
+  Matrix<T, rows, kRhsCols> y(rhs);
+  ApplyQt(y);
+  // Backward substitution on the upper square part of R, the residual is discarded.
+  const T* a = qr_.Data();
+  Matrix<T, cols, kRhsCols> x;
+  for (uint8_t i = cols; i-- > 0;)
+    for (uint8_t col = 0; col < kRhsCols; ++col)
+    {
+      T sum = y.Data()[i * kRhsCols + col];
+      for (uint8_t k = i + 1; k < cols; ++k)
+        sum -= a[i * cols + k] * x.Data()[k * kRhsCols + col];
+      x.Data()[i * kRhsCols + col] = sum / a[i * cols + i];
+    }
+  return x;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, cols, cols> QR<T, rows, cols>::Inverse() const
+{
+  static_assert(rows == cols,
+                "ERROR: QR::Inverse() is defined only for square matrices!");
+  return Solve(Matrix<T, rows, cols>(1));
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, rows> QR<T, rows, cols>::GetQ() const
+{
+  // Q = H_1 * ... * H_k, i.e. the transpose of the reflections applied to the identity.
+  Matrix<T, rows, rows> q(1);
+  ApplyQt(q);
+  return q.Transpose();
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols> QR<T, rows, cols>::GetR() const
+{
+  Matrix<T, rows, cols> upper;
+  for (uint8_t row = 1; row <= cols; ++row)
+    for (uint8_t col = row; col <= cols; ++col)
+      upper(row, col) = qr_(row, col);
+  return upper;
+}
+
+//----- LDLT -------------------------------------------------------------------------//
+
+template <typename T, uint8_t dim>
+LDLTStatus LDLT<T, dim>::Compute(const Matrix<T, dim, dim>& matrix)
+{
+  ldl_ = matrix;
+
+  T* a = ldl_.Data();
+  T work[dim] = {}; // elements of the current row of L times the corresponding pivots
+  for (uint8_t j = 0; j < dim; ++j)
+  {
+    T* row_j = a + j * dim;
+    T pivot  = row_j[j];
+    for (uint8_t k = 0; k < j; ++k)
+    {
+      work[k] = row_j[k] * a[k * dim + k];
+      pivot -= row_j[k] * work[k];
+    }
+    // Written this way, a NaN pivot is rejected as well.
+    if (!(pivot > 0))
+    {
+      status_ = LDLT_NOT_POSITIVE_DEFINITE;
+      return status_;
+    }
+    row_j[j] = pivot;
+    for (uint8_t i = j + 1; i < dim; ++i)
+    {
+      T* row_i = a + i * dim;
+      T sum    = row_i[j];
+      for (uint8_t k = 0; k < j; ++k)
+        sum -= row_i[k] * work[k];
+      row_i[j] = sum / pivot;
+    }
+  }
+  status_ = LDLT_SUCCESS;
+  return status_;
+}
+
+template <typename T, uint8_t dim>
+LDLTStatus LDLT<T, dim>::Update(const Matrix<T, dim, 1>& vect, const T sigma)
+{
+  if (status_ != LDLT_SUCCESS)
+    return status_;
+
+  T* a = ldl_.Data();
+  // Since A + sigma * z * z^T = L * (D + sigma * p * p^T) * L^T, with L * p = z, the
+  // result is positive-definite if and only if 1 + sigma * p^T * D^-1 * p > 0.
+  T p[dim];
+  T ratio = 1;
+  for (uint8_t i = 0; i < dim; ++i)
+  {
+    T sum = vect.Data()[i];
+    for (uint8_t k = 0; k < i; ++k)
+      sum -= a[i * dim + k] * p[k];
+    p[i] = sum;
+    ratio += sigma * sum * sum / a[i * dim + i];
+  }
+  if (!(ratio > 0))
+    return LDLT_NOT_POSITIVE_DEFINITE;
+
+  // Method C1 of Gill, Golub, Murray and Saunders (1974).
+  T w[dim];
+  std::copy(vect.Data(), vect.Data() + dim, w);
+  T alpha = sigma;
+  for (uint8_t j = 0; j < dim; ++j)
+  {
+    const T pj        = w[j];
+    const T pivot     = a[j * dim + j];
+    const T new_pivot = pivot + alpha * pj * pj;
+    const T beta      = alpha * pj / new_pivot;
+    alpha             = alpha * pivot / new_pivot;
+    a[j * dim + j]    = new_pivot;
+    for (uint8_t i = j + 1; i < dim; ++i)
+    {
+      w[i] -= pj * a[i * dim + j];
+      a[i * dim + j] += beta * w[i];
+    }
+  }
+  return LDLT_SUCCESS;
+}
+
+template <typename T, uint8_t dim>
+bool LDLT<T, dim>::IsPositiveDefinite(const double tol) const
+{
+  if (status_ != LDLT_SUCCESS)
+    return false;
+  for (uint8_t i = 0; i < dim; ++i)
+    if (ldl_.Data()[i * dim + i] <= tol)
+      return false;
+  return true;
+}
+
+template <typename T, uint8_t dim> T LDLT<T, dim>::Det() const
+{
+  assert(status_ == LDLT_SUCCESS);
+  T det = 1;
+  for (uint8_t i = 0; i < dim; ++i)
+    det *= ldl_.Data()[i * dim + i];
+  return det;
+}
+
+template <typename T, uint8_t dim>
+template <class ExprT>
+Matrix<T, dim, ExprTraits<ExprT>::kCols>
+LDLT<T, dim>::Solve(const MatrixExpr<ExprT>& rhs) const
+{
+  static constexpr uint8_t kRhsCols = ExprTraits<ExprT>::kCols;
+  static_assert(ExprTraits<ExprT>::kRows == dim && !IsDynamic<ExprT>::value,
+                "ERROR: invalid right-hand side dimensions in LDLT::Solve()!");
+  assert(status_ == LDLT_SUCCESS);
+
+  const ExprT& b = rhs.Self();
+  const T* a     = ldl_.Data();
+  Matrix<T, dim, kRhsCols> x;
+  T* y = x.Data();
+  // Forward substitution, L has unit diagonal.
+  for (uint8_t i = 0; i < dim; ++i)
+    for (uint8_t col = 0; col < kRhsCols; ++col)
+    {
+      T sum = static_cast<T>(b.Coeff(i, col));
+      for (uint8_t k = 0; k < i; ++k)
+        sum -= a[i * dim + k] * y[k * kRhsCols + col];
+      y[i * kRhsCols + col] = sum;
+    }
+  // Diagonal scaling and backward substitution with L^T.
+  for (uint8_t i = dim; i-- > 0;)
+    for (uint8_t col = 0; col < kRhsCols; ++col)
+    {
+      T sum = y[i * kRhsCols + col] / a[i * dim + i];
+      for (uint8_t k = i + 1; k < dim; ++k)
+        sum -= a[k * dim + i] * y[k * kRhsCols + col];
+      y[i * kRhsCols + col] = sum;
+    }
+  return x;
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, dim> LDLT<T, dim>::GetL() const
+{
+  Matrix<T, dim, dim> lower(1);
+  for (uint8_t row = 2; row <= dim; ++row)
+    for (uint8_t col = 1; col < row; ++col)
+      lower(row, col) = ldl_(row, col);
+  return lower;
+}
+
+template <typename T, uint8_t dim> Matrix<T, dim, 1> LDLT<T, dim>::GetD() const
+{
+  Matrix<T, dim, 1> diag;
+  for (uint8_t i = 1; i <= dim; ++i)
+    diag(i) = ldl_(i, i);
+  return diag;
+}
+
+//----- Jacobi rotations -------------------------------------------------------------//
+
+// Computes cosine c and sine s of the plane rotation which diagonalizes the symmetric
+// 2x2 matrix [app apq; apq aqq], i.e. such that [c s; -s c]^T * [app apq; apq aqq] *
+// [c s; -s c] is diagonal, and returns their ratio t. This is the smaller root of
+// t^2 + 2 * zeta * t - 1 = 0, with zeta = (aqq - app) / (2 * apq), so that the rotation
+// angle is at most 45 degrees.
+template <typename T>
+T MakeJacobiRotation(const T app, const T apq, const T aqq, T* c, T* s)
+{
+  const T zeta = (aqq - app) / (2 * apq);
+  const T t    = (zeta >= 0 ? 1 : -1) / (std::abs(zeta) + std::sqrt(1 + zeta * zeta));
+  *c           = 1 / std::sqrt(1 + t * t);
+  *s           = t * *c;
+  return t;
+}
+
+// Applies the rotation computed by MakeJacobiRotation() to the columns p and q of a
+// row-major matrix with given numbers of rows and columns.
+template <typename T>
+void RotateColumns(T* mat, const uint8_t rows, const uint8_t cols, const uint8_t p,
+                   const uint8_t q, const T c, const T s)
+{
+  for (uint8_t k = 0; k < rows; ++k)
+  {
+    const T mkp       = mat[k * cols + p];
+    const T mkq       = mat[k * cols + q];
+    mat[k * cols + p] = c * mkp - s * mkq;
+    mat[k * cols + q] = s * mkp + c * mkq;
+  }
+}
+
+// Swaps the columns p and q of a row-major matrix with given numbers of rows and columns.
+template <typename T>
+void SwapColumns(T* mat, const uint8_t rows, const uint8_t cols, const uint8_t p,
+                 const uint8_t q)
+{
+  for (uint8_t k = 0; k < rows; ++k)
+    std::swap(mat[k * cols + p], mat[k * cols + q]);
+}
+
+//----- SymmetricEigen ---------------------------------------------------------------//
+
+template <typename T, uint8_t dim>
+SymmetricEigen<T, dim>&
+SymmetricEigen<T, dim>::Compute(const Matrix<T, dim, dim>& matrix,
+                                const bool compute_vectors)
+{
+  Matrix<T, dim, dim> work = matrix;
+  T* a                     = work.Data();
+  T norm_sq                = 0;
+  for (uint8_t i = 0; i < dim; ++i)
+  {
+    for (uint8_t j = i + 1; j < dim; ++j)
+    {
+      a[j * dim + i] = a[i * dim + j];
+      norm_sq += 2 * a[i * dim + j] * a[i * dim + j];
+    }
+    norm_sq += a[i * dim + i] * a[i * dim + i];
+  }
+  if (compute_vectors)
+    vectors_ = Matrix<T, dim, dim>(1);
+
+  const T tol_sq = norm_sq * std::numeric_limits<T>::epsilon() *
+                   std::numeric_limits<T>::epsilon();
+  converged_ = false;
+  for (uint8_t sweep = 0; sweep < kMaxSweeps; ++sweep)
+  {
+    T off_sq = 0;
+    for (uint8_t p = 0; p < dim; ++p)
+      for (uint8_t q = p + 1; q < dim; ++q)
+        off_sq += 2 * a[p * dim + q] * a[p * dim + q];
+    if (off_sq <= tol_sq)
+    {
+      converged_ = true;
+      break;
+    }
+    for (uint8_t p = 0; p < dim; ++p)
+      for (uint8_t q = p + 1; q < dim; ++q)
+      {
+        const T apq = a[p * dim + q];
+        if (apq == 0)
+          continue;
+        T c, s;
+        const T t = MakeJacobiRotation(a[p * dim + p], apq, a[q * dim + q], &c, &s);
+        // Both rows and columns p and q are rotated, exploiting symmetry.
+        a[p * dim + p] -= t * apq;
+        a[q * dim + q] += t * apq;
+        a[p * dim + q] = a[q * dim + p] = 0;
+        for (uint8_t k = 0; k < dim; ++k)
+        {
+          if (k == p || k == q)
+            continue;
+          const T akp    = a[k * dim + p];
+          const T akq    = a[k * dim + q];
+          a[k * dim + p] = a[p * dim + k] = c * akp - s * akq;
+          a[k * dim + q] = a[q * dim + k] = s * akp + c * akq;
+        }
+        if (compute_vectors)
+          RotateColumns(vectors_.Data(), dim, dim, p, q, c, s);
+      }
+  }
+
+  // Selection sort of the eigenvalues in ascending order.
+  for (uint8_t i = 0; i < dim; ++i)
+    values_.Data()[i] = a[i * dim + i];
+  for (uint8_t i = 0; i < dim; ++i)
+  {
+    uint8_t min = i;
+    for (uint8_t j = i + 1; j < dim; ++j)
+      if (values_.Data()[j] < values_.Data()[min])
+        min = j;
+    if (min == i)
+      continue;
+    std::swap(values_.Data()[i], values_.Data()[min]);
+    if (compute_vectors)
+      SwapColumns(vectors_.Data(), dim, dim, i, min);
+  }
+  return *this;
+}
+
+//----- SVD --------------------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+SVD<T, rows, cols>& SVD<T, rows, cols>::Compute(const Matrix<T, rows, cols>& matrix,
+                                                const bool compute_vectors)
+{
+  // The columns of A are orthogonalized, or the ones of its transpose if it is wide, so
+  // that there are as few of them as possible.
+  T* w       = work_.Data();
+  const T* a = matrix.Data();
+  for (uint8_t i = 0; i < kMaxDim; ++i)
+    for (uint8_t j = 0; j < kMinDim; ++j)
+      w[i * kMinDim + j] = rows >= cols ? a[i * cols + j] : a[j * cols + i];
+  if (compute_vectors)
+    rot_ = Matrix<T, kMinDim, kMinDim>(1);
+
+  const T eps = std::numeric_limits<T>::epsilon();
+  T norms_sq[kMinDim];
+  converged_ = false;
+  for (uint8_t sweep = 0; sweep < kMaxSweeps; ++sweep)
+  {
+    // Squared column norms are the diagonal of A^T * A. They are updated along with the
+    // rotations and computed again at each sweep, so that errors do not accumulate.
+    for (uint8_t j = 0; j < kMinDim; ++j)
+    {
+      norms_sq[j] = 0;
+      for (uint8_t k = 0; k < kMaxDim; ++k)
+        norms_sq[j] += w[k * kMinDim + j] * w[k * kMinDim + j];
+    }
+    bool rotated = false;
+    for (uint8_t p = 0; p < kMinDim; ++p)
+      for (uint8_t q = p + 1; q < kMinDim; ++q)
+      {
+        // Off-diagonal element of the 2x2 submatrix of A^T * A to be annihilated.
+        T gamma = 0;
+        for (uint8_t k = 0; k < kMaxDim; ++k)
+          gamma += w[k * kMinDim + p] * w[k * kMinDim + q];
+        if (std::abs(gamma) <= eps * std::sqrt(norms_sq[p] * norms_sq[q]))
+          continue;
+        rotated = true;
+        T c, s;
+        const T t = MakeJacobiRotation(norms_sq[p], gamma, norms_sq[q], &c, &s);
+        norms_sq[p] -= t * gamma;
+        norms_sq[q] += t * gamma;
+        RotateColumns(w, kMaxDim, kMinDim, p, q, c, s);
+        if (compute_vectors)
+          RotateColumns(rot_.Data(), kMinDim, kMinDim, p, q, c, s);
+      }
+    if (!rotated)
+    {
+      converged_ = true;
+      break;
+    }
+  }
+
+  // Singular values are the norms of the orthogonal columns, which are then normalized.
+  for (uint8_t j = 0; j < kMinDim; ++j)
+  {
+    T norm_sq = 0;
+    for (uint8_t k = 0; k < kMaxDim; ++k)
+      norm_sq += w[k * kMinDim + j] * w[k * kMinDim + j];
+    values_.Data()[j] = std::sqrt(norm_sq);
+    if (compute_vectors && norm_sq > 0)
+      for (uint8_t k = 0; k < kMaxDim; ++k)
+        w[k * kMinDim + j] /= values_.Data()[j];
+  }
+  // Selection sort of the singular values in descending order.
+  for (uint8_t i = 0; i < kMinDim; ++i)
+  {
+    uint8_t max = i;
+    for (uint8_t j = i + 1; j < kMinDim; ++j)
+      if (values_.Data()[j] > values_.Data()[max])
+        max = j;
+    if (max == i)
+      continue;
+    std::swap(values_.Data()[i], values_.Data()[max]);
+    if (compute_vectors)
+    {
+      SwapColumns(w, kMaxDim, kMinDim, i, max);
+      SwapColumns(rot_.Data(), kMinDim, kMinDim, i, max);
+    }
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols> T SVD<T, rows, cols>::Condition() const
+{
+  if (values_.Data()[kMinDim - 1] == 0)
+    return std::numeric_limits<T>::infinity();
+  return values_.Data()[0] / values_.Data()[kMinDim - 1];
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+uint8_t SVD<T, rows, cols>::Rank(const double tol) const
+{
+  uint8_t rank = 0;
+  while (rank < kMinDim && values_.Data()[rank] > tol * values_.Data()[0])
+    ++rank;
+  return rank;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, SVD<T, rows, cols>::kMinDim> SVD<T, rows, cols>::GetU() const
+{
+  // U holds the orthogonalized columns, unless the transpose of A was decomposed.
+  const T* src = rows >= cols ? work_.Data() : rot_.Data();
+  Matrix<T, rows, kMinDim> u;
+  std::copy(src, src + rows * kMinDim, u.Data());
+  return u;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, cols, SVD<T, rows, cols>::kMinDim> SVD<T, rows, cols>::GetV() const
+{
+  const T* src = rows >= cols ? rot_.Data() : work_.Data();
+  Matrix<T, cols, kMinDim> v;
+  std::copy(src, src + cols * kMinDim, v.Data());
+  return v;
+}
+
+//----- Inverse ----------------------------------------------------------------------//
+
+template <typename T, uint8_t dim>
+Matrix<T, dim, dim> Inverse(const Matrix<T, dim, dim>& matrix)
+{
+  return LU<T, dim>(matrix).Inverse();
+}
+
+template <typename T> Matrix<T, 2, 2> Inverse(const Matrix<T, 2, 2>& matrix)
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in Inverse()!");
+  const T* a  = matrix.Data();
+  const T det = a[0] * a[3] - a[1] * a[2];
+  if (det == 0)
+    throw std::invalid_argument("Matrix must be non-singular!");
+  const T inv_det = 1 / det;
+
+  Matrix<T, 2, 2> inverse;
+  T* b = inverse.Data();
+  b[0] = a[3] * inv_det;
+  b[1] = -a[1] * inv_det;
+  b[2] = -a[2] * inv_det;
+  b[3] = a[0] * inv_det;
+  return inverse;
+}
+
+template <typename T> Matrix<T, 3, 3> Inverse(const Matrix<T, 3, 3>& matrix)
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in Inverse()!");
+  const T* a = matrix.Data();
+  // Cofactors of the first column, reused for the determinant.
+  const T c0 = a[4] * a[8] - a[5] * a[7];
+  const T c3 = a[5] * a[6] - a[3] * a[8];
+  const T c6 = a[3] * a[7] - a[4] * a[6];
+  const T det = a[0] * c0 + a[1] * c3 + a[2] * c6;
+  if (det == 0)
+    throw std::invalid_argument("Matrix must be non-singular!");
+  const T inv_det = 1 / det;
+
+  // Transposed matrix of cofactors (adjugate) over determinant.
+  Matrix<T, 3, 3> inverse;
+  T* b = inverse.Data();
+  b[0] = c0 * inv_det;
+  b[1] = (a[2] * a[7] - a[1] * a[8]) * inv_det;
+  b[2] = (a[1] * a[5] - a[2] * a[4]) * inv_det;
+  b[3] = c3 * inv_det;
+  b[4] = (a[0] * a[8] - a[2] * a[6]) * inv_det;
+  b[5] = (a[2] * a[3] - a[0] * a[5]) * inv_det;
+  b[6] = c6 * inv_det;
+  b[7] = (a[1] * a[6] - a[0] * a[7]) * inv_det;
+  b[8] = (a[0] * a[4] - a[1] * a[3]) * inv_det;
+  return inverse;
+}
+
+template <typename T> Matrix<T, 4, 4> Inverse(const Matrix<T, 4, 4>& matrix)
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in Inverse()!");
+  const T* a = matrix.Data();
+  // 2x2 minors of the upper (s) and lower (c) halves, shared by all cofactors.
+  const T s0 = a[0] * a[5] - a[4] * a[1];
+  const T s1 = a[0] * a[6] - a[4] * a[2];
+  const T s2 = a[0] * a[7] - a[4] * a[3];
+  const T s3 = a[1] * a[6] - a[5] * a[2];
+  const T s4 = a[1] * a[7] - a[5] * a[3];
+  const T s5 = a[2] * a[7] - a[6] * a[3];
+  const T c5 = a[10] * a[15] - a[14] * a[11];
+  const T c4 = a[9] * a[15] - a[13] * a[11];
+  const T c3 = a[9] * a[14] - a[13] * a[10];
+  const T c2 = a[8] * a[15] - a[12] * a[11];
+  const T c1 = a[8] * a[14] - a[12] * a[10];
+  const T c0 = a[8] * a[13] - a[12] * a[9];
+  const T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+  if (det == 0)
+    throw std::invalid_argument("Matrix must be non-singular!");
+  const T inv_det = 1 / det;
+
+  Matrix<T, 4, 4> inverse;
+  T* b  = inverse.Data();
+  b[0]  = (a[5] * c5 - a[6] * c4 + a[7] * c3) * inv_det;
+  b[1]  = (-a[1] * c5 + a[2] * c4 - a[3] * c3) * inv_det;
+  b[2]  = (a[13] * s5 - a[14] * s4 + a[15] * s3) * inv_det;
+  b[3]  = (-a[9] * s5 + a[10] * s4 - a[11] * s3) * inv_det;
+  b[4]  = (-a[4] * c5 + a[6] * c2 - a[7] * c1) * inv_det;
+  b[5]  = (a[0] * c5 - a[2] * c2 + a[3] * c1) * inv_det;
+  b[6]  = (-a[12] * s5 + a[14] * s2 - a[15] * s1) * inv_det;
+  b[7]  = (a[8] * s5 - a[10] * s2 + a[11] * s1) * inv_det;
+  b[8]  = (a[4] * c4 - a[5] * c2 + a[7] * c0) * inv_det;
+  b[9]  = (-a[0] * c4 + a[1] * c2 - a[3] * c0) * inv_det;
+  b[10] = (a[12] * s4 - a[13] * s2 + a[15] * s0) * inv_det;
+  b[11] = (-a[8] * s4 + a[9] * s2 - a[11] * s0) * inv_det;
+  b[12] = (-a[4] * c3 + a[5] * c1 - a[6] * c0) * inv_det;
+  b[13] = (a[0] * c3 - a[1] * c1 + a[2] * c0) * inv_det;
+  b[14] = (-a[12] * s3 + a[13] * s1 - a[14] * s0) * inv_det;
+  b[15] = (a[8] * s3 - a[9] * s1 + a[10] * s0) * inv_det;
+  return inverse;
+}
+
+template <class ExprT>
+Matrix<typename ExprTraits<ExprT>::Scalar, ExprTraits<ExprT>::kRows,
+       ExprTraits<ExprT>::kCols>
+Inverse(const MatrixExpr<ExprT>& matrix)
+{
+  static_assert(ExprTraits<ExprT>::kRows == ExprTraits<ExprT>::kCols &&
+                  !IsDynamic<ExprT>::value,
+                "ERROR: Inverse() is defined only for fixed-size square matrices!");
+  return Inverse(matrix.Self().Eval());
+}
+
+//----- Pseudo-inverse ---------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, cols, rows> PseudoInverse(const Matrix<T, rows, cols>& matrix, const double tol)
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in PseudoInverse()!");
+  static constexpr uint8_t kMinDim = rows < cols ? rows : cols;
+
+  // QR decomposition with column pivoting: A * P = Q * [R1; 0], where R1 has full row
+  // rank and its number of rows is the rank of A.
+  Matrix<T, rows, cols> qr(matrix);
+  T* a = qr.Data();
+  T tau[kMinDim];
+  uint8_t perm[cols];
+  for (uint8_t j = 0; j < cols; ++j)
+    perm[j] = j;
+  uint8_t rank = 0;
+  for (; rank < kMinDim; ++rank)
+  {
+    const uint8_t k = rank;
+    // Bring the column with largest remaining norm forward.
+    uint8_t pivot   = k;
+    T pivot_norm_sq = -1;
+    for (uint8_t j = k; j < cols; ++j)
+    {
+      T norm_sq = 0;
+      for (uint8_t i = k; i < rows; ++i)
+        norm_sq += a[i * cols + j] * a[i * cols + j];
+      if (norm_sq > pivot_norm_sq)
+      {
+        pivot         = j;
+        pivot_norm_sq = norm_sq;
+      }
+    }
+    if (std::sqrt(pivot_norm_sq) <= tol)
+      break;
+    if (pivot != k)
+    {
+      for (uint8_t i = 0; i < rows; ++i)
+        std::swap(a[i * cols + k], a[i * cols + pivot]);
+      std::swap(perm[k], perm[pivot]);
+    }
+    T* v   = a + k * cols + k;
+    tau[k] = MakeHouseholder(v, rows - k, cols);
+    for (uint8_t j = k + 1; j < cols; ++j)
+      ApplyHouseholder(v, cols, tau[k], v + j - k, cols, rows - k);
+  }
+
+  // QR decomposition of the transpose of R1: R1^T = Z * U, being U a square
+  // upper-triangular matrix, so that A = Q1 * U^T * Z^T * P^T.
+  Matrix<T, cols, kMinDim> zu;
+  T* z = zu.Data();
+  for (uint8_t i = 0; i < rank; ++i)
+    for (uint8_t j = i; j < cols; ++j)
+      z[j * kMinDim + i] = a[i * cols + j];
+  T ztau[kMinDim];
+  for (uint8_t k = 0; k < rank; ++k)
+  {
+    T* v    = z + k * kMinDim + k;
+    ztau[k] = MakeHouseholder(v, cols - k, kMinDim);
+    for (uint8_t j = k + 1; j < rank; ++j)
+      ApplyHouseholder(v, kMinDim, ztau[k], v + j - k, kMinDim, cols - k);
+  }
+
+  // Column by column, A^+ = P * Z * U^-T * Q1^T.
+  Matrix<T, cols, rows> pinv;
+  T y[rows];
+  T w[cols];
+  for (uint8_t col = 0; col < rows; ++col)
+  {
+    std::fill(y, y + rows, T(0));
+    y[col] = 1;
+    for (uint8_t k = 0; k < rank; ++k)
+      ApplyHouseholder(a + k * cols + k, cols, tau[k], y + k, 1, rows - k);
+    std::fill(w, w + cols, T(0));
+    for (uint8_t i = 0; i < rank; ++i)
+    {
+      T sum = y[i];
+      for (uint8_t k = 0; k < i; ++k)
+        sum -= z[k * kMinDim + i] * w[k];
+      w[i] = sum / z[i * kMinDim + i];
+    }
+    for (uint8_t k = rank; k-- > 0;)
+      ApplyHouseholder(z + k * kMinDim + k, kMinDim, ztau[k], w + k, 1, cols - k);
+    for (uint8_t j = 0; j < cols; ++j)
+      pinv(perm[j] + 1, col + 1) = w[j];
+  }
+  return pinv;
+}
+
+template <class ExprT>
+Matrix<typename ExprTraits<ExprT>::Scalar, ExprTraits<ExprT>::kCols,
+       ExprTraits<ExprT>::kRows>
+PseudoInverse(const MatrixExpr<ExprT>& matrix, const double tol)
+{
+  static_assert(!IsDynamic<ExprT>::value,
+                "ERROR: PseudoInverse() is defined only for fixed-size matrices!");
+  return PseudoInverse(matrix.Self().Eval(), tol);
+}
+
+} //  end namespace grabnum
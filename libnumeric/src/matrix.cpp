@@ -1,471 +1,595 @@
-/**
- * @file matrix.cpp
- * @author Edoardo Idà, Simone Comari
- * @date 13 Mar 2019
- * @brief File containing definitions and implementation of matrix class.
- */
-
-#include <assert.h>
-
-#include "matrix.h"
-
-#ifndef ARRAY_SIZE
-#define ARRAY_SIZE(x)                                                                    \
-  (sizeof((x)) / sizeof((x)[0])) /**< returns the size of a standard array*/
-#endif
-
-namespace grabnum {
-
-//----- Constructors -----------------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols> Matrix<T, rows, cols>::Matrix()
-{
-  SetZero();
-}
-
-template <typename T, uint8_t rows, uint8_t cols> Matrix<T, rows, cols>::Matrix(T scalar)
-{
-  if (scalar == 0)
-    SetZero();
-  else
-    *this = SetIdentity() * scalar;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>::Matrix(const T* values, const uint16_t size)
-{
-  Fill(values, size);
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>::Matrix(const std::vector<T>& values)
-{
-  Fill(values);
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <typename T2>
-Matrix<T, rows, cols>::Matrix(const Matrix<T2, rows, cols>& other)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] = static_cast<T>(other(row + 1, col + 1));
-}
-
-//----- Operator Overloadings --------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <typename NewT>
-Matrix<T, rows, cols>::operator Matrix<NewT, rows, cols>()
-{
-  Matrix<NewT, rows, cols> result(*this);
-  return result;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <typename NewT>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::
-operator=(const Matrix<NewT, rows, cols>& other)
-{
-  *this = static_cast<Matrix<T, rows, cols>>(other);
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::operator==(const Matrix<T, rows, cols>& other) const
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (elements_[row][col] != other(row + 1, col + 1))
-        return false;
-    }
-  return true;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::operator!=(const Matrix<T, rows, cols>& other) const
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (elements_[col][row] != other.elements_[col][row])
-        return true;
-    }
-  return false;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator+=(const T& scalar)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] += scalar;
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::
-operator+=(const Matrix<T, rows, cols>& other)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] += other(row + 1, col + 1);
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator-=(const T& scalar)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] -= scalar;
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::
-operator-=(const Matrix<T, rows, cols>& other)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] -= other(row + 1, col + 1);
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator*=(const T& scalar)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] *= scalar;
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator/=(const T& scalar)
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] /= scalar;
-  return *this;
-}
-
-//----- Setters ----------------------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <uint8_t block_rows, uint8_t block_cols>
-Matrix<T, rows, cols>&
-Matrix<T, rows, cols>::SetBlock(const uint8_t start_row, const uint8_t start_col,
-                                const Matrix<T, block_rows, block_cols>& other)
-{
-  assert(start_row + block_rows - 1 <= rows);
-  assert(start_col + block_cols - 1 <= cols);
-
-  for (uint8_t row = start_row; row < start_row + block_rows; ++row)
-    for (uint8_t col = start_col; col < start_col + block_cols; ++col)
-      elements_[row - 1][col - 1] = other(row - start_row + 1, col - start_col + 1);
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
-                                                     const Matrix<T, rows, 1>& matrix1d)
-{
-  for (uint8_t i = 0; i < rows; ++i)
-  {
-    elements_[i][cl - 1] = matrix1d(i + 1);
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl, const T* vect,
-                                                     const uint8_t size)
-{
-  assert(size == rows);
-
-  for (uint8_t i = 0; i < rows; ++i)
-  {
-    elements_[i][cl - 1] = vect[i];
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
-                                                     const std::vector<T>& vect)
-{
-  assert(vect.size() == rows);
-
-  for (uint8_t i = 0; i < rows; ++i)
-  {
-    elements_[i][cl - 1] = vect[i];
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <uint8_t _rows, uint8_t _cols>
-Matrix<T, rows, cols>&
-Matrix<T, rows, cols>::SetFromBlock(const uint8_t start_row, const uint8_t start_col,
-                                    const Matrix<T, _rows, _cols>& other)
-{
-  assert(start_row + rows - 1 <= _rows);
-  assert(start_col + cols - 1 <= _cols);
-
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] = other(row + start_row, col + start_col);
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetIdentity()
-{
-#if (MCU_TARGET == 0)
-  if (!IsSquare())
-  {
-    std::cerr << "WARNING: Matrix is not square! Pseudo-identity matrix is generated."
-              << std::endl;
-  }
-#endif
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (row == col)
-        elements_[row][col] = 1;
-      else
-        elements_[row][col] = 0;
-    }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
-                                                     const Matrix<T, 1, cols>& matrix1d)
-{
-  for (uint8_t i = 0; i < cols; ++i)
-  {
-    elements_[rw - 1][i] = matrix1d(i + 1);
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw, const T* vect,
-                                                     const uint8_t size)
-{
-  assert(size == cols);
-
-  for (uint8_t i = 0; i < cols; ++i)
-  {
-    elements_[rw - 1][i] = vect[i];
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
-                                                     const std::vector<T>& vect)
-{
-  assert(vect.size() == cols);
-
-  for (uint8_t i = 0; i < cols; ++i)
-  {
-    elements_[rw - 1][i] = vect[i];
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetZero()
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] = 0;
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::Fill(const T* values, const uint16_t size)
-{
-  assert(size == this->Size());
-
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] = values[row * cols + col];
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::Fill(const std::vector<T>& values)
-{
-  assert(values.size() == this->Size());
-
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      elements_[row][col] = values[row * cols + col];
-  return *this;
-}
-
-//----- Matrix manipulation ----------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, cols, rows> Matrix<T, rows, cols>::Transpose() const
-{
-  Matrix<T, cols, rows> transpose;
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-      transpose(col + 1, row + 1) = elements_[row][col];
-  return transpose;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SwapRow(const uint8_t row1,
-                                                      const uint8_t row2)
-{
-  T temp;
-  for (uint8_t i = 0; i < cols; ++i)
-  {
-    temp                   = elements_[row1 - 1][i];
-    elements_[row1 - 1][i] = elements_[row2 - 1][i];
-    elements_[row2 - 1][i] = temp;
-  }
-  return *this;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols>& Matrix<T, rows, cols>::SwapCol(const uint8_t col1,
-                                                      const uint8_t col2)
-{
-  T temp;
-  for (uint8_t i = 0; i < rows; ++i)
-  {
-    temp                   = elements_[i][col1 - 1];
-    elements_[i][col1 - 1] = elements_[i][col2 - 1];
-    elements_[i][col2 - 1] = temp;
-  }
-  return *this;
-}
-
-//----- Getters ----------------------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, 1, cols> Matrix<T, rows, cols>::GetRow(const uint8_t row) const
-{
-  Matrix<T, 1, cols> row_vect;
-  for (uint8_t col = 0; col < cols; ++col)
-    row_vect(col + 1) = elements_[row - 1][col];
-  return row_vect;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-VectorX<T, rows> Matrix<T, rows, cols>::GetCol(const uint8_t col) const
-{
-  VectorX<T, rows> col_vect;
-  for (uint8_t row = 0; row < rows; ++row)
-    col_vect(row + 1) = elements_[row][col - 1];
-  return col_vect;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-template <uint8_t blk_rows, uint8_t blk_cols>
-Matrix<T, blk_rows, blk_cols>
-Matrix<T, rows, cols>::GetBlock(const uint8_t start_row, const uint8_t start_col) const
-{
-  Matrix<T, blk_rows, blk_cols> block;
-  block.SetFromBlock(start_row, start_col, *this);
-  return block;
-}
-
-//----- Check functions --------------------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::IsSquare() const
-{
-  return rows == cols;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::IsSymmetric() const
-{
-  if (!IsSquare())
-    return false;
-  return *this == Transpose();
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::IsPositiveDefinite() const
-{
-  if (!IsSymmetric())
-    return false;
-  try
-  {
-    Cholesky(*this);
-    return true;
-  }
-  catch (std::invalid_argument)
-  {
-    return false;
-  }
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-bool Matrix<T, rows, cols>::IsApprox(const Matrix<T, rows, cols>& other,
-                                     const double tol /* = epsilon*/) const
-{
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (!IsClose(elements_[row][col], other(row + 1, col + 1), tol))
-        return false;
-    }
-  return true;
-}
-
-//----- Matrix internal utilities ----------------------------------------------------//
-
-template <typename T, uint8_t rows, uint8_t cols>
-uint16_t Matrix<T, rows, cols>::MaxIdx() const
-{
-  uint16_t index;
-  uint8_t i_max = 0;
-  uint8_t j_max = 0;
-  T max         = elements_[0][0];
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (elements_[row][col] > max)
-      {
-        max   = elements_[row][col];
-        i_max = row;
-        j_max = col;
-      }
-    }
-  index = i_max * cols + j_max + 1;
-  return index;
-}
-
-template <typename T, uint8_t rows, uint8_t cols>
-uint16_t Matrix<T, rows, cols>::MinIdx() const
-{
-  uint16_t index;
-  uint8_t i_min = 0;
-  uint8_t j_min = 0;
-  T min         = elements_[0][0];
-  for (uint8_t row = 0; row < rows; ++row)
-    for (uint8_t col = 0; col < cols; ++col)
-    {
-      if (elements_[row][col] < min)
-      {
-        min   = elements_[row][col];
-        i_min = row;
-        j_min = col;
-      }
-    }
-  index = i_min * cols + j_min + 1;
-  return index;
-}
-
-} // end namespace grabnum
+/**
+ * @file matrix.cpp
+ * @author Edoardo Idà, Simone Comari
+ * @date 13 Mar 2019
+ * @brief File containing definitions and implementation of matrix class.
+ */
+
+#include <assert.h>
+
+#include "matrix.h"
+
+#ifndef ARRAY_SIZE
+#define ARRAY_SIZE(x)                                                                    \
+  (sizeof((x)) / sizeof((x)[0])) /**< returns the size of a standard array*/
+#endif
+
+namespace grabnum {
+
+//----- Constructors -----------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+constexpr Matrix<T, rows, cols>::Matrix() : elements_{}
+{}
+
+template <typename T, uint8_t rows, uint8_t cols>
+constexpr Matrix<T, rows, cols>::Matrix(T scalar) : elements_{}
+{
+  if (scalar == 0)
+    return;
+  if (rows != cols)
+  {
+    // Pseudo-identity, only at run time since it warns the user.
+    SetIdentity();
+    *this *= scalar;
+    return;
+  }
+  for (uint8_t i = 0; i < rows; ++i)
+    elements_[i * cols + i] = scalar;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+constexpr Matrix<T, rows, cols>::Matrix(const T* values, const uint16_t size)
+  : elements_{}
+{
+  assert(size == rows * cols);
+  for (uint16_t i = 0; i < rows * cols && i < size; ++i)
+    elements_[i] = values[i];
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+constexpr Matrix<T, rows, cols>::Matrix(std::initializer_list<T> values)
+  : Matrix(values.begin(), static_cast<uint16_t>(values.size()))
+{}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>::Matrix(const std::vector<T>& values)
+{
+  ClearPadding();
+  Fill(values);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+constexpr Matrix<T, rows, cols>::Matrix(const std::array<T, rows * cols>& values)
+  : elements_{}
+{
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] = values[i];
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <typename T2>
+constexpr Matrix<T, rows, cols>::Matrix(const Matrix<T2, rows, cols>& other)
+  : elements_{}
+{
+  const T2* other_elements = other.Data();
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] = static_cast<T>(other_elements[i]);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT, typename>
+constexpr Matrix<T, rows, cols>::Matrix(const MatrixExpr<ExprT>& other) : elements_{}
+{
+  *this = other;
+}
+
+//----- Operator Overloadings --------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <typename NewT>
+Matrix<T, rows, cols>::operator Matrix<NewT, rows, cols>()
+{
+  Matrix<NewT, rows, cols> result(*this);
+  return result;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <typename NewT>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::
+operator=(const Matrix<NewT, rows, cols>& other)
+{
+  *this = static_cast<Matrix<T, rows, cols>>(other);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+constexpr Matrix<T, rows, cols>&
+Matrix<T, rows, cols>::operator=(const MatrixExpr<ExprT>& other)
+{
+  static_assert(HaveSameSize<Matrix<T, rows, cols>, ExprT>::value,
+                "ERROR: matrix dimensions mismatch in assignment!");
+  // Single fused loop, the expression is never stored in a temporary matrix.
+  const ExprT& expr = other.Self();
+  assert(expr.Rows() == rows && expr.Cols() == cols);
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] = static_cast<T>(expr.Coeff(i));
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator+=(const T& scalar)
+{
+  // Padding is left untouched, so that it stays zero.
+  simd::AddScalar(elements_, scalar, rows * cols);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::
+operator+=(const Matrix<T, rows, cols>& other)
+{
+  simd::Add(elements_, other.elements_, kStorageSize);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator+=(const MatrixExpr<ExprT>& other)
+{
+  static_assert(HaveSameSize<Matrix<T, rows, cols>, ExprT>::value,
+                "ERROR: matrix dimensions mismatch in sum!");
+  const ExprT& expr = other.Self();
+  assert(expr.Rows() == rows && expr.Cols() == cols);
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] += expr.Coeff(i);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator-=(const T& scalar)
+{
+  // Padding is left untouched, so that it stays zero.
+  simd::AddScalar(elements_, static_cast<T>(-scalar), rows * cols);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::
+operator-=(const Matrix<T, rows, cols>& other)
+{
+  simd::Sub(elements_, other.elements_, kStorageSize);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator-=(const MatrixExpr<ExprT>& other)
+{
+  static_assert(HaveSameSize<Matrix<T, rows, cols>, ExprT>::value,
+                "ERROR: matrix dimensions mismatch in subtraction!");
+  const ExprT& expr = other.Self();
+  assert(expr.Rows() == rows && expr.Cols() == cols);
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] -= expr.Coeff(i);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator*=(const T& scalar)
+{
+  simd::Scale(elements_, scalar, kStorageSize);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::operator/=(const T& scalar)
+{
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] /= scalar;
+  return *this;
+}
+
+//----- Setters ----------------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, rows, cols>&
+Matrix<T, rows, cols>::SetBlock(const uint8_t start_row, const uint8_t start_col,
+                                const MatrixExpr<ExprT>& other)
+{
+  // Block dimensions are compile-time constants unless the block has dynamic size.
+  const ExprT& block        = other.Self();
+  const uint16_t block_rows = block.Rows();
+  const uint16_t block_cols = block.Cols();
+  assert(start_row + block_rows - 1 <= rows);
+  assert(start_col + block_cols - 1 <= cols);
+
+  for (uint8_t row = 0; row < block_rows; ++row)
+    for (uint8_t col = 0; col < block_cols; ++col)
+      elements_[(start_row + row - 1) * cols + start_col + col - 1] =
+        block.Coeff(row, col);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
+                                                     const MatrixExpr<ExprT>& matrix1d)
+{
+  static_assert(HaveSameSize<Matrix<T, rows, 1>, ExprT>::value,
+                "ERROR: invalid column dimensions in SetCol()!");
+  const ExprT& column = matrix1d.Self();
+  assert(column.Rows() == rows && column.Cols() == 1);
+  for (uint8_t i = 0; i < rows; ++i)
+  {
+    elements_[i * cols + cl - 1] = column.Coeff(i);
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl, const T* vect,
+                                                     const uint8_t size)
+{
+  assert(size == rows);
+
+  for (uint8_t i = 0; i < rows; ++i)
+  {
+    elements_[i * cols + cl - 1] = vect[i];
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
+                                                     const std::vector<T>& vect)
+{
+  assert(vect.size() == rows);
+
+  for (uint8_t i = 0; i < rows; ++i)
+  {
+    elements_[i * cols + cl - 1] = vect[i];
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
+                                                     std::initializer_list<T> vect)
+{
+  return SetCol(cl, vect.begin(), static_cast<uint8_t>(vect.size()));
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetCol(const uint8_t cl,
+                                                     const std::array<T, rows>& vect)
+{
+  return SetCol(cl, vect.data(), rows);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <uint8_t _rows, uint8_t _cols>
+Matrix<T, rows, cols>&
+Matrix<T, rows, cols>::SetFromBlock(const uint8_t start_row, const uint8_t start_col,
+                                    const Matrix<T, _rows, _cols>& other)
+{
+  assert(start_row + rows - 1 <= _rows);
+  assert(start_col + cols - 1 <= _cols);
+
+  for (uint8_t row = 0; row < rows; ++row)
+    for (uint8_t col = 0; col < cols; ++col)
+      elements_[row * cols + col] = other(row + start_row, col + start_col);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetIdentity()
+{
+#if (MCU_TARGET == 0)
+  if (!IsSquare())
+  {
+    std::cerr << "WARNING: Matrix is not square! Pseudo-identity matrix is generated."
+              << std::endl;
+  }
+#endif
+  for (uint8_t row = 0; row < rows; ++row)
+    for (uint8_t col = 0; col < cols; ++col)
+    {
+      if (row == col)
+        elements_[row * cols + col] = 1;
+      else
+        elements_[row * cols + col] = 0;
+    }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <class ExprT>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
+                                                     const MatrixExpr<ExprT>& matrix1d)
+{
+  static_assert(HaveSameSize<Matrix<T, 1, cols>, ExprT>::value,
+                "ERROR: invalid row dimensions in SetRow()!");
+  const ExprT& row = matrix1d.Self();
+  assert(row.Rows() == 1 && row.Cols() == cols);
+  for (uint8_t i = 0; i < cols; ++i)
+  {
+    elements_[(rw - 1) * cols + i] = row.Coeff(i);
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw, const T* vect,
+                                                     const uint8_t size)
+{
+  assert(size == cols);
+
+  for (uint8_t i = 0; i < cols; ++i)
+  {
+    elements_[(rw - 1) * cols + i] = vect[i];
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
+                                                     const std::vector<T>& vect)
+{
+  assert(vect.size() == cols);
+
+  for (uint8_t i = 0; i < cols; ++i)
+  {
+    elements_[(rw - 1) * cols + i] = vect[i];
+  }
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
+                                                     std::initializer_list<T> vect)
+{
+  return SetRow(rw, vect.begin(), static_cast<uint8_t>(vect.size()));
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetRow(const uint8_t rw,
+                                                     const std::array<T, cols>& vect)
+{
+  return SetRow(rw, vect.data(), cols);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SetZero()
+{
+  for (uint16_t i = 0; i < kStorageSize; ++i)
+    elements_[i] = 0;
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::Fill(const T* values, const uint16_t size)
+{
+  assert(size == this->Size());
+
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] = values[i];
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::Fill(const std::vector<T>& values)
+{
+  assert(values.size() == this->Size());
+
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    elements_[i] = values[i];
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::Fill(std::initializer_list<T> values)
+{
+  return Fill(values.begin(), static_cast<uint16_t>(values.size()));
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>&
+Matrix<T, rows, cols>::Fill(const std::array<T, rows * cols>& values)
+{
+  return Fill(values.data(), rows * cols);
+}
+
+//----- Matrix manipulation ----------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, cols, rows> Matrix<T, rows, cols>::Transpose() const
+{
+  Matrix<T, cols, rows> transpose;
+  simd::Transpose<T, rows, cols>(elements_, transpose.Data());
+  return transpose;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SwapRow(const uint8_t row1,
+                                                      const uint8_t row2)
+{
+  std::swap_ranges(elements_ + (row1 - 1) * cols, elements_ + row1 * cols,
+                   elements_ + (row2 - 1) * cols);
+  return *this;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, rows, cols>& Matrix<T, rows, cols>::SwapCol(const uint8_t col1,
+                                                      const uint8_t col2)
+{
+  for (uint8_t i = 0; i < rows; ++i)
+    std::swap(elements_[i * cols + col1 - 1], elements_[i * cols + col2 - 1]);
+  return *this;
+}
+
+//----- Getters ----------------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+Matrix<T, 1, cols> Matrix<T, rows, cols>::GetRow(const uint8_t row) const
+{
+  Matrix<T, 1, cols> row_vect;
+  for (uint8_t col = 0; col < cols; ++col)
+    row_vect(col + 1) = elements_[(row - 1) * cols + col];
+  return row_vect;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+VectorX<T, rows> Matrix<T, rows, cols>::GetCol(const uint8_t col) const
+{
+  VectorX<T, rows> col_vect;
+  for (uint8_t row = 0; row < rows; ++row)
+    col_vect(row + 1) = elements_[row * cols + col - 1];
+  return col_vect;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <uint8_t blk_rows, uint8_t blk_cols>
+Matrix<T, blk_rows, blk_cols>
+Matrix<T, rows, cols>::GetBlock(const uint8_t start_row, const uint8_t start_col) const
+{
+  Matrix<T, blk_rows, blk_cols> block;
+  block.SetFromBlock(start_row, start_col, *this);
+  return block;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+MatrixView<T, 1, cols, cols> Matrix<T, rows, cols>::Row(const uint8_t row)
+{
+  assert(row >= 1 && row <= rows);
+  return MatrixView<T, 1, cols, cols>(elements_ + (row - 1) * cols);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+MatrixView<const T, 1, cols, cols> Matrix<T, rows, cols>::Row(const uint8_t row) const
+{
+  assert(row >= 1 && row <= rows);
+  return MatrixView<const T, 1, cols, cols>(elements_ + (row - 1) * cols);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+MatrixView<T, rows, 1, cols> Matrix<T, rows, cols>::Col(const uint8_t col)
+{
+  assert(col >= 1 && col <= cols);
+  return MatrixView<T, rows, 1, cols>(elements_ + col - 1);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+MatrixView<const T, rows, 1, cols> Matrix<T, rows, cols>::Col(const uint8_t col) const
+{
+  assert(col >= 1 && col <= cols);
+  return MatrixView<const T, rows, 1, cols>(elements_ + col - 1);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <uint8_t blk_rows, uint8_t blk_cols>
+MatrixView<T, blk_rows, blk_cols, cols>
+Matrix<T, rows, cols>::Block(const uint8_t start_row, const uint8_t start_col)
+{
+  assert(start_row + blk_rows - 1 <= rows);
+  assert(start_col + blk_cols - 1 <= cols);
+  return MatrixView<T, blk_rows, blk_cols, cols>(
+    elements_ + (start_row - 1) * cols + start_col - 1);
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+template <uint8_t blk_rows, uint8_t blk_cols>
+MatrixView<const T, blk_rows, blk_cols, cols>
+Matrix<T, rows, cols>::Block(const uint8_t start_row, const uint8_t start_col) const
+{
+  assert(start_row + blk_rows - 1 <= rows);
+  assert(start_col + blk_cols - 1 <= cols);
+  return MatrixView<const T, blk_rows, blk_cols, cols>(
+    elements_ + (start_row - 1) * cols + start_col - 1);
+}
+
+//----- Check functions --------------------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+bool Matrix<T, rows, cols>::IsSquare() const
+{
+  return rows == cols;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+bool Matrix<T, rows, cols>::IsSymmetric() const
+{
+  if (!IsSquare())
+    return false;
+  return *this == Transpose();
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+bool Matrix<T, rows, cols>::IsPositiveDefinite() const
+{
+  if (!IsSymmetric())
+    return false;
+  // Square-root-free Cholesky factorization, which exists if and only if all pivots are
+  // positive. Unlike Cholesky(), a failure is detected without throwing.
+  double ldl[rows * cols];
+  for (uint8_t j = 0; j < rows; ++j)
+  {
+    double pivot = elements_[j * cols + j];
+    for (uint8_t k = 0; k < j; ++k)
+      pivot -= ldl[j * cols + k] * ldl[j * cols + k] * ldl[k * cols + k];
+    if (!(pivot > 0))
+      return false;
+    ldl[j * cols + j] = pivot;
+    for (uint8_t i = j + 1; i < rows; ++i)
+    {
+      double sum = elements_[i * cols + j];
+      for (uint8_t k = 0; k < j; ++k)
+        sum -= ldl[i * cols + k] * ldl[j * cols + k] * ldl[k * cols + k];
+      ldl[i * cols + j] = sum / pivot;
+    }
+  }
+  return true;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+bool Matrix<T, rows, cols>::IsApprox(const Matrix<T, rows, cols>& other,
+                                     const double tol /* = epsilon*/) const
+{
+  for (uint16_t i = 0; i < rows * cols; ++i)
+    if (!IsClose(elements_[i], other.elements_[i], tol))
+      return false;
+  return true;
+}
+
+//----- Matrix internal utilities ----------------------------------------------------//
+
+template <typename T, uint8_t rows, uint8_t cols>
+uint16_t Matrix<T, rows, cols>::MaxIdx() const
+{
+  uint16_t i_max = 0;
+  for (uint16_t i = 1; i < rows * cols; ++i)
+    if (elements_[i] > elements_[i_max])
+      i_max = i;
+  return i_max + 1;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+uint16_t Matrix<T, rows, cols>::MinIdx() const
+{
+  uint16_t i_min = 0;
+  for (uint16_t i = 1; i < rows * cols; ++i)
+    if (elements_[i] < elements_[i_min])
+      i_min = i;
+  return i_min + 1;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+void Matrix<T, rows, cols>::ClearPadding()
+{
+  for (uint16_t i = rows * cols; i < kStorageSize; ++i)
+    elements_[i] = 0;
+}
+
+} // end namespace grabnum
@@ -0,0 +1,374 @@
+/**
+ * @file matrix_dynamic.tcc
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions and implementation of the dynamic-size matrix class.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_DYNAMIC_H
+#error Do not include this file directly, include matrix_dynamic.h instead
+#endif
+
+#include <assert.h>
+#include <utility>
+
+namespace grabnum {
+
+//----- Constructors -----------------------------------------------------------------//
+
+template <typename T>
+MatrixX<T>::MatrixX()
+  : data_(inline_elements_), rows_(0), cols_(0), capacity_(kInlineSize), external_(false)
+{}
+
+template <typename T>
+MatrixX<T>::MatrixX(const uint16_t rows, const uint16_t cols) : MatrixX()
+{
+  Resize(rows, cols);
+}
+
+template <typename T>
+MatrixX<T>::MatrixX(const uint16_t rows, const uint16_t cols, const T scalar)
+  : MatrixX(rows, cols)
+{
+  if (scalar != 0)
+  {
+    SetIdentity();
+    *this *= scalar;
+  }
+}
+
+template <typename T>
+MatrixX<T>::MatrixX(const uint16_t rows, const uint16_t cols, const T* values,
+                    const uint32_t size)
+  : MatrixX(rows, cols)
+{
+  Fill(values, size);
+}
+
+template <typename T>
+MatrixX<T>::MatrixX(const uint16_t rows, const uint16_t cols,
+                    const std::vector<T>& values)
+  : MatrixX(rows, cols)
+{
+  Fill(values);
+}
+
+template <typename T>
+MatrixX<T>::MatrixX(const uint16_t rows, const uint16_t cols,
+                    std::initializer_list<T> values)
+  : MatrixX(rows, cols)
+{
+  Fill(values);
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>::MatrixX(const MatrixExpr<ExprT>& other) : MatrixX()
+{
+  *this = other;
+}
+
+template <typename T> MatrixX<T>::MatrixX(const MatrixX<T>& other) : MatrixX()
+{
+  *this = other;
+}
+
+template <typename T> MatrixX<T>::MatrixX(MatrixX<T>&& other) noexcept : MatrixX()
+{
+  *this = std::move(other);
+}
+
+template <typename T> MatrixX<T>::~MatrixX() { Release(); }
+
+template <typename T>
+MatrixX<T> MatrixX<T>::Map(T* buffer, const uint16_t rows, const uint16_t cols)
+{
+  MatrixX<T> mapped;
+  mapped.data_     = buffer;
+  mapped.rows_     = rows;
+  mapped.cols_     = cols;
+  mapped.capacity_ = mapped.Size();
+  mapped.external_ = true;
+  return mapped;
+}
+
+template <typename T>
+template <uint8_t rows, uint8_t cols>
+MatrixX<T> MatrixX<T>::Map(Matrix<T, rows, cols>& matrix)
+{
+  // Fixed-size matrices are padded only at the end, so their rows are contiguous.
+  return Map(matrix.Data(), rows, cols);
+}
+
+//----- Storage ----------------------------------------------------------------------//
+
+template <typename T> void MatrixX<T>::Reserve(const uint32_t size)
+{
+  if (size <= capacity_)
+    return;
+  assert(!external_ && "ERROR: a mapped matrix can not grow!");
+  Release();
+  data_     = new T[size];
+  capacity_ = size;
+}
+
+template <typename T> void MatrixX<T>::Release()
+{
+  if (!external_ && data_ != inline_elements_)
+    delete[] data_;
+  data_     = inline_elements_;
+  capacity_ = kInlineSize;
+  external_ = false;
+}
+
+template <typename T>
+MatrixX<T>& MatrixX<T>::Resize(const uint16_t rows, const uint16_t cols)
+{
+  Reserve(static_cast<uint32_t>(rows) * cols);
+  rows_ = rows;
+  cols_ = cols;
+  return SetZero();
+}
+
+//----- Operator Overloadings --------------------------------------------------------//
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator=(const MatrixX<T>& other)
+{
+  if (this != &other)
+    *this = static_cast<const MatrixExpr<MatrixX<T>>&>(other);
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator=(MatrixX<T>&& other) noexcept
+{
+  if (this == &other)
+    return *this;
+  // Inline elements can not be handed over, while a mapped matrix keeps its buffer.
+  if (external_ || (!other.external_ && other.data_ == other.inline_elements_))
+  {
+    *this       = static_cast<const MatrixExpr<MatrixX<T>>&>(other);
+    other.rows_ = 0;
+    other.cols_ = 0;
+    return *this;
+  }
+
+  Release();
+  data_     = other.data_;
+  rows_     = other.rows_;
+  cols_     = other.cols_;
+  capacity_ = other.capacity_;
+  external_ = other.external_;
+
+  other.data_     = other.inline_elements_;
+  other.rows_     = 0;
+  other.cols_     = 0;
+  other.capacity_ = kInlineSize;
+  other.external_ = false;
+  return *this;
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::operator=(const MatrixExpr<ExprT>& other)
+{
+  const ExprT& expr = other.Self();
+  if (expr.Rows() != rows_ || expr.Cols() != cols_)
+  {
+    // Storage is reused if it fits, otherwise the expression is larger than *this and can
+    // not refer to it, so the old storage can be dropped.
+    assert(!external_ && "ERROR: a mapped matrix can not be resized!");
+    Reserve(static_cast<uint32_t>(expr.Rows()) * expr.Cols());
+    rows_ = expr.Rows();
+    cols_ = expr.Cols();
+  }
+  // Single fused loop, the expression is never stored in a temporary matrix.
+  const uint32_t size = Size();
+  for (uint32_t i = 0; i < size; ++i)
+    data_[i] = static_cast<T>(expr.Coeff(i));
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator+=(const T& scalar)
+{
+  simd::AddScalar(data_, scalar, Size());
+  return *this;
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::operator+=(const MatrixExpr<ExprT>& other)
+{
+  const ExprT& expr = other.Self();
+  assert(expr.Rows() == rows_ && expr.Cols() == cols_);
+  const uint32_t size = Size();
+  for (uint32_t i = 0; i < size; ++i)
+    data_[i] += expr.Coeff(i);
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator-=(const T& scalar)
+{
+  simd::AddScalar(data_, static_cast<T>(-scalar), Size());
+  return *this;
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::operator-=(const MatrixExpr<ExprT>& other)
+{
+  const ExprT& expr = other.Self();
+  assert(expr.Rows() == rows_ && expr.Cols() == cols_);
+  const uint32_t size = Size();
+  for (uint32_t i = 0; i < size; ++i)
+    data_[i] -= expr.Coeff(i);
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator*=(const T& scalar)
+{
+  simd::Scale(data_, scalar, Size());
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::operator/=(const T& scalar)
+{
+  const uint32_t size = Size();
+  for (uint32_t i = 0; i < size; ++i)
+    data_[i] /= scalar;
+  return *this;
+}
+
+//----- Setters ----------------------------------------------------------------------//
+
+template <typename T> MatrixX<T>& MatrixX<T>::SetZero()
+{
+  std::fill(data_, data_ + Size(), T(0));
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::SetIdentity()
+{
+  SetZero();
+  const uint16_t diag_size = std::min(rows_, cols_);
+  for (uint16_t i = 0; i < diag_size; ++i)
+    data_[i * cols_ + i] = 1;
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::Fill(const T* values, const uint32_t size)
+{
+  assert(size == Size());
+  std::copy(values, values + size, data_);
+  return *this;
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::Fill(const std::vector<T>& values)
+{
+  return Fill(values.data(), static_cast<uint32_t>(values.size()));
+}
+
+template <typename T> MatrixX<T>& MatrixX<T>::Fill(std::initializer_list<T> values)
+{
+  return Fill(values.begin(), static_cast<uint32_t>(values.size()));
+}
+
+template <typename T>
+template <size_t size>
+MatrixX<T>& MatrixX<T>::Fill(const std::array<T, size>& values)
+{
+  return Fill(values.data(), size);
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::SetBlock(const uint16_t start_row, const uint16_t start_col,
+                                 const MatrixExpr<ExprT>& other)
+{
+  const ExprT& block = other.Self();
+  assert(start_row + block.Rows() - 1 <= rows_);
+  assert(start_col + block.Cols() - 1 <= cols_);
+
+  for (uint16_t row = 0; row < block.Rows(); ++row)
+    for (uint16_t col = 0; col < block.Cols(); ++col)
+      data_[(start_row + row - 1) * cols_ + start_col + col - 1] = block.Coeff(row, col);
+  return *this;
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::SetRow(const uint16_t row, const MatrixExpr<ExprT>& matrix1d)
+{
+  static_assert(DimsMatch(ExprTraits<ExprT>::kRows, 1),
+                "ERROR: invalid row dimensions in SetRow()!");
+  assert(matrix1d.Self().Rows() == 1 && matrix1d.Self().Cols() == cols_);
+  return SetBlock(row, 1, matrix1d);
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T>& MatrixX<T>::SetCol(const uint16_t col, const MatrixExpr<ExprT>& matrix1d)
+{
+  static_assert(DimsMatch(ExprTraits<ExprT>::kCols, 1),
+                "ERROR: invalid column dimensions in SetCol()!");
+  assert(matrix1d.Self().Rows() == rows_ && matrix1d.Self().Cols() == 1);
+  return SetBlock(1, col, matrix1d);
+}
+
+//----- Getters ----------------------------------------------------------------------//
+
+template <typename T> MatrixX<T> MatrixX<T>::GetRow(const uint16_t row) const
+{
+  assert(row >= 1 && row <= rows_);
+  return MatrixX<T>(1, cols_, data_ + (row - 1) * cols_, cols_);
+}
+
+template <typename T> MatrixX<T> MatrixX<T>::GetCol(const uint16_t col) const
+{
+  assert(col >= 1 && col <= cols_);
+  MatrixX<T> column(rows_, 1);
+  for (uint16_t row = 0; row < rows_; ++row)
+    column.data_[row] = data_[row * cols_ + col - 1];
+  return column;
+}
+
+template <typename T>
+template <uint8_t blk_rows, uint8_t blk_cols>
+Matrix<T, blk_rows, blk_cols> MatrixX<T>::GetBlock(const uint16_t start_row,
+                                                   const uint16_t start_col) const
+{
+  return Matrix<T, blk_rows, blk_cols>(Block<blk_rows, blk_cols>(start_row, start_col));
+}
+
+template <typename T>
+template <uint8_t blk_rows, uint8_t blk_cols>
+MatrixView<T, blk_rows, blk_cols, kDynamic>
+MatrixX<T>::Block(const uint16_t start_row, const uint16_t start_col)
+{
+  assert(start_row + blk_rows - 1 <= rows_);
+  assert(start_col + blk_cols - 1 <= cols_);
+  return MatrixView<T, blk_rows, blk_cols, kDynamic>(
+    data_ + (start_row - 1) * cols_ + start_col - 1, cols_);
+}
+
+template <typename T>
+template <uint8_t blk_rows, uint8_t blk_cols>
+MatrixView<const T, blk_rows, blk_cols, kDynamic>
+MatrixX<T>::Block(const uint16_t start_row, const uint16_t start_col) const
+{
+  assert(start_row + blk_rows - 1 <= rows_);
+  assert(start_col + blk_cols - 1 <= cols_);
+  return MatrixView<const T, blk_rows, blk_cols, kDynamic>(
+    data_ + (start_row - 1) * cols_ + start_col - 1, cols_);
+}
+
+template <typename T> MatrixX<T> MatrixX<T>::Transpose() const
+{
+  MatrixX<T> transposed(cols_, rows_);
+  for (uint16_t row = 0; row < rows_; ++row)
+    for (uint16_t col = 0; col < cols_; ++col)
+      transposed.data_[col * rows_ + row] = data_[row * cols_ + col];
+  return transposed;
+}
+
+} //  end namespace grabnum
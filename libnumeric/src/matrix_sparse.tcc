@@ -0,0 +1,406 @@
+/**
+ * @file matrix_sparse.tcc
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions of the sparse matrix class and of the structured
+ * linear solvers.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_MATRIX_SPARSE_H
+#error Do not include this file directly, include matrix_sparse.h instead
+#endif
+
+#include <assert.h>
+#include <numeric>
+
+namespace grabnum {
+
+//----- SparseMatrix -----------------------------------------------------------------//
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const uint16_t rows, const uint16_t cols)
+  : rows_(rows), cols_(cols), row_offsets_(rows + 1, 0)
+{}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(const uint16_t rows, const uint16_t cols,
+                              const std::vector<Triplet<T>>& entries)
+  : SparseMatrix(rows, cols)
+{
+  std::vector<Triplet<T>> sorted(entries);
+  std::sort(sorted.begin(), sorted.end(),
+            [](const Triplet<T>& lhs, const Triplet<T>& rhs) {
+              return lhs.row < rhs.row || (lhs.row == rhs.row && lhs.col < rhs.col);
+            });
+  col_indices_.reserve(sorted.size());
+  values_.reserve(sorted.size());
+  for (size_t k = 0; k < sorted.size(); ++k)
+  {
+    const Triplet<T>& entry = sorted[k];
+    assert(entry.row >= 1 && entry.row <= rows && entry.col >= 1 && entry.col <= cols);
+    if (k > 0 && entry.row == sorted[k - 1].row && entry.col == sorted[k - 1].col)
+    {
+      values_.back() += entry.value;
+      continue;
+    }
+    col_indices_.push_back(entry.col - 1);
+    values_.push_back(entry.value);
+    row_offsets_[entry.row]++;
+  }
+  std::partial_sum(row_offsets_.begin(), row_offsets_.end(), row_offsets_.begin());
+}
+
+template <typename T>
+template <class ExprT>
+SparseMatrix<T>::SparseMatrix(const MatrixExpr<ExprT>& dense, const T tol /*= 0*/)
+  : SparseMatrix(dense.Self().Rows(), dense.Self().Cols())
+{
+  for (uint16_t i = 0; i < rows_; ++i)
+  {
+    for (uint16_t j = 0; j < cols_; ++j)
+    {
+      const T value = dense.Self().Coeff(i, j);
+      if (std::abs(value) <= tol)
+        continue;
+      col_indices_.push_back(j);
+      values_.push_back(value);
+    }
+    row_offsets_[i + 1] = static_cast<uint32_t>(values_.size());
+  }
+}
+
+template <typename T>
+T SparseMatrix<T>::operator()(const uint16_t row, const uint16_t col) const
+{
+  assert(row >= 1 && row <= rows_ && col >= 1 && col <= cols_);
+  const auto begin = col_indices_.begin() + row_offsets_[row - 1];
+  const auto end   = col_indices_.begin() + row_offsets_[row];
+  const auto match = std::lower_bound(begin, end, col - 1);
+  if (match == end || *match != col - 1)
+    return 0;
+  return values_[match - col_indices_.begin()];
+}
+
+template <typename T> uint16_t SparseMatrix<T>::LowerBandwidth() const
+{
+  uint16_t bandwidth = 0;
+  for (uint16_t i = 1; i < rows_; ++i)
+    // Columns are sorted, the first one is the farthest below the diagonal.
+    if (row_offsets_[i] < row_offsets_[i + 1] && col_indices_[row_offsets_[i]] < i)
+      bandwidth =
+        std::max(bandwidth, static_cast<uint16_t>(i - col_indices_[row_offsets_[i]]));
+  return bandwidth;
+}
+
+template <typename T> uint16_t SparseMatrix<T>::UpperBandwidth() const
+{
+  uint16_t bandwidth = 0;
+  for (uint16_t i = 0; i < rows_; ++i)
+  {
+    // Columns are sorted, the last one is the farthest above the diagonal.
+    if (row_offsets_[i] == row_offsets_[i + 1])
+      continue;
+    const uint16_t last_col = col_indices_[row_offsets_[i + 1] - 1];
+    if (last_col > i)
+      bandwidth = std::max(bandwidth, static_cast<uint16_t>(last_col - i));
+  }
+  return bandwidth;
+}
+
+template <typename T> SparseMatrix<T> SparseMatrix<T>::Transpose() const
+{
+  SparseMatrix<T> transposed(cols_, rows_);
+  transposed.col_indices_.resize(values_.size());
+  transposed.values_.resize(values_.size());
+  // Counting sort of the entries by column.
+  for (const uint16_t col : col_indices_)
+    transposed.row_offsets_[col + 1]++;
+  std::partial_sum(transposed.row_offsets_.begin(), transposed.row_offsets_.end(),
+                   transposed.row_offsets_.begin());
+  std::vector<uint32_t> next(transposed.row_offsets_.begin(),
+                             transposed.row_offsets_.end() - 1);
+  for (uint16_t i = 0; i < rows_; ++i)
+    for (uint32_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+    {
+      const uint32_t dest           = next[col_indices_[k]]++;
+      transposed.col_indices_[dest] = i;
+      transposed.values_[dest]      = values_[k];
+    }
+  return transposed;
+}
+
+template <typename T> MatrixX<T> SparseMatrix<T>::ToDense() const
+{
+  MatrixX<T> dense(rows_, cols_);
+  for (uint16_t i = 0; i < rows_; ++i)
+    for (uint32_t k = row_offsets_[i]; k < row_offsets_[i + 1]; ++k)
+      dense(i + 1, col_indices_[k] + 1) = values_[k];
+  return dense;
+}
+
+template <typename T, class ExprT>
+MatrixX<T> operator*(const SparseMatrix<T>& lhs, const MatrixExpr<ExprT>& rhs)
+{
+  static_assert(std::is_same<T, typename ExprTraits<ExprT>::Scalar>::value,
+                "ERROR: matrix types mismatch in sparse product!");
+  assert(lhs.Cols() == rhs.Self().Rows());
+  const uint16_t cols = rhs.Self().Cols();
+  MatrixX<T> product(lhs.Rows(), cols);
+  T* dest = product.Data();
+  for (uint16_t i = 0; i < lhs.Rows(); ++i)
+    for (uint32_t k = lhs.RowOffsets()[i]; k < lhs.RowOffsets()[i + 1]; ++k)
+    {
+      const T value = lhs.Values()[k];
+      for (uint16_t j = 0; j < cols; ++j)
+        dest[i * cols + j] += value * rhs.Self().Coeff(lhs.ColIndices()[k], j);
+    }
+  return product;
+}
+
+//----- BandedLU ---------------------------------------------------------------------//
+
+template <typename T> BandedLU<T>& BandedLU<T>::Compute(const SparseMatrix<T>& matrix)
+{
+  assert(matrix.Rows() == matrix.Cols());
+  size_     = matrix.Rows();
+  lower_    = matrix.LowerBandwidth();
+  upper_    = matrix.UpperBandwidth();
+  fill_     = size_ > 0 ? std::min<uint16_t>(lower_ + upper_, size_ - 1) : 0;
+  width_    = lower_ + fill_ + 1;
+  singular_ = false;
+  band_.assign(static_cast<size_t>(size_) * width_, 0);
+  pivots_.resize(size_);
+  for (uint16_t i = 0; i < size_; ++i)
+    for (uint32_t k = matrix.RowOffsets()[i]; k < matrix.RowOffsets()[i + 1]; ++k)
+      At(i, matrix.ColIndices()[k]) = matrix.Values()[k];
+
+  for (uint16_t k = 0; k < size_; ++k)
+  {
+    const uint16_t last_row = std::min<uint16_t>(k + lower_, size_ - 1);
+    const uint16_t last_col = std::min<uint16_t>(k + fill_, size_ - 1);
+    // Partial pivoting within the rows reached by the band.
+    uint16_t pivot = k;
+    for (uint16_t i = k + 1; i <= last_row; ++i)
+      if (std::abs(At(i, k)) > std::abs(At(pivot, k)))
+        pivot = i;
+    pivots_[k] = pivot;
+    // Only the part right of the diagonal is swapped: multipliers of previous steps stay
+    // in place and row swaps are replayed on the right-hand side while solving.
+    if (pivot != k)
+      for (uint16_t j = k; j <= last_col; ++j)
+        std::swap(At(k, j), At(pivot, j));
+    if (At(k, k) == 0)
+    {
+      singular_ = true;
+      continue;
+    }
+    for (uint16_t i = k + 1; i <= last_row; ++i)
+    {
+      const T factor = At(i, k) /= At(k, k);
+      if (factor == 0)
+        continue;
+      for (uint16_t j = k + 1; j <= last_col; ++j)
+        At(i, j) -= factor * At(k, j);
+    }
+  }
+  return *this;
+}
+
+template <typename T> bool BandedLU<T>::IsInvertible(const double tol /*= EPSILON*/) const
+{
+  for (uint16_t i = 0; i < size_; ++i)
+    if (std::abs(At(i, i)) <= tol)
+      return false;
+  return true;
+}
+
+template <typename T>
+void BandedLU<T>::SolveInPlace(T* vect, const uint32_t stride /*= 1*/) const
+{
+  if (singular_)
+    throw std::invalid_argument("Matrix must be non-singular!");
+
+  // Forward substitution, with L and row swaps applied step by step.
+  for (uint16_t k = 0; k < size_; ++k)
+  {
+    if (pivots_[k] != k)
+      std::swap(vect[k * stride], vect[pivots_[k] * stride]);
+    const uint16_t last_row = std::min<uint16_t>(k + lower_, size_ - 1);
+    for (uint16_t i = k + 1; i <= last_row; ++i)
+      vect[i * stride] -= At(i, k) * vect[k * stride];
+  }
+  // Backward substitution with U.
+  for (uint16_t i = size_; i-- > 0;)
+  {
+    const uint16_t last_col = std::min<uint16_t>(i + fill_, size_ - 1);
+    T sum                   = vect[i * stride];
+    for (uint16_t j = i + 1; j <= last_col; ++j)
+      sum -= At(i, j) * vect[j * stride];
+    vect[i * stride] = sum / At(i, i);
+  }
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T> BandedLU<T>::Solve(const MatrixExpr<ExprT>& rhs) const
+{
+  assert(rhs.Self().Rows() == size_);
+  MatrixX<T> solution(rhs);
+  for (uint16_t j = 0; j < solution.Cols(); ++j)
+    SolveInPlace(solution.Data() + j, solution.Cols());
+  return solution;
+}
+
+//----- SparseLU ---------------------------------------------------------------------//
+
+// Splits the unknowns of a square matrix into groups which are not coupled by any entry,
+// i.e. the connected components of the pattern of A + A^T. Groups are returned one after
+// the other in indices, each one in increasing order, with offsets marking their starts.
+template <typename T>
+void SplitIndependentBlocks(const SparseMatrix<T>& matrix, std::vector<uint16_t>& indices,
+                            std::vector<uint16_t>& offsets)
+{
+  const uint16_t size = matrix.Rows();
+  // Union-find with path halving, each group being labelled by its smallest index.
+  std::vector<uint16_t> parent(size);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](uint16_t i) {
+    while (parent[i] != i)
+      i = parent[i] = parent[parent[i]];
+    return i;
+  };
+  for (uint16_t i = 0; i < size; ++i)
+    for (uint32_t k = matrix.RowOffsets()[i]; k < matrix.RowOffsets()[i + 1]; ++k)
+    {
+      const uint16_t root1 = find(i);
+      const uint16_t root2 = find(matrix.ColIndices()[k]);
+      if (root1 != root2)
+        parent[std::max(root1, root2)] = std::min(root1, root2);
+    }
+
+  std::vector<uint16_t> block_of(size);
+  std::vector<uint16_t> counts;
+  std::vector<uint16_t> label(size, size);
+  for (uint16_t i = 0; i < size; ++i)
+  {
+    const uint16_t root = find(i);
+    if (label[root] == size)
+    {
+      label[root] = static_cast<uint16_t>(counts.size());
+      counts.push_back(0);
+    }
+    block_of[i] = label[root];
+    counts[block_of[i]]++;
+  }
+  offsets.assign(counts.size() + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+  std::vector<uint16_t> next(offsets.begin(), offsets.end() - 1);
+  indices.resize(size);
+  for (uint16_t i = 0; i < size; ++i)
+    indices[next[block_of[i]]++] = i;
+}
+
+template <typename T> SparseStructure SelectSparseStructure(const SparseMatrix<T>& matrix)
+{
+  assert(matrix.Rows() == matrix.Cols());
+  // Below this size the whole matrix fits in cache and dense loops are fastest anyway.
+  static constexpr uint16_t kMinSparseSize = 16;
+  const uint16_t size = matrix.Rows();
+  if (size < kMinSparseSize)
+    return DENSE;
+
+  std::vector<uint16_t> indices;
+  std::vector<uint16_t> offsets;
+  SplitIndependentBlocks(matrix, indices, offsets);
+  if (offsets.size() > 2)
+    return BLOCK_DIAGONAL;
+
+  // Banded elimination costs about n * kl * (kl + ku), against n^3 / 3 of a dense one.
+  const double lower = matrix.LowerBandwidth();
+  const double upper = matrix.UpperBandwidth();
+  if (2.0 * lower * (lower + upper) < size * size / 3.0)
+    return BANDED;
+  return DENSE;
+}
+
+template <typename T> SparseLU<T>& SparseLU<T>::Compute(const SparseMatrix<T>& matrix)
+{
+  return Compute(matrix, SelectSparseStructure(matrix));
+}
+
+template <typename T>
+SparseLU<T>& SparseLU<T>::Compute(const SparseMatrix<T>& matrix,
+                                  const SparseStructure structure)
+{
+  assert(matrix.Rows() == matrix.Cols());
+  structure_ = structure;
+  if (structure_ != BLOCK_DIAGONAL)
+  {
+    // A dense matrix is just a banded one whose band covers it all.
+    blocks_.resize(1);
+    blocks_.front().Compute(matrix);
+    indices_.clear();
+    block_offsets_.assign({0, matrix.Rows()});
+    return *this;
+  }
+
+  SplitIndependentBlocks(matrix, indices_, block_offsets_);
+  blocks_.resize(block_offsets_.size() - 1);
+  // Position of each unknown within its own block.
+  std::vector<uint16_t> local(matrix.Rows());
+  for (size_t b = 0; b < blocks_.size(); ++b)
+    for (uint16_t k = block_offsets_[b]; k < block_offsets_[b + 1]; ++k)
+      local[indices_[k]] = k - block_offsets_[b];
+  std::vector<Triplet<T>> entries;
+  for (size_t b = 0; b < blocks_.size(); ++b)
+  {
+    entries.clear();
+    for (uint16_t k = block_offsets_[b]; k < block_offsets_[b + 1]; ++k)
+    {
+      const uint16_t i = indices_[k];
+      for (uint32_t e = matrix.RowOffsets()[i]; e < matrix.RowOffsets()[i + 1]; ++e)
+        entries.push_back({static_cast<uint16_t>(local[i] + 1),
+                           static_cast<uint16_t>(local[matrix.ColIndices()[e]] + 1),
+                           matrix.Values()[e]});
+    }
+    const uint16_t block_size = block_offsets_[b + 1] - block_offsets_[b];
+    blocks_[b].Compute(SparseMatrix<T>(block_size, block_size, entries));
+  }
+  return *this;
+}
+
+template <typename T> bool SparseLU<T>::IsInvertible(const double tol /*= EPSILON*/) const
+{
+  for (const BandedLU<T>& block : blocks_)
+    if (!block.IsInvertible(tol))
+      return false;
+  return true;
+}
+
+template <typename T>
+template <class ExprT>
+MatrixX<T> SparseLU<T>::Solve(const MatrixExpr<ExprT>& rhs) const
+{
+  assert(!blocks_.empty() && rhs.Self().Rows() == block_offsets_.back());
+  if (structure_ != BLOCK_DIAGONAL)
+    return blocks_.front().Solve(rhs);
+
+  // Rows are gathered block by block, solved in place and finally put back in order.
+  MatrixX<T> solution(rhs.Self().Rows(), rhs.Self().Cols());
+  for (size_t b = 0; b < blocks_.size(); ++b)
+    for (uint16_t j = 0; j < solution.Cols(); ++j)
+    {
+      T* column = solution.Data() + j;
+      const uint32_t stride = solution.Cols();
+      for (uint16_t k = block_offsets_[b]; k < block_offsets_[b + 1]; ++k)
+        column[k * stride] = rhs.Self().Coeff(indices_[k], j);
+      blocks_[b].SolveInPlace(column + block_offsets_[b] * stride, stride);
+    }
+  MatrixX<T> permuted(solution.Rows(), solution.Cols());
+  for (uint16_t k = 0; k < solution.Rows(); ++k)
+    for (uint16_t j = 0; j < solution.Cols(); ++j)
+      permuted(indices_[k] + 1, j + 1) = solution(k + 1, j + 1);
+  return permuted;
+}
+
+} //  end namespace grabnum
@@ -35,242 +35,258 @@ std::ostream& operator<<(std::ostream& stream, const Matrix<T, rows, cols>& matr
   }
   return stream;
 }
-#endif
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const T& scalar, const Matrix<T, rows, cols>& matrix)
+template <class ExprT>
+std::ostream& operator<<(std::ostream& stream, const MatrixExpr<ExprT>& expr)
 {
-  Matrix<T, rows, cols> sum;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      sum(row, col) = matrix(row, col) + scalar;
-  return sum;
+  // Same layout of a plain matrix, reading the expression straight away (dynamic-size
+  // matrices included).
+  const ExprT& matrix = expr.Self();
+  for (uint16_t row = 0; row < matrix.Rows(); ++row)
+  {
+    if (row == 0)
+      stream << "[";
+    else
+      stream << " ";
+    for (uint16_t col = 0; col < matrix.Cols(); ++col)
+    {
+      stream << std::setw(15) << std::setprecision(7) << matrix.Coeff(row, col);
+      if (row == matrix.Rows() - 1 && col == matrix.Cols() - 1)
+        stream << "          ]";
+    }
+    stream << "\n";
+  }
+  return stream;
 }
+#endif
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const Matrix<T, rows, cols>& matrix, const T& scalar)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarSumOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator+(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix)
 {
-  Matrix<T, rows, cols> sum;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      sum(row, col) = matrix(row, col) + scalar;
-  return sum;
+  using Op = ScalarSumOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator+(const Matrix<T, rows, cols>& matrix1,
-                                const Matrix<T, rows, cols>& matrix2)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarSumOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator+(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar)
 {
-  Matrix<T, rows, cols> sum;
-  for (uint8_t row; row <= rows; ++row)
-    for (uint8_t col; col <= cols; ++col)
-      sum(row, col) = matrix1(row, col) + matrix2(row, col);
-  return sum;
+  using Op = ScalarSumOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const T& scalar, const Matrix<T, rows, cols>& matrix)
+template <class LhsT, class RhsT>
+constexpr CwiseBinaryExpr<SumOp, LhsT, RhsT>
+operator+(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2)
 {
-  Matrix<T, rows, cols> result;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      result(row, col) = scalar - matrix(row, col);
-  return result;
+  return CwiseBinaryExpr<SumOp, LhsT, RhsT>(matrix1.Self(), matrix2.Self());
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix, const T& scalar)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarRDiffOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix)
 {
-  Matrix<T, rows, cols> diff;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      diff(row, col) = matrix(row, col) - scalar;
-  return diff;
+  using Op = ScalarRDiffOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix1,
-                                const Matrix<T, rows, cols>& matrix2)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarDiffOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar)
 {
-  Matrix<T, rows, cols> diff;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      diff(row, col) = matrix1(row, col) - matrix2(row, col);
-  return diff;
+  using Op = ScalarDiffOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator-(const Matrix<T, rows, cols>& matrix)
+template <class LhsT, class RhsT>
+constexpr CwiseBinaryExpr<DiffOp, LhsT, RhsT>
+operator-(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2)
 {
-  Matrix<T, rows, cols> opposite;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      opposite(row, col) = -matrix(row, col);
-  return opposite;
+  return CwiseBinaryExpr<DiffOp, LhsT, RhsT>(matrix1.Self(), matrix2.Self());
 }
 
-template <typename T, uint8_t rows1, uint8_t dim_common, uint8_t cols2>
-Matrix<T, rows1, cols2> operator*(const Matrix<T, rows1, dim_common>& matrix1,
-                                  const Matrix<T, dim_common, cols2>& matrix2)
+template <class ExprT>
+constexpr CwiseUnaryExpr<NegateOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator-(const MatrixExpr<ExprT>& matrix)
 {
-  Matrix<T, rows1, cols2> prod;
-  for (uint8_t row = 1; row <= rows1; ++row)
-  {
-    for (uint8_t col = 1; col <= cols2; ++col)
-    {
-      T sum = 0;
-      for (uint8_t j = 1; j <= dim_common; j++)
-        sum += matrix1(row, j) * matrix2(j, col);
-      prod(row, col) = sum;
-    }
-  }
-  return prod;
+  using Op = NegateOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op());
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const VectorX<T, rows>& vvect,
-                                const Matrix<T, 1, cols>& hvect)
+template <class LhsT, class RhsT>
+typename std::enable_if<IsMatrixProduct<LhsT, RhsT>::value,
+                        Matrix<typename ExprTraits<LhsT>::Scalar, ExprTraits<LhsT>::kRows,
+                               ExprTraits<RhsT>::kCols>>::type
+operator*(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2)
 {
-  Matrix<T, rows, cols> prod;
-  for (uint8_t row = 1; row <= rows; ++row)
-  {
-    for (uint8_t col = 1; col <= cols; ++col)
-    {
-      prod(row, col) = vvect(row) * hvect(col);
-    }
-  }
+  using T = typename ExprTraits<LhsT>::Scalar;
+  static constexpr uint8_t rows1      = ExprTraits<LhsT>::kRows;
+  static constexpr uint8_t dim_common = ExprTraits<LhsT>::kCols;
+  static constexpr uint8_t cols2      = ExprTraits<RhsT>::kCols;
+  static_assert(std::is_same<T, typename ExprTraits<RhsT>::Scalar>::value,
+                "ERROR: matrix types mismatch in product!");
+
+  // Plain matrices are taken by reference, expressions are evaluated once here.
+  const Matrix<T, rows1, dim_common>& lhs = matrix1.Self().Eval();
+  const Matrix<T, dim_common, cols2>& rhs = matrix2.Self().Eval();
+  Matrix<T, rows1, cols2> prod;
+  simd::MatMul<T, rows1, dim_common, cols2>(lhs.Data(), rhs.Data(), prod.Data());
   return prod;
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const T& scalar, const Matrix<T, rows, cols>& matrix)
+template <class LhsT, class RhsT>
+typename std::enable_if<IsDynamicProduct<LhsT, RhsT>::value,
+                        MatrixX<typename ExprTraits<LhsT>::Scalar>>::type
+operator*(const MatrixExpr<LhsT>& matrix1, const MatrixExpr<RhsT>& matrix2)
 {
-  Matrix<T, rows, cols> prod;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      prod(row, col) = matrix(row, col) * scalar;
+  using T = typename ExprTraits<LhsT>::Scalar;
+  static_assert(std::is_same<T, typename ExprTraits<RhsT>::Scalar>::value,
+                "ERROR: matrix types mismatch in product!");
+
+  // Plain matrices are taken by reference, expressions are evaluated once here.
+  const typename MatrixExpr<LhsT>::PlainType& lhs = matrix1.Self().Eval();
+  const typename MatrixExpr<RhsT>::PlainType& rhs = matrix2.Self().Eval();
+  assert(lhs.Cols() == rhs.Rows());
+  MatrixX<T> prod(lhs.Rows(), rhs.Cols());
+  simd::MatMul(lhs.Data(), rhs.Data(), prod.Data(), lhs.Rows(), lhs.Cols(), rhs.Cols());
   return prod;
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator*(const Matrix<T, rows, cols>& matrix, const T& scalar)
+template <class LhsT, class RhsT>
+constexpr typename std::enable_if<IsCwiseProduct<LhsT, RhsT>::value,
+                                  CwiseBinaryExpr<CwiseProdOp, LhsT, RhsT>>::type
+operator*(const MatrixExpr<LhsT>& vect1, const MatrixExpr<RhsT>& vect2)
 {
-  Matrix<T, rows, cols> prod;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      prod(row, col) = matrix(row, col) * scalar;
-  return prod;
+  return CwiseBinaryExpr<CwiseProdOp, LhsT, RhsT>(vect1.Self(), vect2.Self());
 }
 
-template <typename T, uint8_t rows>
-VectorX<T, rows> operator*(const VectorX<T, rows>& vvect1, const VectorX<T, rows>& vvect2)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarProdOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator*(const typename ExprTraits<ExprT>::Scalar& scalar,
+          const MatrixExpr<ExprT>& matrix)
 {
-  VectorX<T, rows> prod;
-  for (uint8_t row = 1; row <= rows; ++row)
-    prod(row) = vvect1(row) * vvect2(row);
-  return prod;
+  using Op = ScalarProdOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t cols>
-Matrix<T, 1, cols> operator*(const Matrix<T, 1, cols>& hvect1,
-                             const Matrix<T, 1, cols>& hvect2)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarProdOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator*(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar)
 {
-  Matrix<T, 1, cols> prod;
-  for (uint8_t col = 1; col <= cols; ++col)
-    prod(col) = hvect1(col) * hvect2(col);
-  return prod;
+  using Op = ScalarProdOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols>
-Matrix<T, rows, cols> operator/(const Matrix<T, rows, cols>& matrix, const T& scalar)
+template <class ExprT>
+constexpr CwiseUnaryExpr<ScalarQuotOp<typename ExprTraits<ExprT>::Scalar>, ExprT>
+operator/(const MatrixExpr<ExprT>& matrix,
+          const typename ExprTraits<ExprT>::Scalar& scalar)
 {
-  Matrix<T, rows, cols> result;
-  for (uint8_t row = 1; row <= rows; ++row)
-    for (uint8_t col = 1; col <= cols; ++col)
-      result(row, col) = matrix(row, col) / scalar;
-  return result;
+  using Op = ScalarQuotOp<typename ExprTraits<ExprT>::Scalar>;
+  return CwiseUnaryExpr<Op, ExprT>(matrix.Self(), Op{scalar});
 }
 
-template <typename T, uint8_t rows, uint8_t cols1, uint8_t cols2>
-Matrix<T, rows, cols1 + cols2> HorzCat(const Matrix<T, rows, cols1>& matrix_lx,
-                                       const Matrix<T, rows, cols2>& matrix_rx)
+template <class LhsT, class RhsT>
+Matrix<typename ExprTraits<LhsT>::Scalar, ExprTraits<LhsT>::kRows,
+       ExprTraits<LhsT>::kCols + ExprTraits<RhsT>::kCols>
+HorzCat(const MatrixExpr<LhsT>& matrix_lx, const MatrixExpr<RhsT>& matrix_rx)
 {
-  Matrix<T, rows, cols1 + cols2> result;
-
-  for (uint8_t row = 1; row <= rows; ++row)
-  {
-    uint8_t col;
-    for (col = 1; col <= cols1; ++col)
-      result(row, col) = matrix_lx(row, col);
-    for (col = 1; col <= cols2; ++col)
-      result(row, col + cols1) = matrix_rx(row, col);
-  }
+  static_assert(ExprTraits<LhsT>::kRows == ExprTraits<RhsT>::kRows,
+                "ERROR: matrix dimensions mismatch in HorzCat()!");
+  Matrix<typename ExprTraits<LhsT>::Scalar, ExprTraits<LhsT>::kRows,
+         ExprTraits<LhsT>::kCols + ExprTraits<RhsT>::kCols>
+    result;
+  result.SetBlock(1, 1, matrix_lx);
+  result.SetBlock(1, ExprTraits<LhsT>::kCols + 1, matrix_rx);
   return result;
 }
 
-template <typename T, uint8_t rows1, uint8_t rows2, uint8_t cols>
-Matrix<T, rows1 + rows2, cols> VertCat(const Matrix<T, rows1, cols>& matrix_up,
-                                       const Matrix<T, rows2, cols>& matrix_down)
+template <class UpT, class DownT>
+Matrix<typename ExprTraits<UpT>::Scalar,
+       ExprTraits<UpT>::kRows + ExprTraits<DownT>::kRows, ExprTraits<UpT>::kCols>
+VertCat(const MatrixExpr<UpT>& matrix_up, const MatrixExpr<DownT>& matrix_down)
 {
-  Matrix<T, rows1 + rows2, cols> result;
-  for (uint8_t col = 1; col <= cols; ++col)
-  {
-    uint8_t row;
-    for (row = 1; row <= rows1; ++row)
-      result(row, col) = matrix_up(row, col);
-    for (row = 1; row <= rows2; ++row)
-      result(row + rows1, col) = matrix_down(row, col);
-  }
+  static_assert(ExprTraits<UpT>::kCols == ExprTraits<DownT>::kCols,
+                "ERROR: matrix dimensions mismatch in VertCat()!");
+  Matrix<typename ExprTraits<UpT>::Scalar,
+         ExprTraits<UpT>::kRows + ExprTraits<DownT>::kRows, ExprTraits<UpT>::kCols>
+    result;
+  result.SetBlock(1, 1, matrix_up);
+  result.SetBlock(ExprTraits<UpT>::kRows + 1, 1, matrix_down);
   return result;
 }
 
-template <typename T, uint8_t dim>
-T Dot(const VectorX<T, dim>& vvect1, const VectorX<T, dim>& vvect2)
+template <class LhsT, class RhsT>
+typename ExprTraits<LhsT>::Scalar Dot(const MatrixExpr<LhsT>& vect1,
+                                      const MatrixExpr<RhsT>& vect2)
 {
-  T result = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
-  {
-    result += vvect1(i) * vvect2(i);
-  }
+  static_assert((ExprTraits<LhsT>::kRows == 1 || ExprTraits<LhsT>::kCols == 1 ||
+                 IsDynamic<LhsT>::value) &&
+                  (ExprTraits<RhsT>::kRows == 1 || ExprTraits<RhsT>::kCols == 1 ||
+                   IsDynamic<RhsT>::value),
+                "ERROR: Dot() is defined only for vectors!");
+  static_assert(ExprTraits<LhsT>::kRows * ExprTraits<LhsT>::kCols ==
+                    ExprTraits<RhsT>::kRows * ExprTraits<RhsT>::kCols ||
+                  IsDynamic<LhsT>::value || IsDynamic<RhsT>::value,
+                "ERROR: vector dimensions mismatch in Dot()!");
+  assert(vect1.Self().Rows() == 1 || vect1.Self().Cols() == 1);
+  assert(vect1.Self().Rows() * vect1.Self().Cols() ==
+         vect2.Self().Rows() * vect2.Self().Cols());
+  typename ExprTraits<LhsT>::Scalar result = 0;
+  const uint32_t dim = static_cast<uint32_t>(vect1.Self().Rows()) * vect1.Self().Cols();
+  for (uint32_t i = 0; i < dim; ++i)
+    result += vect1.Self().Coeff(i) * vect2.Self().Coeff(i);
   return result;
 }
 
-template <typename T, uint8_t dim>
-T Dot(const Matrix<T, 1, dim>& hvect, const VectorX<T, dim>& vvect)
+template <class ExprT> double Norm(const MatrixExpr<ExprT>& vect)
 {
-  T result = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
+  static_assert(ExprTraits<ExprT>::kRows == 1 || ExprTraits<ExprT>::kCols == 1 ||
+                  IsDynamic<ExprT>::value,
+                "ERROR: Norm() is defined only for vectors!");
+  assert(vect.Self().Rows() == 1 || vect.Self().Cols() == 1);
+  typename ExprTraits<ExprT>::Scalar result = 0;
+  const uint32_t dim = static_cast<uint32_t>(vect.Self().Rows()) * vect.Self().Cols();
+  for (uint32_t i = 0; i < dim; ++i)
   {
-    result += hvect(i) * vvect(i);
+    const typename ExprTraits<ExprT>::Scalar value = vect.Self().Coeff(i);
+    result += value * value;
   }
-  return result;
-}
-
-template <typename T, uint8_t dim> double Norm(const VectorX<T, dim>& vvect)
-{
-  T result = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
-    result += vvect(i) * vvect(i);
   return sqrt(result);
 }
 
-template <typename T, uint8_t dim> double Norm(const Matrix<T, 1, dim>& hvect)
+template <class LhsT, class RhsT>
+Vector3<typename ExprTraits<LhsT>::Scalar> Cross(const MatrixExpr<LhsT>& vvect3d1,
+                                                 const MatrixExpr<RhsT>& vvect3d2)
 {
-  T result = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
-    result += hvect(i) * hvect(i);
-  return sqrt(result);
-}
-
-template <typename T>
-Vector3<T> Cross(const Vector3<T>& vvect3d1, const Vector3<T>& vvect3d2)
-{
-  return Skew(vvect3d1) * vvect3d2;
+  static_assert(ExprTraits<LhsT>::kRows == 3 && ExprTraits<LhsT>::kCols == 1 &&
+                  ExprTraits<RhsT>::kRows == 3 && ExprTraits<RhsT>::kCols == 1,
+                "ERROR: Cross() is defined only for 3D vertical vectors!");
+  using T = typename ExprTraits<LhsT>::Scalar;
+  // Each operand is read once, so that expressions are not evaluated twice.
+  const T a1 = vvect3d1.Self().Coeff(0), a2 = vvect3d1.Self().Coeff(1),
+          a3 = vvect3d1.Self().Coeff(2);
+  const T b1 = vvect3d2.Self().Coeff(0), b2 = vvect3d2.Self().Coeff(1),
+          b3 = vvect3d2.Self().Coeff(2);
+  Vector3<T> result;
+  result(1) = a2 * b3 - a3 * b2;
+  result(2) = a3 * b1 - a1 * b3;
+  result(3) = a1 * b2 - a2 * b1;
+  return result;
 }
 
-template <typename T> Matrix3<T> Skew(const Vector3<T>& vvect3d)
+template <class ExprT>
+Matrix3<typename ExprTraits<ExprT>::Scalar> Skew(const MatrixExpr<ExprT>& vvect3d)
 {
-  Matrix3<T> result;
+  static_assert(ExprTraits<ExprT>::kRows == 3 && ExprTraits<ExprT>::kCols == 1,
+                "ERROR: Skew() is defined only for 3D vertical vectors!");
+  Matrix3<typename ExprTraits<ExprT>::Scalar> result;
   result(1, 1) = 0;
   result(2, 2) = 0;
   result(3, 3) = 0;
@@ -310,12 +326,10 @@ Matrix<T, rows - 1, cols - 1> GetCofactor(const Matrix<T, rows, cols>& matrix,
   return cofactor;
 }
 
-template <typename T, uint8_t dim> T Det(const Matrix<T, dim, dim>& matrix)
+// Determinant by cofactors expansion along the first row.
+template <typename T, uint8_t dim>
+T Det(const Matrix<T, dim, dim>& matrix, std::false_type /*use_lu*/)
 {
-  //  Base case : if matrix contains single element
-  if (dim == 1)
-    return matrix(1, 1);
-
   int8_t sign = 1; // to store sign multiplier
   T det = 0;       // initialize result
   // Iterate for each element of first row
@@ -330,6 +344,34 @@ template <typename T, uint8_t dim> T Det(const Matrix<T, dim, dim>& matrix)
   return det;
 }
 
+// Determinant by LU factorization.
+template <typename T, uint8_t dim>
+T Det(const Matrix<T, dim, dim>& matrix, std::true_type /*use_lu*/)
+{
+  // Integer matrices are factorized in double precision.
+  using Real =
+    typename std::conditional<std::is_floating_point<T>::value, T, double>::type;
+  const Real det = LU<Real, dim>(Matrix<Real, dim, dim>(matrix)).Det();
+  return std::is_floating_point<T>::value ? static_cast<T>(det)
+                                          : static_cast<T>(std::round(det));
+}
+
+template <typename T, uint8_t dim> T Det(const Matrix<T, dim, dim>& matrix)
+{
+  return Det(matrix, std::integral_constant<bool, (dim >= 6)>());
+}
+
+template <typename T> T Det(const Matrix<T, 1, 1>& matrix) { return matrix(1, 1); }
+
+template <class ExprT>
+typename ExprTraits<ExprT>::Scalar Det(const MatrixExpr<ExprT>& matrix)
+{
+  static_assert(ExprTraits<ExprT>::kRows == ExprTraits<ExprT>::kCols &&
+                  !IsDynamic<ExprT>::value,
+                "ERROR: Det() is defined only for fixed-size square matrices!");
+  return Det(matrix.Self().Eval());
+}
+
 template <typename T, uint8_t dim>
 MatrixXd<dim, dim> Cholesky(const Matrix<T, dim, dim>& A)
 {
@@ -353,20 +395,34 @@ MatrixXd<dim, dim> Cholesky(const Matrix<T, dim, dim>& A)
   return L;
 }
 
-template <typename T, uint8_t dim> double Mean(const VectorX<T, dim>& vvect)
+template <class ExprT>
+MatrixXd<ExprTraits<ExprT>::kRows, ExprTraits<ExprT>::kCols>
+Cholesky(const MatrixExpr<ExprT>& matrix)
 {
-  T sum = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
-    sum += vvect(i);
+  static_assert(ExprTraits<ExprT>::kRows == ExprTraits<ExprT>::kCols &&
+                  !IsDynamic<ExprT>::value,
+                "ERROR: Cholesky() is defined only for fixed-size square matrices!");
+  return Cholesky(matrix.Self().Eval());
+}
+
+template <class ExprT> double Mean(const MatrixExpr<ExprT>& vvect)
+{
+  static_assert(ExprTraits<ExprT>::kCols == 1,
+                "ERROR: Mean() is defined only for vertical vectors!");
+  typename ExprTraits<ExprT>::Scalar sum = 0;
+  const uint16_t dim = vvect.Self().Rows() * vvect.Self().Cols();
+  for (uint16_t i = 0; i < dim; ++i)
+    sum += vvect.Self().Coeff(i);
   return static_cast<double>(sum) / static_cast<double>(dim);
 }
 
-template <typename T, uint8_t dim> double Std(const VectorX<T, dim>& vvect)
+template <class ExprT> double Std(const MatrixExpr<ExprT>& vvect)
 {
   double mean = Mean(vvect);
   double sum = 0;
-  for (uint8_t i = 1; i <= dim; ++i)
-    sum += SQUARE(vvect(i) - mean);
+  const uint16_t dim = vvect.Self().Rows() * vvect.Self().Cols();
+  for (uint16_t i = 0; i < dim; ++i)
+    sum += SQUARE(vvect.Self().Coeff(i) - mean);
   return sqrt(static_cast<double>(sum) / static_cast<double>(dim));
 }
 
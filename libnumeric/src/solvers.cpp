@@ -18,33 +18,7 @@ VectorX<T, dim> Linsolve(const Matrix<T, dim, dim>& _mat, const VectorX<T, dim>&
 {
   static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in LinSolve()!");
 
-  Matrix<T, dim, dim>& mat(_mat);
-  VectorX<T, dim>& vect(_vect);
-  for (uint8_t i = 1; i < dim; ++i)
-  {
-    uint8_t max_idx = i;
-    T max_val = mat(i, i);
-    for (uint8_t j = i + 1; j <= dim; ++j)
-    {
-      if (fabs(mat(j, i)) > fabs(max_val))
-      {
-        max_val = mat(j, i);
-        max_idx = j;
-      }
-    }
-    mat.SwapRow(i, max_idx);
-    vect.SwapRow(i, max_idx);
-    for (uint8_t j = i + 1; j <= dim; ++j)
-    {
-      T m = mat(j, i) / mat(i, i);
-      vect(j) -= vect(i) * m;
-      for (uint8_t k = i; k <= dim; ++k)
-      {
-        mat(j, k) -= mat(i, k) * m;
-      }
-    }
-  }
-  return LinsolveUp(mat, vect);
+  return LU<T, dim>(_mat).Solve(_vect);
 }
 
 template <typename T, uint8_t dim>
@@ -53,33 +27,15 @@ void Linsolve(const Matrix<T, dim, dim>& _mat, const VectorX<T, dim>& _vect,
 {
   static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in LinSolve()!");
 
-  Matrix<T, dim, dim>& mat(_mat);
-  VectorX<T, dim>& vect(_vect);
-  for (uint8_t i = 1; i < dim; ++i)
-  {
-    uint8_t max_idx = i;
-    T max_val = mat(i, i);
-    for (uint8_t j = i + 1; j <= dim; ++j)
-    {
-      if (fabs(mat(j, i)) > fabs(max_val))
-      {
-        max_val = mat(j, i);
-        max_idx = j;
-      }
-    }
-    mat.SwapRow(i, max_idx);
-    vect.SwapRow(i, max_idx);
-    for (uint8_t j = i + 1; j <= dim; ++j)
-    {
-      T m = mat(j, i) / mat(i, i);
-      vect(j) -= vect(i) * m;
-      for (uint8_t k = i; k <= dim; ++k)
-      {
-        mat(j, k) -= mat(i, k) * m;
-      }
-    }
-  }
-  LinsolveUp(mat, vect, result);
+  result = LU<T, dim>(_mat).Solve(_vect);
+}
+
+template <typename T, class ExprT>
+MatrixX<T> Linsolve(const SparseMatrix<T>& mat, const MatrixExpr<ExprT>& vect)
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in LinSolve()!");
+
+  return SparseLU<T>(mat).Solve(vect);
 }
 
 template <typename T, uint8_t dim>
@@ -122,28 +78,48 @@ void LinsolveUp(const Matrix<T, dim, dim>& mat, const VectorX<T, dim>& vect,
 
 template <typename T, uint8_t dim>
 int NonLinsolveJacobian(void (*fun_ptr)(VectorX<T, dim>&, Matrix<T, dim, dim>&,
-                const VectorX<T, dim>&), VectorX<T, dim>& solution,
-                const uint8_t nmax /*= 100*/)
+                                        const VectorX<T, dim>&),
+                        VectorX<T, dim>& solution, const uint8_t nmax /*= 100*/)
 {
-  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in NonLinsolveJacobian()!");
+  NewtonWorkspace<T, dim> workspace;
+  return NonLinsolveJacobian(fun_ptr, solution, workspace, nmax);
+}
+
+template <typename T, uint8_t dim, class FunT>
+int NonLinsolveJacobian(FunT&& fun, VectorX<T, dim>& solution,
+                        const uint8_t nmax /*= 100*/)
+{
+  NewtonWorkspace<T, dim> workspace;
+  return NonLinsolveJacobian(std::forward<FunT>(fun), solution, workspace, nmax);
+}
+
+template <typename T, uint8_t dim, class FunT>
+int NonLinsolveJacobian(FunT&& fun, VectorX<T, dim>& solution,
+                        NewtonWorkspace<T, dim>& workspace, const uint8_t nmax /*= 100*/)
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in NonLinsolveJacobian()!");
 
   static const T ftol = 1e-9;
   static const T xtol = 1e-7;
   uint8_t iter = 0;
   T err = 1.0;
   T cond = 0.0;
-  VectorX<T, dim> F;
-  VectorX<T, dim> s;
-  Matrix<T, dim, dim> J;
+  VectorX<T, dim>& F     = workspace.residual;
+  VectorX<T, dim>& s     = workspace.step;
+  Matrix<T, dim, dim>& J = workspace.jacobian;
 
-  fun_ptr(F, J, solution);
+  fun(F, J, solution);
 
   while (iter < nmax && Norm(F) > ftol && err > cond)
   {
+    workspace.lu.Compute(J);
+    if (!workspace.lu.IsInvertible(0.0))
+      break;
     iter++;
-    Linsolve(J, s, F);
+    s = workspace.lu.Solve(F);
     solution -= s;
-    fun_ptr(F, J, solution);
+    fun(F, J, solution);
     err = Norm(s);
     cond = xtol * (1 + Norm(solution));
   }
@@ -154,6 +130,21 @@ int NonLinsolveJacobian(void (*fun_ptr)(VectorX<T, dim>&, Matrix<T, dim, dim>&,
 template <typename T, uint8_t dim>
 int fsolveB(void (*fun_ptr)(VectorX<T, dim>&, const VectorX<T, dim>&),
             VectorX<T, dim>& solution, const uint8_t nmax /*= 100*/)
+{
+  BroydenWorkspace<T, dim> workspace;
+  return fsolveB(fun_ptr, solution, workspace, nmax);
+}
+
+template <typename T, uint8_t dim, class FunT>
+int fsolveB(FunT&& fun, VectorX<T, dim>& solution, const uint8_t nmax /*= 100*/)
+{
+  BroydenWorkspace<T, dim> workspace;
+  return fsolveB(std::forward<FunT>(fun), solution, workspace, nmax);
+}
+
+template <typename T, uint8_t dim, class FunT>
+int fsolveB(FunT&& fun, VectorX<T, dim>& solution, BroydenWorkspace<T, dim>& workspace,
+            const uint8_t nmax /*= 100*/)
 {
   static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in fsolveB()!");
 
@@ -162,21 +153,24 @@ int fsolveB(void (*fun_ptr)(VectorX<T, dim>&, const VectorX<T, dim>&),
   uint8_t iter = 0;
   T err = 1.0;
   T cond = 0.0;
-  VectorX<T, dim> F;
-  VectorX<T, dim> s;
-  Matrix<T, dim, dim> B;
+  VectorX<T, dim>& F     = workspace.residual;
+  VectorX<T, dim>& s     = workspace.step;
+  Matrix<T, dim, dim>& B = workspace.jacobian;
 
-  fun_ptr(F, solution);
-  B.Identity();
-  B -= (F * F.Transpose()) / (Dot(F, F));
+  fun(F, solution);
+  B.SetIdentity();
 
   while (iter < nmax && Norm(F) > ftol && err > cond)
   {
+    workspace.lu.Compute(B);
+    if (!workspace.lu.IsInvertible(0.0))
+      break;
     iter++;
-    Linsolve(B, s, F);
+    s = workspace.lu.Solve(F);
     solution -= s;
-    fun_ptr(F, solution);
-    B += (F * s.Transpose()) / (Dot(s, s));
+    fun(F, solution);
+    // Broyden update with secant step -s, whose residual change is F - B * (-s) = F.
+    B -= (F * s.Transpose()) / (Dot(s, s));
     err = Norm(s);
     cond = xtol * (1 + Norm(solution));
   }
@@ -184,48 +178,517 @@ int fsolveB(void (*fun_ptr)(VectorX<T, dim>&, const VectorX<T, dim>&),
   return iter;
 }
 
-template <typename T, uint8_t dim, size_t t_steps>
-void RKSolver(void (*fun_ptr)(const T, const VectorX<T, dim>, VectorX<T, dim>),
+template <uint8_t rows, typename T, uint8_t cols, class FunT>
+SolverReport<T>
+LevenbergMarquardt(FunT&& fun, VectorX<T, cols>& solution,
+                   const LevMarOptions<T>& options /*= LevMarOptions<T>()*/)
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in LevenbergMarquardt()!");
+  using Clock = std::chrono::steady_clock;
+
+  const Clock::time_point start = Clock::now();
+  SolverReport<T> report{NUMERIC_FAILURE, 0, 1, 0, 0, 0.0};
+  VectorX<T, rows> F, F_new;
+  Matrix<T, rows, cols> J, J_new;
+  VectorX<T, cols> x_new;
+
+  fun(F, J, solution);
+  T cost = static_cast<T>(0.5) * Dot(F, F);
+  if (!std::isfinite(cost))
+    return report;
+  Matrix<T, cols, cols> JtJ = J.Transpose() * J;
+  VectorX<T, cols> grad     = J.Transpose() * F;
+
+  T max_diag = 0;
+  for (uint8_t i = 1; i <= cols; ++i)
+    max_diag = std::max(max_diag, JtJ(i, i));
+  T mu = options.damping * (max_diag > 0 ? max_diag : 1);
+  T nu = 2;
+
+  while (true)
+  {
+    T grad_norm = 0;
+    for (uint8_t i = 1; i <= cols; ++i)
+      grad_norm = std::max(grad_norm, std::fabs(grad(i)));
+    if (std::sqrt(2 * cost) <= options.ftol)
+    {
+      report.status = CONVERGED_RESIDUAL;
+      break;
+    }
+    if (grad_norm <= options.gtol)
+    {
+      report.status = CONVERGED_GRADIENT;
+      break;
+    }
+    if (report.iterations >= options.max_iter)
+    {
+      report.status = MAX_ITERATIONS;
+      break;
+    }
+    if (options.max_time > 0.0 &&
+        std::chrono::duration<double>(Clock::now() - start).count() >= options.max_time)
+    {
+      report.status = MAX_TIME;
+      break;
+    }
+
+    report.iterations++;
+    Matrix<T, cols, cols> damped_JtJ = JtJ;
+    for (uint8_t i = 1; i <= cols; ++i)
+      damped_JtJ(i, i) += mu;
+    const VectorX<T, cols> step = -LU<T, cols>(damped_JtJ).Solve(grad);
+    if (Norm(step) <= options.xtol * (Norm(solution) + options.xtol))
+    {
+      report.status = CONVERGED_STEP;
+      break;
+    }
+
+    x_new = solution + step;
+    fun(F_new, J_new, x_new);
+    report.evaluations++;
+    const T new_cost = static_cast<T>(0.5) * Dot(F_new, F_new);
+    // Gain ratio between actual and predicted (by the linear model) decrease.
+    const T predicted = static_cast<T>(0.5) * Dot(step, mu * step - grad);
+    const T gain      = (cost - new_cost) / predicted;
+    if (std::isfinite(new_cost) && gain > 0)
+    {
+      solution = x_new;
+      F        = F_new;
+      J        = J_new;
+      cost     = new_cost;
+      JtJ      = J.Transpose() * J;
+      grad     = J.Transpose() * F;
+      const T shrink = 2 * gain - 1;
+      mu *= std::max(static_cast<T>(1) / 3, 1 - shrink * shrink * shrink);
+      nu = 2;
+    }
+    else
+    {
+      // Rejected step: retry closer to gradient descent.
+      mu *= nu;
+      nu *= 2;
+    }
+  }
+
+  report.residual_norm = std::sqrt(2 * cost);
+  report.damping       = mu;
+  report.elapsed       = std::chrono::duration<double>(Clock::now() - start).count();
+  return report;
+}
+
+template <typename T, uint8_t rows, uint8_t cols>
+SolverReport<T>
+LevenbergMarquardt(void (*fun_ptr)(VectorX<T, rows>&, Matrix<T, rows, cols>&,
+                                   const VectorX<T, cols>&),
+                   VectorX<T, cols>& solution,
+                   const LevMarOptions<T>& options /*= LevMarOptions<T>()*/)
+{
+  return LevenbergMarquardt<rows>(fun_ptr, solution, options);
+}
+
+template <typename T, uint8_t n, uint8_t m>
+SolverReport<T> QuadProg(const Matrix<T, n, n>& hessian, const VectorX<T, n>& gradient,
+                         const Matrix<T, m, n>& eq_mat, const VectorX<T, m>& eq_vect,
+                         const VectorX<T, n>& lower, const VectorX<T, n>& upper,
+                         VectorX<T, n>& solution, QPWorkspace<T, n, m>& workspace,
+                         const QPOptions<T>& options /*= QPOptions<T>()*/)
+{
+  static_assert(std::is_floating_point<T>::value, "ERROR: invalid type in QuadProg()!");
+  using Clock = std::chrono::steady_clock;
+  // Full exchanges allowed without reducing the number of violations before falling
+  // back to single ones.
+  static constexpr uint8_t kMaxStalls = 3;
+
+  const Clock::time_point start = Clock::now();
+  T max_diag = 0;
+  for (uint8_t i = 1; i <= n; ++i)
+    max_diag = std::max(max_diag, hessian(i, i));
+  const T delta = options.regularization * (max_diag > 0 ? max_diag : 1);
+  SolverReport<T> report{NUMERIC_FAILURE, 0, 0, 0, delta, 0.0};
+
+  // The rows of the constraints do not depend on the active set.
+  Matrix<T, n + m, n + m>& kkt = workspace.kkt;
+  VectorX<T, n + m> rhs;
+  for (uint8_t j = 1; j <= m; ++j)
+  {
+    for (uint8_t k = 1; k <= n; ++k)
+      kkt(n + j, k) = eq_mat(j, k);
+    for (uint8_t k = 1; k <= m; ++k)
+      kkt(n + j, n + k) = j == k ? -delta : 0;
+    rhs(n + j) = eq_vect(j);
+  }
+
+  uint8_t min_violations = n + 1;
+  uint8_t stalls         = 0;
+  while (true)
+  {
+    if (report.iterations >= options.max_iter)
+    {
+      report.status = MAX_ITERATIONS;
+      break;
+    }
+    if (options.max_time > 0.0 &&
+        std::chrono::duration<double>(Clock::now() - start).count() >= options.max_time)
+    {
+      report.status = MAX_TIME;
+      break;
+    }
+    report.iterations++;
+
+    // KKT system of the equality-constrained problem, with fixed variables replaced by
+    // the trivial equations x_i = bound_i.
+    for (uint8_t i = 1; i <= n; ++i)
+    {
+      const int8_t active = workspace.active_set[i - 1];
+      for (uint8_t k = 1; k <= n; ++k)
+        kkt(i, k) = active ? (i == k ? 1 : 0) : hessian(i, k);
+      for (uint8_t j = 1; j <= m; ++j)
+        kkt(i, n + j) = active ? 0 : eq_mat(j, i);
+      rhs(i) = active < 0 ? lower(i) : (active > 0 ? upper(i) : -gradient(i));
+    }
+    workspace.lu.Compute(kkt);
+    if (!workspace.lu.IsInvertible(0.0))
+      break;
+    const VectorX<T, n + m> kkt_sol = workspace.lu.Solve(rhs);
+    for (uint8_t i = 1; i <= n; ++i)
+      solution(i) = kkt_sol(i);
+    for (uint8_t j = 1; j <= m; ++j)
+      workspace.eq_multipliers(j) = kkt_sol(n + j);
+    const VectorX<T, n> cost_grad = hessian * solution + gradient;
+    workspace.bound_multipliers =
+      cost_grad + eq_mat.Transpose() * workspace.eq_multipliers;
+    if (!std::isfinite(Dot(workspace.bound_multipliers, workspace.bound_multipliers)))
+      break;
+
+    T grad_scale = 0;
+    for (uint8_t i = 1; i <= n; ++i)
+      grad_scale = std::max(grad_scale, std::fabs(cost_grad(i)));
+    const T mult_tol = options.tol * (1 + grad_scale);
+    uint8_t violations = 0;
+    uint8_t last       = 0;
+    std::array<int8_t, n> next_set = workspace.active_set;
+    for (uint8_t i = 1; i <= n; ++i)
+    {
+      const int8_t active = workspace.active_set[i - 1];
+      const T mult        = workspace.bound_multipliers(i);
+      int8_t next         = active;
+      if (active == 0)
+        workspace.bound_multipliers(i) = 0;
+      if (active == 0 && solution(i) < lower(i) - options.tol * (1 + std::fabs(lower(i))))
+        next = -1;
+      else if (active == 0 &&
+               solution(i) > upper(i) + options.tol * (1 + std::fabs(upper(i))))
+        next = 1;
+      else if ((active < 0 && mult < -mult_tol) || (active > 0 && mult > mult_tol))
+        next = 0;
+      if (next != active)
+      {
+        next_set[i - 1] = next;
+        violations++;
+        last = i;
+      }
+    }
+    if (violations == 0)
+    {
+      report.status = CONVERGED_RESIDUAL;
+      break;
+    }
+
+    if (violations < min_violations)
+    {
+      min_violations = violations;
+      stalls         = 0;
+    }
+    else
+      stalls++;
+    if (stalls < kMaxStalls)
+      workspace.active_set = next_set;
+    else
+      // Murty's rule, as safeguard of the block pivoting: change only the violating
+      // variable with the largest index.
+      workspace.active_set[last - 1] = next_set[last - 1];
+  }
+
+  report.elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  if (report.status == NUMERIC_FAILURE)
+    return report;
+  report.residual_norm = Norm(eq_mat * solution - eq_vect);
+  if (report.status == CONVERGED_RESIDUAL &&
+      report.residual_norm > options.eqtol * (1 + Norm(eq_vect)))
+    report.status = INFEASIBLE;
+  return report;
+}
+
+template <typename T, uint8_t dim, uint8_t t_steps>
+void RKSolver(void (*fun_ptr)(const T, const VectorX<T, dim>&, VectorX<T, dim>&),
               const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
               Matrix<T, dim, t_steps>& sol)
+{
+  RKWorkspace<T, dim> workspace;
+  RKSolver(fun_ptr, time, y0, sol, workspace);
+}
+
+template <typename T, uint8_t dim, uint8_t t_steps, class FunT>
+void RKSolver(FunT&& fun, const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
+              Matrix<T, dim, t_steps>& sol)
+{
+  RKWorkspace<T, dim> workspace;
+  RKSolver(std::forward<FunT>(fun), time, y0, sol, workspace);
+}
+
+template <typename T, uint8_t dim, uint8_t t_steps, class FunT>
+void RKSolver(FunT&& fun, const VectorX<T, t_steps>& time, const VectorX<T, dim>& y0,
+              Matrix<T, dim, t_steps>& sol, RKWorkspace<T, dim>& workspace)
 {
   static constexpr uint8_t rk_dim = 6;
-  static const VectorX<T, rk_dim> c(
-    std::vector<T>{0., 0.25, 0.375, 12. / 13., 1., 0.5});
-  static const VectorX<T, rk_dim> b(
-    std::vector<T>{16. / 135., 0., 6656. / 12825., 28561. / 56430., -0.18, 2. / 5.});
-  static const Matrix<T, rk_dim, rk_dim> rk_mat(std::vector<T>{
-                                                  0., 0., 0., 0., 0., 0.,
-                                                  0.25, 0., 0., 0., 0., 0,
-                                                  0.09375, 0, 28125, 0., 0., 0., 0.,
-                                                  1932. / 2197., -7200. / 2197., 7296. / 2197., 0., 0., 0.,
-                                                  439. / 216., -8., 3680. / 513., -845. / 4104., 0, 0,
-                                                  -8. / 27., 2., -3544. / 2565., 1859. / 4104., -0.275, 0.});
+  // Butcher tableau of the method, built at compile time.
+  static constexpr VectorX<T, rk_dim> c = {0., 0.25, 0.375, 12. / 13., 1., 0.5};
+  static constexpr VectorX<T, rk_dim> b = {
+    16. / 135., 0., 6656. / 12825., 28561. / 56430., -9. / 50., 2. / 55.};
+  static constexpr Matrix<T, rk_dim, rk_dim> rk_mat = {
+    0.,            0.,             0.,             0.,            0.,     0.,
+    0.25,          0.,             0.,             0.,            0.,     0.,
+    3. / 32.,      9. / 32.,       0.,             0.,            0.,     0.,
+    1932. / 2197., -7200. / 2197., 7296. / 2197.,  0.,            0.,     0.,
+    439. / 216.,   -8.,            3680. / 513.,   -845. / 4104., 0.,     0.,
+    -8. / 27.,     2.,             -3544. / 2565., 1859. / 4104., -0.275, 0.};
 
   // Initialize
-  Matrix<T, dim, rk_dim> K;
-  VectorX<T, dim> f, s, col;
+  Matrix<T, dim, rk_dim>& K = workspace.stages;
+  VectorX<T, dim>& f        = workspace.increment;
+  VectorX<T, dim>& s        = workspace.state;
+  VectorX<T, dim>& col      = workspace.derivative;
   T h = time(2) - time(1);
   sol.SetZero();
-  sol.SetCol(1, y0);
+  sol.Col(1) = y0;
 
   // Solve
-  for (size_t i = 2; i <= t_steps; ++i)
+  for (uint8_t i = 2; i <= t_steps; ++i)
   {
     f.SetZero();
     for (uint8_t j = 1; j <= rk_dim; ++j)
     {
-      s.SetZero();
+      s = sol.Col(i - 1);
       for (uint8_t k = 1; k <= j - 1; ++k)
-        {
-          s += rk_mat(j, k) * K.getCol(k);
-        }
-      fun_ptr(time(i - 1) + h * c(j), sol.GetCol(i - 1) + h * s, col);
-      K.SetCol(j, col);
+      {
+        s += (h * rk_mat(j, k)) * K.Col(k);
+      }
+      fun(time(i - 1) + h * c(j), s, col);
+      K.Col(j) = col;
       f += b(j) * col;
     }
-    sol.SetCol(i, sol.GetCol(i - 1) + h * f);
+    sol.Col(i) = sol.Col(i - 1) + h * f;
+  }
+}
+
+template <typename T, uint8_t dim>
+VectorX<T, dim> DenseOutput<T, dim>::Evaluate(const T time) const
+{
+  const T theta  = (time - start_time_) / step_;
+  const T theta1 = 1 - theta;
+  return coeffs_[0] +
+         theta * (coeffs_[1] +
+                  theta1 * (coeffs_[2] + theta * (coeffs_[3] + theta1 * coeffs_[4])));
+}
+
+template <typename T, uint8_t dim, class FunT, class CallbackT>
+ODEReport<T> DormandPrince(FunT&& fun, const T start_time, const T end_time,
+                           VectorX<T, dim>& state, const ODEOptions<T>& options,
+                           CallbackT&& callback)
+{
+  static_assert(std::is_floating_point<T>::value,
+                "ERROR: invalid type in DormandPrince()!");
+  if (end_time <= start_time)
+    throw std::invalid_argument("Final time must be greater than initial time!");
+  if (options.rel_tol <= 0 || options.abs_tol <= 0)
+    throw std::invalid_argument("Tolerances must be positive!");
+
+  // Butcher tableau of the method (Dormand & Prince, 1980), with the coefficients of
+  // the error estimate and of the continuous extension (Hairer et al., 1993).
+  static constexpr T c2 = 1. / 5., c3 = 3. / 10., c4 = 4. / 5., c5 = 8. / 9.;
+  static constexpr T a21 = 1. / 5.;
+  static constexpr T a31 = 3. / 40., a32 = 9. / 40.;
+  static constexpr T a41 = 44. / 45., a42 = -56. / 15., a43 = 32. / 9.;
+  static constexpr T a51 = 19372. / 6561., a52 = -25360. / 2187.,
+                     a53 = 64448. / 6561., a54 = -212. / 729.;
+  static constexpr T a61 = 9017. / 3168., a62 = -355. / 33., a63 = 46732. / 5247.,
+                     a64 = 49. / 176., a65 = -5103. / 18656.;
+  static constexpr T a71 = 35. / 384., a73 = 500. / 1113., a74 = 125. / 192.,
+                     a75 = -2187. / 6784., a76 = 11. / 84.;
+  static constexpr T e1 = 71. / 57600., e3 = -71. / 16695., e4 = 71. / 1920.,
+                     e5 = -17253. / 339200., e6 = 22. / 525., e7 = -1. / 40.;
+  static constexpr T d1 = -12715105075. / 11282082432., d3 = 87487479700. / 32700410799.,
+                     d4 = -10690763975. / 1880347072., d5 = 701980252875. / 199316789632.,
+                     d6 = -1453857185. / 822651844., d7 = 69997945. / 29380423.;
+  // Step size controller.
+  static constexpr T kSafety = 0.9, kMinScale = 0.2, kMaxScale = 10.;
+
+  ODEReport<T> report{END_REACHED, start_time, 0, 0, 0, 1};
+  VectorX<T, dim> k1, k2, k3, k4, k5, k6, k7, y_new, error;
+  DenseOutput<T, dim> dense;
+
+  // Weighted RMS norm of a vector, relative to the tolerances.
+  auto scaled_norm = [&options](const VectorX<T, dim>& vect, const VectorX<T, dim>& y1,
+                                const VectorX<T, dim>& y2) {
+    T sum = 0;
+    for (uint8_t i = 1; i <= dim; ++i)
+    {
+      const T scale =
+        options.abs_tol + options.rel_tol * std::max(std::fabs(y1(i)), std::fabs(y2(i)));
+      sum += (vect(i) / scale) * (vect(i) / scale);
+    }
+    return std::sqrt(sum / dim);
+  };
+
+  T& t = report.time;
+  fun(t, state, k1);
+  T h = options.initial_step;
+  if (h <= 0)
+  {
+    // Initial guess such that an explicit Euler step would roughly meet the tolerances.
+    const T state_norm = scaled_norm(state, state, state);
+    const T deriv_norm = scaled_norm(k1, state, state);
+    const T h0         = (state_norm < 1e-5 || deriv_norm < 1e-5)
+                   ? static_cast<T>(1e-6)
+                   : static_cast<T>(0.01) * state_norm / deriv_norm;
+    y_new = state + h0 * k1;
+    fun(t + h0, y_new, k2);
+    report.evaluations++;
+    const T curvature = std::max(deriv_norm, scaled_norm(k2 - k1, state, state) / h0);
+    const T h1        = curvature <= 1e-15
+                   ? std::max(static_cast<T>(1e-6), h0 * static_cast<T>(1e-3))
+                   : std::pow(static_cast<T>(0.01) / curvature, static_cast<T>(0.2));
+    h = std::min(100 * h0, h1);
+  }
+  if (options.max_step > 0)
+    h = std::min(h, options.max_step);
+
+  bool last_rejected = false;
+  while (t < end_time)
+  {
+    if (report.accepted_steps + report.rejected_steps >= options.max_steps)
+    {
+      report.status = MAX_STEPS;
+      break;
+    }
+    if (h < 10 * std::numeric_limits<T>::epsilon() * std::max(std::fabs(t), T(1)))
+    {
+      report.status = STEP_UNDERFLOW;
+      break;
+    }
+    // Do not overshoot, nor leave a tiny last step.
+    const bool last_step = t + static_cast<T>(1.01) * h >= end_time;
+    if (last_step)
+      h = end_time - t;
+
+    y_new = state + (h * a21) * k1;
+    fun(t + c2 * h, y_new, k2);
+    y_new = state + h * (a31 * k1 + a32 * k2);
+    fun(t + c3 * h, y_new, k3);
+    y_new = state + h * (a41 * k1 + a42 * k2 + a43 * k3);
+    fun(t + c4 * h, y_new, k4);
+    y_new = state + h * (a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4);
+    fun(t + c5 * h, y_new, k5);
+    y_new = state + h * (a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 + a65 * k5);
+    fun(t + h, y_new, k6);
+    y_new = state + h * (a71 * k1 + a73 * k3 + a74 * k4 + a75 * k5 + a76 * k6);
+    fun(t + h, y_new, k7);
+    report.evaluations += 6;
+
+    error = h * (e1 * k1 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 + e7 * k7);
+    const T err = scaled_norm(error, state, y_new);
+    // Optimal scale of the step for a 5th-order local error, within safe bounds.
+    T scale = err > 0 ? kSafety * std::pow(err, static_cast<T>(-0.2)) : kMaxScale;
+    scale   = std::max(kMinScale, std::min(kMaxScale, scale));
+    if (!(err <= 1))
+    {
+      // Rejected (or not finite) error: retry with a smaller step.
+      report.rejected_steps++;
+      h *= std::isfinite(err) ? scale : kMinScale;
+      last_rejected = true;
+      continue;
+    }
+
+    // Accepted step: build its dense output, then reuse the last stage (FSAL).
+    dense.start_time_ = t;
+    dense.step_       = h;
+    dense.end_state_  = y_new;
+    dense.coeffs_[0]  = state;
+    dense.coeffs_[1]  = y_new - state;
+    dense.coeffs_[2]  = h * k1 - dense.coeffs_[1];
+    dense.coeffs_[3]  = dense.coeffs_[1] - h * k7 - dense.coeffs_[2];
+    dense.coeffs_[4] = h * (d1 * k1 + d3 * k3 + d4 * k4 + d5 * k5 + d6 * k6 + d7 * k7);
+    state            = y_new;
+    k1               = k7;
+    t                = last_step ? end_time : t + h;
+    report.last_step = h;
+    report.accepted_steps++;
+    if (!callback(dense))
+    {
+      report.status = INTERRUPTED;
+      break;
+    }
+
+    // Do not grow the step right after a rejection.
+    h *= last_rejected ? std::min(scale, static_cast<T>(1)) : scale;
+    last_rejected = false;
+    if (options.max_step > 0)
+      h = std::min(h, options.max_step);
+  }
+  return report;
+}
+
+template <typename T, uint8_t dim, class FunT>
+ODEReport<T> DormandPrince(FunT&& fun, const T start_time, const T end_time,
+                           VectorX<T, dim>& state,
+                           const ODEOptions<T>& options /*= ODEOptions<T>()*/)
+{
+  return DormandPrince(std::forward<FunT>(fun), start_time, end_time, state, options,
+                       [](const DenseOutput<T, dim>&) { return true; });
+}
+
+template <typename T, uint8_t dim, class FunT>
+void RK4Stepper<T, dim, FunT>::Step(const T time, VectorX<T, dim>& state, const T dt)
+{
+  const T half_dt = dt / 2;
+  fun_(time, state, k1_);
+  stage_ = state + half_dt * k1_;
+  fun_(time + half_dt, stage_, k2_);
+  stage_ = state + half_dt * k2_;
+  fun_(time + half_dt, stage_, k3_);
+  stage_ = state + dt * k3_;
+  fun_(time + dt, stage_, k4_);
+  state += (dt / 6) * (k1_ + 2 * (k2_ + k3_) + k4_);
+}
+
+template <typename T, uint8_t dim, class FunT>
+void SemiImplicitEulerStepper<T, dim, FunT>::Step(const T time, VectorX<T, dim>& state,
+                                                  const T dt)
+{
+  static constexpr uint8_t kHalf = dim / 2;
+  fun_(time, state, derivative_);
+  for (uint8_t i = 1; i <= kHalf; ++i)
+  {
+    state(kHalf + i) += dt * derivative_(kHalf + i);
+    state(i) += dt * state(kHalf + i);
+  }
+}
+
+template <typename T, uint8_t dim, class FunT>
+void VerletStepper<T, dim, FunT>::Step(const T time, VectorX<T, dim>& state, const T dt)
+{
+  static constexpr uint8_t kHalf = dim / 2;
+  const T half_dt                = dt / 2;
+  fun_(time, state, derivative_);
+  for (uint8_t i = 1; i <= kHalf; ++i)
+  {
+    state(kHalf + i) += half_dt * derivative_(kHalf + i);
+    state(i) += dt * state(kHalf + i);
   }
+  fun_(time + dt, state, derivative_);
+  for (uint8_t i = 1; i <= kHalf; ++i)
+    state(kHalf + i) += half_dt * derivative_(kHalf + i);
 }
 
 } // end namespace solvers
@@ -0,0 +1,83 @@
+/**
+ * @file vector_batch.tcc
+ * @author Simone Comari
+ * @date 15 Oct 2026
+ * @brief File containing definitions of the batch of 3D vectors and its kernels.
+ */
+
+#ifndef GRABCOMMON_LIBNUMERIC_VECTOR_BATCH_H
+#error Do not include this file directly, include vector_batch.h instead
+#endif
+
+#include <assert.h>
+
+namespace grabnum {
+
+//----- Vector3Batch -----------------------------------------------------------------//
+
+template <typename T, uint16_t size>
+Vector3<T> Vector3Batch<T, size>::Get(const uint16_t index) const
+{
+  assert(index >= 1 && index <= size);
+  return Vector3<T>({elements_[index - 1], elements_[kStride + index - 1],
+                     elements_[2 * kStride + index - 1]});
+}
+
+template <typename T, uint16_t size>
+Vector3Batch<T, size>& Vector3Batch<T, size>::Set(const uint16_t index,
+                                                  const Vector3<T>& vect)
+{
+  assert(index >= 1 && index <= size);
+  elements_[index - 1]               = vect(1);
+  elements_[kStride + index - 1]     = vect(2);
+  elements_[2 * kStride + index - 1] = vect(3);
+  return *this;
+}
+
+//----- Kernels ----------------------------------------------------------------------//
+
+template <typename T, uint16_t size>
+std::array<T, size> Dot(const Vector3Batch<T, size>& vects1,
+                        const Vector3Batch<T, size>& vects2)
+{
+  std::array<T, size> dot;
+  simd::Dot3(vects1.Data(), vects2.Data(), Vector3Batch<T, size>::kStride, dot.data(),
+             size);
+  return dot;
+}
+
+template <typename T, uint16_t size>
+Vector3Batch<T, size> Cross(const Vector3Batch<T, size>& vects1,
+                            const Vector3Batch<T, size>& vects2)
+{
+  // Padding lanes are crossed as well, they stay zero.
+  Vector3Batch<T, size> cross;
+  simd::Cross3(vects1.Data(), vects2.Data(), Vector3Batch<T, size>::kStride, cross.Data(),
+               Vector3Batch<T, size>::kStride);
+  return cross;
+}
+
+template <typename T, uint16_t size>
+std::array<T, size> Norm(const Vector3Batch<T, size>& vects)
+{
+  std::array<T, size> norm;
+  simd::Norm3(vects.Data(), Vector3Batch<T, size>::kStride, norm.data(), size);
+  return norm;
+}
+
+template <typename T, size_t size>
+std::array<T, size> Atan2(const std::array<T, size>& y, const std::array<T, size>& x)
+{
+  std::array<T, size> angles;
+  simd::Atan2(y.data(), x.data(), angles.data(), size);
+  return angles;
+}
+
+template <typename T, size_t size>
+void SinCos(const std::array<T, size>& angles, std::array<T, size>* sin,
+            std::array<T, size>* cos)
+{
+  simd::SinCos(angles.data(), sin->data(), cos->data(), size);
+}
+
+} //  end namespace grabnum
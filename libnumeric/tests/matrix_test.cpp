@@ -4,6 +4,8 @@
 
 #include "matrix.h"
 #include "matrix_utilities.h"
+#include "solvers.h"
+#include "vector_batch.h"
 #include "common.h"
 
 class TestMatrix : public QObject
@@ -41,6 +43,17 @@ private slots:
   void Operations();
 
   void Utilities();
+
+  void Kernels();
+
+  void Expressions();
+  void Views();
+  void DynamicMatrix();
+  void Sparse();
+  void Decompositions();
+  void VectorBatch();
+
+  void Solvers();
 };
 
 void TestMatrix::init()
@@ -97,6 +110,24 @@ void TestMatrix::Constructors()
     for (uint8_t j = 1; j <= m; ++j)
       QCOMPARE(mat_nxm_f4(i, j), std_vec[(i - 1) * m + (j - 1)]);
 
+  // Constructor from initializer list.
+  grabnum::MatrixXf<n, m> mat_nxm_f5 = {3.45f, 3.1f, 6.7f, 54.3f, 5.74f, 0.45f};
+  QVERIFY(mat_nxm_f5 == mat_nxm_f);
+  const std::array<float, n * m> std_arr = {3.45f, 3.1f, 6.7f, 54.3f, 5.74f, 0.45f};
+  QVERIFY((grabnum::MatrixXf<n, m>(std_arr) == mat_nxm_f));
+
+  // Compile-time construction and arithmetic.
+  constexpr grabnum::Matrix2d kMat = {1., 2., 3., 4.};
+  constexpr grabnum::Matrix2d kSum = 2.0 * kMat - grabnum::Matrix2d(1.0) + 1.0;
+  constexpr grabnum::Vector3d kVect = {1., 2., 3.};
+  constexpr grabnum::Vector3d kProd = kVect * kVect / 2.0 - (-kVect);
+  static_assert(kSum(1, 1) == 2.0 && kSum(1, 2) == 5.0 && kSum(2, 2) == 8.0,
+                "constexpr matrix arithmetic");
+  static_assert(kProd(3) == 7.5, "constexpr vector arithmetic");
+  static_assert(kMat + grabnum::Matrix2d(1.0) == grabnum::Matrix2d({2., 2., 3., 5.}),
+                "constexpr matrix comparison");
+  QVERIFY(kSum == 2.0 * kMat - grabnum::Matrix2d(1.0) + 1.0);
+
   // Constructor from copy.
   grabnum::MatrixXf<n, m> mat_nxm_f3 = mat_nxm_f2;
   QVERIFY(mat_nxm_f2 == mat_nxm_f3);
@@ -265,6 +296,13 @@ void TestMatrix::Setters()
       else
         QVERIFY(mat(i, j) == 0);
 
+  // Test SetCol with initializer list and standard array
+  mat.SetZero();
+  mat.SetCol(start_col, {1, 2, 3, 4, 5});
+  QVERIFY(mat.GetCol(start_col) == grabnum::VectorXi<dim1>(values, dim1));
+  mat.SetCol(start_col, std::array<int, dim1>{{5, 4, 3, 2, 1}});
+  QVERIFY(mat(1, start_col) == 5 && mat(dim1, start_col) == 1);
+
   // Test SetRow with 1D matrix
   mat.SetZero();
   grabnum::MatrixXi<1, dim2> row(IValues_, dim2);
@@ -287,7 +325,18 @@ void TestMatrix::Setters()
       else
         QVERIFY(mat(i, j) == 0);
 
+  // Test SetRow with initializer list and standard array
+  mat.SetZero();
+  mat.SetRow(start_row, {1, 2, 3, 4});
+  QVERIFY((mat.GetRow(start_row) == grabnum::MatrixXi<1, dim2>(values2, dim2)));
+  mat.SetRow(start_row, std::array<int, dim2>{{4, 3, 2, 1}});
+  QVERIFY(mat(start_row, 1) == 4 && mat(start_row, dim2) == 1);
+
   // Test Fill
+  mat22i_.Fill({4, 3, 2, 1});
+  QVERIFY(mat22i_(1, 1) == 4 && mat22i_(2, 2) == 1);
+  mat22i_.Fill(std::array<int, 4>{{2, 1, 4, 3}});
+  QVERIFY(mat22i_(1, 1) == 2 && mat22i_(2, 2) == 3);
   mat22i_.Fill(values2, ARRAY_SIZE(values2));
   QVERIFY(mat22i_(1, 1) == 1);
   QVERIFY(mat22i_(1, 2) == 2);
@@ -408,5 +457,656 @@ void TestMatrix::Utilities()
   QVERIFY(!mat.IsPositiveDefinite());
 }
 
+void TestMatrix::Kernels()
+{
+  // Odd sizes exercise both the vectorized body and the remainder of each kernel
+  grabnum::MatrixXd<5, 7> lhs;
+  grabnum::MatrixXd<7, 3> rhs;
+  for (uint8_t i = 1; i <= lhs.Size(); ++i)
+    lhs(i) = 0.5 * i - 3.0;
+  for (uint8_t i = 1; i <= rhs.Size(); ++i)
+    rhs(i) = 1.0 / i;
+
+  // Test product against naive implementation
+  grabnum::MatrixXd<5, 3> prod = lhs * rhs;
+  for (uint8_t row = 1; row <= 5; ++row)
+    for (uint8_t col = 1; col <= 3; ++col)
+    {
+      double value = 0.0;
+      for (uint8_t k = 1; k <= 7; ++k)
+        value += lhs(row, k) * rhs(k, col);
+      QVERIFY(grabnum::IsClose(prod(row, col), value));
+    }
+
+  // Test transposition
+  grabnum::MatrixXd<7, 5> lhs_t = lhs.Transpose();
+  for (uint8_t row = 1; row <= 5; ++row)
+    for (uint8_t col = 1; col <= 7; ++col)
+      QVERIFY(lhs_t(col, row) == lhs(row, col));
+  QVERIFY(lhs_t.Transpose() == lhs);
+
+  // Test element-wise operations and padding consistency
+  grabnum::MatrixXd<5, 7> sum = lhs + lhs * 2.0 - lhs;
+  QVERIFY(sum.IsApprox(2.0 * lhs));
+  sum += 1.0;
+  sum -= 1.0;
+  QVERIFY(sum.IsApprox(lhs * 2.0));
+  QVERIFY((lhs - lhs).IsApprox(lhs * 0.0));
+
+  grabnum::Matrix3i mat_i(2);
+  QVERIFY(mat_i * mat_i == grabnum::Matrix3i(4));
+}
+
+void TestMatrix::Expressions()
+{
+  grabnum::Vector3d vect1(DValues_, 3);
+  grabnum::Vector3d vect2(DValues_ + 3, 3);
+
+  // Element-wise operations are lazy and evaluated only on assignment
+  QVERIFY((!std::is_base_of<grabnum::Vector3d, decltype(vect1 + 2.0 * vect2)>::value));
+  grabnum::Vector3d result = vect1 * 0.5 + 2.0 * vect2 - vect1 / 4.0;
+  for (uint8_t i = 1; i <= 3; ++i)
+    QVERIFY(grabnum::IsClose(result(i), 0.25 * DValues_[i - 1] + 2.0 * DValues_[i + 2]));
+  QVERIFY((vect1 + vect2)(2) == vect1(2) + vect2(2));
+  QVERIFY((-vect1 + vect2) == (vect2 - vect1));
+
+  // Aliasing is safe for element-wise expressions
+  result = vect1;
+  result = vect2 - result * 2.0;
+  QVERIFY(result.IsApprox(vect2 - 2.0 * vect1));
+  result += vect1 + vect1;
+  QVERIFY(result.IsApprox(vect2));
+  result -= vect2 - vect1;
+  QVERIFY(result.IsApprox(vect1));
+
+  // Expressions as operands of products and utilities
+  QVERIFY(grabnum::IsClose(grabnum::Dot(vect1 + vect2, vect1 - vect2),
+                           grabnum::Dot(vect1, vect1) - grabnum::Dot(vect2, vect2)));
+  QVERIFY(grabnum::IsClose(grabnum::Norm(vect2 - vect1), std::sqrt(27.0)));
+  QVERIFY(
+    grabnum::Cross(vect1 * 2.0, vect2).IsApprox(2.0 * grabnum::Cross(vect1, vect2)));
+  grabnum::Matrix3d mat = grabnum::Skew(vect1) + grabnum::Matrix3d(1.0);
+  QVERIFY((mat * (vect1 + vect2)).IsApprox(mat * vect1 + mat * vect2));
+  mat.SetCol(2, vect1 - vect2);
+  QVERIFY(mat.GetCol(2).IsApprox(vect1 - vect2));
+  mat.SetRow(3, (vect1 + vect2).Transpose());
+  QVERIFY(mat(3, 2) == vect1(2) + vect2(2));
+}
+
+void TestMatrix::Views()
+{
+  grabnum::MatrixXd<4, 5> mat(DValues_, 20);
+  grabnum::Vector3d vect(DValues_, 3);
+
+  // Views read the same elements of the copies
+  QVERIFY(mat.Col(2) == mat.GetCol(2));
+  QVERIFY(mat.Row(3) == mat.GetRow(3));
+  QVERIFY((mat.Block<2, 3>(2, 3) == mat.GetBlock<2, 3>(2, 3)));
+  QVERIFY((mat.Block<2, 3>(2, 3)(2, 1) == mat(3, 3)));
+  QVERIFY(mat.Col(4)(3) == mat(3, 4));
+
+  // Views as operands of expressions, products and utilities
+  QVERIFY(grabnum::IsClose(grabnum::Dot(mat.Col(1), mat.Col(2)),
+                           grabnum::Dot(mat.GetCol(1), mat.GetCol(2))));
+  QVERIFY(grabnum::IsClose(grabnum::Norm(mat.Row(2)), grabnum::Norm(mat.GetRow(2))));
+  grabnum::Vector3d result = mat.Block<3, 1>(1, 2) + 2.0 * vect;
+  QVERIFY(result.IsApprox(mat.GetBlock<3, 1>(1, 2) + 2.0 * vect));
+  QVERIFY((mat.Col(5) * mat.Row(1)).IsApprox(mat.GetCol(5) * mat.GetRow(1)));
+  QVERIFY((mat.Block<3, 3>(1, 1) * vect).IsApprox(mat.GetBlock<3, 3>(1, 1) * vect));
+
+  // Views assign in place
+  grabnum::MatrixXd<4, 5> copy(mat);
+  mat.Col(2) = mat.Col(1) * 2.0;
+  QVERIFY(mat.GetCol(2).IsApprox(copy.GetCol(1) * 2.0));
+  QVERIFY(mat.GetCol(1) == copy.GetCol(1));
+  grabnum::MatrixXd<1, 5> row = mat.Row(4);
+  mat.Row(4) += mat.Row(1);
+  QVERIFY(mat.GetRow(4).IsApprox(row + mat.GetRow(1)));
+  mat.Block<3, 1>(2, 5) = vect;
+  QVERIFY((mat.GetBlock<3, 1>(2, 5) == vect));
+  QVERIFY(mat(1, 5) == copy(1, 5));
+  mat.Block<2, 2>(1, 1) *= 0.0;
+  QVERIFY(mat(1, 1) == 0.0 && mat(2, 2) == 0.0 && mat(3, 3) == copy(3, 3));
+  mat.Col(3).Fill(1.0);
+  for (uint8_t i = 1; i <= 4; ++i)
+    QVERIFY(mat(i, 3) == 1.0);
+
+  // Read-only views of constant matrices
+  const grabnum::MatrixXd<4, 5>& const_mat = copy;
+  grabnum::MatrixView<const double, 4, 1, 5> const_col = copy.Col(1);
+  QVERIFY(const_col == const_mat.Col(1));
+  QVERIFY(grabnum::IsClose(grabnum::Dot(const_mat.Block<3, 1>(1, 1), vect),
+                           grabnum::Dot(copy.GetBlock<3, 1>(1, 1), vect)));
+}
+
+void TestMatrix::DynamicMatrix()
+{
+  grabnum::Vector3d vect(DValues_, 3);
+
+  // Construction, small-size storage and growth beyond it
+  grabnum::MatrixX<double> mat(kDim1_, kDim2_, DValues_, 6);
+  QVERIFY(mat.Rows() == kDim1_ && mat.Cols() == kDim2_ && mat.Size() == 6);
+  QVERIFY(mat == mat23d_.Fill(DValues_, 6));
+  QVERIFY(grabnum::MatrixX<double>(2, 2, {1., 2., 3., 4.}) ==
+          grabnum::Matrix2d({1., 2., 3., 4.}));
+  QVERIFY(grabnum::MatrixX<double>(1, 2).Fill(std::array<double, 2>{{1., 2.}})(1, 2) ==
+          2.);
+  QVERIFY(grabnum::MatrixX<double>(3, 3, 1.0) == grabnum::Matrix3d(1.0));
+  grabnum::MatrixX<double> big(20, 30, 2.0);
+  QVERIFY(big(20, 20) == 2.0 && big(20, 21) == 0.0 && big(1, 30) == 0.0);
+  big.Resize(6, 12);
+  QVERIFY(big.Rows() == 6 && big.Cols() == 12 && big(6, 6) == 0.0);
+
+  // Copy and move semantics
+  grabnum::MatrixX<double> copy(big);
+  copy(1, 1) = 1.0;
+  QVERIFY(big(1, 1) == 0.0);
+  grabnum::MatrixX<double> moved(std::move(copy));
+  QVERIFY(moved(1, 1) == 1.0 && copy.Size() == 0);
+
+  // Interoperability with fixed-size matrices, expressions and views
+  grabnum::MatrixX<double> structure(6, 4);
+  for (uint8_t i = 1; i <= 4; ++i)
+  {
+    structure.Block<3, 1>(1, i) = vect * static_cast<double>(i);
+    structure.Block<3, 1>(4, i) = grabnum::Cross(vect, vect) + 1.0;
+  }
+  QVERIFY((structure.GetBlock<3, 1>(1, 3) == vect * 3.0));
+  grabnum::MatrixX<double> tension(4, 1, std::vector<double>(4, 0.5));
+  grabnum::VectorXd<6> wrench = structure * tension;
+  QVERIFY((wrench.GetBlock<3, 1>(1, 1).IsApprox(vect * 5.0)));
+  QVERIFY(grabnum::IsClose(wrench(6), 2.0));
+  QVERIFY((structure.Transpose() * wrench).IsApprox(
+    structure.Transpose() * (structure * tension)));
+  grabnum::MatrixX<double> sum = 2.0 * structure - structure;
+  QVERIFY(sum == structure);
+  sum -= structure;
+  QVERIFY(sum == grabnum::MatrixX<double>(6, 4));
+  QVERIFY(grabnum::IsClose(grabnum::Dot(tension, tension), 1.0));
+  QVERIFY(grabnum::IsClose(grabnum::Norm(tension), 1.0));
+
+  // Mapping on existing storage, without copies
+  grabnum::Matrix3d fixed(1.0);
+  grabnum::MatrixX<double> mapped = grabnum::MatrixX<double>::Map(fixed);
+  mapped(1, 2) = 5.0;
+  QVERIFY(fixed(1, 2) == 5.0);
+  mapped = mapped * 2.0;
+  QVERIFY(fixed(3, 3) == 2.0 && fixed(1, 2) == 10.0);
+  double buffer[6] = {0.0};
+  grabnum::MatrixX<double>::Map(buffer, 2, 3).SetRow(2, vect.Transpose());
+  QVERIFY(buffer[3] == vect(1) && buffer[5] == vect(3));
+}
+
+void TestMatrix::Sparse()
+{
+  // Construction from triplets, with duplicates summed up
+  grabnum::SparseMatrix<double> mat(
+    3, 4, {{2, 3, 1.0}, {1, 1, 2.0}, {3, 4, -1.0}, {2, 3, 0.5}, {1, 2, 3.0}});
+  QVERIFY(mat.Rows() == 3 && mat.Cols() == 4 && mat.NonZeros() == 4);
+  QVERIFY(mat(2, 3) == 1.5 && mat(1, 2) == 3.0 && mat(3, 1) == 0.0);
+  QVERIFY(mat.LowerBandwidth() == 0 && mat.UpperBandwidth() == 1);
+  grabnum::MatrixX<double> dense = mat.ToDense();
+  QVERIFY(grabnum::SparseMatrix<double>(dense).NonZeros() == 4);
+  QVERIFY(mat.Transpose().ToDense() == dense.Transpose());
+  grabnum::VectorXd<4> vect({1.0, -2.0, 3.0, 0.5});
+  QVERIFY((mat * vect).IsApprox(dense * vect));
+
+  // Banded system needing row exchanges
+  const uint16_t kSize = 40;
+  std::vector<grabnum::Triplet<double>> entries;
+  for (uint16_t i = 1; i <= kSize; ++i)
+  {
+    entries.push_back({i, i, i % 3 == 0 ? 1e-3 : 4.0});
+    if (i > 1)
+      entries.push_back({i, static_cast<uint16_t>(i - 1), 1.0 + i % 5});
+    if (i < kSize)
+      entries.push_back({i, static_cast<uint16_t>(i + 1), -1.0});
+    if (i + 2 <= kSize)
+      entries.push_back({i, static_cast<uint16_t>(i + 2), 0.5});
+  }
+  grabnum::SparseMatrix<double> banded(kSize, kSize, entries);
+  QVERIFY(banded.LowerBandwidth() == 1 && banded.UpperBandwidth() == 2);
+  grabnum::MatrixX<double> rhs(kSize, 2);
+  for (uint16_t i = 1; i <= kSize; ++i)
+  {
+    rhs(i, 1) = std::sin(i);
+    rhs(i, 2) = 1.0;
+  }
+  grabnum::BandedLU<double> band_lu(banded);
+  QVERIFY(band_lu.IsInvertible());
+  QVERIFY((banded * band_lu.Solve(rhs)).IsApprox(rhs, 1e-9));
+  QVERIFY(grabnum::SelectSparseStructure(banded) == grabnum::BANDED);
+
+  // Independent subsystems with interleaved unknowns, e.g. several robots at once
+  entries.clear();
+  for (uint16_t k = 1; k <= kSize; ++k)
+    for (uint16_t j = (k - 1) % 4 + 1; j <= kSize; j += 4)
+      entries.push_back({k, j, k == j ? 10.0 : 1.0 / (k + j)});
+  grabnum::SparseMatrix<double> blocks(kSize, kSize, entries);
+  QVERIFY(grabnum::SelectSparseStructure(blocks) == grabnum::BLOCK_DIAGONAL);
+  grabnum::SparseLU<double> sparse_lu(blocks);
+  QVERIFY(sparse_lu.Structure() == grabnum::BLOCK_DIAGONAL && sparse_lu.Blocks() == 4);
+  grabnum::MatrixX<double> solution = sparse_lu.Solve(rhs);
+  QVERIFY((blocks * solution).IsApprox(rhs, 1e-9));
+  sparse_lu.Compute(blocks, grabnum::DENSE);
+  QVERIFY(sparse_lu.Solve(rhs).IsApprox(solution, 1e-9));
+  QVERIFY(grabnum::solvers::Linsolve(blocks, rhs).IsApprox(solution, 1e-9));
+
+  // Small matrices are dense, singular ones are detected
+  grabnum::SparseMatrix<double> diagonal(grabnum::Matrix3d(2.0));
+  QVERIFY(grabnum::SelectSparseStructure(diagonal) == grabnum::DENSE);
+  grabnum::SparseMatrix<double> singular(3, 3, {{1, 1, 1.0}, {3, 3, 1.0}});
+  grabnum::SparseLU<double> singular_lu(singular);
+  QVERIFY(!singular_lu.IsInvertible());
+  bool thrown = false;
+  try
+  {
+    singular_lu.Solve(vect.GetBlock<3, 1>(1, 1));
+  }
+  catch (const std::invalid_argument&)
+  {
+    thrown = true;
+  }
+  QVERIFY(thrown);
+}
+
+void TestMatrix::Decompositions()
+{
+  grabnum::Matrix3d A(std::vector<double>{2, 1, 1, 4, -6, 0, -2, 7, 2});
+  grabnum::Vector3d b(std::vector<double>{5, -2, 9});
+  grabnum::Vector3d x(std::vector<double>{1, 1, 2});
+
+  // LU: factorize once, solve many times
+  grabnum::LU<double, 3> lu(A);
+  QVERIFY(lu.IsInvertible());
+  QVERIFY(lu.Solve(b).IsApprox(x));
+  QVERIFY(lu.Solve(2.0 * b).IsApprox(2.0 * x));
+  QVERIFY((lu.GetP() * A).IsApprox(lu.GetL() * lu.GetU()));
+  QVERIFY(grabnum::IsClose(lu.Det(), grabnum::Det(A)));
+  QVERIFY((A * lu.Inverse()).IsApprox(grabnum::Matrix3d(1.0)));
+  QVERIFY(grabnum::solvers::Linsolve(A, b).IsApprox(x));
+  QVERIFY((!grabnum::LU<double, 3>(grabnum::Matrix3d(0.0)).IsInvertible()));
+
+  // QR: square and least-squares systems
+  grabnum::QR<double, 3, 3> qr(A);
+  QVERIFY(qr.Solve(b).IsApprox(x));
+  QVERIFY((qr.GetQ() * qr.GetR()).IsApprox(A));
+  QVERIFY((qr.GetQ().Transpose() * qr.GetQ()).IsApprox(grabnum::Matrix3d(1.0)));
+  QVERIFY(grabnum::IsClose(qr.Det(), lu.Det()));
+  QVERIFY(qr.Inverse().IsApprox(lu.Inverse()));
+  // Line fitting y = 1 + 2 * t through noisy points
+  grabnum::MatrixXd<5, 2> samples(std::vector<double>{1, 0, 1, 1, 1, 2, 1, 3, 1, 4});
+  grabnum::VectorXd<5> y(std::vector<double>{1.1, 2.9, 5.1, 6.9, 9.0});
+  grabnum::QR<double, 5, 2> fit(samples);
+  grabnum::VectorXd<2> coeffs = fit.Solve(y);
+  QVERIFY((coeffs.IsApprox(grabnum::LU<double, 2>(samples.Transpose() * samples)
+                              .Solve(samples.Transpose() * y))));
+  QVERIFY(std::fabs(coeffs(1) - 1.0) < 0.1 && std::fabs(coeffs(2) - 2.0) < 0.1);
+
+  // Large determinants go through LU, and stay exact on integer matrices
+  grabnum::MatrixXi<6, 6> imat(1);
+  imat.SetBlock(1, 1, grabnum::Matrix3i(std::vector<int>{3, 1, 0, 2, 5, 1, 0, 4, 2}));
+  imat(4, 1) = 7;
+  imat(6, 6) = -3;
+  QVERIFY(grabnum::Det(imat) == -3 * 14);
+  grabnum::MatrixXd<6, 6> dmat(imat);
+  dmat(1, 6) = 0.5;
+  // Cross-check against the cofactor expansion along the last column
+  QVERIFY(grabnum::IsClose(grabnum::Det(dmat),
+                           -0.5 * grabnum::Det(grabnum::GetCofactor(dmat, 1, 6)) -
+                             3.0 * grabnum::Det(grabnum::GetCofactor(dmat, 6, 6))));
+
+  // Closed-form and LU inverses
+  grabnum::Matrix2d A2(std::vector<double>{4, 7, 2, 6});
+  QVERIFY((grabnum::Inverse(A2) * A2).IsApprox(grabnum::Matrix2d(1.0)));
+  QVERIFY(grabnum::Inverse(A).IsApprox(lu.Inverse()));
+  grabnum::MatrixXd<4, 4> A4(1.0);
+  A4.SetBlock(1, 1, A);
+  A4.SetRow(4, grabnum::MatrixXd<1, 4>(std::vector<double>{1, -1, 3, 5}));
+  QVERIFY((grabnum::Inverse(A4) * A4).IsApprox(grabnum::MatrixXd<4, 4>(1.0)));
+  QVERIFY(grabnum::Inverse(A4).IsApprox(grabnum::LU<double, 4>(A4).Inverse()));
+  QVERIFY((grabnum::Inverse(dmat) * dmat).IsApprox(grabnum::MatrixXd<6, 6>(1.0)));
+  QVERIFY(grabnum::Inverse(2.0 * A).IsApprox(0.5 * grabnum::Inverse(A)));
+  bool thrown = false;
+  try
+  {
+    grabnum::Inverse(grabnum::Matrix3d(0.0));
+  }
+  catch (const std::invalid_argument&)
+  {
+    thrown = true;
+  }
+  QVERIFY(thrown);
+
+  // Pseudo-inverse of full-rank and rank-deficient matrices
+  QVERIFY(grabnum::PseudoInverse(A).IsApprox(grabnum::Inverse(A)));
+  grabnum::MatrixXd<2, 5> pinv = grabnum::PseudoInverse(samples);
+  QVERIFY((pinv * y).IsApprox(coeffs));
+  grabnum::MatrixXd<5, 2> pinv_t = grabnum::PseudoInverse(samples.Transpose());
+  QVERIFY(pinv_t.IsApprox(pinv.Transpose()));
+  grabnum::MatrixXd<3, 4> deficient(
+    std::vector<double>{1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 0, 1});
+  grabnum::MatrixXd<4, 3> pinv_d = grabnum::PseudoInverse(deficient);
+  QVERIFY((deficient * pinv_d * deficient).IsApprox(deficient));
+  QVERIFY((pinv_d * deficient * pinv_d).IsApprox(pinv_d));
+  QVERIFY((deficient * pinv_d).IsApprox((deficient * pinv_d).Transpose()));
+  QVERIFY((pinv_d * deficient).IsApprox((pinv_d * deficient).Transpose()));
+
+  // LDLT of a symmetric, positive-definite matrix
+  grabnum::Matrix3d spd(std::vector<double>{25, 15, -5, 15, 18, 0, -5, 0, 11});
+  grabnum::Matrix3d l_spd(std::vector<double>{1, 0, 0, 0.6, 1, 0, -0.2, 1.0 / 3.0, 1});
+  grabnum::LDLT<double, 3> ldlt;
+  QVERIFY(ldlt.Status() == grabnum::LDLT_NOT_COMPUTED);
+  QVERIFY(ldlt.Compute(spd) == grabnum::LDLT_SUCCESS);
+  QVERIFY(ldlt.IsPositiveDefinite());
+  QVERIFY(ldlt.GetL().IsApprox(l_spd));
+  QVERIFY(ldlt.GetD().IsApprox(grabnum::Vector3d({25, 9, 9})));
+  QVERIFY(grabnum::IsClose(ldlt.Det(), 2025.0));
+  grabnum::Vector3d rhs({1, -2, 3});
+  QVERIFY((spd * ldlt.Solve(rhs)).IsApprox(rhs));
+
+  // Rank-1 update and downdate
+  grabnum::Vector3d z({1, 2, -1});
+  grabnum::Matrix3d spd_up = spd + z * z.Transpose();
+  QVERIFY(ldlt.Update(z) == grabnum::LDLT_SUCCESS);
+  QVERIFY(ldlt.GetL().IsApprox(grabnum::LDLT<double, 3>(spd_up).GetL()));
+  QVERIFY(ldlt.GetD().IsApprox(grabnum::LDLT<double, 3>(spd_up).GetD()));
+  QVERIFY((spd_up * ldlt.Solve(rhs)).IsApprox(rhs));
+  QVERIFY(ldlt.Update(z, -1) == grabnum::LDLT_SUCCESS);
+  QVERIFY(ldlt.GetL().IsApprox(l_spd));
+  QVERIFY(ldlt.GetD().IsApprox(grabnum::Vector3d({25, 9, 9})));
+  // A downdate breaking positive-definiteness leaves the factorization untouched.
+  QVERIFY(ldlt.Update(10.0 * z, -1) == grabnum::LDLT_NOT_POSITIVE_DEFINITE);
+  QVERIFY(ldlt.GetD().IsApprox(grabnum::Vector3d({25, 9, 9})));
+
+  // Failures are reported by status, without exceptions
+  grabnum::Matrix3d indefinite = spd - 20.0 * grabnum::Matrix3d(1.0);
+  QVERIFY(ldlt.Compute(indefinite) == grabnum::LDLT_NOT_POSITIVE_DEFINITE);
+  QVERIFY(!ldlt.IsPositiveDefinite());
+  QVERIFY(ldlt.Update(z) == grabnum::LDLT_NOT_POSITIVE_DEFINITE);
+  QVERIFY(spd.IsPositiveDefinite());
+  QVERIFY(!indefinite.IsPositiveDefinite());
+
+  // Eigendecomposition of symmetric matrices, A * V = V * diag(lambda)
+  grabnum::SymmetricEigen<double, 3> eig(spd);
+  QVERIFY(eig.HasConverged());
+  grabnum::Vector3d lambda = eig.GetEigenvalues();
+  QVERIFY(lambda(1) <= lambda(2) && lambda(2) <= lambda(3));
+  QVERIFY(grabnum::IsClose(lambda(1) + lambda(2) + lambda(3), 54.0));
+  QVERIFY(grabnum::IsClose(lambda(1) * lambda(2) * lambda(3), 2025.0, 1e-9));
+  grabnum::Matrix3d vectors = eig.GetEigenvectors();
+  QVERIFY((vectors.Transpose() * vectors).IsApprox(grabnum::Matrix3d(1.0)));
+  for (uint8_t i = 1; i <= 3; ++i)
+    QVERIFY((spd * vectors.GetCol(i)).IsApprox(lambda(i) * vectors.GetCol(i)));
+  eig.Compute(indefinite, false);
+  QVERIFY(eig.GetEigenvalues().IsApprox(lambda - 20.0 * grabnum::Vector3d({1, 1, 1})));
+  grabnum::MatrixXd<6, 6> sym = dmat + dmat.Transpose();
+  grabnum::SymmetricEigen<double, 6> eig6(sym);
+  QVERIFY(eig6.HasConverged());
+  grabnum::MatrixXd<6, 6> scaled = eig6.GetEigenvectors();
+  for (uint8_t i = 1; i <= 6; ++i)
+    for (uint8_t j = 1; j <= 6; ++j)
+      scaled(i, j) *= eig6.GetEigenvalues()(j);
+  QVERIFY((sym * eig6.GetEigenvectors()).IsApprox(scaled));
+
+  // Singular value decomposition of tall and wide matrices, A = U * diag(sigma) * V^T
+  grabnum::SVD<double, 5, 2> svd(samples);
+  QVERIFY(svd.HasConverged());
+  grabnum::MatrixXd<5, 2> u_sigma = svd.GetU();
+  for (uint8_t i = 1; i <= 5; ++i)
+    for (uint8_t j = 1; j <= 2; ++j)
+      u_sigma(i, j) *= svd.GetSingularValues()(j);
+  QVERIFY((u_sigma * svd.GetV().Transpose()).IsApprox(samples));
+  QVERIFY((svd.GetU().Transpose() * svd.GetU()).IsApprox(grabnum::Matrix2d(1.0)));
+  grabnum::SymmetricEigen<double, 2> gram(samples.Transpose() * samples);
+  grabnum::Vector2d gram_values = gram.GetEigenvalues();
+  QVERIFY(grabnum::IsClose(svd.GetSingularValues()(1), std::sqrt(gram_values(2))));
+  QVERIFY(grabnum::IsClose(svd.Condition(), std::sqrt(gram_values(2) / gram_values(1))));
+  QVERIFY(svd.Rank() == 2);
+  grabnum::SVD<double, 3, 4> svd_d(deficient);
+  QVERIFY(svd_d.HasConverged());
+  QVERIFY(svd_d.Rank() == 2);
+  QVERIFY(svd_d.Condition() > 1e12);
+  grabnum::MatrixXd<3, 3> u_sigma_d = svd_d.GetU();
+  for (uint8_t i = 1; i <= 3; ++i)
+    for (uint8_t j = 1; j <= 3; ++j)
+      u_sigma_d(i, j) *= svd_d.GetSingularValues()(j);
+  QVERIFY((u_sigma_d * svd_d.GetV().Transpose()).IsApprox(deficient));
+  grabnum::SVD<double, 3, 3> svd_zero(grabnum::Matrix3d(0.0), false);
+  QVERIFY(svd_zero.Rank() == 0);
+  QVERIFY(std::isinf(svd_zero.Condition()));
+}
+
+void TestMatrix::VectorBatch()
+{
+  // Odd number of lanes, so that the SIMD tail is exercised too
+  constexpr uint16_t kLanes = 7;
+  grabnum::Vector3Batchd<kLanes> vects1, vects2;
+  std::array<double, kLanes> angles;
+  for (uint16_t i = 1; i <= kLanes; ++i)
+  {
+    vects1.Set(i, grabnum::Vector3d({0.5 * i, 1.0 - i, 2.0}));
+    vects2.Set(i, grabnum::Vector3d({-1.0, 0.3 * i * i, 1.0 / i}));
+    angles[i - 1] = -7.0 + 2.3 * i;
+  }
+
+  // Lane-by-lane linear algebra matches the single-vector functions
+  const std::array<double, kLanes> dot   = grabnum::Dot(vects1, vects2);
+  const std::array<double, kLanes> norm  = grabnum::Norm(vects1);
+  const grabnum::Vector3Batchd<kLanes> cross = grabnum::Cross(vects1, vects2);
+  for (uint16_t i = 1; i <= kLanes; ++i)
+  {
+    QVERIFY(std::abs(dot[i - 1] - grabnum::Dot(vects1.Get(i), vects2.Get(i))) < 1e-12);
+    QVERIFY(std::abs(norm[i - 1] - grabnum::Norm(vects1.Get(i))) < 1e-12);
+    QVERIFY(cross.Get(i).IsApprox(grabnum::Cross(vects1.Get(i), vects2.Get(i))));
+  }
+
+  // Trigonometric kernels match the standard library in all quadrants
+  std::array<double, kLanes> sin, cos;
+  grabnum::SinCos(angles, &sin, &cos);
+  const std::array<double, kLanes> atan2 = grabnum::Atan2(sin, cos);
+  for (uint16_t i = 0; i < kLanes; ++i)
+  {
+    QVERIFY(std::abs(sin[i] - std::sin(angles[i])) < 1e-15);
+    QVERIFY(std::abs(cos[i] - std::cos(angles[i])) < 1e-15);
+    QVERIFY(std::abs(atan2[i] - std::atan2(sin[i], cos[i])) < 1e-15);
+  }
+
+  // Single precision
+  std::array<float, 9> anglesf, sinf, cosf;
+  for (uint16_t i = 0; i < anglesf.size(); ++i)
+    anglesf[i] = -3.f + 0.75f * i;
+  grabnum::SinCos(anglesf, &sinf, &cosf);
+  for (uint16_t i = 0; i < anglesf.size(); ++i)
+  {
+    QVERIFY(std::abs(sinf[i] - std::sin(anglesf[i])) < 1e-6f);
+    QVERIFY(std::abs(cosf[i] - std::cos(anglesf[i])) < 1e-6f);
+  }
+}
+
+void TestMatrix::Solvers()
+{
+  // Levenberg-Marquardt on the Rosenbrock function, from the classic starting point
+  grabnum::Vector2d x({-1.2, 1.0});
+  grabnum::solvers::SolverReport<double> report = grabnum::solvers::LevenbergMarquardt(
+    +[](grabnum::Vector2d& F, grabnum::Matrix2d& J, const grabnum::Vector2d& x) {
+      F.Fill({10.0 * (x(2) - x(1) * x(1)), 1.0 - x(1)});
+      J.Fill({-20.0 * x(1), 10.0, -1.0, 0.0});
+    },
+    x);
+  QVERIFY(report.Converged());
+  QVERIFY(x.IsApprox(grabnum::Vector2d({1.0, 1.0}), 1e-6));
+
+  // Over-determined: fit a circle to noisy points with a capturing callable
+  const double kPoints[6][2] = {{2.1, 1.0},  {1.0, 2.05}, {-0.05, 1.0},
+                                {1.0, -0.02}, {1.72, 1.7}, {0.29, 0.3}};
+  grabnum::Vector3d circle({0.5, 0.5, 0.5}); // center and radius
+  report = grabnum::solvers::LevenbergMarquardt<6>(
+    [&kPoints](grabnum::VectorXd<6>& F, grabnum::MatrixXd<6, 3>& J,
+               const grabnum::Vector3d& c) {
+      for (uint8_t i = 1; i <= 6; ++i)
+      {
+        const double dx = c(1) - kPoints[i - 1][0];
+        const double dy = c(2) - kPoints[i - 1][1];
+        const double d  = std::sqrt(dx * dx + dy * dy);
+        F(i)            = d - c(3);
+        J.SetRow(i, {dx / d, dy / d, -1.0});
+      }
+    },
+    circle);
+  QVERIFY(report.Converged());
+  QVERIFY(report.residual_norm < 0.1);
+  QVERIFY(circle.IsApprox(grabnum::Vector3d({1.0, 1.0, 1.0}), 0.05));
+
+  // Budget exhaustion is reported, and the best solution found so far is kept
+  grabnum::solvers::LevMarOptions<double> options;
+  options.max_iter = 2;
+  x.Fill({-1.2, 1.0});
+  report = grabnum::solvers::LevenbergMarquardt(
+    +[](grabnum::Vector2d& F, grabnum::Matrix2d& J, const grabnum::Vector2d& x) {
+      F.Fill({10.0 * (x(2) - x(1) * x(1)), 1.0 - x(1)});
+      J.Fill({-20.0 * x(1), 10.0, -1.0, 0.0});
+    },
+    x, options);
+  QVERIFY(report.status == grabnum::solvers::MAX_ITERATIONS);
+  QVERIFY(report.iterations == 2 && !report.Converged());
+  QVERIFY(report.residual_norm < std::sqrt(4.4 * 4.4 + 2.2 * 2.2));
+
+  // Square systems with callables carrying their parameters: intersect a circle of
+  // given radius with the line y = x
+  const double radius = 2.0;
+  grabnum::solvers::NewtonWorkspace<double, 2> newton;
+  x.Fill({1.0, 0.5});
+  grabnum::solvers::NonLinsolveJacobian(
+    [radius](grabnum::Vector2d& F, grabnum::Matrix2d& J, const grabnum::Vector2d& x) {
+      F.Fill({x(1) * x(1) + x(2) * x(2) - radius * radius, x(1) - x(2)});
+      J.Fill({2.0 * x(1), 2.0 * x(2), 1.0, -1.0});
+    },
+    x, newton);
+  QVERIFY(x.IsApprox(grabnum::Vector2d({std::sqrt(2.0), std::sqrt(2.0)}), 1e-9));
+  QVERIFY(grabnum::Norm(newton.residual) < 1e-9);
+  x.Fill({1.0, 0.5});
+  grabnum::solvers::fsolveB(
+    [radius](grabnum::Vector2d& F, const grabnum::Vector2d& x) {
+      F.Fill({x(1) * x(1) + x(2) * x(2) - radius * radius, x(1) - x(2)});
+    },
+    x);
+  QVERIFY(std::fabs(std::fabs(x(1)) - std::sqrt(2.0)) < 1e-6);
+  QVERIFY(std::fabs(x(1) - x(2)) < 1e-6);
+
+  // A singular jacobian stops the iterations at the last iterate instead of throwing
+  x.Fill({0.0, 0.0});
+  QVERIFY(grabnum::solvers::NonLinsolveJacobian(
+            [radius](grabnum::Vector2d& F, grabnum::Matrix2d& J,
+                     const grabnum::Vector2d& x) {
+              F.Fill({x(1) * x(1) + x(2) * x(2) - radius * radius, x(1) - x(2)});
+              J.Fill({2.0 * x(1), 2.0 * x(2), 1.0, -1.0});
+            },
+            x) == 0);
+  QVERIFY(x(1) == 0.0 && x(2) == 0.0);
+
+  // Quadratic program: closest point to c on the plane x1 + x2 + x3 = 3 within bounds,
+  // warm-started at the second call
+  grabnum::solvers::QPWorkspace<double, 3, 1> qp;
+  const grabnum::Matrix3d hessian(1.0);
+  const grabnum::Vector3d gradient({-3.0, -1.0, -1.0});
+  const grabnum::MatrixXd<1, 3> plane({1.0, 1.0, 1.0});
+  const grabnum::Vector3d lower({0.0, 0.0, 0.0});
+  const grabnum::Vector3d upper({2.0, 2.0, 0.8});
+  grabnum::Vector3d point;
+  report = grabnum::solvers::QuadProg(hessian, gradient, plane, grabnum::VectorXd<1>(3.0),
+                                      lower, upper, point, qp);
+  QVERIFY(report.status == grabnum::solvers::CONVERGED_RESIDUAL);
+  QVERIFY(point.IsApprox(grabnum::Vector3d({2.0, 0.5, 0.5}), 1e-9));
+  QVERIFY(qp.active_set[0] == 1 && qp.active_set[1] == 0 && qp.bound_multipliers(1) < 0);
+  report = grabnum::solvers::QuadProg(hessian, gradient, plane, grabnum::VectorXd<1>(3.0),
+                                      lower, upper, point, qp);
+  QVERIFY(report.Converged() && report.iterations == 1);
+  report = grabnum::solvers::QuadProg(hessian, gradient, plane, grabnum::VectorXd<1>(9.0),
+                                      lower, upper, point, qp);
+  QVERIFY(report.status == grabnum::solvers::INFEASIBLE && !report.Converged());
+  QVERIFY(point.IsApprox(upper, 1e-9));
+
+  // Runge-Kutta on a harmonic oscillator, both with function pointer and callable
+  grabnum::VectorXd<21> time;
+  for (uint8_t i = 1; i <= 21; ++i)
+    time(i) = 0.05 * (i - 1);
+  grabnum::MatrixXd<2, 21> sol_ptr, sol_fun;
+  grabnum::solvers::RKSolver(
+    +[](const double, const grabnum::Vector2d& y, grabnum::Vector2d& y_dot) {
+      y_dot.Fill({y(2), -y(1)});
+    },
+    time, grabnum::Vector2d({1.0, 0.0}), sol_ptr);
+  const double omega = 2.0;
+  grabnum::solvers::RKSolver(
+    [omega](const double, const grabnum::Vector2d& y, grabnum::Vector2d& y_dot) {
+      y_dot.Fill({y(2), -omega * omega * y(1)});
+    },
+    time, grabnum::Vector2d({1.0, 0.0}), sol_fun);
+  QVERIFY(std::fabs(sol_ptr(1, 21) - std::cos(1.0)) < 1e-8);
+  QVERIFY(std::fabs(sol_ptr(2, 21) + std::sin(1.0)) < 1e-8);
+  QVERIFY(std::fabs(sol_fun(1, 21) - std::cos(2.0)) < 1e-6);
+
+  // Adaptive Dormand-Prince over many periods, sampling the dense output at fixed rate
+  grabnum::solvers::ODEOptions<double> ode_options;
+  ode_options.rel_tol = 1e-8;
+  ode_options.abs_tol = 1e-10;
+  grabnum::Vector2d y({1.0, 0.0});
+  double sample_time = 0.0, max_error = 0.0;
+  grabnum::solvers::ODEReport<double> ode_report = grabnum::solvers::DormandPrince(
+    [](const double, const grabnum::Vector2d& y, grabnum::Vector2d& y_dot) {
+      y_dot.Fill({y(2), -y(1)});
+    },
+    0.0, 50.0, y, ode_options,
+    [&](const grabnum::solvers::DenseOutput<double, 2>& step) {
+      for (; sample_time <= step.GetEndTime(); sample_time += 0.01)
+        max_error = std::max(
+          max_error, std::fabs(step.Evaluate(sample_time)(1) - std::cos(sample_time)));
+      return true;
+    });
+  QVERIFY(ode_report.status == grabnum::solvers::END_REACHED);
+  QVERIFY(ode_report.time == 50.0);
+  QVERIFY(ode_report.rejected_steps < ode_report.accepted_steps);
+  QVERIFY(std::fabs(y(1) - std::cos(50.0)) < 1e-6);
+  QVERIFY(std::fabs(y(2) + std::sin(50.0)) < 1e-6);
+  QVERIFY(max_error < 1e-6 && sample_time > 50.0);
+  // The callback can stop the integration
+  y.Fill({1.0, 0.0});
+  uint32_t steps = 0;
+  ode_report = grabnum::solvers::DormandPrince(
+    [](const double, const grabnum::Vector2d& y, grabnum::Vector2d& y_dot) {
+      y_dot.Fill({y(2), -y(1)});
+    },
+    0.0, 50.0, y, ode_options,
+    [&steps](const grabnum::solvers::DenseOutput<double, 2>&) { return ++steps < 3; });
+  QVERIFY(ode_report.status == grabnum::solvers::INTERRUPTED);
+  QVERIFY(ode_report.accepted_steps == 3 && ode_report.time < 50.0);
+  QVERIFY(std::fabs(y(1) - std::cos(ode_report.time)) < 1e-8);
+
+  // Fixed-step steppers on a harmonic oscillator, advanced one period at a time
+  auto oscillator = [](const double, const grabnum::Vector2d& y,
+                       grabnum::Vector2d& y_dot) { y_dot.Fill({y(2), -y(1)}); };
+  auto rk4    = grabnum::solvers::MakeRK4Stepper<double, 2>(oscillator);
+  auto euler  = grabnum::solvers::MakeSemiImplicitEulerStepper<double, 2>(oscillator);
+  auto verlet = grabnum::solvers::MakeVerletStepper<double, 2>(oscillator);
+
+  const double dt = 0.01;
+  grabnum::Vector2d y_rk4({1.0, 0.0}), y_euler({1.0, 0.0}), y_verlet({1.0, 0.0});
+  double max_energy_drift = 0.0;
+  for (uint16_t k = 0; k < 1000; ++k)
+  {
+    rk4.Step(k * dt, y_rk4, dt);
+    euler.Step(k * dt, y_euler, dt);
+    verlet.Step(k * dt, y_verlet, dt);
+    max_energy_drift =
+      std::max(max_energy_drift, std::fabs(grabnum::Dot(y_euler, y_euler) - 1.0));
+  }
+  QVERIFY(std::fabs(y_rk4(1) - std::cos(10.0)) < 1e-9);
+  QVERIFY(std::fabs(y_verlet(1) - std::cos(10.0)) < 1e-4);
+  QVERIFY(std::fabs(y_euler(1) - std::cos(10.0)) < 1e-2);
+  // Symplectic Euler does not drift in energy, unlike explicit Euler
+  QVERIFY(max_energy_drift < 2 * dt);
+}
+
 QTEST_MAIN(TestMatrix)
 #include "matrix_test.moc"